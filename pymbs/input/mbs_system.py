@@ -3087,7 +3087,7 @@ class GenCode(object):
         self.world = world
 
 
-    def Python(self, modelname, dirname='.'):
+    def Python(self, modelname, dirname='.', **kwargs):
         '''
         After the equations of motion have been generated, the simulation code
         for Python can be generated with this function.
@@ -3096,8 +3096,18 @@ class GenCode(object):
         :type modelname: String
         :param dirname: Directory where the model shall be exported to
         :type dirname: String.
+        :param cost_report: Write the number of operations per equation to <modelname>_cost.json
+        :type cost_report: Bool
+        :param cache: Skip writing if the graph, the options and the files of a previous call are unchanged
+        :type cache: Bool
+        :param threads: Number of threads writing the output files in parallel
+        :type threads: Int
+        :param schedule: Reorder the assignments so that fewer intermediate values are alive at the same time
+        :type schedule: Bool
+        :param cse: Hoist common subexpressions into temporaries (cse_<n>), default True
+        :type cse: Bool
         '''
-        return trafo.genCode(self.world, "py", modelname, dirname)
+        return trafo.genCode(self.world, "py", modelname, dirname, **kwargs)
 
 
     def Matlab(self, modelname, dirname='.', symbolic_mode=False):
@@ -3201,6 +3211,24 @@ class GenCode(object):
         :type sfunction: Bool
         :param include_visual: Generate code for visualisation
         :type include_visual: Bool
+        :param sparse_solve: Factorise symmetric mass matrices symbolically, exploiting their zero pattern
+        :type sparse_solve: Bool
+        :param batch: Also write <modelname>_der_state_batch, evaluating many instances (structure of arrays) in one call
+        :type batch: Bool
+        :param jacobian: Also write the analytic jacobian d(yd)/d(y): 'dense' (<modelname>_jac, column major) or 'sparse' (<modelname>_jac_sparsity and <modelname>_jac_csc)
+        :type jacobian: String
+        :param cost_report: Write the number of operations per equation to <modelname>_cost.json
+        :type cost_report: Bool
+        :param cache: Skip writing if the graph, the options and the files of a previous call are unchanged
+        :type cache: Bool
+        :param threads: Number of threads writing the output files in parallel
+        :type threads: Int
+        :param chunk_size: Split <modelname>_der_state into functions of at most chunk_size equations, each in a file <modelname>_der_state_<k>
+        :type chunk_size: Int
+        :param schedule: Reorder the assignments so that fewer intermediate values are alive at the same time
+        :type schedule: Bool
+        :param cse: Hoist common subexpressions into temporaries (cse_<n>), default True
+        :type cse: Bool
         '''
         return trafo.genCode(self.world, "c", modelname, dirname, **kwargs)
 
@@ -3252,5 +3280,17 @@ class GenCode(object):
         :type dirname: String.
         :param pymbs_wrapper: Export python wrapper as well
         :type pymbs_wrapper: Bool
+        :param cost_report: Write the number of operations per equation to <modelname>_cost.json
+        :type cost_report: Bool
+        :param cache: Skip writing if the graph, the options and the files of a previous call are unchanged
+        :type cache: Bool
+        :param threads: Number of threads writing the output files in parallel
+        :type threads: Int
+        :param chunk_size: Split <modelname>_der_state into functions of at most chunk_size equations, each in a file <modelname>_der_state_<k>
+        :type chunk_size: Int
+        :param schedule: Reorder the assignments so that fewer intermediate values are alive at the same time
+        :type schedule: Bool
+        :param cse: Hoist common subexpressions into temporaries (cse_<n>), default True
+        :type cse: Bool
         '''
         return trafo.genCode(self.world, "f90", modelname, dirname, **kwargs)
@@ -837,7 +837,7 @@ class PublicMethods(object):
         # Write Python Code
         print("Writing model code for GUI to temporary directory: '%s'"%tempfile.gettempdir())
 
-        _Graph.writeCode('py', modelname, tempfile.gettempdir())
+        _Graph.writeCode('py', modelname, tempfile.gettempdir(), cache=True)
 
         # this is the list of graphRep objects:
         grList = list(model.graphRepDict.values())
@@ -292,12 +292,51 @@ class Graph(object):
         #return self.cgraph.getShape(exp)
 
 
-    def buildGraph(self, optimize=True):
+    def buildGraph(self, optimize=True, threads=1):
         """
-        Build graph with optional optimization
+        Build graph with optional optimization, threads > 1 simplifies
+        independent equations in parallel
         """
         assert isinstance(optimize, bool), "optimize must be a bool"
-        return self.cgraph.buildGraph(optimize)
+        assert isinstance(threads, int), "threads must be an int"
+        return self.cgraph.buildGraph(optimize, threads)
+
+
+    def changeEquation(self, lhs, rhs, implicit=False):
+        """
+        Replace the equation of lhs, updateGraph relinks the graph afterwards
+        """
+
+        # cast
+        if (isinstance(rhs, (int,float))):
+            rhs = symbolics.CNumber(rhs)
+
+        self.cgraph.changeEquation(lhs, rhs, implicit)
+
+
+    def updateGraph(self):
+        """
+        Relink only the changed equations and their dependents, the graph
+        must have been built without optimization
+        """
+        return self.cgraph.updateGraph()
+
+
+    def saveSnapshot(self, filename):
+        """
+        Write the built graph to a binary snapshot file
+        """
+        assert isinstance(filename, str), "filename must be a string"
+        self.cgraph.saveSnapshot(filename)
+
+
+    def loadSnapshot(self, filename):
+        """
+        Load a snapshot file into this (empty) graph instead of building it,
+        writeCode can be called afterwards
+        """
+        assert isinstance(filename, str), "filename must be a string"
+        return self.cgraph.loadSnapshot(filename)
 
 
     def writeCode(self, typeStr, name, path, **kwargs):
@@ -95,6 +95,14 @@ class TestSymbolics(unittest.TestCase):
                                                       [  0, 2*b,   0],
                                                       [  0,   0, 2*c]]))
 
+    def test_gradient(self):
+        a = symbolics.Symbol('a')
+        b = symbolics.Symbol('b')
+        c = symbolics.Symbol('c')
+
+        grad = symbolics.gradient(a*a*b + c, symbolics.Matrix([a,b,c]))
+        self.assertEqual(grad, symbolics.Matrix([2*a*b, a**2, 1]))
+
     def test_get_set(self):
         A = symbolics.Matrix( (3,3) )
         self.assertIsInstance(A, symbolics.Matrix)
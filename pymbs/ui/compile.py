@@ -1,11 +1,64 @@
 import os
+import re
 import sys
+import glob
+import hashlib
 import platform
-from subprocess import Popen, PIPE, STDOUT
+from concurrent.futures import ThreadPoolExecutor
+from subprocess import Popen, PIPE, STDOUT, run
 
 
 # f2py can be found in PYTHON_INSTALL_DIR/Scripts - must be in your path!
 
+def _sourceHash(path, sources, command):
+    '''
+    Hash over the contents of the source files and the compiler call. The
+    code writers leave unchanged sources untouched when called with
+    cache=True, so an unchanged model gives the same hash.
+    '''
+    h = hashlib.sha1(command.encode('UTF-8'))
+    for source in sources:
+        try:
+            with open(os.path.join(path, source), 'rb') as f:
+                h.update(f.read())
+        except OSError:
+            return None
+    return h.hexdigest()
+
+
+def _isUpToDate(module_file, digest):
+    '''
+    True if module_file exists and was compiled from sources with this hash
+    '''
+    if (digest is None) or not os.path.isfile(module_file):
+        return False
+    try:
+        with open(module_file + '.sha1') as f:
+            return f.read().strip() == digest
+    except OSError:
+        return False
+
+
+def _storeHash(module_file, digest):
+    if (digest is not None) and os.path.isfile(module_file):
+        with open(module_file + '.sha1', 'w') as f:
+            f.write(digest)
+
+
+def _chunkSources(path, modulename, ext):
+    '''
+    Files <modulename>_<k>.<ext>, the parts of a der_state written with
+    chunk_size, ordered by k
+    '''
+    pattern = re.compile(re.escape(modulename) + r'_(\d+)\.' + ext + '$')
+    chunks = []
+    for f in os.listdir(path):
+        m = pattern.match(f)
+        if m:
+            chunks.append((int(m.group(1)), f))
+    return [f for _, f in sorted(chunks)]
+
+
 def compileF90(modulename, path, compiler=None):
     '''
     Compile fortran code generated by PyMbs to a python module. We experienced
@@ -15,10 +68,6 @@ def compileF90(modulename, path, compiler=None):
     '''
     modulename_py=modulename + "_compiledF90"
     try:
-        #first delete
-        if os.path.isfile(path + '/%s.pyd'%modulename_py):
-            os.remove(path + '/%s.pyd'%modulename_py)
-
         # generate platform specific path to f2py and compiler defaults
         opsys = platform.system()
 
@@ -45,9 +94,26 @@ def compileF90(modulename, path, compiler=None):
         # source: https://stackoverflow.com/questions/44633519/fortran-strange-segmentation-fault
         compiler += " --f90flags=\"-ffree-line-length-none -fno-stack-arrays -fno-realloc-lhs\""
 
-        # compile
-        f2py_call = str.format('{0} -c functionmodule.f90 {1}.f90 -m {2} {3}',
-                                f2py, modulename, modulename_py, compiler)
+        # compile, only the main subroutine is wrapped if there are chunks
+        chunks = _chunkSources(path, modulename, 'f90')
+        f2py_call = str.format('{0} -c functionmodule.f90 {1} -m {2} {3}',
+                                f2py, ' '.join(chunks + [modulename + '.f90']),
+                                modulename_py, compiler)
+        if chunks:
+            f2py_call += ' only: %s :' % modulename
+
+        # f2py appends the python version to the module name
+        modules = [m for m in glob.glob(os.path.join(path, modulename_py + '.*'))
+                   if m.endswith(('.pyd', '.so'))]
+        digest = _sourceHash(path, ['functionmodule.f90', modulename + '.f90'] + chunks, f2py_call)
+        if (len(modules) == 1) and _isUpToDate(modules[0], digest):
+            print('"%s.f90" is up to date' % modulename)
+            return
+
+        #first delete
+        for m in modules:
+            os.remove(m)
+
         print(path)
         print(f2py_call)
 
@@ -63,6 +129,11 @@ def compileF90(modulename, path, compiler=None):
                 print(output.decode('UTF-8'))
             if compileProcess.poll() is not None:
                 break
+
+        modules = [m for m in glob.glob(os.path.join(path, modulename_py + '.*'))
+                   if m.endswith(('.pyd', '.so'))]
+        if (compileProcess.returncode == 0) and (len(modules) == 1):
+            _storeHash(modules[0], digest)
         """
         output = compileProcess.communicate()
 
@@ -93,6 +164,18 @@ def compileC(modulename, path):
 
     module_file = os.path.join(path, f'{modulename}.{ext}')
 
+    # functionmodule.c is included by the module, the compiler calls set the flags
+    chunks = _chunkSources(path, modulename, 'c')
+    chunk_calls, link_call = _gccCommands(modulename, chunks)
+    commands = chunk_calls + [link_call]
+    if opsys == 'Windows':
+        commands.append(_vsCommand(modulename, chunks))
+    digest = _sourceHash(path, ['functionmodule.c', modulename + '.c'] + chunks,
+                         '\n'.join(commands))
+    if _isUpToDate(module_file, digest):
+        print(f'"{modulename}.c" is up to date')
+        return module_file
+
     try:
         #first delete existing module
         if os.path.isfile(module_file):
@@ -101,17 +184,17 @@ def compileC(modulename, path):
         if opsys == 'Windows':
 
             # Try gcc first on Windows, just less hassle
-            compileProcess = compile_gcc(path, modulename)
+            compileProcess = compile_gcc(path, modulename, chunks)
             compileProcess.wait()
 
             # Fall back to Visual Studio if gcc was not found
             if compileProcess.returncode != 0:
                 print("Trying Visual Studio...")
-                compileProcess = compile_vs(path, modulename)
+                compileProcess = compile_vs(path, modulename, chunks)
 
         else:
             # Use gcc on all other platforms
-            compileProcess = compile_gcc(path, modulename)
+            compileProcess = compile_gcc(path, modulename, chunks)
 
         output = compileProcess.communicate()
 
@@ -119,6 +202,7 @@ def compileC(modulename, path):
             print(output[0])
         else:
             print(f'Compilation of "{modulename}.c" successful')
+            _storeHash(module_file, digest)
 
     except OSError as e:
         print("Execution failed:", e, file=sys.stderr)
@@ -126,20 +210,47 @@ def compileC(modulename, path):
     return module_file
 
 
-def compile_gcc(path, modulename):
-    """
-    Use gcc to compile c-module to shared lib
-    """
+def _gccCommands(modulename, chunks=()):
+    '''
+    gcc calls of compile_gcc: one object per chunk and the shared lib
+    '''
     ext = 'dll' if platform.system() == 'Windows' else 'so'
     declspec = '-fdeclspec' if platform.system() == 'Darwin' else ''
+    objects = ' '.join(chunk[:-2] + '.o' for chunk in chunks)
+    chunk_calls = [f'gcc -Ofast -c {chunk} -fPIC -o {chunk[:-2]}.o' for chunk in chunks]
+    return chunk_calls, f'gcc -Ofast -shared {modulename}.c {objects} -fPIC {declspec} -o {modulename}.{ext}'
 
-    return Popen(f'gcc -Ofast -shared {modulename}.c -fPIC {declspec} -o {modulename}.{ext}',
-                    stdout=PIPE, stderr=STDOUT, shell=True, cwd=path)
+
+def _vsCommand(modulename, chunks=()):
+    '''
+    Visual Studio call of compile_vs
+    '''
+    sources = ' '.join([modulename + '.c'] + list(chunks))
+    return f'vcvars64.bat && cl /MP /LD {sources}'
+
+
+def compile_gcc(path, modulename, chunks=()):
+    """
+    Use gcc to compile c-module to shared lib. The chunks of a der_state
+    are separate translation units and are compiled in parallel first.
+    """
+    chunk_calls, link_call = _gccCommands(modulename, chunks)
+
+    def compileChunk(call):
+        result = run(call, stdout=PIPE, stderr=STDOUT, shell=True, cwd=path)
+        if result.returncode != 0:
+            print(result.stdout.decode('UTF-8'))
+
+    if chunks:
+        with ThreadPoolExecutor(os.cpu_count()) as pool:
+            list(pool.map(compileChunk, chunk_calls))
+
+    return Popen(link_call, stdout=PIPE, stderr=STDOUT, shell=True, cwd=path)
 
 
-def compile_vs(path, modulename):
+def compile_vs(path, modulename, chunks=()):
     """
     Use Visual Studio to compile c-module to shared lib
     """
-    return Popen(f'vcvars64.bat && cl /LD {modulename}.c',
+    return Popen(_vsCommand(modulename, chunks),
                     stdout=PIPE, stderr=STDOUT, shell=True, cwd=path)
@@ -1003,7 +1003,7 @@ class Gui(QMainWindow, pymbsMainWindow):
         print('Creating and compiling Fortran90 sources...')
         print("Writing sources to '%s'"%tempfile.gettempdir())
 
-        self.graph.writeCode('f90', self.modelName, tempfile.gettempdir(), pymbs_wrapper=True)
+        self.graph.writeCode('f90', self.modelName, tempfile.gettempdir(), pymbs_wrapper=True, cache=True)
 
         print("Compiling Fortran Code ...")
         compileF90('%s_der_state' % self.modelName, tempfile.gettempdir())
@@ -1048,7 +1048,7 @@ class Gui(QMainWindow, pymbsMainWindow):
         print("Writing sources to '%s'"%tempfile.gettempdir())
 
         self.dynamicLibraries = []
-        self.graph.writeCode('c', self.modelName, tempfile.gettempdir(), pymbs_wrapper=True)
+        self.graph.writeCode('c', self.modelName, tempfile.gettempdir(), pymbs_wrapper=True, cache=True)
         print("Compiling C Code ...")
         self.dynamicLibraries.append(
             compileC('%s_der_state' % self.modelName, tempfile.gettempdir()))
@@ -0,0 +1,169 @@
+#include "Adjoint.h"
+#include "Symbolics.h"
+#include "str.h"
+#include <unordered_map>
+
+using namespace Symbolics;
+
+/*****************************************************************************/
+Adjoint::Adjoint()
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+Adjoint::~Adjoint()
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr Adjoint::gradient( BasicPtr const& exp, BasicPtr const& symbols )
+/*****************************************************************************/
+{
+    if (!exp->is_Scalar())
+        throw InternalError("gradient could only be used with a Scalar as first argument!");
+    if (!symbols->is_Vector() || (symbols->getType() != Type_Matrix))
+        throw InternalError("gradient could only be used with a Vector as second argument!");
+
+    // Symbol -> Zeilen des Gradienten
+    typedef std::unordered_map<BasicPtr,std::vector<size_t>,BasicPtrHash,BasicPtrEqual> ColumnMap;
+    ColumnMap columns;
+    const size_t n = symbols->getArgsSize();
+    for (size_t i=0;i<n;++i)
+    {
+        if (symbols->getArg(i)->getType() != Type_Symbol)
+            throw InternalError("gradient: all elements of the second argument must be Symbols!");
+        columns[symbols->getArg(i)].push_back(i);
+    }
+
+    BasicPtr e = Util::simplify(exp);
+    BasicPtrVec order;
+    e->getPostOrder(order);
+
+    // haengt der Knoten von einem der Symbole ab?
+    std::unordered_map<Basic const*,bool> active;
+    for (size_t i=0;i<order.size();++i)
+    {
+        Basic *b = order[i].get();
+        bool a = false;
+        if (b->getType() == Type_Symbol)
+            a = (columns.find(order[i]) != columns.end());
+        else
+        {
+            Basic::FreeSymbols const& free = b->getFreeSymbols();
+            for (size_t k=0;(k<free.size()) && !a;++k)
+                a = (columns.find(BasicPtr(free[k])) != columns.end());
+        }
+        active[b] = a;
+    }
+
+    // Beitraege zur Adjungierten, von der Wurzel zu den Blaettern: in umgekehrter
+    // post-order sind alle Eltern eines Knotens vor ihm fertig
+    std::unordered_map<Basic const*,BasicPtrVec> contributions;
+    std::vector<BasicPtrVec> grad(n);
+    contributions[e.get()].push_back(Int::getOne());
+    for (size_t i=order.size();i>0;--i)
+    {
+        BasicPtr const& node = order[i-1];
+        std::unordered_map<Basic const*,BasicPtrVec>::iterator ii = contributions.find(node.get());
+        if (ii == contributions.end())
+            continue;
+        if (!active[node.get()])
+        {
+            contributions.erase(ii);
+            continue;
+        }
+        BasicPtr adj = Util::simplify((ii->second.size() == 1) ? ii->second[0] : BasicPtr(new Add(ii->second)));
+        contributions.erase(ii);
+        if (Util::is_Zero(adj))
+            continue;
+
+        if (node->getType() == Type_Symbol)
+        {
+            std::vector<size_t> const& rows = columns[node];
+            for (size_t k=0;k<rows.size();++k)
+                grad[rows[k]].push_back(adj);
+            continue;
+        }
+
+        bool scalarArgs = true;
+        for (size_t k=0;k<node->getArgsSize();++k)
+            scalarArgs &= node->getArg(k)->is_Scalar();
+        if (!scalarArgs)
+        {
+            // Matrixargumente (Element, Skalarprodukt, ...): vorwaerts ab diesem Knoten
+            Basic::FreeSymbols const& free = node->getFreeSymbols();
+            for (size_t k=0;k<free.size();++k)
+            {
+                BasicPtr s(free[k]);
+                ColumnMap::const_iterator jj = columns.find(s);
+                if (jj == columns.end())
+                    continue;
+                BasicPtr d = Util::simplify(node->der(s));
+                if (Util::is_Zero(d))
+                    continue;
+                for (size_t l=0;l<jj->second.size();++l)
+                    grad[jj->second[l]].push_back(Mul::New(adj,d));
+            }
+            continue;
+        }
+
+        std::vector<bool> act(node->getArgsSize());
+        for (size_t k=0;k<node->getArgsSize();++k)
+            act[k] = active[node->getArg(k).get()];
+        BasicPtrVec partials = getPartials(node,act);
+        for (size_t k=0;k<node->getArgsSize();++k)
+        {
+            if (!act[k] || Util::is_Zero(partials[k]))
+                continue;
+            contributions[node->getArg(k).get()].push_back(Util::is_One(partials[k]) ? adj : Mul::New(adj,partials[k]));
+        }
+    }
+
+    BasicPtrVec vec;
+    vec.reserve(n);
+    for (size_t i=0;i<n;++i)
+    {
+        if (grad[i].empty())
+            vec.push_back(Zero::getZero());
+        else
+            vec.push_back(Util::simplify((grad[i].size() == 1) ? grad[i][0] : BasicPtr(new Add(grad[i]))));
+    }
+    return BasicPtr(new Matrix(vec,Shape(n)));
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtrVec Adjoint::getPartials( BasicPtr const& node, std::vector<bool> const& active )
+/*****************************************************************************/
+{
+    // Argumente durch Platzhalter ersetzen, damit der() nur den Knoten selbst ableitet
+    const size_t nargs = node->getArgsSize();
+    BasicPtrVec args;
+    BasicPtrVec placeholders;
+    for (size_t k=0;k<nargs;++k)
+    {
+        BasicPtr p = active[k] ? BasicPtr(new Symbol("$adj" + str(k))) : node->getArg(k);
+        placeholders.push_back(p);
+        args.push_back(p);
+    }
+    BasicPtr local = node->newBasic(args);
+
+    BasicPtrVec partials(nargs);
+    for (size_t k=0;k<nargs;++k)
+    {
+        if (!active[k])
+            continue;
+        BasicPtr d = Util::simplify(local->der(placeholders[k]));
+        for (size_t l=0;l<nargs;++l)
+            if (active[l])
+                d = d->subs(placeholders[l],node->getArg(l));
+        partials[k] = Util::simplify(d);
+    }
+    return partials;
+}
+/*****************************************************************************/
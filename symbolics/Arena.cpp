@@ -0,0 +1,228 @@
+#include "Arena.h"
+#include "Int.h"
+#include "Real.h"
+#include "Bool.h"
+#include <cmath>
+#include <mutex>
+
+using namespace Symbolics;
+
+/*****************************************************************************/
+bool Arena::s_enabled = true;
+/*****************************************************************************/
+
+/*****************************************************************************/
+// eingetragene Knoten koennen auch in parallelen Abschnitten frei werden
+static std::mutex& getMutex()
+/*****************************************************************************/
+{
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Arena::Arena()
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+Arena::~Arena()
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+Arena::NodeMap& Arena::getNodes()
+/*****************************************************************************/
+{
+    // wird nie freigegeben, da statische BasicPtr (Int::one, ...) erst nach
+    // der Tabelle zerstoert werden koennten
+    static NodeMap *nodes = new NodeMap();
+    return *nodes;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+size_t Arena::size()
+/*****************************************************************************/
+{
+    return getNodes().size();
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+static inline void hashCombine( size_t &seed, size_t value )
+/*****************************************************************************/
+{
+    seed ^= value + 0x9e3779b9 + (seed<<6) + (seed>>2);
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+size_t Arena::calcKey( Basic const* node )
+/*****************************************************************************/
+{
+    size_t key = static_cast<size_t>(node->getType());
+    Shape const& shape = node->getShape();
+    hashCombine(key, shape.getNrDimensions());
+    hashCombine(key, shape.getDimension(1));
+    hashCombine(key, shape.getDimension(2));
+
+    // Werte der Konstanten
+    switch (node->getType())
+    {
+    case Type_Int:
+        hashCombine(key, std::hash<int>()(static_cast<Int const*>(node)->getValue()));
+        break;
+    case Type_Real:
+        hashCombine(key, std::hash<double>()(static_cast<Real const*>(node)->getValue()));
+        break;
+    case Type_Bool:
+        hashCombine(key, static_cast<Bool const*>(node)->getValue() ? 1 : 0);
+        break;
+    default:
+        break;
+    }
+
+    // Argumente ueber ihre Adresse, diese sind bereits eindeutig
+    size_t num = node->getArgsSize();
+    for (size_t i=0; i<num; ++i)
+        hashCombine(key, reinterpret_cast<size_t>(node->getArg(i).get()));
+    return key;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+bool Arena::isSame( Basic const* lhs, Basic const* rhs )
+/*****************************************************************************/
+{
+    if (lhs->getType() != rhs->getType())
+        return false;
+    if (lhs->getShape() != rhs->getShape())
+        return false;
+    size_t num = lhs->getArgsSize();
+    if (num != rhs->getArgsSize())
+        return false;
+    for (size_t i=0; i<num; ++i)
+        if (lhs->getArg(i).get() != rhs->getArg(i).get())
+            return false;
+    // -0.0 und 0.0 nicht zusammenlegen
+    if ((lhs->getType() == Type_Real) &&
+        (std::signbit(static_cast<Real const*>(lhs)->getValue()) != std::signbit(static_cast<Real const*>(rhs)->getValue())))
+        return false;
+    // Werte, Indizes, ...
+    return (*lhs == *rhs);
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+BasicPtr Arena::intern( Basic *node )
+/*****************************************************************************/
+{
+    // uebernimmt den Knoten, wird freigegeben falls es ihn schon gibt
+    BasicPtr res(node);
+    if (!s_enabled)
+        return res;
+
+    switch (node->getType())
+    {
+    case Type_Symbol:
+    case Type_Unknown:
+    case Type_Matrix:
+    case Type_Zero:
+    case Type_Eye:
+        return res;
+    default:
+        break;
+    }
+
+    std::lock_guard<std::mutex> lock(getMutex());
+    NodeMap &nodes = getNodes();
+    size_t key = calcKey(node);
+    std::pair<NodeMap::iterator,NodeMap::iterator> range = nodes.equal_range(key);
+    for (NodeMap::iterator it=range.first; it!=range.second; ++it)
+    {
+        // Knoten koennen sich seit dem Eintragen veraendert haben (simplify),
+        // daher immer den aktuellen Zustand vergleichen
+        if (isSame(it->second, node))
+            return BasicPtr(it->second);
+    }
+
+    node->m_arenaKey = key;
+    node->m_interned = true;
+    nodes.insert(NodeMap::value_type(key, node));
+    return res;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+BasicPtr Arena::internTree( BasicPtr const& exp )
+/*****************************************************************************/
+{
+    if (!s_enabled)
+        return exp;
+    BasicPtrVec order;
+    exp->getPostOrder(order);
+    std::unordered_map<Basic const*,BasicPtr> done;
+    done.reserve(order.size());
+    BasicPtrVec args;
+    for (size_t i=0; i<order.size(); ++i)
+    {
+        Basic *b = order[i].get();
+        bool same = true;
+        args.clear();
+        for (size_t j=0; j<b->getArgsSize(); ++j)
+        {
+            args.push_back(done[b->getArg(j).get()]);
+            same = same && (args.back().get() == b->getArg(j).get());
+        }
+        if (!same)
+            done[b] = b->newBasic(args);
+        else if (b->m_interned && (calcKey(b) == b->m_arenaKey))
+            done[b] = order[i];
+        else
+        {
+            // nach dem Eintragen veraendert (simplify): unter dem alten Schluessel
+            // nicht mehr auffindbar
+            if (b->m_interned)
+            {
+                remove(b);
+                b->m_interned = false;
+            }
+            done[b] = intern(b);
+        }
+    }
+    return done[exp.get()];
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+void Arena::remove( Basic const* node )
+/*****************************************************************************/
+{
+    std::lock_guard<std::mutex> lock(getMutex());
+    NodeMap &nodes = getNodes();
+    std::pair<NodeMap::iterator,NodeMap::iterator> range = nodes.equal_range(node->m_arenaKey);
+    for (NodeMap::iterator it=range.first; it!=range.second; ++it)
+    {
+        if (it->second == node)
+        {
+            nodes.erase(it);
+            return;
+        }
+    }
+}
+/*****************************************************************************/
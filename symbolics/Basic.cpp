@@ -1,24 +1,76 @@
 #include "Basic.h"
 #include "Factory.h"
+#include "Arena.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <iterator>
 
 using namespace Symbolics;
 
+/*****************************************************************************/
+bool Basic::s_lockParents = false;
+/*****************************************************************************/
+
 /*****************************************************************************/
 Basic::Basic( Basic_Type const& type):
-m_type(type), m_refCount(0),m_simplified(false)
+m_type(type), m_refCount(0),m_simplified(false),m_hashValid(false),m_freeSymbolsValid(false),m_firstParent(NULL),m_parentsSize(0),m_interned(false),m_arenaKey(0)
 /*****************************************************************************/
 {
-    calcHash();
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
 Basic::Basic( Basic_Type const& type,  Shape const& shape):
-m_type(type), m_shape(shape), m_refCount(0),m_simplified(false)
+m_type(type), m_shape(shape), m_refCount(0),m_simplified(false),m_hashValid(false),m_freeSymbolsValid(false),m_firstParent(NULL),m_parentsSize(0),m_interned(false),m_arenaKey(0)
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+Basic::Basic( Basic const& src ):
+m_type(src.m_type), m_shape(src.m_shape), m_refCount(0),m_simplified(src.m_simplified),m_hash(src.m_hash),m_hashValid(src.m_hashValid),m_freeSymbolsValid(false),
+m_firstParent(NULL),m_parentsSize(0),m_interned(false),m_arenaKey(0)
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+std::mutex& Basic::getParentsMutex() const
 /*****************************************************************************/
 {
-    calcHash();
+    // ein Mutex pro Knoten waere zu gross, daher ueber die Adresse verteilt
+    static std::mutex mutexes[64];
+    return mutexes[(reinterpret_cast<size_t>(this) >> 4) % 64];
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+void Basic::destroy( Basic* b )
+/*****************************************************************************/
+{
+    // pro Thread: laeuft schon ein destroy, nur vormerken
+    static thread_local std::vector<Basic*> *pending = NULL;
+    if (pending != NULL)
+    {
+        pending->push_back(b);
+        return;
+    }
+    std::vector<Basic*> nodes(1, b);
+    pending = &nodes;
+    while (!nodes.empty())
+    {
+        Basic *n = nodes.back();
+        nodes.pop_back();
+        delete n;
+    }
+    pending = NULL;
 }
 /*****************************************************************************/
 
@@ -27,6 +79,8 @@ m_type(type), m_shape(shape), m_refCount(0),m_simplified(false)
 Basic::~Basic()
 /*****************************************************************************/
 {
+    if (m_interned)
+        Arena::remove(this);
 }
 /*****************************************************************************/
 
@@ -84,17 +138,16 @@ Basic::BasicSizeTMap Basic::getAtomsAmound()
  void Basic::subs( BasicPtr const& new_exp)
 /*****************************************************************************/
 {
-    // brauchen eine Kopie da setArg m_parents veraendert
-    ArgumentPtrSet parents = m_parents;
-    // subs me
-    for (ArgumentPtrSet::iterator ii = parents.begin();ii!=parents.end();++ii)
+    if (new_exp.get() == this)
+      return;
+    // setArg haengt das Argument bei uns aus, daher immer das erste nehmen
+    while (m_firstParent != NULL)
     {
-      (*ii)->setArg(new_exp);
-      if ((*ii)->getParent().get() != NULL)
-        (*ii)->getParent()->changed();
+      ArgumentPtr arg = m_firstParent;
+      arg->setArg(new_exp);
+      if (arg->getParent().get() != NULL)
+        arg->getParent()->changed();
     }
-    // no parents left
-    clearParents();
 }
 /*****************************************************************************/
 
@@ -105,27 +158,73 @@ Basic::BasicSizeTMap Basic::getAtomsAmound()
   //if (m_simplified)
   {
     m_simplified = false;
-    for (ArgumentPtrSet::iterator ii = m_parents.begin();ii!=m_parents.end();++ii)
+    m_hashValid = false;
+    m_freeSymbolsValid = false;
+    clearSimplifyCache();
+    for (ArgumentPtr ii = m_firstParent;ii!=NULL;ii=ii->getNextParent())
     {
-      if ((*ii)->getParent().get() != NULL)
-        (*ii)->getParent()->changed();
+      if (ii->getParent().get() != NULL)
+        ii->getParent()->changed();
     }
   }
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Basic::getPostOrder(BasicPtrVec &order)
+/*****************************************************************************/
+{
+    // Knoten bleibt auf dem Stack, bis alle Argumente fertig sind
+    std::unordered_set<Basic const*> visited;
+    std::vector<std::pair<Basic*,size_t> > stack;
+    visited.insert(this);
+    stack.push_back(std::make_pair(this,0));
+    while (!stack.empty())
+    {
+        Basic *b = stack.back().first;
+        size_t &next = stack.back().second;
+        if (next < b->getArgsSize())
+        {
+            Basic *arg = b->getArg(next++).get();
+            if (visited.insert(arg).second)
+                stack.push_back(std::make_pair(arg,0));
+            continue;
+        }
+        order.push_back(BasicPtr(b));
+        stack.pop_back();
+    }
+}
+/*****************************************************************************/
+
+
 /*****************************************************************************/
  BasicPtr Basic::iterateExp(Symbolics::Basic::Iterator &v)
 /*****************************************************************************/
 {
-    // iterate args
+    BasicPtrVec order;
+    getPostOrder(order);
+    // Argumente sind immer vor ihren Eltern fertig
+    std::unordered_map<Basic const*,BasicPtr> done;
+    done.reserve(order.size());
     BasicPtrVec new_args;
-    new_args.reserve( getArgsSize() );
-    for (size_t i=0; i<getArgsSize(); ++i)
-        new_args.push_back(getArg(i)->iterateExp(v));
+    for (size_t i=0; i<order.size(); ++i)
+    {
+        Basic *b = order[i].get();
+        new_args.clear();
+        for (size_t j=0; j<b->getArgsSize(); ++j)
+            new_args.push_back(done[b->getArg(j).get()]);
+        done[b] = v.process_Arg(b->newBasic(new_args));
+    }
+    return done[this];
+}
+/*****************************************************************************/
+
 
-    BasicPtr newI = Factory::newBasic( getType(), new_args, getShape() );
-    return v.process_Arg(newI);
+/*****************************************************************************/
+ BasicPtr Basic::newBasic( BasicPtrVec &args )
+/*****************************************************************************/
+{
+    return Factory::newBasic( getType(), args, getShape() );
 }
 /*****************************************************************************/
 
@@ -134,14 +233,130 @@ Basic::BasicSizeTMap Basic::getAtomsAmound()
 void Basic::scanExp(Symbolics::Basic::Scanner &s)
 /*****************************************************************************/
 {
-    bool stop = false;
-    if (!s.process_Arg(BasicPtr(this),stop))
-      return;
-    if (stop)
-      return;
-    // iterate args
-    for (size_t i=0; i<getArgsSize(); ++i)
-      getArg(i)->scanExp(s);
+    std::unordered_set<Basic const*> visited;
+    std::vector<Basic*> stack(1,this);
+    while (!stack.empty())
+    {
+        Basic *b = stack.back();
+        stack.pop_back();
+        if (s.is_Unique() && !visited.insert(b).second)
+            continue;
+        bool stop = false;
+        if (!s.process_Arg(BasicPtr(b),stop))
+            continue;
+        if (stop)
+            continue;
+        // iterate args, erstes Argument zuerst
+        for (size_t i=b->getArgsSize(); i>0; --i)
+            stack.push_back(b->getArg(i-1).get());
+    }
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+void Basic::collectAtoms(BasicSet &atoms)
+/*****************************************************************************/
+{
+    FreeSymbols const& symbols = getFreeSymbols();
+    for (size_t i=0; i<symbols.size(); ++i)
+        atoms.insert(BasicPtr(symbols[i]));
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+Basic::FreeSymbols const& Basic::getFreeSymbols()
+/*****************************************************************************/
+{
+    if ((getArgsSize() == 0) || m_freeSymbolsValid)
+        return m_freeSymbols;
+    // post-order, Teilausdruecke mit gueltigen Symbolen werden nicht betreten
+    std::vector<std::pair<Basic*,size_t> > stack;
+    stack.push_back(std::make_pair(this,0));
+    FreeSymbols merged;
+    while (!stack.empty())
+    {
+        Basic *b = stack.back().first;
+        size_t &next = stack.back().second;
+        size_t argssize = b->getArgsSize();
+        if (next < argssize)
+        {
+            Basic *arg = b->getArg(next++).get();
+            if ((arg->getArgsSize() > 0) && !arg->m_freeSymbolsValid)
+                stack.push_back(std::make_pair(arg,0));
+            continue;
+        }
+        b->m_freeSymbols.clear();
+        for (size_t i=0; i<argssize; ++i)
+        {
+            Basic *arg = b->getArg(i).get();
+            if (arg->getArgsSize() == 0)
+            {
+                if (arg->getType() != Type_Symbol)
+                    continue;
+                FreeSymbols::iterator pos = std::lower_bound(b->m_freeSymbols.begin(),b->m_freeSymbols.end(),arg);
+                if ((pos == b->m_freeSymbols.end()) || (*pos != arg))
+                    b->m_freeSymbols.insert(pos,arg);
+                continue;
+            }
+            merged.clear();
+            std::set_union(b->m_freeSymbols.begin(),b->m_freeSymbols.end(),
+                           arg->m_freeSymbols.begin(),arg->m_freeSymbols.end(),
+                           std::back_inserter(merged));
+            b->m_freeSymbols.swap(merged);
+        }
+        b->m_freeSymbolsValid = true;
+        stack.pop_back();
+    }
+    return m_freeSymbols;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+bool Basic::has_FreeSymbol( Basic const* symbol )
+/*****************************************************************************/
+{
+    FreeSymbols const& symbols = getFreeSymbols();
+    if (std::binary_search(symbols.begin(),symbols.end(),const_cast<Basic*>(symbol)))
+        return true;
+    // Symbole sind ueber den Namen gleich, nicht ueber die Adresse
+    for (size_t i=0; i<symbols.size(); ++i)
+    {
+        if (*symbols[i] == *symbol)
+            return true;
+    }
+    return false;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+void Basic::collectAtoms(BasicSizeTMap &atoms)
+/*****************************************************************************/
+{
+    // Anzahl: Zahl der Pfade von der Wurzel zum Blatt, von oben nach unten aufsummiert
+    BasicPtrVec order;
+    getPostOrder(order);
+    std::unordered_map<Basic const*,size_t> paths;
+    paths[this] = 1;
+    for (size_t i=order.size(); i>0; --i)
+    {
+        Basic *b = order[i-1].get();
+        size_t num = paths[b];
+        size_t argssize = b->getArgsSize();
+        if (argssize == 0)
+        {
+            BasicSet leafatoms;
+            b->getAtoms(leafatoms);
+            for (BasicSet::iterator ii=leafatoms.begin(); ii!=leafatoms.end(); ++ii)
+                atoms[*ii] += num;
+            continue;
+        }
+        for (size_t j=0; j<argssize; ++j)
+            paths[b->getArg(j).get()] += num;
+    }
 }
 /*****************************************************************************/
 
@@ -149,7 +364,34 @@ void Basic::scanExp(Symbolics::Basic::Scanner &s)
 void Basic::calcHash()
 /*****************************************************************************/
 {
-    m_hash = 0;
+    size_t hash = static_cast<size_t>(m_type);
+    hashCombine(hash, m_shape.getNrDimensions());
+    hashCombine(hash, m_shape.getDimension(1));
+    hashCombine(hash, m_shape.getDimension(2));
+    size_t num = getArgsSize();
+    for (size_t i=0; i<num; ++i)
+        hashCombine(hash, getArg(i)->getHash());
+    m_hash = hash;
+    m_hashValid = true;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Basic::hashChanged()
+/*****************************************************************************/
+{
+    // ist beides schon ungueltig, dann auch bei allen Eltern; ein Knoten mit
+    // simplify-Ergebnis hat immer einen gueltigen Hash (setSimplifyCache)
+    if (!m_hashValid && !m_freeSymbolsValid)
+        return;
+    m_hashValid = false;
+    m_freeSymbolsValid = false;
+    clearSimplifyCache();
+    for (ArgumentPtr ii = m_firstParent;ii!=NULL;ii=ii->getNextParent())
+    {
+      if (ii->getParent().get() != NULL)
+        ii->getParent()->hashChanged();
+    }
 }
 /*****************************************************************************/
 
@@ -217,6 +459,18 @@ bool Basic::LookFor::process_Arg(BasicPtr const &p, bool &stop)
         stop = true;
         return false;
     }
+    // Symbol: die freien Symbole reichen, kein Abstieg noetig
+    if (m_lookfor->getType() == Type_Symbol)
+    {
+        found = p->has_FreeSymbol(m_lookfor.get());
+        stop = true;
+        return false;
+    }
+    for (size_t i=0; i<m_symbols.size(); ++i)
+    {
+        if (!p->has_FreeSymbol(m_symbols[i]))
+            return false;
+    }
     return true;
 }
 /*****************************************************************************/
@@ -230,15 +484,17 @@ bool Basic::LookForMultiple::process_Arg(BasicPtr const &p, bool &stop)
         stop = true;
         return false;
     }
-    if (p->getType() == Type_Symbol)
+    // m_lookfor enthaelt nur Symbole, die freien Symbole von p genuegen
+    FreeSymbols const& symbols = p->getFreeSymbols();
+    for (size_t i=0; i<symbols.size(); ++i)
     {
-      if (m_lookfor.find(p) != m_lookfor.end())
+      if (m_lookfor.find(BasicPtr(symbols[i])) != m_lookfor.end())
       {
           found = true;
-          stop = true;
-          return false;
+          break;
       }
     }
-    return true;
+    stop = true;
+    return false;
 }
 /*****************************************************************************/
\ No newline at end of file
@@ -51,6 +51,13 @@ BinaryOp::~BinaryOp()
 bool BinaryOp::operator ==( Basic const& rhs) const
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (this == &rhs)
+      return true;
+    // Arena: ohne die Argumente anzusehen
+    if (is_InternedDifferent(rhs))
+      return false;
+
     // Typen vergleichen
     if (getType() != rhs.getType()) 
       return false;
@@ -72,6 +79,10 @@ bool BinaryOp::operator ==( Basic const& rhs) const
 bool BinaryOp::operator<(Basic const& rhs) const
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (this == &rhs)
+        return false;
+
     // Typen vergleichen
     if (getType() != rhs.getType())
         return getType() < rhs.getType();
@@ -96,8 +107,7 @@ bool BinaryOp::operator<(Basic const& rhs) const
 void BinaryOp::getAtoms(Basic::BasicSet& atoms)
 /*****************************************************************************/
 {
-    getArg1()->getAtoms(atoms);
-    getArg2()->getAtoms(atoms);
+    collectAtoms(atoms);
 }
 /*****************************************************************************/
 
@@ -105,8 +115,7 @@ void BinaryOp::getAtoms(Basic::BasicSet& atoms)
 void BinaryOp::getAtoms(Basic::BasicSizeTMap& atoms)
 /*****************************************************************************/
 {
-    getArg1()->getAtoms(atoms);
-    getArg2()->getAtoms(atoms);
+    collectAtoms(atoms);
 }
 /*****************************************************************************/
 
@@ -3,6 +3,7 @@
 #include "Bool.h"
 #include "Util.h"
 #include "Operators.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -14,6 +15,7 @@ BasicPtr Bool::getArgres;
 Bool::Bool(  const bool value ): Basic(Type_Bool), m_value(value)
 /*****************************************************************************/
 {
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -25,10 +27,18 @@ Bool::~Bool()
 /*****************************************************************************/
 
 /*****************************************************************************/
- BasicPtr Bool::iterateExp(Symbolics::Basic::Iterator &v)
+BasicPtr Bool::New( const bool b)
 /*****************************************************************************/
 {
-    return v.process_Arg( BasicPtr(this) );
+    return Arena::intern(new Bool(b));
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+ BasicPtr Bool::newBasic( BasicPtrVec &args )
+/*****************************************************************************/
+{
+    return BasicPtr(this);
 }
 /*****************************************************************************/
 
@@ -156,6 +166,15 @@ bool Bool::operator<(  Basic const& rhs ) const
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Bool::calcHash()
+/*****************************************************************************/
+{
+    m_hash = hashValue(m_value ? 1.0 : 0.0);
+    m_hashValid = true;
+}
+/*****************************************************************************/
+
  
 /*****************************************************************************/
  BasicPtr Bool::subs( ConstBasicPtr const& old_exp, BasicPtr const& new_exp)
@@ -9,7 +9,7 @@
 using namespace Symbolics;
 
 /*****************************************************************************/
-BasicPtr Eye::eye = BasicPtr( new Eye() );
+BasicPtr Eye::eye = Basic::immortal( new Eye() );
 BasicPtr Eye::getArgres;
 /*****************************************************************************/
 
@@ -17,6 +17,7 @@ BasicPtr Eye::getArgres;
 Eye::Eye(): Basic(Type_Eye)
 /*****************************************************************************/
 {
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -24,6 +25,7 @@ Eye::Eye(): Basic(Type_Eye)
 Eye::Eye(Shape const& s): Basic(Type_Eye,s)
 /*****************************************************************************/
 {
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -35,10 +37,10 @@ Eye::~Eye()
 /*****************************************************************************/
 
 /*****************************************************************************/
- BasicPtr Eye::iterateExp(Symbolics::Basic::Iterator &v)
+ BasicPtr Eye::newBasic( BasicPtrVec &args )
 /*****************************************************************************/
 {
-    return v.process_Arg( BasicPtr(this) );
+    return BasicPtr(this);
 }
 /*****************************************************************************/
 
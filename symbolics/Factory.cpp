@@ -1,5 +1,6 @@
 #include "Factory.h"
 #include "str.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -43,23 +44,25 @@ BasicPtr Factory::newBasic( Basic_Type type,  BasicPtr &arg, Shape const& shape)
     case Type_Der:
         return Der::New(arg);
     case Type_Atan:
-        return BasicPtr( new Atan(arg) );
+        return Arena::intern( new Atan(arg) );
     case Type_Abs:
-        return BasicPtr( new Abs(arg) );
+        return Arena::intern( new Abs(arg) );
     case Type_Acos:
-        return BasicPtr( new Acos(arg) );
+        return Arena::intern( new Acos(arg) );
     case Type_Asin:
-        return BasicPtr( new Asin(arg) );
+        return Arena::intern( new Asin(arg) );
     case Type_Scalar:
-        return BasicPtr( new Scalar(arg) );
+        return Arena::intern( new Scalar(arg) );
     case Type_Skew:
         return Skew::New(arg);
     case Type_Transpose:
-        return BasicPtr( new Transpose(arg) );
+        return Arena::intern( new Transpose(arg) );
     case Type_Unknown:
         throw InternalError("Unknown is not supported by Factory!");
     case Type_Tan:
-        return BasicPtr( new Tan(arg) );
+        return Arena::intern( new Tan(arg) );
+    case Type_Sign:
+        return Sign::New(arg);
     default:
         throw InternalError("Unknown Type: " + str(type) + "!");
     };
@@ -83,17 +86,17 @@ BasicPtr Factory::newBasic( Basic_Type type,  BasicPtr &arg1, BasicPtr &arg2, Sh
     case Type_Mul:
         return Mul::New(arg1,arg2);
     case Type_Pow:
-        return BasicPtr( new Pow(arg1,arg2) );
+        return Arena::intern( new Pow(arg1,arg2) );
     case Type_Solve:
-        return BasicPtr( new Solve(arg1,arg2) );
+        return Arena::intern( new Solve(arg1,arg2) );
     case Type_Atan2:
-        return BasicPtr( new Atan2(arg1,arg2) );
+        return Arena::intern( new Atan2(arg1,arg2) );
     case Type_Less:
-        return BasicPtr( new Less(arg1,arg2) );
+        return Arena::intern( new Less(arg1,arg2) );
     case Type_Greater:
-        return BasicPtr( new Greater(arg1,arg2) );
+        return Arena::intern( new Greater(arg1,arg2) );
     case Type_Equal:
-        return BasicPtr( new Equal(arg1,arg2) );
+        return Arena::intern( new Equal(arg1,arg2) );
     case Type_Unknown:
         throw InternalError("Unknown is not supported by Factory!");
     default:
@@ -117,51 +120,59 @@ BasicPtr Factory::newBasic( Basic_Type type,  BasicPtrVec &args, Shape const& sh
     case Type_Matrix:
         return BasicPtr( new Matrix( args, shape ) );
     case Type_Neg:
-        return BasicPtr( new Neg(args) );
+        return Arena::intern( new Neg(args) );
     case Type_Add:
-        return BasicPtr( new Add(args) );//->simplify();
+        return Arena::intern( new Add(args) );//->simplify();
     case Type_Mul:
-        return BasicPtr( new Mul(args) );//->simplify();
+        return Arena::intern( new Mul(args) );//->simplify();
     case Type_Pow:
-        return BasicPtr( new Pow(args) );
+        return Arena::intern( new Pow(args) );
     case Type_Sin:
-        return BasicPtr( new Sin(args) );
+        return Arena::intern( new Sin(args) );
     case Type_Cos:
-        return BasicPtr( new Cos(args) );
+        return Arena::intern( new Cos(args) );
     case Type_Der:
-        return BasicPtr( new Der(args) );
+        return Arena::intern( new Der(args) );
     case Type_Element:
-        return BasicPtr( new Element(args) );
+        return Arena::intern( new Element(args) );
     case Type_Atan:
-        return BasicPtr( new Atan(args) );
+        return Arena::intern( new Atan(args) );
     case Type_Solve:
-        return BasicPtr( new Solve(args) );
+        return Arena::intern( new Solve(args) );
     case Type_Atan2:
-        return BasicPtr( new Atan2(args) );
+        return Arena::intern( new Atan2(args) );
     case Type_Abs:
-        return BasicPtr( new Abs(args) );
+        return Arena::intern( new Abs(args) );
     case Type_Acos:
-        return BasicPtr( new Acos(args) );
+        return Arena::intern( new Acos(args) );
     case Type_Asin:
-        return BasicPtr( new Asin(args) );
+        return Arena::intern( new Asin(args) );
     case Type_Scalar:
-        return BasicPtr( new Scalar(args) );
+        return Arena::intern( new Scalar(args) );
     case Type_Skew:
-        return BasicPtr( new Skew(args) );
+        return Arena::intern( new Skew(args) );
     case Type_Transpose:
-        return BasicPtr( new Transpose(args) );
+        return Arena::intern( new Transpose(args) );
     case Type_Less:
-        return BasicPtr( new Less(args) );
+        return Arena::intern( new Less(args) );
     case Type_Greater:
-        return BasicPtr( new Greater(args) );
+        return Arena::intern( new Greater(args) );
     case Type_Equal:
-        return BasicPtr( new Equal(args) );
+        return Arena::intern( new Equal(args) );
     case Type_If:
-        return BasicPtr( new If(args) );
+        return Arena::intern( new If(args) );
     case Type_Unknown:
         throw InternalError("Unknown is not supported by Factory!");
     case Type_Tan:
-        return BasicPtr( new Tan(args) );
+        return Arena::intern( new Tan(args) );
+    case Type_Sign:
+        return Arena::intern( new Sign(args) );
+    case Type_Jacobian:
+        return Arena::intern( new Jacobian(args) );
+    case Type_Outer:
+        return Arena::intern( new Outer(args) );
+    case Type_Inverse:
+        return Arena::intern( new Inverse(args) );
     default:
         throw InternalError("Unknown Type: " + str(type) + "!");
     };
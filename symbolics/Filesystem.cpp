@@ -55,3 +55,21 @@ bool filesystem::is_regular(std::string path)
     #endif
     }
 }
+
+bool filesystem::file_info(std::string path, long long &size, long long &mtime)
+{
+    #ifdef _WIN32
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if (!GetFileAttributesEx(path.c_str(), GetFileExInfoStandard, &data))
+            return false;
+        size = (static_cast<long long>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        mtime = ((static_cast<long long>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime) / 10000000;
+    #else
+        struct stat s;
+        if (stat(path.c_str(), &s) != 0)
+            return false;
+        size = s.st_size;
+        mtime = s.st_mtime;
+    #endif
+    return true;
+}
@@ -3,12 +3,13 @@
 #include "Util.h"
 #include "Operators.h"
 #include "Matrix.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
 /*****************************************************************************/
- BasicPtr Int::one = BasicPtr( new Int(1) );
- BasicPtr Int::minusOne = BasicPtr( new Int(-1) );
+ BasicPtr Int::one = Basic::immortal( new Int(1) );
+ BasicPtr Int::minusOne = Basic::immortal( new Int(-1) );
  BasicPtr Int::getArgres;
 /*****************************************************************************/
 
@@ -17,6 +18,8 @@ using namespace Symbolics;
 Int::Int( const int value): Basic(Type_Int), m_value(value)
 /*****************************************************************************/
 {
+    // Konstanten werden geteilt (auch zwischen Threads), Hash nicht erst beim ersten Zugriff
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -41,16 +44,16 @@ BasicPtr Int::New( const int i)
     case 1:
         return Int::getOne();
     default:
-        return BasicPtr(new Int(i));
+        return Arena::intern(new Int(i));
     }
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
- BasicPtr Int::iterateExp(Symbolics::Basic::Iterator &v)
+ BasicPtr Int::newBasic( BasicPtrVec &args )
 /*****************************************************************************/
 {
-    return v.process_Arg( BasicPtr(this) );
+    return BasicPtr(this);
 }
 /*****************************************************************************/
 
@@ -184,6 +187,15 @@ bool Int::operator<(  Basic const& rhs ) const
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Int::calcHash()
+/*****************************************************************************/
+{
+    m_hash = hashValue(static_cast<double>(m_value));
+    m_hashValid = true;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 Int Int::operator+ ( Int const& rhs)
 /*****************************************************************************/
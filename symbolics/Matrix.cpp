@@ -121,17 +121,10 @@ BasicPtr Matrix::simplify()
 
 
 /*****************************************************************************/
- BasicPtr Matrix::iterateExp(Symbolics::Basic::Iterator &v)
+ BasicPtr Matrix::newBasic( BasicPtrVec &args )
 /*****************************************************************************/
 {
-    // iterate args
-    BasicPtrVec iter_args;
-    iter_args.reserve(getArgsSize());
-    for (size_t i=0; i<getArgsSize(); ++i)
-    {
-        iter_args.push_back(getArg(i)->iterateExp(v));
-    }
-    return v.process_Arg(BasicPtr(new Matrix(iter_args, m_shape)));
+    return BasicPtr(new Matrix(args, m_shape));
 }
 /*****************************************************************************/
 
@@ -199,6 +192,36 @@ bool Matrix::operator<(Basic const& rhs) const
     return false;
 }
 /*****************************************************************************/
+
+/*****************************************************************************/
+void Matrix::calcHash()
+/*****************************************************************************/
+{
+    size_t hash = static_cast<size_t>(m_type);
+    hashCombine(hash, m_shape.getNrDimensions());
+    hashCombine(hash, m_shape.getDimension(1));
+    hashCombine(hash, m_shape.getDimension(2));
+
+    // Elementweise, wie in operator==
+    bool zero = true;
+    size_t rows = m_shape.getDimension(1);
+    size_t cols = m_shape.getDimension(2);
+    for (size_t m=0; m<rows; ++m)
+    {
+        for (size_t n=0; n<cols; ++n)
+        {
+            BasicPtr const& arg = get(m,n);
+            if (zero && !(arg == Zero::getZero()))
+                zero = false;
+            hashCombine(hash, arg->getHash());
+        }
+    }
+
+    // eine Nullmatrix ist gleich Zero
+    m_hash = zero ? hashValue(0.0) : hash;
+    m_hashValid = true;
+}
+/*****************************************************************************/
     
 
 /*****************************************************************************/
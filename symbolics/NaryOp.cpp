@@ -106,6 +106,13 @@ std::string NaryOp::join( std::string const& posSep,
 bool NaryOp::operator ==( Basic const& rhs) const
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (this == &rhs)
+      return true;
+    // Arena: ohne die Argumente anzusehen
+    if (is_InternedDifferent(rhs))
+      return false;
+
     // Typen vergleichen
     if (getType() != rhs.getType()) 
       return false;
@@ -135,6 +142,10 @@ bool NaryOp::operator ==( Basic const& rhs) const
 bool NaryOp::operator<(Basic  const& rhs) const
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (this == &rhs)
+        return false;
+
     // Typen vergleichen
     if (getType() != rhs.getType())
         return getType() < rhs.getType();
@@ -150,6 +161,8 @@ bool NaryOp::operator<(Basic  const& rhs) const
         {
             BasicPtr rhsArg(naryop.getArg(i)); 
             // Args vergleichen
+            if (getArg(i).get() == rhsArg.get())
+                continue;
             if ((*getArg(i).get()) == (*rhsArg.get()))
                 continue;
             return (*getArg(i).get()) < (*rhsArg.get());
@@ -165,8 +178,7 @@ bool NaryOp::operator<(Basic  const& rhs) const
 void NaryOp::getAtoms(Basic::BasicSet& atoms)
 /*****************************************************************************/
 {
-    for (size_t i=0; i<m_args.size(); ++i)
-        getArg(i)->getAtoms(atoms);
+    collectAtoms(atoms);
 }
 /*****************************************************************************/
 
@@ -174,8 +186,7 @@ void NaryOp::getAtoms(Basic::BasicSet& atoms)
 void NaryOp::getAtoms(Basic::BasicSizeTMap& atoms)
 /*****************************************************************************/
 {
-    for (size_t i=0; i<m_args.size(); ++i)
-        getArg(i)->getAtoms(atoms);
+    collectAtoms(atoms);
 }
 /*****************************************************************************/
 
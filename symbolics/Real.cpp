@@ -3,6 +3,7 @@
 #include "Util.h"
 #include "Operators.h"
 #include "Matrix.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -14,6 +15,7 @@ BasicPtr Real::getArgres;
 Real::Real( const double value): Basic(Type_Real), m_value(value)
 /*****************************************************************************/
 {
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -22,6 +24,7 @@ Real::Real( const Int i ): Basic(Type_Real),
 m_value(static_cast<double>(i.getValue()))
 /*****************************************************************************/
 {
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -33,10 +36,18 @@ Real::~Real()
 /*****************************************************************************/
 
 /*****************************************************************************/
- BasicPtr Real::iterateExp(Symbolics::Basic::Iterator &v)
+BasicPtr Real::New( const double r)
 /*****************************************************************************/
 {
-    return v.process_Arg( BasicPtr(this) );
+    return Arena::intern(new Real(r));
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+ BasicPtr Real::newBasic( BasicPtrVec &args )
+/*****************************************************************************/
+{
+    return BasicPtr(this);
 }
 /*****************************************************************************/
 
@@ -170,6 +181,15 @@ bool Real::operator<(  Basic const& rhs ) const
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Real::calcHash()
+/*****************************************************************************/
+{
+    m_hash = hashValue(m_value);
+    m_hashValid = true;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 Real Real::operator+ ( Int const& rhs)
 /*****************************************************************************/
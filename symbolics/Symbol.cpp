@@ -24,6 +24,7 @@ Symbol::Symbol( std::string const& name,
 Basic(Type_Symbol,shape), m_name(name), m_kind(category)
 /*****************************************************************************/
 {
+  m_freeSymbols.push_back(this);
   m_statekind=ALL;
   m_state = static_cast<size_t*>(calloc(m_shape.getNumEl(),sizeof(size_t)));
   m_state[0] = NO_STATE;
@@ -42,6 +43,7 @@ Symbol::Symbol( std::string const& name,  Symbol_Kind category):
 Basic(Type_Symbol), m_name(name), m_kind(category)
 /*****************************************************************************/
 {
+  m_freeSymbols.push_back(this);
   m_statekind=ALL;
   m_state = static_cast<size_t*>(calloc(m_shape.getNumEl(),sizeof(size_t)));
   m_state[0] = NO_STATE;
@@ -140,6 +142,18 @@ void Symbol::setState(size_t dim1, size_t dim2)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Symbol::setStateFlags(SymbolElementKind kind, std::vector<size_t> const& flags)
+/*****************************************************************************/
+{
+  if (flags.size() != m_shape.getNumEl())
+    throw InternalError("Symbol " + m_name + ": wrong number of state flags!");
+  for (size_t i=0;i<flags.size();i++)
+    m_state[i] = flags[i];
+  m_statekind = kind;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 void Symbol::setVariable(size_t dim1, size_t dim2)
 /*****************************************************************************/
@@ -189,27 +203,26 @@ void Symbol::setVariable(size_t dim1, size_t dim2)
   }
   BasicPtrVec subparents;
   BasicPtrVec esubparents;
-  for (ArgumentPtrSet::iterator ii = m_parents.begin();ii!=m_parents.end();++ii)
+  for (ArgumentPtr ii = m_firstParent;ii!=NULL;ii=ii->getNextParent())
   {
-    if ((*ii)->getParent().get() != NULL)
+    if (ii->getParent().get() != NULL)
     {
-      if ((*ii)->getParent()->getType() == Type_Der)
+      if (ii->getParent()->getType() == Type_Der)
       {
-        subparents.push_back((*ii)->getParent());
+        subparents.push_back(ii->getParent());
       }
-      else if ((*ii)->getParent()->getType() == Type_Element)
+      else if (ii->getParent()->getType() == Type_Element)
       {
-        Element *elem = Util::getAsPtr<Element>((*ii)->getParent());
+        Element *elem = Util::getAsPtr<Element>(ii->getParent());
         if ((elem->getRow() == dim1) && (elem->getCol() == dim2))
         {
-          ArgumentPtrSet& epars = elem->getParents();
-         for (ArgumentPtrSet::const_iterator jj = epars.begin();jj!=epars.end();jj++)
+         for (ArgumentPtr jj = elem->getFirstParent();jj!=NULL;jj=jj->getNextParent())
           {
-            if ((*jj)->getParent().get() != NULL)
+            if (jj->getParent().get() != NULL)
             {
-              if ((*jj)->getParent()->getType() == Type_Der)
+              if (jj->getParent()->getType() == Type_Der)
               {
-                esubparents.push_back((*jj)->getParent());
+                esubparents.push_back(jj->getParent());
               }
             }
           } 
@@ -260,10 +273,10 @@ void Symbol::setVariable(size_t dim1, size_t dim2)
 /*****************************************************************************/
 
 /*****************************************************************************/
- BasicPtr Symbol::iterateExp(Iterator &v)
+ BasicPtr Symbol::newBasic( BasicPtrVec &args )
 /*****************************************************************************/
 {
-    return BasicPtr(v.process_Arg(BasicPtr(this)));
+    return BasicPtr(this);
 }
 /*****************************************************************************/
 
@@ -300,6 +313,7 @@ void Symbol::calcHash()
     for(size_t i = 0; i < m_name.length(); ++i)
         hash = 65599 * hash + m_name[i];
     m_hash = hash;
+    m_hashValid = true;
 }
 /*****************************************************************************/
 
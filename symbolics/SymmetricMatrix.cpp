@@ -73,17 +73,10 @@ SymmetricMatrix::~SymmetricMatrix()
 /*****************************************************************************/
 
 /*****************************************************************************/
- BasicPtr SymmetricMatrix::iterateExp(Symbolics::Basic::Iterator &v)
+ BasicPtr SymmetricMatrix::newBasic( BasicPtrVec &args )
 /*****************************************************************************/
 {
-    // iterate args
-    BasicPtrVec iter_args;
-    iter_args.reserve(getArgsSize());
-    for (size_t i=0; i<getArgsSize(); ++i)
-    {
-        iter_args.push_back(getArg(i)->iterateExp(v));
-    }
-    return v.process_Arg(BasicPtr(new SymmetricMatrix(iter_args, m_shape)));
+    return BasicPtr(new SymmetricMatrix(args, m_shape));
 }
 /*****************************************************************************/
 
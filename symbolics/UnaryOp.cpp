@@ -46,6 +46,13 @@ UnaryOp::~UnaryOp()
 bool UnaryOp::operator ==( Basic const& rhs) const
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (this == &rhs)
+      return true;
+    // Arena: ohne die Argumente anzusehen
+    if (is_InternedDifferent(rhs))
+      return false;
+
     // Typen vergleichen
     if (getType() != rhs.getType()) 
       return false;
@@ -67,6 +74,10 @@ bool UnaryOp::operator ==( Basic const& rhs) const
 bool UnaryOp::operator<(Basic const& rhs) const
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (this == &rhs)
+        return false;
+
     // Typen vergleichen
     if (getType() != rhs.getType())
         return getType() < rhs.getType();
@@ -9,7 +9,7 @@
 using namespace Symbolics;
 
 /*****************************************************************************/
-BasicPtr Zero::zero = BasicPtr( new Zero() );
+BasicPtr Zero::zero = Basic::immortal( new Zero() );
 BasicPtr Zero::getArgres;
 /*****************************************************************************/
 
@@ -17,6 +17,7 @@ BasicPtr Zero::getArgres;
 Zero::Zero(): Basic(Type_Zero)
 /*****************************************************************************/
 {
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -24,6 +25,7 @@ Zero::Zero(): Basic(Type_Zero)
 Zero::Zero(Shape const& s): Basic(Type_Zero,s)
 /*****************************************************************************/
 {
+    calcHash();
 }
 /*****************************************************************************/
 
@@ -35,10 +37,10 @@ Zero::~Zero()
 /*****************************************************************************/
 
 /*****************************************************************************/
- BasicPtr Zero::iterateExp(Symbolics::Basic::Iterator &v)
+ BasicPtr Zero::newBasic( BasicPtrVec &args )
 /*****************************************************************************/
 {
-    return v.process_Arg( BasicPtr(this) );
+    return BasicPtr(this);
 }
 /*****************************************************************************/
 
@@ -79,6 +81,16 @@ bool Zero::operator==(  Basic const& rhs ) const
     }
 }
 /*****************************************************************************/
+
+/*****************************************************************************/
+void Zero::calcHash()
+/*****************************************************************************/
+{
+    // gleich zu 0, 0.0, false und jeder Nullmatrix, unabhaengig vom Shape
+    m_hash = hashValue(0.0);
+    m_hashValid = true;
+}
+/*****************************************************************************/
  
 /*****************************************************************************/
  BasicPtr Zero::subs( ConstBasicPtr const& old_exp, BasicPtr const& new_exp)
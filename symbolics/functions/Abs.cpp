@@ -6,6 +6,7 @@
 #include "Zero.h"
 #include "Matrix.h"
 #include "Mul.h"
+#include "Arena.h"
 
 #include <math.h>
 
@@ -166,7 +167,7 @@ BasicPtr Abs::New( BasicPtr const& arg)
             return mat->applyFunctor(f);
         }    
     }
-    return BasicPtr(new Abs(arg));
+    return Arena::intern(new Abs(arg));
 }
 /*****************************************************************************/
 
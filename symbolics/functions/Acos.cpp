@@ -7,11 +7,12 @@
 #include "Add.h"
 #include "Mul.h"
 #include "Matrix.h"
+#include "Arena.h"
 #include <math.h>
 
 using namespace Symbolics;
 
-ScopePtr  Acos::m_scope = ScopePtr(new Scope()); 
+ScopePtr  Acos::m_scope = Scope::immortal(new Scope()); 
 
 /*****************************************************************************/
 Acos::Acos( BasicPtrVec const& args ): UnaryOp(Type_Acos, args), List(m_scope)
@@ -152,7 +153,7 @@ BasicPtr Acos::New( BasicPtr const& arg)
             return mat->applyFunctor(f);
         }
     }
-    return BasicPtr(new Acos(arg));
+    return Arena::intern(new Acos(arg));
 }
 /*****************************************************************************/
 
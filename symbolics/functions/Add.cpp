@@ -6,7 +6,9 @@
 #include "Neg.h"
 #include "Mul.h"
 #include "Util.h"
+#include "Arena.h"
 #include <list>
+#include <algorithm>
 
 using namespace Symbolics;
 
@@ -60,6 +62,18 @@ BasicPtr Add::simplify()
 {
     if (m_simplified)
         return BasicPtr(this);
+    // geteilter Knoten, ueber einen anderen Elternknoten schon vereinfacht
+    if (m_simplifyCache.get() != NULL)
+        return m_simplifyCache;
+    return setSimplifyCache(simplifyArgList());
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+BasicPtr Add::simplifyArgList()
+/*****************************************************************************/
+{
     // call arg
     simplifyArgs();
 
@@ -149,7 +163,8 @@ BasicPtr Add::simplify()
         return val;
     }
     // combine equal args
-    BasicPtrMap argmap;
+    BasicPtrHashMap argmap;
+    argmap.reserve( other_args.size() );
     for (size_t i=0; i<other_args.size(); ++i)
     {
         BasicPtr v(new Int(1));
@@ -187,21 +202,28 @@ BasicPtr Add::simplify()
                 }
             }
         }
-        BasicPtrMap::iterator iter = argmap.find(other_args[i]);
+        BasicPtrHashMap::iterator iter = argmap.find(other_args[i]);
         if (iter == argmap.end())
         {
             argmap[other_args[i]] = v;
         }
         else
         {
-            argmap[other_args[i]] = New(argmap[other_args[i]],v);
+            iter->second = New(iter->second,v);
         }
     }
-    BasicPtrMap::iterator iter;
+    // sortieren, damit die Reihenfolge der Argumente eindeutig bleibt
+    BasicPtrVec argkeys;
+    argkeys.reserve( argmap.size() );
+    BasicPtrHashMap::iterator iter;
+    for(iter=argmap.begin();iter!=argmap.end();++iter)
+      argkeys.push_back(iter->first);
+    std::sort(argkeys.begin(),argkeys.end());
     BasicPtrVec other_args1;
     other_args1.reserve( argmap.size() );
-    for(iter=argmap.begin();iter!=argmap.end();++iter)
+    for(size_t k=0;k<argkeys.size();++k)
     {
+        iter = argmap.find(argkeys[k]);
         if (!Util::is_Zero(iter->second))
         {
             if (Util::is_One(iter->second))
@@ -410,6 +432,26 @@ bool Add::operator==(  Basic const& rhs ) const
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Add::calcHash()
+/*****************************************************************************/
+{
+    // Summe der Hashes, damit die Reihenfolge keine Rolle spielt (siehe operator==)
+    size_t sum = 0;
+    for (size_t i=0; i<getArgsSize(); ++i)
+        sum += getArg(i)->getHash();
+
+    size_t hash = static_cast<size_t>(m_type);
+    hashCombine(hash, m_shape.getNrDimensions());
+    hashCombine(hash, m_shape.getDimension(1));
+    hashCombine(hash, m_shape.getDimension(2));
+    hashCombine(hash, getArgsSize());
+    hashCombine(hash, sum);
+    m_hash = hash;
+    m_hashValid = true;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 BasicPtr Add::New( BasicPtr const& lhs, BasicPtr const& rhs )
 /*****************************************************************************/
@@ -517,7 +559,7 @@ BasicPtr Add::New( BasicPtr const& lhs, BasicPtr const& rhs )
         }
         else
             addargs.push_back(rhs);
-        return BasicPtr(new Add(addargs));
+        return Arena::intern(new Add(addargs));
     }
     if (rhs->getType() == Type_Add)
     {
@@ -527,9 +569,9 @@ BasicPtr Add::New( BasicPtr const& lhs, BasicPtr const& rhs )
         size_t argssize = a->getArgsSize();
         for (size_t j=0; j<argssize; ++j)
           addargs.push_back(a->getArg(j));
-        return BasicPtr(new Add(addargs));
+        return Arena::intern(new Add(addargs));
     }
-    return BasicPtr(new Add(lhs,rhs));
+    return Arena::intern(new Add(lhs,rhs));
 }
 /*****************************************************************************/
 
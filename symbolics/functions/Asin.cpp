@@ -6,11 +6,12 @@
 #include "Add.h"
 #include "Mul.h"
 #include "Neg.h"
+#include "Arena.h"
 #include <math.h>
 
 using namespace Symbolics;
 
-ScopePtr  Asin::m_scope = ScopePtr(new Scope()); 
+ScopePtr  Asin::m_scope = Scope::immortal(new Scope()); 
 
 /*****************************************************************************/
 Asin::Asin( BasicPtrVec const& args ): UnaryOp(Type_Asin, args), List(m_scope)
@@ -152,7 +153,7 @@ BasicPtr Asin::New( BasicPtr const& arg)
             return mat->applyFunctor(f);
         }
     }
-    return BasicPtr(new Asin(arg));
+    return Arena::intern(new Asin(arg));
 }
 /*****************************************************************************/
 
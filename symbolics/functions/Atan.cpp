@@ -4,11 +4,12 @@
 #include "Add.h"
 #include "Util.h"
 #include "Matrix.h"
+#include "Arena.h"
 #include <math.h>
 
 using namespace Symbolics;
 
-ScopePtr  Atan::m_scope = ScopePtr(new Scope()); 
+ScopePtr  Atan::m_scope = Scope::immortal(new Scope()); 
 
 /*****************************************************************************/
 Atan::Atan( BasicPtrVec const& args ): UnaryOp(Type_Atan, args), List(m_scope)
@@ -148,7 +149,7 @@ BasicPtr Atan::New( BasicPtr const& arg)
             return mat->applyFunctor(f);
         }
     }
-    return BasicPtr(new Atan(arg));
+    return Arena::intern(new Atan(arg));
 }
 /*****************************************************************************/
 
@@ -7,11 +7,12 @@
 #include "Add.h"
 #include "Mul.h"
 #include "Util.h"
+#include "Arena.h"
 #include <math.h>
 
 using namespace Symbolics;
 
-ScopePtr  Atan2::m_scope = ScopePtr(new Scope()); 
+ScopePtr  Atan2::m_scope = Scope::immortal(new Scope()); 
 
 /*****************************************************************************/
 Atan2::Atan2( BasicPtrVec const& args ): BinaryOp(Type_Atan2, args), List(m_scope)
@@ -235,7 +236,7 @@ BasicPtr Atan2::New( BasicPtr const& arg1, BasicPtr const& arg2)
 
         return BasicPtr( new Real(atan2( src1->getValue(), src2->getValue() )) );
     }
-    return BasicPtr(new Atan2(arg1,arg2));
+    return Arena::intern(new Atan2(arg1,arg2));
 }
 /*****************************************************************************/
 
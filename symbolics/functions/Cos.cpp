@@ -6,12 +6,13 @@
 #include "Util.h"
 #include "Mul.h"
 #include "Matrix.h"
+#include "Arena.h"
 #include <math.h>
 
 
 using namespace Symbolics;
 
-ScopePtr  Cos::m_scope = ScopePtr(new Scope()); 
+ScopePtr  Cos::m_scope = Scope::immortal(new Scope()); 
 
 /*****************************************************************************/
 Cos::Cos( BasicPtrVec const& args ): UnaryOp(Type_Cos, args), List(m_scope)
@@ -165,7 +166,7 @@ BasicPtr Cos::New( BasicPtr const& arg)
             return negmat;
         }
     }
-    return BasicPtr(new Cos(arg));
+    return Arena::intern(new Cos(arg));
 }
 /*****************************************************************************/
 
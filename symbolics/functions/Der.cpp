@@ -3,6 +3,7 @@
 #include "Symbol.h"
 #include "Int.h"
 #include "Matrix.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -86,7 +87,7 @@ BasicPtr Der::New( BasicPtr const& arg)
   case Type_Real:
         return Zero::getZero();
   case Type_Der:
-     return BasicPtr(new Der(arg));
+     return Arena::intern(new Der(arg));
   case Type_Matrix:
     {
         Matrix::UnaryFunctor<Der> f;
@@ -9,6 +9,7 @@
 #include "Add.h"
 #include "Mul.h"
 #include "str.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -29,8 +30,8 @@ NaryOp(Type_Element, BasicPtrVec()), m_row(zeroBasedRow), m_col(zeroBasedCol)
   // Argument speichern
   reserveArgs( 3 );
   addArg( arg );
-  addArg( BasicPtr( new Int(m_row) ) );
-  addArg( BasicPtr( new Int(m_col) ) );
+  addArg( Arena::intern( new Int(m_row) ) );
+  addArg( Arena::intern( new Int(m_col) ) );
 
   validate();
 }
@@ -299,7 +300,7 @@ BasicPtr Element::New( BasicPtr const& arg, size_t zeroBasedRow, size_t zeroBase
         return New(a,zeroBasedRow,zeroBasedCol);
     }
   }
-  return BasicPtr(new Element(arg,zeroBasedRow,zeroBasedCol));
+  return Arena::intern(new Element(arg,zeroBasedRow,zeroBasedCol));
 }
 /*****************************************************************************/
 
@@ -311,7 +312,7 @@ BasicPtr Element::Scalarizer::process_Arg(BasicPtr const &p)
   {
     if (p->is_Scalar())
       return p;
-    BasicPtrMap::iterator ii = scalars.find(p);
+    BasicPtrHashMap::iterator ii = scalars.find(p);
     if (ii != scalars.end())
       return ii->second;
     Matrix *mat = new Matrix(p->getShape());
@@ -2,6 +2,7 @@
 #include "If.h"
 #include "Bool.h"
 #include "Util.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -110,6 +111,6 @@ BasicPtr If::New( BasicPtr const& cond, BasicPtr const& arg1, BasicPtr const& ar
         else
             return arg2;
     }
-    return BasicPtr(new If(cond,arg1,arg2));
+    return Arena::intern(new If(cond,arg1,arg2));
 }
 /*****************************************************************************/
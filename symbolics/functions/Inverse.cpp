@@ -3,6 +3,7 @@
 #include "Util.h"
 #include "Neg.h"
 #include "Operators.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -114,6 +115,6 @@ BasicPtr Inverse::New( BasicPtr const& arg )
             return trans->getArg();
         }
     }
-    return BasicPtr( new Inverse(arg) );
+    return Arena::intern( new Inverse(arg) );
 }
 /*****************************************************************************/
\ No newline at end of file
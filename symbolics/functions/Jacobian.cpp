@@ -3,6 +3,10 @@
 #include "Matrix.h"
 #include "Der.h"
 #include "Matrix.h"
+#include "Arena.h"
+#include "Operators.h"
+#include <algorithm>
+#include <unordered_map>
 
 using namespace Symbolics;
 
@@ -71,12 +75,9 @@ BasicPtr Jacobian::simplify()
   // 
   if (getArg1()->is_Scalar())
   {
-    BasicPtrVec vec;
-    size_t numelem = getArg2()->getShape().getNumEl();
-    vec.reserve(numelem);
-    for (size_t i=0;i<numelem;++i)
-      vec.push_back(getArg1()->der(getArg2()->getArg(i))->simplify());
-    return BasicPtr(new Matrix(vec,Shape(numelem)));
+    SparseJacobian sparse = getSparse(getArg1(),getArg2());
+    sparse.shape = Shape(getArg2()->getShape().getNumEl());
+    return sparse.toMatrix();
   }
   else if (Util::is_Const(getArg1()))
   {
@@ -84,11 +85,7 @@ BasicPtr Jacobian::simplify()
   }
   else if (getArg1()->getType() == Type_Matrix)
   {
-    Matrix *mat = new Matrix(m_shape);
-    for (size_t i=0;i<getArg2()->getShape().getNumEl();++i)
-      for (size_t j=0;j<getArg1()->getShape().getNumEl();++j)
-        mat->set(i,j,getArg1()->getArg(j)->der(getArg2()->getArg(i))->simplify());
-    return BasicPtr(mat);
+    return getSparse(getArg1(),getArg2()).toMatrix();
   }
   m_simplified = true;
   return BasicPtr(this);
@@ -106,16 +103,13 @@ BasicPtr Jacobian::New( BasicPtr const& exp, BasicPtr const& symbols)
 
   Shape s(exp->getShape().getNumEl(), symbols->getShape().getNumEl());
 
-  BasicPtr exp1 = exp->simplify();
+  BasicPtr exp1 = Util::simplify(exp);
 
   if (exp1->is_Scalar()) // Wir leiten einen Skalar ab => Vektor mit Shape(1,n)
   {
-    BasicPtrVec vec;
-    size_t numelem = symbols->getShape().getNumEl();
-    vec.reserve(numelem);
-    for (size_t i=0;i<numelem;++i)
-      vec.push_back(exp1->der(symbols->getArg(i))->simplify());
-    return BasicPtr(new Matrix(vec,Shape(1,1,numelem)));
+    SparseJacobian sparse = getSparse(exp1,symbols);
+    sparse.shape = Shape(1,1,symbols->getShape().getNumEl());
+    return sparse.toMatrix();
   }
   else if (Util::is_Const(exp1))
   {
@@ -123,19 +117,94 @@ BasicPtr Jacobian::New( BasicPtr const& exp, BasicPtr const& symbols)
   }
   else if (exp1->getType() == Type_Matrix)	// Wir leiten einen Vektor ab => Matrix
   {
-	  // Neue Matrix anlegen
-	  Matrix *mat = new Matrix(s);
+    return getSparse(exp1,symbols).toMatrix();
+  }
+  return Arena::intern( new Jacobian(exp1,symbols));
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+SparseJacobian Jacobian::getSparse( BasicPtr const& exp, BasicPtr const& symbols)
+/*****************************************************************************/
+{
+  if (!exp->is_Scalar() && (exp->getType() != Type_Matrix))
+    throw InternalError("Jacobian: getSparse needs a Scalar or a Matrix as first argument!");
+  if (symbols->getType() != Type_Matrix)
+    throw InternalError("Jacobian: getSparse needs a Matrix as second argument!");
+
+  const size_t rows = exp->is_Scalar() ? 1 : exp->getArgsSize();
+  const size_t cols = symbols->getArgsSize();
+
+  // Symbol -> Spalten, nach allem anderen wird immer abgeleitet
+  std::unordered_map<BasicPtr,std::vector<size_t>,BasicPtrHash,BasicPtrEqual> columns;
+  std::vector<size_t> others;
+  for (size_t i=0;i<cols;++i)
+  {
+    if (symbols->getArg(i)->getType() == Type_Symbol)
+      columns[symbols->getArg(i)].push_back(i);
+    else
+      others.push_back(i);
+  }
 
-	  // i -> Symbole (=Spalten)
-    for (size_t i=0;i<symbols->getShape().getNumEl();++i)
-		// j - Expression (=Zeilen)
-		for (size_t j=0;j<exp1->getShape().getNumEl();++j)
-			// Matrixelement
-			mat->set(j,i, exp1->getArg(j)->der(symbols->getArg(i))->simplify());
+  // Zeilenweise: nur Spalten, deren Symbol in den (gespeicherten) freien Symbolen vorkommt
+  std::vector<std::vector<std::pair<size_t,BasicPtr> > > entries(cols);
+  std::vector<size_t> candidates;
+  for (size_t j=0;j<rows;++j)
+  {
+    BasicPtr e = exp->is_Scalar() ? exp : exp->getArg(j);
+    candidates = others;
+    if (e->getType() == Type_Symbol)
+    {
+      std::unordered_map<BasicPtr,std::vector<size_t>,BasicPtrHash,BasicPtrEqual>::const_iterator ii = columns.find(e);
+      if (ii != columns.end())
+        candidates.insert(candidates.end(),ii->second.begin(),ii->second.end());
+    }
+    else
+    {
+      Basic::FreeSymbols const& free = e->getFreeSymbols();
+      for (size_t k=0;k<free.size();++k)
+      {
+        std::unordered_map<BasicPtr,std::vector<size_t>,BasicPtrHash,BasicPtrEqual>::const_iterator ii = columns.find(BasicPtr(free[k]));
+        if (ii != columns.end())
+          candidates.insert(candidates.end(),ii->second.begin(),ii->second.end());
+      }
+    }
+    std::sort(candidates.begin(),candidates.end());
+    candidates.erase(std::unique(candidates.begin(),candidates.end()),candidates.end());
+    for (size_t k=0;k<candidates.size();++k)
+    {
+      BasicPtr d = e->der(symbols->getArg(candidates[k]))->simplify();
+      if (!Util::is_Zero(d))
+        entries[candidates[k]].push_back(std::make_pair(j,d));
+    }
+  }
 
-    return BasicPtr(mat);
+  SparseJacobian sparse;
+  sparse.shape = Shape(rows,cols);
+  sparse.colptr.push_back(0);
+  for (size_t i=0;i<cols;++i)
+  {
+    for (size_t k=0;k<entries[i].size();++k)
+    {
+      sparse.rowind.push_back(entries[i][k].first);
+      sparse.values.push_back(entries[i][k].second);
+    }
+    sparse.colptr.push_back(sparse.rowind.size());
   }
-  return BasicPtr( new Jacobian(exp1,symbols));
+  return sparse;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr SparseJacobian::toMatrix() const
+/*****************************************************************************/
+{
+  const size_t cols = colptr.size()-1;
+  BasicPtrVec vec(shape.getNumEl(),Zero::getZero());
+  for (size_t c=0;c<cols;++c)
+    for (size_t k=colptr[c];k<colptr[c+1];++k)
+      vec[rowind[k]*cols + c] = values[k];
+  return BasicPtr(new Matrix(vec,shape));
 }
 /*****************************************************************************/
 
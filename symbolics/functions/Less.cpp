@@ -1,6 +1,7 @@
 #include "Less.h"
 #include "Bool.h"
 #include "Util.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -184,6 +185,6 @@ BasicPtr Less::New( BasicPtr const& arg1, BasicPtr const& arg2)
             return BasicPtr(new Bool(crhs->getValue()>clhs->getValue()));
         }
     }
-    return BasicPtr(new Less(arg1,arg2));
+    return Arena::intern(new Less(arg1,arg2));
 }
 /*****************************************************************************/
\ No newline at end of file
@@ -1,11 +1,22 @@
+#include <mutex>
 #include "List.h"
 
 using namespace Symbolics;
 
+/*****************************************************************************/
+// Scopes sind statisch und werden von allen Threads benutzt
+static std::mutex& getScopeMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 List::List(ScopePtr scope):m_left(NULL),m_right(NULL),m_scope(scope)
 /*****************************************************************************/
 {
+    std::lock_guard<std::mutex> lock(getScopeMutex());
     if (scope->first==NULL)
     {
         scope->first=this;
@@ -24,6 +35,7 @@ List::List(ScopePtr scope):m_left(NULL),m_right(NULL),m_scope(scope)
 List::~List()
 /*****************************************************************************/
 {
+    std::lock_guard<std::mutex> lock(getScopeMutex());
     if (m_left)
     {
         if (m_right)
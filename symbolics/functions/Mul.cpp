@@ -5,6 +5,7 @@
 #include "Neg.h"
 #include "Util.h"
 #include "Pow.h"
+#include "Arena.h"
 #include <list>
 
 using namespace Symbolics;
@@ -55,6 +56,18 @@ BasicPtr Mul::simplify()
 {
     if (m_simplified)
         return BasicPtr(this);
+    // geteilter Knoten, ueber einen anderen Elternknoten schon vereinfacht
+    if (m_simplifyCache.get() != NULL)
+        return m_simplifyCache;
+    return setSimplifyCache(simplifyArgList());
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+BasicPtr Mul::simplifyArgList()
+/*****************************************************************************/
+{
     // call arg
     simplifyArgs();
 
@@ -334,6 +347,30 @@ bool Mul::operator==(  Basic const& rhs ) const
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Mul::calcHash()
+/*****************************************************************************/
+{
+    // skalare Faktoren sind vertauschbar, nicht skalare nicht (siehe operator==)
+    size_t sum = 0;
+    size_t hash = static_cast<size_t>(m_type);
+    hashCombine(hash, m_shape.getNrDimensions());
+    hashCombine(hash, m_shape.getDimension(1));
+    hashCombine(hash, m_shape.getDimension(2));
+    hashCombine(hash, getArgsSize());
+    for (size_t i=0; i<getArgsSize(); ++i)
+    {
+        if (getArg(i)->is_Scalar())
+            sum += getArg(i)->getHash();
+        else
+            hashCombine(hash, getArg(i)->getHash());
+    }
+    hashCombine(hash, sum);
+    m_hash = hash;
+    m_hashValid = true;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 BasicPtr Mul::New( BasicPtr const& lhs, BasicPtr  const& rhs )
 /*****************************************************************************/
@@ -465,7 +502,7 @@ BasicPtr Mul::New( BasicPtr const& lhs, BasicPtr  const& rhs )
         }
         else
             mulargs.push_back(rhs);
-        return BasicPtr(new Mul(mulargs));
+        return Arena::intern(new Mul(mulargs));
     }
     if (rhs->getType() == Type_Mul)
     {
@@ -475,9 +512,9 @@ BasicPtr Mul::New( BasicPtr const& lhs, BasicPtr  const& rhs )
         size_t argssize = a->getArgsSize();
         for (size_t j=0; j<argssize; ++j)
           mulargs.push_back(a->getArg(j));
-        return BasicPtr(new Mul(mulargs));
+        return Arena::intern(new Mul(mulargs));
     }
-    return BasicPtr(new Mul(lhs,rhs));
+    return Arena::intern(new Mul(lhs,rhs));
 }
 /*****************************************************************************/
 
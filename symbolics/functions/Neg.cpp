@@ -3,6 +3,7 @@
 #include "Bool.h"
 #include "Matrix.h"
 #include "Util.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -129,8 +130,7 @@ BasicPtr Neg::New(BasicPtr const& e)
         }
     case Type_Matrix:
         {
-            BasicSet atoms = e->getAtoms();
-            if (atoms.size() == 0)
+            if (e->getFreeSymbols().empty())
             {
                 const Matrix *c = Util::getAsConstPtr<Matrix>(e);
                 return Int::getMinusOne()*(*c);
@@ -138,6 +138,6 @@ BasicPtr Neg::New(BasicPtr const& e)
             break;
         }
     }
-    return BasicPtr(new Neg(e));
+    return Arena::intern(new Neg(e));
 }
 /*****************************************************************************/
@@ -16,6 +16,9 @@ using namespace Symbolics;
 bool Symbolics::operator<(BasicPtr const& lhs, BasicPtr  const& rhs)
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (lhs.get() == rhs.get())
+        return false;
     // zuerst den Typ vergleichen
     // Ausnamen fuer Zero
     if ((lhs->getType() == Type_Zero) &&
@@ -85,6 +88,11 @@ bool Symbolics::operator>(BasicPtr const& lhs, BasicPtr  const& rhs)
 bool Symbolics::operator== (BasicPtr const& lhs, BasicPtr  const& rhs)
 /*****************************************************************************/
 {
+    // derselbe Knoten
+    if (lhs.get() == rhs.get())
+        return true;
+    if (lhs->is_InternedDifferent(*rhs.get()))
+        return false;
     // zuerst den Typ vergleichen
     // Ausnamen fuer Zero
     if (lhs->getType() == Type_Zero)
@@ -4,6 +4,7 @@
 #include "Util.h"
 #include "Mul.h"
 #include "Operators.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -121,6 +122,6 @@ BasicPtr Outer::New( BasicPtr const& arg1, BasicPtr const& arg2 )
 		return BasicPtr(mat3);
 	}
 
-    return BasicPtr(new Outer(arg1, arg2));
+    return Arena::intern(new Outer(arg1, arg2));
 }
 /*****************************************************************************/
\ No newline at end of file
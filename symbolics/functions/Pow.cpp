@@ -1,5 +1,6 @@
 #include "Pow.h"
 #include "Symbolics.h"
+#include "Arena.h"
 #include <math.h>
 
 using namespace Symbolics;
@@ -327,7 +328,7 @@ BasicPtr Pow::New( BasicPtr const& arg1, BasicPtr const& arg2)
                 Matrix *mat = new Matrix(*base);
                 for(int j=1;j<i;++j)
                   *mat = (*mat)*(*base);
-                return BasicPtr(new Pow(BasicPtr(mat),Int::getMinusOne()));
+                return Arena::intern(new Pow(BasicPtr(mat),Int::getMinusOne()));
               }
             }
             else if (arg2->getType() == Type_Real)
@@ -348,7 +349,7 @@ BasicPtr Pow::New( BasicPtr const& arg1, BasicPtr const& arg2)
                     Matrix *mat = new Matrix(*base);
                     for(int j=1;j<i;++j)
                       *mat = (*mat)*(*base);
-                    return BasicPtr(new Pow(BasicPtr(mat),Int::getMinusOne()));
+                    return Arena::intern(new Pow(BasicPtr(mat),Int::getMinusOne()));
                   }
               }
             }
@@ -378,7 +379,7 @@ BasicPtr Pow::New( BasicPtr const& arg1, BasicPtr const& arg2)
             return Neg::New(New(arg_1,arg2));
         }
     }
-    return BasicPtr(new Pow(arg1,arg2));
+    return Arena::intern(new Pow(arg1,arg2));
 }
 /*****************************************************************************/
 
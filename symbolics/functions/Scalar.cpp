@@ -4,6 +4,7 @@
 #include "Util.h"
 #include "Matrix.h"
 #include "Int.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -116,6 +117,6 @@ BasicPtr Scalar::New(BasicPtr const& arg)
             return Neg::New(New(neg->getArg()));
         }
     }
-    return BasicPtr(new Scalar(arg));
+    return Arena::intern(new Scalar(arg));
 }
 /*****************************************************************************/
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Neg.h"
 #include "Util.h"
 #include "Operators.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -141,7 +142,7 @@ BasicPtr Sign::New( BasicPtr const& arg)
             return Neg::New(New(neg->getArg()) );
         }
     }
-    return BasicPtr(new Sign(arg));
+    return Arena::intern(new Sign(arg));
 }
 /*****************************************************************************/
 
@@ -7,10 +7,11 @@
 #include "Mul.h"
 #include <math.h>
 #include "Matrix.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
-ScopePtr  Sin::m_scope = ScopePtr(new Scope()); 
+ScopePtr  Sin::m_scope = Scope::immortal(new Scope()); 
 
 /*****************************************************************************/
 Sin::Sin( BasicPtrVec const& args ): UnaryOp(Type_Sin, args), List(m_scope)
@@ -148,7 +149,7 @@ BasicPtr Sin::New( BasicPtr const& arg)
             return negmat;
         }
     }
-    return BasicPtr(new Sin(arg));
+    return Arena::intern(new Sin(arg));
 }
 /*****************************************************************************/
 
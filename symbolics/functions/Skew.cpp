@@ -4,6 +4,7 @@
 #include "Neg.h"
 #include "Util.h"
 #include "Operators.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -124,6 +125,6 @@ BasicPtr Skew::New( BasicPtr const& arg)
             return Neg::New(New(neg->getArg()));
         }
     }
-    return BasicPtr(new Skew(arg));
+    return Arena::intern(new Skew(arg));
 }
 /*****************************************************************************/
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Neg.h"
 #include "Mul.h"
 #include "Util.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -122,7 +123,7 @@ BasicPtr Solve::New( BasicPtr const& arg1, BasicPtr const& arg2)
     {
         return Util::div(arg2,arg1);
     }
-    return BasicPtr(new Solve(arg1,arg2));
+    return Arena::intern(new Solve(arg1,arg2));
 }
 /*****************************************************************************/
 
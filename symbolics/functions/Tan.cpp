@@ -7,11 +7,12 @@
 #include "Cos.h"
 #include "Pow.h"
 #include "Mul.h"
+#include "Arena.h"
 #include <math.h>
 
 using namespace Symbolics;
 
-ScopePtr  Tan::m_scope = ScopePtr(new Scope()); 
+ScopePtr  Tan::m_scope = Scope::immortal(new Scope()); 
 
 /*****************************************************************************/
 Tan::Tan( BasicPtrVec const& args ): UnaryOp(Type_Tan, args), List(m_scope)
@@ -150,7 +151,7 @@ BasicPtr Tan::New( BasicPtr const& arg)
             return mat->applyFunctor(f);
         }
     }
-    return BasicPtr(new Tan(arg));
+    return Arena::intern(new Tan(arg));
 }
 /*****************************************************************************/
 
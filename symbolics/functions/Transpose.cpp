@@ -4,6 +4,7 @@
 #include "Util.h"
 #include "Neg.h"
 #include "Operators.h"
+#include "Arena.h"
 
 using namespace Symbolics;
 
@@ -125,6 +126,6 @@ BasicPtr Transpose::New( BasicPtr const& arg )
             return trans->getArg();
         }
     }
-    return BasicPtr( new Transpose(arg) );
+    return Arena::intern( new Transpose(arg) );
 }
 /*****************************************************************************/
\ No newline at end of file
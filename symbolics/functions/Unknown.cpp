@@ -70,17 +70,10 @@ BasicPtr Unknown::simplify()
 
 
 /*****************************************************************************/
- BasicPtr Unknown::iterateExp(Iterator &v)
+ BasicPtr Unknown::newBasic( BasicPtrVec &args )
 /*****************************************************************************/
 {
-    // iterate args
-    BasicPtrVec iter_args;
-    iter_args.reserve(getArgsSize());
-    for (size_t i=0; i<getArgsSize(); ++i)
-    {
-        iter_args.push_back(getArg(i)->iterateExp(v));
-    }
-    return v.process_Arg(BasicPtr(new Unknown(m_name, iter_args)));
+    return BasicPtr(new Unknown(m_name, args));
 }
 /*****************************************************************************/
 
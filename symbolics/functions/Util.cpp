@@ -40,6 +40,7 @@
 #include "Cos.h"
 #include "Sin.h"
 #include "Tan.h"
+#include <unordered_set>
 
 using namespace Symbolics;
 
@@ -201,8 +202,7 @@ bool Util::is_One( BasicPtr const& e)
 bool Util::is_Const( BasicPtr const& arg)
 /*****************************************************************************/
 {
-    Basic::BasicSet atoms = arg->getAtoms();
-    return atoms.size() == 0;
+    return arg->getFreeSymbols().empty();
 }
 /*****************************************************************************/
 
@@ -276,6 +276,39 @@ BasicPtr Util::eye( Shape const& s)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+BasicPtr Util::simplify( BasicPtr const& exp )
+/*****************************************************************************/
+{
+    if (exp->is_Simplified())
+        return exp;
+    // post-order mit eigenem Stack, vereinfachte Teilbaeume werden nicht betreten.
+    // Danach findet simplify() die Argumente bereits vereinfacht (m_simplified oder
+    // simplify-Cache) und steigt nicht mehr tief ab.
+    std::unordered_set<Basic const*> visited;
+    std::vector<std::pair<BasicPtr,size_t> > stack;
+    visited.insert(exp.get());
+    stack.push_back(std::make_pair(exp,0));
+    while (!stack.empty())
+    {
+        BasicPtr b = stack.back().first;
+        size_t next = stack.back().second;
+        if (next < b->getArgsSize())
+        {
+            ++stack.back().second;
+            BasicPtr const& arg = b->getArg(next);
+            if ((arg->getArgsSize() > 0) && !arg->is_Simplified() && visited.insert(arg.get()).second)
+                stack.push_back(std::make_pair(arg,0));
+            continue;
+        }
+        stack.pop_back();
+        if (b.get() != exp.get())
+            b->simplify();
+    }
+    return exp->simplify();
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 void Util::newScope()
 /*****************************************************************************/
@@ -30,6 +30,12 @@ namespace Symbolics
         // derivative
         BasicPtr der();
         BasicPtr der(BasicPtr const& symbol);
+
+    protected:
+        // Hash unabhaengig von der Reihenfolge der Argumente
+        void calcHash();
+        // eigentliches Vereinfachen, simplify() merkt sich das Ergebnis
+        BasicPtr simplifyArgList();
     };
 
     typedef boost::intrusive_ptr< Add> ConstAddPtr;
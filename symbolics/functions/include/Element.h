@@ -39,7 +39,7 @@ namespace Symbolics
             Scalarizer() {;}
             ~Scalarizer() {;}
           
-            BasicPtrMap scalars;
+            BasicPtrHashMap scalars;
             BasicPtr process_Arg(BasicPtr const &p);
         };
 
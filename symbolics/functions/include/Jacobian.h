@@ -1,11 +1,26 @@
 #ifndef __JACOBIAN_H_
 #define __JACOBIAN_H_
 
+#include <vector>
 #include "BinaryOp.h"
 
 namespace Symbolics
 {
 
+    // Jacobimatrix, nur die strukturell von Null verschiedenen Eintraege
+    // spaltenweise (CSC): Spalte c steht in values[colptr[c]..colptr[c+1]-1]
+    struct SparseJacobian
+    {
+        Shape shape;
+        std::vector<size_t> colptr;
+        std::vector<size_t> rowind;
+        BasicPtrVec values;
+
+        inline size_t getNNZ() const { return values.size(); };
+        // dichte Matrix, die uebrigen Eintraege sind Zero
+        BasicPtr toMatrix() const;
+    };
+
     class Jacobian: public BinaryOp
     {
     public:
@@ -24,6 +39,10 @@ namespace Symbolics
 
         static BasicPtr New( BasicPtr const& exp, BasicPtr const&  symbols);
 
+        // Besetzungsmuster ueber die freien Symbole, abgeleitet werden nur diese Eintraege
+        // exp: Skalar oder Vektor (Matrix), symbols: Vektor (Matrix)
+        static SparseJacobian getSparse( BasicPtr const& exp, BasicPtr const&  symbols);
+
         BasicPtr der();
         BasicPtr der(BasicPtr const& symbol);
 	protected:
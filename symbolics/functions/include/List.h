@@ -31,11 +31,13 @@ namespace Symbolics
         // Konstruktor
         Scope( ): first(NULL), last(NULL), m_refCount(0) {;};
         ~Scope( ) {;};
+        // statische Scopes der Funktionen werden nie freigegeben und nicht gezaehlt
+        static inline ScopePtr immortal( Scope *s ) { s->m_refCount.setImmortal(); return ScopePtr(s); };
         List* first;
         List* last;
     private:
         // Boost Intrusive Ptr
-        unsigned int m_refCount;
+        RefCount m_refCount;
         // friend
         friend void ::boost::intrusive_ptr_add_ref( const Scope* p);
         friend void ::boost::intrusive_ptr_release( const Scope* p);
@@ -81,7 +83,7 @@ namespace boost
     {
         // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
         Symbolics::Scope* b = const_cast<Symbolics::Scope*>(p);
-        ++(b->m_refCount);
+        b->m_refCount.inc();
     }
 
     // decrement reference count, and delete object when reference count reaches 0
@@ -89,7 +91,7 @@ namespace boost
     {
         // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
         Symbolics::Scope* b = const_cast<Symbolics::Scope*>(p);
-        if (--(b->m_refCount) == 0)
+        if (b->m_refCount.dec())
             delete p;
     } 
 
@@ -2,6 +2,7 @@
 #define __OPERATORS_H_
 
 #include "Basic.h"
+#include <unordered_map>
 
 namespace Symbolics
 {
@@ -16,6 +17,17 @@ namespace Symbolics
     bool operator<( BasicPtr const& lhs, BasicPtr  const& rhs);
     bool operator>( BasicPtr const& lhs, BasicPtr  const& rhs);
 
+    // Hash und Vergleich fuer std::unordered_map, Hash siehe Basic::calcHash
+    struct BasicPtrHash
+    {
+        inline size_t operator()( BasicPtr const& p ) const { return p->getHash(); };
+    };
+    struct BasicPtrEqual
+    {
+        inline bool operator()( BasicPtr const& lhs, BasicPtr const& rhs ) const { return lhs == rhs; };
+    };
+    typedef std::unordered_map<BasicPtr, BasicPtr, BasicPtrHash, BasicPtrEqual> BasicPtrHashMap;
+
     // Operatoren mit doubles
     BasicPtr operator+ (double lhs, BasicPtr  const& rhs);
     BasicPtr operator+ (BasicPtr const& lhs, double rhs);
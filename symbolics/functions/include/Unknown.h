@@ -25,7 +25,7 @@ namespace Symbolics
         // Ersetzen
          BasicPtr subs( ConstBasicPtr const& old_exp,  BasicPtr const& new_exp);
         // Iterate
-         BasicPtr iterateExp( Iterator &v );
+         BasicPtr newBasic( BasicPtrVec &args );
 
 		    static BasicPtr New( std::string const& name, BasicPtrVec const& args );
 
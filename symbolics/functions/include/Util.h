@@ -22,6 +22,9 @@ namespace Symbolics
 
         static BasicPtr sqrt( BasicPtr const& arg);
 
+        // simplify ohne tiefe Rekursion: Teilausdruecke werden vorher von unten nach oben vereinfacht
+        static BasicPtr simplify( BasicPtr const& exp );
+
         template< typename Ty >
         static Ty* getAsPtr( const BasicPtr & basic )
         {
@@ -66,5 +66,31 @@ int test_jacobian( int &argc,  char *argv[])
     BasicPtr mat(new Matrix(mat3vec,Shape(3,3)));
     if (jacaabbccs != mat) return -4;
 
+    // Besetzungsmuster von [a*b, c, sin(a)] nach [a,b,c], spaltenweise
+    BasicPtrVec vecsparse;
+    vecsparse.push_back(a*b);
+    vecsparse.push_back(c);
+    vecsparse.push_back(Sin::New(a));
+    BasicPtr expsparse(new Matrix(vecsparse,Shape(3)));
+    SparseJacobian sparse = Jacobian::getSparse(expsparse,symbols3);
+    if (sparse.getNNZ() != 4) return -5;
+    size_t colptr[] = {0,2,3,4};
+    size_t rowind[] = {0,2,0,1};
+    for (size_t i=0;i<4;++i)
+        if (sparse.colptr[i] != colptr[i]) return -6;
+    for (size_t i=0;i<4;++i)
+        if (sparse.rowind[i] != rowind[i]) return -7;
+    if (sparse.values[1] != Cos::New(a)) return -8;
+
+    // Zeilen sind die Ausdruecke, Spalten die Symbole: [a*b, c] nach [a,b,c] ist (2,3)
+    BasicPtrVec vecabc2;
+    vecabc2.push_back(a*b);
+    vecabc2.push_back(c);
+    BasicPtr jac23 = Jacobian::New(BasicPtr(new Matrix(vecabc2,Shape(2))),symbols3);
+    if (jac23->getShape() != Shape(2,3)) return -9;
+    if (Element::New(jac23,0,1) != a) return -10;
+    if (Element::New(jac23,1,2) != Int::getOne()) return -11;
+    if (!Util::is_Zero(Element::New(jac23,1,0))) return -12;
+
     return 0;
 }
\ No newline at end of file
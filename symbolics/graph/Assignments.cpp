@@ -1,4 +1,6 @@
 #include "Assignments.h"
+#include "CSEOptimisation.h"
+#include "Scheduler.h"
 
 
 
@@ -16,6 +18,16 @@ Symbolics::Graph::Assignment::Assignment( NodePtr node)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+Symbolics::Graph::Assignment::Assignment( BasicPtr const& symbol, BasicPtr const& exp, Category_Type category):
+category(category), implizit(false)
+/*****************************************************************************/
+{
+  lhs.push_back(symbol);
+  rhs.push_back(exp);
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 Symbolics::Graph::Assignment::~Assignment()
 /*****************************************************************************/
@@ -133,3 +145,21 @@ std::vector<Symbolics::Graph::Assignment> Symbolics::Graph::Assignments::getEqua
   return res;
 }
 /*****************************************************************************/
+
+/*****************************************************************************/
+void Symbolics::Graph::Assignments::eliminateCommonSubexpressions(EquationSystemPtr eqsys, size_t &counter)
+/*****************************************************************************/
+{
+  CSEOptimisation cse(eqsys,m_assignments,m_symbols,counter);
+  cse.optimize();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Symbolics::Graph::Assignments::schedule()
+/*****************************************************************************/
+{
+  Scheduler scheduler(m_assignments);
+  scheduler.schedule();
+}
+/*****************************************************************************/
@@ -0,0 +1,635 @@
+#include "CSEOptimisation.h"
+#include "str.h"
+#include "Factory.h"
+#include <algorithm>
+#include <set>
+
+using namespace Symbolics;
+using namespace Graph;
+
+// Add/Mul mit sehr haeufigen Argumenten (Parameter) werden bei der paarweisen
+// Suche nach gemeinsamen Teilmengen uebergangen, sonst waechst der Aufwand quadratisch
+static const size_t maxPairSearch = 256;
+
+/*****************************************************************************/
+CSEOptimisation::CSEOptimisation(EquationSystemPtr eqsys, std::vector<Assignment> &assignments, SymbolPtrVec &symbols, size_t &counter):
+m_eqsys(eqsys), m_assignments(assignments), m_symbols(symbols), m_counter(counter)
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+CSEOptimisation::~CSEOptimisation()
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CSEOptimisation::optimize()
+/*****************************************************************************/
+{
+  // Eingaenge werden von keinem Writer ausgegeben, implizite Gleichungen bleiben unveraendert
+  Category_Type skip = INPUT;
+
+  // Verwendungen zaehlen
+  for (std::vector<Assignment>::const_iterator ii=m_assignments.begin(); ii!=m_assignments.end(); ++ii)
+  {
+    if (ii->implizit || (ii->category & skip))
+      continue;
+    for (size_t i=0; i<ii->rhs.size(); ++i)
+      addUse(collect(ii->rhs[i]));
+  }
+  findFactors();
+  nameTemps();
+
+  // neu aufbauen, Hilfsvariablen vor der ersten Verwendung einfuegen
+  std::set<Basic*> temps;
+  std::vector<Assignment> res;
+  for (std::vector<Assignment>::const_iterator ii=m_assignments.begin(); ii!=m_assignments.end(); ++ii)
+  {
+    if (ii->implizit || (ii->category & skip))
+    {
+      res.push_back(*ii);
+      continue;
+    }
+    Assignment a = *ii;
+    for (size_t i=0; i<a.rhs.size(); ++i)
+      a.rhs[i] = rebuild(a.rhs[i]);
+    for (size_t i=0; i<m_pending.size(); ++i)
+    {
+      temps.insert(m_pending[i].lhs[0].get());
+      res.push_back(m_pending[i]);
+    }
+    m_pending.clear();
+    res.push_back(a);
+  }
+
+  cleanup(res,temps);
+  m_assignments.swap(res);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CSEOptimisation::is_Nary(Basic_Type type)
+/*****************************************************************************/
+{
+  return (type == Type_Add) || (type == Type_Mul);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CSEOptimisation::is_Eligible(Entry const& e) const
+/*****************************************************************************/
+{
+  // Teilmenge eines Add/Mul
+  if (e.exp.get() == NULL)
+    return true;
+  if (!e.exp->is_Scalar() || (e.exp->getArgsSize() == 0))
+    return false;
+  switch (e.type)
+  {
+  // lohnt sich nicht bzw. muss fuer die Writer erhalten bleiben
+  case Type_Neg:
+  case Type_Matrix:
+  case Type_Solve:
+  case Type_Der:
+  case Type_Jacobian:
+  case Type_Unknown:
+    return false;
+  case Type_Element:
+    return (e.exp->getArg(0)->getType() != Type_Symbol);
+  default:
+    return true;
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CSEOptimisation::is_Factorable(Entry const& e) const
+/*****************************************************************************/
+{
+  if (!is_Nary(e.type) || !is_Eligible(e))
+    return false;
+  // Skalarprodukt o.ae.: Argumente sind nicht vertauschbar
+  if (e.exp.get() != NULL)
+    for (size_t j=0; j<e.exp->getArgsSize(); ++j)
+      if (!e.exp->getArg(j)->is_Scalar())
+        return false;
+  return true;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CSEOptimisation::is_SubSet(IdVec const& sub, IdVec const& set)
+/*****************************************************************************/
+{
+  return std::includes(set.begin(),set.end(),sub.begin(),sub.end());
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+CSEOptimisation::IdVec CSEOptimisation::getIntersection(IdVec const& a, IdVec const& b)
+/*****************************************************************************/
+{
+  IdVec res;
+  std::set_intersection(a.begin(),a.end(),b.begin(),b.end(),std::back_inserter(res));
+  return res;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+size_t CSEOptimisation::collect(BasicPtr const& exp)
+/*****************************************************************************/
+{
+  BasicPtrVec order;
+  exp->getPostOrder(order);
+  for (size_t i=0; i<order.size(); ++i)
+  {
+    BasicPtr const& b = order[i];
+    if (m_ids.find(b) != m_ids.end())
+      continue;
+    size_t id = m_entries.size();
+    m_entries.push_back(Entry());
+    Entry &e = m_entries.back();
+    e.exp = b;
+    e.type = b->getType();
+    for (size_t j=0; j<b->getArgsSize(); ++j)
+      e.args.push_back(m_ids[b->getArg(j)]);
+    if (is_Nary(e.type))
+    {
+      std::sort(e.args.begin(),e.args.end());
+      m_factors[std::make_pair(e.type,e.args)] = id;
+    }
+    m_ids[b] = id;
+    for (size_t j=0; j<m_entries[id].args.size(); ++j)
+      addUse(m_entries[id].args[j]);
+  }
+  return m_ids[exp];
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CSEOptimisation::addUse(size_t id)
+/*****************************************************************************/
+{
+  // Ausdruecke, die keine Hilfsvariable bekommen, werden bei jeder Verwendung neu
+  // ausgegeben, ihre Argumente also mehrfach verwendet
+  Entry &e = m_entries[id];
+  ++e.count;
+  if ((e.count > 1) && !is_Eligible(e))
+  {
+    for (size_t j=0; j<e.args.size(); ++j)
+      addUse(e.args[j]);
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CSEOptimisation::findFactors()
+/*****************************************************************************/
+{
+  size_t n = m_entries.size();
+  for (size_t id=0; id<n; ++id)
+  {
+    Entry const& e = m_entries[id];
+    if (!is_Factorable(e))
+      continue;
+    for (size_t j=0; j<e.args.size(); ++j)
+      if ((j == 0) || (e.args[j] != e.args[j-1]))
+        m_containing[std::make_pair(e.type,e.args[j])].push_back(id);
+  }
+
+  // vorhandene Add/Mul, die in einem anderen enthalten sind
+  for (size_t id=0; id<n; ++id)
+  {
+    if (!is_Factorable(m_entries[id]))
+      continue;
+    IdVec const& args = m_entries[id].args;
+    IdVec const* rarest = NULL;
+    for (size_t j=0; j<args.size(); ++j)
+    {
+      IdVec const& c = m_containing[std::make_pair(m_entries[id].type,args[j])];
+      if ((rarest == NULL) || (c.size() < rarest->size()))
+        rarest = &c;
+    }
+    for (size_t k=0; k<rarest->size(); ++k)
+    {
+      size_t other = (*rarest)[k];
+      if ((other != id) && (m_entries[other].args.size() > args.size()) && is_SubSet(args,m_entries[other].args))
+        ++m_entries[id].count;
+    }
+  }
+
+  // gemeinsame Teilmengen zweier Add/Mul, die selbst nicht vorkommen
+  std::map<size_t,std::set<size_t> > supersets;
+  for (size_t id=0; id<n; ++id)
+  {
+    if (!is_Factorable(m_entries[id]))
+      continue;
+    Basic_Type type = m_entries[id].type;
+    std::map<size_t,size_t> shared;
+    IdVec const& args = m_entries[id].args;
+    for (size_t j=0; j<args.size(); ++j)
+    {
+      if ((j > 0) && (args[j] == args[j-1]))
+        continue;
+      IdVec const& c = m_containing[std::make_pair(type,args[j])];
+      if (c.size() > maxPairSearch)
+        continue;
+      for (size_t k=0; k<c.size(); ++k)
+        if (c[k] > id)
+          ++shared[c[k]];
+    }
+    for (std::map<size_t,size_t>::const_iterator ii=shared.begin(); ii!=shared.end(); ++ii)
+    {
+      if (ii->second < 2)
+        continue;
+      IdVec common = getIntersection(args,m_entries[ii->first].args);
+      if ((common.size() < 2) || (common == args) || (common == m_entries[ii->first].args))
+        continue;
+      std::pair<Basic_Type,IdVec> key(type,common);
+      std::map<std::pair<Basic_Type,IdVec>,size_t>::const_iterator f = m_factors.find(key);
+      size_t factor;
+      if (f == m_factors.end())
+      {
+        factor = m_entries.size();
+        m_entries.push_back(Entry());
+        m_entries.back().type = type;
+        m_entries.back().args = common;
+        m_factors[key] = factor;
+      }
+      else
+        factor = f->second;
+      supersets[factor].insert(id);
+      supersets[factor].insert(ii->first);
+    }
+  }
+  for (std::map<size_t,std::set<size_t> >::const_iterator ii=supersets.begin(); ii!=supersets.end(); ++ii)
+    if (m_entries[ii->first].exp.get() == NULL)
+      m_entries[ii->first].count = ii->second.size();
+
+  // Teilmengen, die beim Neuaufbau herausgezogen werden
+  for (size_t id=0; id<m_entries.size(); ++id)
+  {
+    Entry const& e = m_entries[id];
+    if (!is_Factorable(e) || (e.count < 2))
+      continue;
+    for (size_t j=0; j<e.args.size(); ++j)
+      if ((j == 0) || (e.args[j] != e.args[j-1]))
+        m_factorsContaining[std::make_pair(e.type,e.args[j])].push_back(id);
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+size_t CSEOptimisation::getHash(size_t id) const
+/*****************************************************************************/
+{
+  Entry const& e = m_entries[id];
+  if (e.exp.get() != NULL)
+    return e.exp->getHash();
+  std::vector<size_t> hashes;
+  for (size_t j=0; j<e.args.size(); ++j)
+    hashes.push_back(m_entries[e.args[j]].exp->getHash());
+  std::sort(hashes.begin(),hashes.end());
+  size_t hash = e.type;
+  for (size_t j=0; j<hashes.size(); ++j)
+    hash = hash*31 + hashes[j];
+  return hash;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::string CSEOptimisation::getString(size_t id) const
+/*****************************************************************************/
+{
+  Entry const& e = m_entries[id];
+  if (e.exp.get() != NULL)
+    return e.exp->toString();
+  std::vector<std::string> args;
+  for (size_t j=0; j<e.args.size(); ++j)
+    args.push_back(m_entries[e.args[j]].exp->toString());
+  std::sort(args.begin(),args.end());
+  std::string res = str(static_cast<int>(e.type));
+  for (size_t j=0; j<args.size(); ++j)
+    res += "," + args[j];
+  return res;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CSEOptimisation::nameTemps()
+/*****************************************************************************/
+{
+  std::vector<std::pair<size_t,size_t> > temps;
+  for (size_t id=0; id<m_entries.size(); ++id)
+    if (is_Eligible(m_entries[id]) && (m_entries[id].count > 1))
+      temps.push_back(std::make_pair(getHash(id),id));
+  std::sort(temps.begin(),temps.end());
+  // gleicher Hash (selten): nach Text
+  for (size_t i=0; i<temps.size(); )
+  {
+    size_t j = i+1;
+    while ((j < temps.size()) && (temps[j].first == temps[i].first))
+      ++j;
+    if (j > i+1)
+    {
+      std::vector<std::pair<std::string,size_t> > byString;
+      for (size_t k=i; k<j; ++k)
+        byString.push_back(std::make_pair(getString(temps[k].second),temps[k].second));
+      std::sort(byString.begin(),byString.end());
+      for (size_t k=i; k<j; ++k)
+        temps[k].second = byString[k-i].second;
+    }
+    i = j;
+  }
+  for (size_t i=0; i<temps.size(); ++i)
+  {
+    Entry &e = m_entries[temps[i].second];
+    e.rank = i;
+    do
+      e.name = "cse_" + str(m_counter++);
+    while (m_eqsys->hasSymbol(e.name));
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr CSEOptimisation::rebuild(BasicPtr const& exp)
+/*****************************************************************************/
+{
+  BasicPtrVec order;
+  exp->getPostOrder(order);
+  for (size_t i=0; i<order.size(); ++i)
+    getRepl(m_ids[order[i]]);
+  return m_entries[m_ids[exp]].repl;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr CSEOptimisation::getRepl(size_t id)
+/*****************************************************************************/
+{
+  if (m_entries[id].repl.get() != NULL)
+    return m_entries[id].repl;
+  Entry const& e = m_entries[id];
+
+  // Blaetter bleiben, wie sie sind
+  if ((e.exp.get() != NULL) && ((e.exp->getArgsSize() == 0) ||
+      ((e.type == Type_Element) && (e.exp->getArg(0)->getType() == Type_Symbol))))
+  {
+    m_entries[id].repl = e.exp;
+    return e.exp;
+  }
+
+  BasicPtrVec args;
+  if (is_Factorable(e))
+  {
+    // groesste enthaltene Teilmenge zuerst herausziehen
+    IdVec remaining = e.args;
+    while (remaining.size() > 1)
+    {
+      size_t best = m_entries.size();
+      for (size_t j=0; j<remaining.size(); ++j)
+      {
+        if ((j > 0) && (remaining[j] == remaining[j-1]))
+          continue;
+        std::map<std::pair<Basic_Type,size_t>,IdVec>::const_iterator c = m_factorsContaining.find(std::make_pair(e.type,remaining[j]));
+        if (c == m_factorsContaining.end())
+          continue;
+        for (size_t k=0; k<c->second.size(); ++k)
+        {
+          size_t f = c->second[k];
+          Entry const& fe = m_entries[f];
+          if ((f == id) || (fe.args.size() > remaining.size()) || !is_SubSet(fe.args,remaining))
+            continue;
+          if (best == m_entries.size())
+            best = f;
+          else
+          {
+            Entry const& be = m_entries[best];
+            if ((fe.args.size() > be.args.size()) ||
+                ((fe.args.size() == be.args.size()) && ((fe.count > be.count) || ((fe.count == be.count) && (fe.rank < be.rank)))))
+              best = f;
+          }
+        }
+      }
+      if (best == m_entries.size())
+        break;
+      IdVec rest;
+      std::set_difference(remaining.begin(),remaining.end(),m_entries[best].args.begin(),m_entries[best].args.end(),std::back_inserter(rest));
+      remaining.swap(rest);
+      args.push_back(getRepl(best));
+    }
+    // restliche Argumente in der urspruenglichen Reihenfolge
+    if (e.exp.get() != NULL)
+    {
+      for (size_t j=0; j<e.exp->getArgsSize(); ++j)
+      {
+        size_t arg = m_ids[e.exp->getArg(j)];
+        IdVec::iterator r = std::lower_bound(remaining.begin(),remaining.end(),arg);
+        if ((r != remaining.end()) && (*r == arg))
+        {
+          remaining.erase(r);
+          args.push_back(getRepl(arg));
+        }
+      }
+    }
+    else
+    {
+      for (size_t j=0; j<remaining.size(); ++j)
+        args.push_back(getRepl(remaining[j]));
+    }
+  }
+  else
+  {
+    // urspruengliche Reihenfolge, e.args ist bei Add/Mul sortiert
+    for (size_t j=0; j<e.exp->getArgsSize(); ++j)
+      args.push_back(getRepl(m_ids[e.exp->getArg(j)]));
+  }
+
+  BasicPtr exp;
+  // alle Argumente in einer Teilmenge
+  if (is_Factorable(e) && (args.size() == 1))
+    exp = args[0];
+  else if (e.exp.get() != NULL)
+    exp = e.exp->newBasic(args);
+  else
+    exp = Factory::newBasic(e.type,args,Shape());
+
+  if (is_Eligible(m_entries[id]) && (m_entries[id].count > 1))
+  {
+    // Hilfsvariable
+    SymbolPtr symbol(new Symbol(m_entries[id].name));
+    m_symbols.push_back(symbol);
+    m_pending.push_back(Assignment(symbol,exp));
+    exp = symbol;
+  }
+  m_entries[id].repl = exp;
+  return exp;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr CSEOptimisation::Inliner::process_Arg(BasicPtr const &p)
+/*****************************************************************************/
+{
+  if (p->getType() != Type_Symbol)
+    return p;
+  BasicPtrHashMap::const_iterator ii = m_defs.find(p);
+  if (ii == m_defs.end())
+    return p;
+  return ii->second;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CSEOptimisation::is_Alias(Assignment const& temp, Assignment const& a, std::set<Basic*> const& temps)
+/*****************************************************************************/
+{
+  // a: y = cse_n bzw. y[i] = cse_n, direkt nach der Definition von cse_n
+  if (a.implizit || (a.lhs.size() != 1) || (a.rhs.size() != 1))
+    return false;
+  BasicPtr const& lhs = a.lhs[0];
+  if (!lhs->is_Scalar() || (temps.find(lhs.get()) != temps.end()))
+    return false;
+  if ((lhs->getType() != Type_Symbol) &&
+      ((lhs->getType() != Type_Element) || (lhs->getArg(0)->getType() != Type_Symbol)))
+    return false;
+  return (temps.find(temp.lhs[0].get()) != temps.end()) && (a.rhs[0].get() == temp.lhs[0].get());
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CSEOptimisation::substitute(Assignment &a, Inliner &inliner, std::set<Basic*> const& symbols)
+/*****************************************************************************/
+{
+  if (symbols.empty())
+    return;
+  for (size_t i=0; i<a.rhs.size(); ++i)
+  {
+    Basic::FreeSymbols const& free = a.rhs[i]->getFreeSymbols();
+    for (size_t j=0; j<free.size(); ++j)
+      if (symbols.find(free[j]) != symbols.end())
+      {
+        a.rhs[i] = a.rhs[i]->iterateExp(inliner);
+        break;
+      }
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CSEOptimisation::setCategories(std::vector<Assignment> &assignments, std::set<Basic*> const& temps,
+  bool skipAliases, std::map<Basic*,Category_Type> &categories)
+/*****************************************************************************/
+{
+  // Hilfsvariable wird ausgegeben, sobald eine ihrer Verwendungen ausgegeben wird
+  // (getEquations(exclude) laesst eine Gleichung weg, wenn category & exclude)
+  for (size_t k=assignments.size(); k-- > 0; )
+  {
+    Basic *lhs = assignments[k].lhs[0].get();
+    if (temps.find(lhs) != temps.end())
+      assignments[k].category = categories[lhs];
+    if (skipAliases && (k > 0) && is_Alias(assignments[k-1],assignments[k],temps))
+      continue;
+    for (size_t i=0; i<assignments[k].rhs.size(); ++i)
+    {
+      Basic::FreeSymbols const& symbols = assignments[k].rhs[i]->getFreeSymbols();
+      for (size_t j=0; j<symbols.size(); ++j)
+      {
+        if (temps.find(symbols[j]) == temps.end())
+          continue;
+        std::map<Basic*,Category_Type>::iterator c = categories.find(symbols[j]);
+        if (c == categories.end())
+          categories[symbols[j]] = assignments[k].category;
+        else
+          c->second &= assignments[k].category;
+      }
+    }
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CSEOptimisation::cleanup(std::vector<Assignment> &assignments, std::set<Basic*> const& temps)
+/*****************************************************************************/
+{
+  // Verwendungen der Hilfsvariablen im fertigen Code (Vielfachheit ueber geteilte Knoten)
+  std::map<Basic*,size_t> uses;
+  for (size_t k=0; k<assignments.size(); ++k)
+  {
+    for (size_t i=0; i<assignments[k].rhs.size(); ++i)
+    {
+      BasicPtrVec order;
+      assignments[k].rhs[i]->getPostOrder(order);
+      std::unordered_map<Basic*,size_t> mult;
+      mult[order.back().get()] = 1;
+      for (size_t j=order.size(); j-- > 0; )
+      {
+        Basic *b = order[j].get();
+        size_t m = mult[b];
+        if (temps.find(b) != temps.end())
+          uses[b] += m;
+        for (size_t l=0; l<b->getArgsSize(); ++l)
+          mult[b->getArg(l).get()] += m;
+      }
+    }
+  }
+
+  // nur einmal verwendete Hilfsvariablen wieder einsetzen
+  Inliner inliner;
+  std::set<Basic*> removed;
+  std::vector<Assignment> res;
+  for (size_t k=0; k<assignments.size(); ++k)
+  {
+    Assignment &a = assignments[k];
+    substitute(a,inliner,removed);
+    Basic *lhs = a.lhs[0].get();
+    if ((temps.find(lhs) != temps.end()) && (uses[lhs] < 2))
+    {
+      inliner.m_defs[a.lhs[0]] = a.rhs[0];
+      removed.insert(lhs);
+      continue;
+    }
+    res.push_back(a);
+  }
+
+  std::map<Basic*,Category_Type> categories;
+  setCategories(res,temps,true,categories);
+
+  // cse_n = exp; y = cse_n  ->  y = exp, weiter mit y statt cse_n
+  // nur, wenn y bei jeder Verwendung von cse_n mit ausgegeben wird
+  Inliner aliases;
+  std::set<Basic*> replaced;
+  std::vector<Assignment> res2;
+  for (size_t k=0; k<res.size(); ++k)
+  {
+    substitute(res[k],aliases,replaced);
+    Basic *lhs = res[k].lhs[0].get();
+    if ((k+1 < res.size()) && is_Alias(res[k],res[k+1],temps) &&
+        ((res[k+1].category & ~categories[lhs]) == 0))
+    {
+      aliases.m_defs[res[k].lhs[0]] = res[k+1].lhs[0];
+      replaced.insert(lhs);
+      removed.insert(lhs);
+      res[k+1].rhs[0] = res[k].rhs[0];
+      continue;
+    }
+    res2.push_back(res[k]);
+  }
+
+  for (size_t k=m_symbols.size(); k-- > 0; )
+  {
+    if (removed.find(m_symbols[k].get()) != removed.end())
+      m_symbols.erase(m_symbols.begin()+k);
+    else if (temps.find(m_symbols[k].get()) != temps.end())
+      m_eqsys->addSymbol(m_symbols[k],NULL,"common subexpression");
+  }
+  categories.clear();
+  setCategories(res2,temps,false,categories);
+  assignments.swap(res2);
+}
+/*****************************************************************************/
@@ -0,0 +1,177 @@
+#include "CostModel.h"
+#include <unordered_map>
+
+using namespace Symbolics;
+using namespace Graph;
+
+/*****************************************************************************/
+OperationCount& OperationCount::operator+= (OperationCount const& rhs)
+/*****************************************************************************/
+{
+  adds += rhs.adds;
+  muls += rhs.muls;
+  divs += rhs.divs;
+  functions += rhs.functions;
+  temps += rhs.temps;
+  return *this;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+OperationCount CostModel::count(BasicPtr const& exp)
+/*****************************************************************************/
+{
+  // Kosten je Knoten, Argumente werden so oft gezaehlt, wie sie vorkommen
+  std::unordered_map<Basic const*,OperationCount> costs;
+  BasicPtrVec order;
+  exp->getPostOrder(order);
+  for (size_t i=0; i<order.size(); ++i)
+  {
+    Basic const* b = order[i].get();
+    OperationCount c = getOwnCost(b);
+    for (size_t j=0; j<b->getArgsSize(); ++j)
+      c += costs[b->getArg(j).get()];
+    costs[b] = c;
+  }
+  return costs[exp.get()];
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+OperationCount CostModel::count(Assignment const& a)
+/*****************************************************************************/
+{
+  OperationCount c;
+  for (size_t i=0; i<a.rhs.size(); ++i)
+    c += count(a.rhs[i]);
+  if (!a.implizit)
+    for (size_t i=0; i<a.lhs.size(); ++i)
+      if (is_Temporary(a.lhs[i]))
+        c.temps++;
+  return c;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+OperationCount CostModel::count(std::vector<Assignment> const& assignments)
+/*****************************************************************************/
+{
+  OperationCount c;
+  for (std::vector<Assignment>::const_iterator ii=assignments.begin(); ii!=assignments.end(); ++ii)
+    c += count(*ii);
+  return c;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CostModel::is_Temporary(BasicPtr const& lhs)
+/*****************************************************************************/
+{
+  Basic const* b = lhs.get();
+  size_t row = 0, col = 0;
+  if (b->getType() == Type_Element)
+  {
+    Element const* e = static_cast<Element const*>(b);
+    row = e->getRow();
+    col = e->getCol();
+    b = e->getArg(0).get();
+  }
+  if (b->getType() != Type_Symbol)
+    return false;
+  Symbol const* s = static_cast<Symbol const*>(b);
+  // Sensoren, Eingaenge, ... haben eine eigene Kategorie
+  if (s->getKind() != VARIABLE)
+    return false;
+  if (s->stateKind() == ALL)
+    return (s->is_State(0,0) & (STATE | DER_STATE)) == 0;
+  return (s->is_State(row,col) & (STATE | DER_STATE)) == 0;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+OperationCount CostModel::getOwnCost(Basic const* exp)
+/*****************************************************************************/
+{
+  OperationCount c;
+  const size_t numEl = exp->getShape().getNumEl();
+  switch (exp->getType())
+  {
+  case Type_Neg:
+    c.adds = numEl;
+    break;
+  case Type_Add:
+    c.adds = (exp->getArgsSize()-1)*numEl;
+    break;
+  case Type_Mul:
+    {
+      // von links nach rechts, Matrix mal Matrix: m*k*n Multiplikationen, m*(k-1)*n Additionen
+      Shape s = exp->getArg(0)->getShape();
+      for (size_t i=1; i<exp->getArgsSize(); ++i)
+      {
+        Shape const& t = exp->getArg(i)->getShape();
+        if ((s.getNrDimensions() == 0) || (t.getNrDimensions() == 0))
+        {
+          s = (s.getNrDimensions() == 0) ? t : s;
+          c.muls += s.getNumEl();
+          continue;
+        }
+        const size_t m = s.getDimension(1);
+        const size_t k = s.getDimension(2);
+        const size_t n = t.getDimension(2);
+        c.muls += m*k*n;
+        c.adds += m*(k-1)*n;
+        s = s*t;
+      }
+    }
+    break;
+  case Type_Outer:
+    c.muls = numEl;
+    break;
+  case Type_Pow:
+    {
+      // ganzzahlige Exponenten durch fortgesetztes Quadrieren, x^5 = (x^2)^2*x,
+      // negative mit einer Division mehr
+      BasicPtr const& e = exp->getArg(1);
+      if (e->getType() == Type_Int)
+      {
+        int v = Util::getAsConstPtr<Int>(e)->getValue();
+        size_t muls = 0;
+        for (size_t bits = (v < 0) ? -(long)v : v; bits > 1; bits >>= 1)
+          muls += (bits & 1) ? 2 : 1;
+        c.muls = muls*numEl;
+        if (v < 0)
+          c.divs = numEl;
+      }
+      else
+        c.functions = numEl;
+    }
+    break;
+  case Type_Sin:
+  case Type_Cos:
+  case Type_Tan:
+  case Type_Asin:
+  case Type_Acos:
+  case Type_Atan:
+  case Type_Atan2:
+  case Type_Abs:
+  case Type_Sign:
+    c.functions = numEl;
+    break;
+  case Type_Solve:
+  case Type_Inverse:
+    {
+      // LR-Zerlegung (n^3/3) und Vorwaerts-/Rueckwaertseinsetzen (n^2 je Spalte)
+      const size_t n = exp->getArg(0)->getShape().getDimension(1);
+      const size_t k = (exp->getType() == Type_Solve) ? exp->getArg(1)->getShape().getDimension(2) : n;
+      c.muls = n*n*n/3 + n*n*k;
+      c.adds = n*n*n/3 + n*n*k;
+      c.divs = n;
+    }
+    break;
+  default:
+    // Symbole, Konstanten, Element, Matrix, Transpose, Vergleiche, ...
+    break;
+  }
+  return c;
+}
+/*****************************************************************************/
@@ -1,5 +1,6 @@
 #include <map>
 #include "Equation.h"
+#include "Arena.h"
 #include "str.h"
 
 using namespace Symbolics;
@@ -13,9 +14,9 @@ m_implizit(implizit),m_category(0),m_numElem(0),m_refCount(0)
 /*****************************************************************************/
 {
   setSolveFor(SolveFor);
-  m_lhs.push_back(Argument(Lhs->simplify()));
+  m_lhs.push_back(Argument(Util::simplify(Lhs)));
   if (Rhs.get() == NULL) throw InternalError("Equation: Value of Rhs is not Valid!");
-  m_rhs.push_back(Argument(Rhs->simplify()));
+  m_rhs.push_back(Argument(Util::simplify(Rhs)));
   m_numElem = Rhs->getShape().getNumEl();
   findSymbols();
 }
@@ -30,11 +31,11 @@ m_implizit(implizit),m_category(0),m_numElem(0),m_refCount(0)
   setSolveFor(SolveFor);
   m_lhs.reserve(Lhs.size());
   for (size_t i=0;i<Lhs.size();++i)
-    m_lhs.push_back(Argument(Lhs[i]->simplify()));
+    m_lhs.push_back(Argument(Util::simplify(Lhs[i])));
   m_rhs.reserve(Rhs.size());
   for (size_t i=0;i<Rhs.size();++i)
   {
-    m_rhs.push_back(Argument(Rhs[i]->simplify()));
+    m_rhs.push_back(Argument(Util::simplify(Rhs[i])));
     m_numElem += Rhs[i]->getShape().getNumEl();
   }
   if (Lhs.size() != Rhs.size())
@@ -123,9 +124,20 @@ void Equation::simplify( )
 /*****************************************************************************/
 {
     for (size_t i=0;i<m_lhs.size();++i)
-        m_lhs[i].setArg(m_lhs[i].getArg()->simplify());
+        m_lhs[i].setArg(Util::simplify(m_lhs[i].getArg()));
     for (size_t i=0;i<m_rhs.size();++i)
-        m_rhs[i].setArg(m_rhs[i].getArg()->simplify());
+        m_rhs[i].setArg(Util::simplify(m_rhs[i].getArg()));
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Equation::intern( )
+/*****************************************************************************/
+{
+    for (size_t i=0;i<m_lhs.size();++i)
+        m_lhs[i].setArg(Arena::internTree(m_lhs[i].getArg()));
+    for (size_t i=0;i<m_rhs.size();++i)
+        m_rhs[i].setArg(Arena::internTree(m_rhs[i].getArg()));
 }
 /*****************************************************************************/
 
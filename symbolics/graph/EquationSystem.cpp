@@ -57,7 +57,7 @@ BasicPtr EquationSystem::addSymbol_Internal( SymbolPtr const& s,
   {
     if (s->getShape() != initalValue->getShape())
       throw ShapeError("Could not use Initvalue " + initalValue->toString() + " for Symbol " + s->toString() + "!");
-    BasicPtr init = BasicPtr(initalValue->simplify());
+    BasicPtr init = BasicPtr(Util::simplify(initalValue));
     InitValueScanner sc;
     init->scanExp(sc);
     if (sc.variable)
@@ -137,7 +137,7 @@ void EquationSystem::addEquation(BasicPtr const& solveFor,
   BasicPtr const& exp, bool implicit)
 /*****************************************************************************/
 {
-  BasicPtr simpleexp = exp->simplify();
+  BasicPtr simpleexp = Util::simplify(exp);
 
   // wenn der(x)=... dann x wird zu State und auch stateder hinzufuegen
   SymbolPtrElemMap symbols;
@@ -183,6 +183,7 @@ void EquationSystem::addEquation(BasicPtr const& solveFor,
   // add
   assignEqnstoSymbols(symbols,eqn);
   m_equations.insert(eqn);
+  m_dirty.insert(eqn);
 }
 /*****************************************************************************/
 
@@ -398,7 +399,7 @@ void EquationSystem::addEquation( BasicPtrVec const& solveFor,
   simpleexp.reserve(exp.size());
   for(size_t j=0;j<exp.size();++j)
   {
-    simpleexp.push_back(exp[j]->simplify());
+    simpleexp.push_back(Util::simplify(exp[j]));
     simpleexp[j]->scanExp(scanner);
   }
   // Symbols of eqn
@@ -414,6 +415,7 @@ void EquationSystem::addEquation( BasicPtrVec const& solveFor,
   EquationPtr eqn = new Equation(symbols,lhs,simpleexp,implicit);
   assignEqnstoSymbols(symbols,eqn);
   m_equations.insert(eqn);
+  m_dirty.insert(eqn);
 }
 /*****************************************************************************/
 
@@ -470,6 +472,9 @@ void EquationSystem::addEquation( EquationPtr eqn)
 
   assignEqnstoSymbols(solveFor,eqn);
   m_equations.insert(eqn);
+  // wieder eingefuegt: im Graphen unveraendert
+  if (m_removed.erase(eqn) == 0)
+    m_dirty.insert(eqn);
 }
 /*****************************************************************************/
 
@@ -482,6 +487,9 @@ void EquationSystem::eraseEquation( EquationPtr eqn)
     throw InternalError("Equation not found! " + eqn->toString());
 
   m_equations.erase(ii);
+  // seit dem letzten Aufbau hinzugefuegt: der Graph kennt sie noch nicht
+  if (m_dirty.erase(eqn) == 0)
+    m_removed.insert(eqn);
 
   SymbolPtrElemMap& solveFor =  eqn->getSolveFor();
   for (SymbolPtrElemMap::iterator ii =solveFor.begin();ii!=solveFor.end();ii++)
@@ -505,13 +513,60 @@ void EquationSystem::eraseEquation( EquationPtr eqn)
 /*****************************************************************************/
 
 
+/*****************************************************************************/
+void EquationSystem::changeEquation( BasicPtr const& solveFor, BasicPtr const& exp, bool implicit)
+/*****************************************************************************/
+{
+  SymbolPtrElemMap symbols;
+  getSymbolOrDer(symbols,solveFor);
+  if (symbols.size() == 0)
+    throw VarUnknownError("changeEquation: " + solveFor->toString() + " is not a variable!");
+
+  // alte Gleichungen suchen, sie duerfen nichts anderes loesen
+  EquationPtrSet old;
+  for (SymbolPtrElemMap::iterator is=symbols.begin();is!=symbols.end();is++)
+  {
+    SymbolEquationMap::iterator ii = m_symbolsequationmap.find(is->first);
+    if (ii == m_symbolsequationmap.end())
+      throw VarUnknownError("changeEquation: " + is->first->getName() + " is not solved by any equation!");
+    if (ii->second.kind == ALL)
+      old.insert(ii->second.eqn);
+    else
+      for (SizeTPairEquationPtrMap::iterator ie=ii->second.elements.begin();ie!=ii->second.elements.end();ie++)
+        if ((is->second.kind == ALL) || (is->second.elements.find(ie->first) != is->second.elements.end()))
+          old.insert(ie->second);
+  }
+  for (EquationPtrSet::iterator ie=old.begin();ie!=old.end();ie++)
+  {
+    SymbolPtrElemMap &esf = (*ie)->getSolveFor();
+    for (SymbolPtrElemMap::iterator e=esf.begin();e!=esf.end();e++)
+      if (symbols.find(e->first) == symbols.end())
+        throw ExpressionSolveForError("changeEquation: " + (*ie)->toString() + " solves also " + e->first->getName() + "!");
+  }
+
+  for (EquationPtrSet::iterator ie=old.begin();ie!=old.end();ie++)
+    eraseEquation(*ie);
+  try
+  {
+    addEquation(solveFor,exp,implicit);
+  }
+  catch (...)
+  {
+    // alten Zustand wiederherstellen
+    for (EquationPtrSet::iterator ie=old.begin();ie!=old.end();ie++)
+      addEquation(*ie);
+    throw;
+  }
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 EquationSystemPtr EquationSystem::makeScalar()
 /*****************************************************************************/
 {
   // neuen Graphen Aufbauen
   EquationSystemPtr eqsys = new EquationSystem();
-  BasicPtrMap symbolreplacemap;
+  BasicPtrHashMap symbolreplacemap;
   // erst alle Variablen uebertragen 
   for (SymbolStartValueMap::iterator ii=m_symbolsvaluemap.begin();ii!=m_symbolsvaluemap.end();++ii)
   {
@@ -649,7 +704,7 @@ BasicPtr EquationSystem::SymbolRepl::process_Arg(BasicPtr const &p)
   {
     if (p->is_Scalar())
       return p;
-    BasicPtrMap::iterator ii = m_symbolmap.find(p);
+    BasicPtrHashMap::iterator ii = m_symbolmap.find(p);
     if (ii != m_symbolmap.end())
       return ii->second;
   }
@@ -742,10 +797,11 @@ SymbolPtrVec EquationSystem::getVariables(Symbol_Kind kind)
 BasicPtr EquationSystem::getinitVal(SymbolPtr const& s)
 /*****************************************************************************/
 {
-  BasicPtr ret = m_symbolsvaluemap[s];
-  if (ret.get() == NULL) 
+  // find statt [], die Writer lesen parallel (Writer::runStages)
+  SymbolStartValueMap::const_iterator ii = m_symbolsvaluemap.find(s);
+  if ((ii == m_symbolsvaluemap.end()) || (ii->second.get() == NULL)) 
     throw InternalError("Symbol \"" + s->getName() + "\" has no initial value!");
-  return ret;
+  return ii->second;
 }
 /*****************************************************************************/
 
@@ -772,7 +828,10 @@ Symbolics::BasicPtr EquationSystem::getEquation(SymbolPtr const& s)
 std::string EquationSystem::getComment(SymbolPtr const& s)
 /*****************************************************************************/
 {
-  return m_symbolscommentmap[s];
+  SymbolCommentMap::const_iterator ii = m_symbolscommentmap.find(s);
+  if (ii == m_symbolscommentmap.end())
+    return "";
+  return ii->second;
 }
 /*****************************************************************************/
 
@@ -820,9 +879,12 @@ EquationPtr EquationSystem::combineEquations(EquationPtrVec equations)
   {
     EquationPtrSet::iterator ii = m_equations.find(equations[i]);
     m_equations.erase(ii);
+    if (m_dirty.erase(equations[i]) == 0)
+      m_removed.insert(equations[i]);
   }
   EquationPtr neweqn(new Equation(solveFor,lhs,rhs,implizit));
   m_equations.insert(neweqn);
+  m_dirty.insert(neweqn);
   return neweqn;
 }
 /*****************************************************************************/
@@ -4,13 +4,16 @@
 #include "UnMatchedSystem.h"
 #include "PreOptimisation.h"
 #include "PastOptimisation.h"
+#include "Snapshot.h"
 
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 
 
 /*****************************************************************************/
-Symbolics::Graph::Graph::Graph() 
+Symbolics::Graph::Graph::Graph():
+m_optimized(false), m_cseCounter(0)
 /*****************************************************************************/
 {
   // open new Scope
@@ -66,6 +69,20 @@ void Symbolics::Graph::Graph::addExpression( BasicPtrVec const& solveFor,
 /*****************************************************************************/
 
 
+/*****************************************************************************/
+void Symbolics::Graph::Graph::changeExpression(BasicPtr const& solveFor,
+  BasicPtr const& exp,
+  bool implicit)
+/*****************************************************************************/
+{
+  // nach der Optimierung sind Gleichungen eingesetzt oder entfernt
+  if (m_optimized)
+    throw InternalError("changeExpression: graph was built with optimization, rebuild the system!");
+  eqsys->changeEquation(solveFor,exp,implicit);
+}
+/*****************************************************************************/
+
+
 /*****************************************************************************/
 Symbolics::SymbolPtr Symbolics::Graph::Graph::getSymbol( std::string const& name)
 /*****************************************************************************/
@@ -82,14 +99,24 @@ void Symbolics::Graph::Graph::makeScalar()
   // neuen Graphen Aufbauen
   eqsys = eqsys->makeScalar();
   m_nodes.clear();
+  m_cseAssignments.clear();
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
 Symbolics::Graph::AssignmentsPtr Symbolics::Graph::Graph::getAssignments(Category_Type inc,
-  Category_Type exclude)
+  Category_Type exclude, bool cse)
 /*****************************************************************************/
 {
+  cse = cse && m_optimized;
+  std::pair<Category_Type,Category_Type> key(inc,exclude);
+  if (cse)
+  {
+    std::map<std::pair<Category_Type,Category_Type>, AssignmentsPtr>::const_iterator ii = m_cseAssignments.find(key);
+    if (ii != m_cseAssignments.end())
+      return AssignmentsPtr(new Assignments(*ii->second));
+  }
+
   // get required nodes
   NodeVec reqnodes;
   NodeCollector v(exclude,reqnodes);
@@ -112,7 +139,22 @@ Symbolics::Graph::AssignmentsPtr Symbolics::Graph::Graph::getAssignments(Categor
   }
 
   // build equations
-  return AssignmentsPtr(new Assignments(reqnodes));
+  AssignmentsPtr a(new Assignments(reqnodes));
+  if (!cse)
+    return a;
+  // die Hilfsvariablen nur einmal anlegen, Kopie damit z.B. schedule() den Speicher nicht aendert
+  a->eliminateCommonSubexpressions(eqsys,m_cseCounter);
+  m_cseAssignments[key] = a;
+  return AssignmentsPtr(new Assignments(*a));
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Symbolics::Graph::StateJacobian Symbolics::Graph::Graph::getStateJacobian(std::vector<Assignment> const& equations,
+  VariableVec const& states)
+/*****************************************************************************/
+{
+  return StateJacobian(eqsys,equations,states);
 }
 /*****************************************************************************/
 
@@ -170,7 +212,7 @@ void Symbolics::Graph::Graph::toGraphML( std::string file )
 /*****************************************************************************/
 
 /*****************************************************************************/
-double Symbolics::Graph::Graph::buildGraph(bool optimize)
+double Symbolics::Graph::Graph::buildGraph(bool optimize, size_t threads)
 /*****************************************************************************/
 {
   double t1 = Util::getTime();
@@ -191,9 +233,12 @@ double Symbolics::Graph::Graph::buildGraph(bool optimize)
   m_syshandler->buildGraph();
   if (optimize)
   {
-    PastOptimisation pastopt(eqsys,m_nodes);
+    PastOptimisation pastopt(eqsys,m_nodes,threads);
     pastopt.optimize();
   }
+  m_optimized = optimize;
+  m_cseAssignments.clear();
+  eqsys->clearDirty();
   //SymbolMap& states = eqsys->getStates();
   //for (SymbolMap::iterator ii = states.begin();ii!=states.end();ii++)
   //{
@@ -251,6 +296,168 @@ double Symbolics::Graph::Graph::buildGraph(bool optimize)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+double Symbolics::Graph::Graph::updateGraph()
+/*****************************************************************************/
+{
+  if (m_syshandler.get() == NULL)
+  {
+    if (!m_nodes.empty())
+      throw InternalError("updateGraph: graph was loaded from a snapshot, rebuild the system!");
+    return buildGraph(false);
+  }
+  if (m_optimized)
+    throw InternalError("updateGraph: graph was built with optimization, use buildGraph!");
+  if (!eqsys->is_Balanced())
+    throw InternalError("updateGraph: only balanced systems could be updated, use buildGraph!");
+  double t = m_syshandler->updateGraph(eqsys->getRemovedEquations(),eqsys->getDirtyEquations());
+  eqsys->clearDirty();
+  return t;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Symbolics::Graph::Graph::saveSnapshot(std::string const& file)
+/*****************************************************************************/
+{
+  if (m_nodes.empty())
+    throw InternalError("saveSnapshot: graph is not built, call buildGraph first!");
+  Snapshot::Info info;
+  info.optimized = m_optimized;
+  info.cseCounter = m_cseCounter;
+  Snapshot::write(file,eqsys,m_nodes,info);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+double Symbolics::Graph::Graph::loadSnapshot(std::string const& file)
+/*****************************************************************************/
+{
+  double t1 = Util::getTime();
+  if (!m_nodes.empty() || (eqsys->getSymbols().size() != 1))
+    throw InternalError("loadSnapshot: graph is not empty!");
+  Snapshot::Info info = Snapshot::read(file,eqsys,m_nodes,Util::getAsPtr<Symbol>(m_time));
+  m_optimized = info.optimized;
+  m_cseCounter = info.cseCounter;
+  eqsys->clearDirty();
+  return Util::getTime()-t1;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+// Mischfunktion (splitmix64), damit auch die Summe ueber vertauschbare Teile streut
+static size_t mixHash(size_t h)
+/*****************************************************************************/
+{
+  uint64_t z = static_cast<uint64_t>(h) + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return static_cast<size_t>(z ^ (z >> 31));
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+// wie Basic::getHash, die Argumente von Add und die skalaren von Mul aber
+// unabhaengig von ihrer Reihenfolge, die simplify nach Adressen sortiert
+static size_t expressionHash(Symbolics::Basic *exp, std::unordered_map<Symbolics::Basic const*,size_t> &done)
+/*****************************************************************************/
+{
+  using namespace Symbolics;
+  if (done.find(exp) != done.end())
+    return done[exp];
+  std::vector<std::pair<Basic*,size_t> > stack;
+  stack.push_back(std::make_pair(exp,0));
+  while (!stack.empty())
+  {
+    Basic *b = stack.back().first;
+    size_t &next = stack.back().second;
+    if (next < b->getArgsSize())
+    {
+      Basic *arg = b->getArg(next++).get();
+      if (done.find(arg) == done.end())
+        stack.push_back(std::make_pair(arg,0));
+      continue;
+    }
+    stack.pop_back();
+    if (done.find(b) != done.end())
+      continue;
+    if (b->getArgsSize() == 0)
+    {
+      done[b] = mixHash(b->getHash());
+      continue;
+    }
+    size_t ordered = mixHash(b->getType());
+    ordered = mixHash(ordered ^ b->getShape().getDimension(1));
+    ordered = mixHash(ordered ^ b->getShape().getDimension(2));
+    size_t unordered = 0;
+    for (size_t i=0;i<b->getArgsSize();++i)
+    {
+      BasicPtr const& arg = b->getArg(i);
+      if ((b->getType() == Type_Add) || ((b->getType() == Type_Mul) && arg->is_Scalar()))
+        unordered += done[arg.get()];
+      else
+        ordered = mixHash(ordered ^ done[arg.get()]);
+    }
+    done[b] = mixHash(ordered + unordered);
+  }
+  return done[exp];
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+size_t Symbolics::Graph::Graph::getHash()
+/*****************************************************************************/
+{
+  if (m_nodes.empty())
+    throw InternalError("getHash: graph is not built, call buildGraph first!");
+
+  std::unordered_map<Basic const*,size_t> done;
+  size_t hash = mixHash(m_optimized ? 1 : 0);
+
+  // Symbole nach Namen geordnet, mit Art, Shape, Startwert und Kommentar; Variablen
+  // ohne Knoten sind die Hilfsvariablen, die jedes getAssignments neu anlegt
+  EquationSystem::StringSymbolMap &symbols = eqsys->getSymbols();
+  for (EquationSystem::StringSymbolMap::iterator ii=symbols.begin();ii!=symbols.end();++ii)
+  {
+    if ((ii->second->getKind() == VARIABLE) && (ii->second->getUserData(ID_UD_NODE) == NULL))
+      continue;
+    hash = mixHash(hash ^ ii->second->getHash());
+    hash = mixHash(hash ^ ii->second->getKind());
+    hash = mixHash(hash ^ ii->second->getShape().getDimension(1));
+    hash = mixHash(hash ^ ii->second->getShape().getDimension(2));
+    BasicPtr init = eqsys->getinitVal(ii->second);
+    if (init.get() != NULL)
+      hash = mixHash(hash ^ expressionHash(init.get(),done));
+    std::string comment = eqsys->getComment(ii->second);
+    hash = mixHash(hash ^ std::hash<std::string>()(comment));
+  }
+
+  // Gleichungen der Knoten, deren Reihenfolge folgt aus den Abhaengigkeiten
+  size_t equations = 0;
+  for (size_t i=0;i<m_nodes.size();++i)
+  {
+    NodePtr const& n = m_nodes[i];
+    size_t h = mixHash(n->get_Category());
+    h = mixHash(h ^ (n->is_Implicit() ? 1 : 0));
+    for (size_t k=0;k<n->getLhsSize();++k)
+      h = mixHash(h ^ expressionHash(n->getLhs(k).get(),done));
+    for (size_t k=0;k<n->getRhsSize();++k)
+      h = mixHash(h ^ expressionHash(n->getRhs(k).get(),done));
+    size_t solveFor = 0;
+    SymbolPtrElemMap &sf = n->getSolveFor();
+    for (SymbolPtrElemMap::iterator ii=sf.begin();ii!=sf.end();++ii)
+    {
+      size_t hs = mixHash(ii->first->getHash() ^ ii->second.kind);
+      for (SizeTPairSet::iterator ie=ii->second.elements.begin();ie!=ii->second.elements.end();++ie)
+        hs = mixHash(hs ^ mixHash(ie->first ^ (ie->second << 16)));
+      solveFor += hs;
+    }
+    equations += mixHash(h + solveFor);
+  }
+  return mixHash(hash + equations);
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 Symbolics::Graph::Graph::NodeCollector::NodeCollector(Category_Type exclude,
   NodeVec& reqnodes):
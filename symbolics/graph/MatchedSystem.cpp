@@ -44,6 +44,50 @@ double MatchedSystem::buildGraph()
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+double MatchedSystem::updateGraph(EquationPtrSet const& removed, EquationPtrSet const& added)
+/*****************************************************************************/
+{
+  double t1 = Util::getTime();
+
+  // alte Knoten loesen, ihre Kinder bekommen neue Eltern
+  NodePtrSet childs;
+  std::vector<size_t> slots;
+  for (size_t i=0;i<m_nodes.size();++i)
+  {
+    if (removed.find(m_nodes[i]->getEqn()) == removed.end())
+      continue;
+    NodePtrSet &c = m_nodes[i]->getChilds();
+    childs.insert(c.begin(),c.end());
+    m_nodes[i]->release();
+    slots.push_back(i);
+  }
+
+  // neue Knoten an die frei gewordenen Plaetze
+  NodeVec nodes;
+  for (EquationPtrSet::const_iterator i = added.begin();i != added.end(); i++)
+  {
+    NodePtr node = new Node(*i,m_time);
+    nodes.push_back(node);
+    if (nodes.size() <= slots.size())
+      m_nodes[slots[nodes.size()-1]] = node;
+    else
+      m_nodes.push_back(node);
+  }
+  for (size_t i=slots.size();i>nodes.size();--i)
+    m_nodes.erase(m_nodes.begin()+slots[i-1]);
+
+  for (size_t i=0;i<nodes.size();++i)
+    nodes[i]->findParentsNodes();
+  for (NodePtrSet::iterator ii=childs.begin();ii!=childs.end();++ii)
+  {
+    if (removed.find((*ii)->getEqn()) == removed.end())
+      (*ii)->findParentsNodes();
+  }
+  return Util::getTime()-t1;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 void MatchedSystem::toGraphML( std::string file )
 /*****************************************************************************/
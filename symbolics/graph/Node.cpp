@@ -277,6 +277,38 @@ void Node::clear()
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void Node::release()
+/*****************************************************************************/
+{
+  for (NodePtrSet::iterator ii=m_parents.begin();ii!=m_parents.end();++ii)
+    (*ii)->removeChild(NodePtr(this));
+  for (SymbolPtrElemMap::iterator ii=m_eqn->getSolveFor().begin();ii!=m_eqn->getSolveFor().end();++ii)
+  {
+    SymbolNodeElement *elem = static_cast<SymbolNodeElement*>(ii->first->getUserData(ID_UD_NODE));
+    if (elem == NULL)
+      continue;
+    // andere Elemente koennen von anderen Knoten geloest werden
+    if (elem->kind != ALL)
+    {
+      for (SizeTPairSet::iterator ie = ii->second.elements.begin();ie!=ii->second.elements.end();ie++)
+      {
+        SizeTPairNodePtrMap::iterator ik = elem->elements.find(SizeTPair(ie->first,ie->second));
+        if ((ik != elem->elements.end()) && (ik->second.get() == this))
+          elem->elements.erase(ik);
+      }
+      if (elem->elements.size() > 0)
+        continue;
+    }
+    delete elem;
+    ii->first->setUserData(NULL,ID_UD_NODE);
+  }
+  m_parentssymbols.clear();
+  m_parents.clear();
+  m_childs.clear();
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 void Node::subs(ConstBasicPtr const& old_exp, BasicPtr const& new_exp)
 /*****************************************************************************/
@@ -1,14 +1,22 @@
 #include "PastOptimisation.h"
+#include "Arena.h"
 #include "str.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
 
 using namespace Symbolics;
 using namespace Graph;
 
 /*****************************************************************************/
-PastOptimisation::PastOptimisation(EquationSystemPtr eqsys, NodeVec &nodes): 
-m_eqsys(eqsys),m_nodes(nodes)
+PastOptimisation::PastOptimisation(EquationSystemPtr eqsys, NodeVec &nodes, size_t threads): 
+m_eqsys(eqsys),m_nodes(nodes),m_threads(threads)
 /*****************************************************************************/
 {
   m_time = m_eqsys->getSymbol("time");
@@ -28,9 +36,16 @@ void PastOptimisation::optimize()
 {
   NodeOptimizer v(m_time);
 
-  for (size_t i=0;i<m_nodes.size();++i)
+  if (m_threads > 1)
+  {
+    optimizeLevels(v);
+  }
+  else
   {
-    Node::node_iterate_depth_first(m_nodes[i],v);
+    for (size_t i=0;i<m_nodes.size();++i)
+    {
+      Node::node_iterate_depth_first(m_nodes[i],v);
+    }
   }
   // reset visited
   for (size_t i=0;i<m_nodes.size();++i)
@@ -47,6 +62,224 @@ void PastOptimisation::optimize()
 /*****************************************************************************/
 
 
+/*****************************************************************************/
+void PastOptimisation::getLevels(std::map<Node*,size_t> &levels, NodeVec &order)
+/*****************************************************************************/
+{
+  // wie Node::node_iterate_depth_first: Eltern vor ihren Kindern
+  struct Frame
+  {
+    NodePtr node;
+    NodeVec parents;
+    size_t next;
+  };
+  std::set<Node*> entered;
+  std::vector<Frame> stack;
+  for (size_t i=0;i<m_nodes.size();++i)
+  {
+    if (!entered.insert(m_nodes[i].get()).second)
+      continue;
+    stack.push_back(Frame());
+    stack.back().node = m_nodes[i];
+    stack.back().next = 0;
+    stack.back().parents.assign(m_nodes[i]->getParents().begin(),m_nodes[i]->getParents().end());
+    while (!stack.empty())
+    {
+      if (stack.back().next < stack.back().parents.size())
+      {
+        NodePtr p = stack.back().parents[stack.back().next++];
+        if (entered.insert(p.get()).second)
+        {
+          stack.push_back(Frame());
+          stack.back().node = p;
+          stack.back().next = 0;
+          stack.back().parents.assign(p->getParents().begin(),p->getParents().end());
+        }
+        continue;
+      }
+      Frame &f = stack.back();
+      size_t level = 0;
+      for (size_t j=0;j<f.parents.size();++j)
+      {
+        std::map<Node*,size_t>::iterator ii = levels.find(f.parents[j].get());
+        if (ii != levels.end())
+          level = std::max(level, ii->second+1);
+      }
+      levels[f.node.get()] = level;
+      order.push_back(f.node);
+      stack.pop_back();
+    }
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void PastOptimisation::optimizeLevels(NodeOptimizer &v)
+/*****************************************************************************/
+{
+  // Ebenen einmal vorab, Eltern liegen immer auf einer kleineren Ebene;
+  // innerhalb einer Ebene gilt die Reihenfolge der seriellen Optimierung
+  std::map<Node*,size_t> levels;
+  NodeVec order;
+  getLevels(levels,order);
+  std::vector<NodeVec> nodesOfLevel;
+  for (size_t i=0;i<order.size();++i)
+  {
+    size_t level = levels[order[i].get()];
+    if (level >= nodesOfLevel.size())
+      nodesOfLevel.resize(level+1);
+    nodesOfLevel[level].push_back(order[i]);
+  }
+
+  for (size_t l=0;l<nodesOfLevel.size();++l)
+  {
+    NodeVec &nodes = nodesOfLevel[l];
+    // alle Eltern sind bearbeitet, es wird nichts mehr in diese Ebene eingesetzt
+    NodeVec subsed;
+    for (size_t i=0;i<nodes.size();++i)
+    {
+      if (nodes[i]->m_subsed)
+        subsed.push_back(nodes[i]);
+    }
+    if (subsed.size() > 1)
+    {
+      simplifyParallel(subsed);
+      for (size_t i=0;i<subsed.size();++i)
+      {
+        // ohne Arena vereinfacht, gleiche Teilausdruecke wieder zusammenfuehren
+        subsed[i]->getEqn()->intern();
+        subsed[i]->findParentsNodes();
+        // process_Node vereinfacht nur noch, falls erneut eingesetzt wird
+        subsed[i]->m_subsed = false;
+      }
+    }
+    for (size_t i=0;i<nodes.size();++i)
+    {
+      if (nodes[i]->visited)
+        continue;
+      nodes[i]->visited = true;
+      v.process_Node(nodes[i]);
+    }
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+// Union-Find ueber die Gleichungen
+static size_t findGroup(std::vector<size_t> &group, size_t i)
+/*****************************************************************************/
+{
+  while (group[i] != i)
+  {
+    group[i] = group[group[i]];
+    i = group[i];
+  }
+  return i;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void PastOptimisation::simplifyParallel(NodeVec &nodes)
+/*****************************************************************************/
+{
+  // Gleichungen, die sich einen Knoten teilen (auch ueber dessen Eltern, da
+  // simplify die Eltern per changed() markiert), werden in einer Gruppe
+  // nacheinander vereinfacht. Blaetter (Symbole, Konstanten) werden geteilt,
+  // deren Elternlisten sind gesperrt.
+  std::vector<size_t> group(nodes.size());
+  for (size_t i=0;i<group.size();++i)
+    group[i] = i;
+  std::unordered_map<Basic*,size_t> owner;
+  std::vector<Basic*> stack;
+  BasicPtrVec postorder;
+  for (size_t i=0;i<nodes.size();++i)
+  {
+    // Hash und freie Symbole werden bei Bedarf berechnet; auch geteilte Blaetter
+    // muessen fertig sein, bevor die Threads lesen
+    postorder.clear();
+    for (size_t j=0;j<nodes[i]->getLhsSize();++j)
+      nodes[i]->getLhs(j)->getPostOrder(postorder);
+    for (size_t j=0;j<nodes[i]->getRhsSize();++j)
+      nodes[i]->getRhs(j)->getPostOrder(postorder);
+    for (size_t j=0;j<postorder.size();++j)
+    {
+      postorder[j]->getHash();
+      postorder[j]->getFreeSymbols();
+    }
+
+    for (size_t j=0;j<nodes[i]->getLhsSize();++j)
+      stack.push_back(nodes[i]->getLhs(j).get());
+    for (size_t j=0;j<nodes[i]->getRhsSize();++j)
+      stack.push_back(nodes[i]->getRhs(j).get());
+    while (!stack.empty())
+    {
+      Basic *b = stack.back();
+      stack.pop_back();
+      if (b->getArgsSize() == 0)
+        continue;
+      std::unordered_map<Basic*,size_t>::iterator ii = owner.find(b);
+      if (ii != owner.end())
+      {
+        group[findGroup(group,ii->second)] = findGroup(group,i);
+        continue;
+      }
+      owner[b] = i;
+      for (size_t j=0;j<b->getArgsSize();++j)
+        stack.push_back(b->getArg(j).get());
+      for (ArgumentPtr a=b->getFirstParent();a!=NULL;a=a->getNextParent())
+      {
+        if (a->getParent().get() != NULL)
+          stack.push_back(a->getParent().get());
+      }
+    }
+  }
+  std::map<size_t,NodeVec> groupmap;
+  for (size_t i=0;i<nodes.size();++i)
+    groupmap[findGroup(group,i)].push_back(nodes[i]);
+  std::vector<NodeVec> groups;
+  groups.reserve(groupmap.size());
+  for (std::map<size_t,NodeVec>::iterator ii=groupmap.begin();ii!=groupmap.end();++ii)
+    groups.push_back(ii->second);
+  // grosse Gruppen zuerst, die kleinen fuellen am Ende auf
+  std::stable_sort(groups.begin(),groups.end(),[](NodeVec const& a, NodeVec const& b) { return a.size() > b.size(); });
+
+  // jeder Thread holt sich die naechste freie Gruppe
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex errormutex;
+  auto worker = [&]()
+  {
+    for (size_t g=next.fetch_add(1); g<groups.size(); g=next.fetch_add(1))
+    {
+      try
+      {
+        for (size_t i=0;i<groups[g].size();++i)
+          groups[g][i]->getEqn()->simplify();
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errormutex);
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  };
+
+  {
+    ParallelSection section;
+    std::vector<std::thread> threads;
+    size_t num = std::min(m_threads,groups.size());
+    for (size_t t=1;t<num;++t)
+      threads.push_back(std::thread(worker));
+    worker();
+    for (size_t t=0;t<threads.size();++t)
+      threads[t].join();
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 PastOptimisation::NodeOptimizer::NodeOptimizer(BasicPtr const& T):
 time(T),removed(0),start(0)
@@ -97,7 +330,8 @@ void PastOptimisation::NodeOptimizer::process_Node(NodePtr p)
             return;
           }
         }
-        Basic::BasicSet atoms = exp->getAtoms();
+        // am Knoten gemerkt, kein Durchlaufen des Ausdrucks
+        Basic::FreeSymbols const& atoms = exp->getFreeSymbols();
         //double t2 = Graph::Util::getTime() - t1;
         //removed = removed>t2?removed:t2;
         // constant 
@@ -106,10 +340,13 @@ void PastOptimisation::NodeOptimizer::process_Node(NodePtr p)
           subs_Node(p,symbol,exp);
           return;
         }
-        else if(atoms.size() == 1)
+        else if (time.get() != NULL)
         {
-          Basic::BasicSet::iterator t = atoms.find(time);
-          if (t != atoms.end())
+          // only time
+          bool onlytime = true;
+          for (size_t i=0; onlytime && (i<atoms.size()); ++i)
+            onlytime = (*atoms[i] == *time);
+          if (onlytime)
           {
             subs_Node(p,symbol,exp);
             return;
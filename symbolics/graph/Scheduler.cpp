@@ -0,0 +1,310 @@
+#include "Scheduler.h"
+#include "Element.h"
+#include <algorithm>
+#include <set>
+
+using namespace Symbolics;
+using namespace Graph;
+
+const Scheduler::Index Scheduler::whole(std::string::npos, std::string::npos);
+
+/*****************************************************************************/
+Scheduler::Scheduler(std::vector<Assignment> &assignments):
+m_assignments(assignments)
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Scheduler::~Scheduler()
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Scheduler::schedule()
+/*****************************************************************************/
+{
+  size_t n = m_assignments.size();
+  if (n < 3)
+    return;
+  for (size_t i=0; i<n; ++i)
+    if (m_assignments[i].implizit)
+      return;
+
+  buildDependencies();
+  std::vector<size_t> order = getOrder();
+  std::vector<size_t> original(n);
+  for (size_t i=0; i<n; ++i)
+    original[i] = i;
+  // bei gleichem Hoechstwert gewinnt die Lokalitaet
+  if (getMaxLive(order) > getMaxLive(original))
+    return;
+
+  std::vector<Assignment> res;
+  res.reserve(n);
+  for (size_t i=0; i<n; ++i)
+    res.push_back(m_assignments[order[i]]);
+  m_assignments.swap(res);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+size_t Scheduler::getMaxLive(std::vector<Assignment> const& assignments)
+/*****************************************************************************/
+{
+  std::vector<Assignment> copy(assignments);
+  Scheduler s(copy);
+  s.buildDependencies();
+  std::vector<size_t> order(copy.size());
+  for (size_t i=0; i<order.size(); ++i)
+    order[i] = i;
+  return s.getMaxLive(order);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Scheduler::buildDependencies()
+/*****************************************************************************/
+{
+  size_t n = m_assignments.size();
+  m_access.clear();
+  m_pred.assign(n, std::vector<size_t>());
+  m_values.assign(n, std::vector<size_t>());
+  m_readers.assign(n, std::vector<size_t>());
+
+  for (size_t j=0; j<n; ++j)
+  {
+    Assignment const& a = m_assignments[j];
+    bool elements = true;
+    for (size_t i=0; i<a.rhs.size(); ++i)
+    {
+      addAccess(a.rhs[i], j, false, true);
+      if (a.rhs[i]->getType() == Type_Solve)
+        elements = false;
+    }
+    for (size_t i=0; i<a.lhs.size(); ++i)
+      addAccess(a.lhs[i], j, true, elements);
+
+    std::sort(m_pred[j].begin(), m_pred[j].end());
+    m_pred[j].erase(std::unique(m_pred[j].begin(), m_pred[j].end()), m_pred[j].end());
+    std::sort(m_values[j].begin(), m_values[j].end());
+    m_values[j].erase(std::unique(m_values[j].begin(), m_values[j].end()), m_values[j].end());
+    for (size_t k=0; k<m_values[j].size(); ++k)
+      m_readers[m_values[j][k]].push_back(j);
+  }
+  m_access.clear();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Scheduler::addAccess(BasicPtr const& exp, size_t j, bool write, bool elements)
+/*****************************************************************************/
+{
+  std::vector<Basic*> stack(1, exp.get());
+  std::set<Basic*> done;
+  while (!stack.empty())
+  {
+    Basic *b = stack.back();
+    stack.pop_back();
+    if (!done.insert(b).second)
+      continue;
+
+    bool der = false;
+    if (b->getType() == Type_Der)
+    {
+      der = true;
+      b = b->getArg(0).get();
+    }
+    Var v(NULL, der);
+    Index e = whole;
+    if (b->getType() == Type_Symbol)
+      v.first = b;
+    else if ((b->getType() == Type_Element) && (b->getArg(0)->getType() == Type_Symbol))
+    {
+      v.first = b->getArg(0).get();
+      if (elements)
+      {
+        Element const* el = static_cast<Element const*>(b);
+        e = Index(el->getRow(), el->getCol());
+      }
+    }
+    if (v.first != NULL)
+    {
+      if (write)
+        addWrite(v, e, j);
+      else
+        addRead(v, e, j);
+      continue;
+    }
+    for (size_t i=0; i<b->getArgsSize(); ++i)
+      stack.push_back(b->getArg(i).get());
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Scheduler::addRead(Var const& v, Index const& e, size_t j)
+/*****************************************************************************/
+{
+  std::map<Index,Access> &acc = m_access[v];
+  if (e == whole)
+  {
+    for (std::map<Index,Access>::const_iterator it=acc.begin(); it!=acc.end(); ++it)
+      addEdge(it->second.write, j, true);
+  }
+  else
+  {
+    std::map<Index,Access>::const_iterator it = acc.find(e);
+    if (it != acc.end())
+      addEdge(it->second.write, j, true);
+    it = acc.find(whole);
+    if (it != acc.end())
+      addEdge(it->second.write, j, true);
+  }
+  acc[e].reads.push_back(j);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Scheduler::addWrite(Var const& v, Index const& e, size_t j)
+/*****************************************************************************/
+{
+  std::map<Index,Access> &acc = m_access[v];
+  for (std::map<Index,Access>::const_iterator it=acc.begin(); it!=acc.end(); ++it)
+  {
+    if ((e != whole) && (it->first != e) && (it->first != whole))
+      continue;
+    addEdge(it->second.write, j, false);
+    for (size_t k=0; k<it->second.reads.size(); ++k)
+      addEdge(it->second.reads[k], j, false);
+  }
+  // die ganze Variable ueberschreibt alle Elemente
+  if (e == whole)
+    acc.clear();
+  acc[e].write = j;
+  acc[e].reads.clear();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Scheduler::addEdge(size_t i, size_t j, bool value)
+/*****************************************************************************/
+{
+  if ((i == std::string::npos) || (i == j))
+    return;
+  m_pred[j].push_back(i);
+  if (value)
+    m_values[j].push_back(i);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::vector<size_t> Scheduler::getOrder()
+/*****************************************************************************/
+{
+  size_t n = m_assignments.size();
+  const size_t none = std::string::npos;
+  std::vector<std::vector<size_t> > succ(n);
+  std::vector<size_t> npred(n), remaining(n), pos(n, none), recent(n, 0);
+  std::vector<long> score(n, 0);
+  for (size_t j=0; j<n; ++j)
+  {
+    npred[j] = m_pred[j].size();
+    for (size_t k=0; k<m_pred[j].size(); ++k)
+      succ[m_pred[j][k]].push_back(j);
+    remaining[j] = m_readers[j].size();
+  }
+
+  // kleinster Schluessel zuerst: hoechste Bewertung, juengste Argumente, bisherige Reihenfolge
+  typedef std::pair<std::pair<long,long>,size_t> Key;
+  std::set<Key> ready;
+  std::vector<bool> is_ready(n, false);
+  for (size_t j=0; j<n; ++j)
+    if (npred[j] == 0)
+    {
+      // ohne Vorgaenger liest sie keine berechneten Werte
+      score[j] = m_readers[j].empty() ? 0 : -1;
+      ready.insert(Key(std::make_pair(-score[j], 0L), j));
+      is_ready[j] = true;
+    }
+
+  std::vector<size_t> order;
+  order.reserve(n);
+  while (!ready.empty())
+  {
+    size_t j = ready.begin()->second;
+    ready.erase(ready.begin());
+    is_ready[j] = false;
+    pos[j] = order.size();
+    order.push_back(j);
+
+    // liest der letzte verbliebene Leser, gibt er den Wert frei
+    for (size_t k=0; k<m_values[j].size(); ++k)
+    {
+      size_t v = m_values[j][k];
+      if (--remaining[v] != 1)
+        continue;
+      for (size_t r=0; r<m_readers[v].size(); ++r)
+      {
+        size_t reader = m_readers[v][r];
+        if (pos[reader] != none)
+          continue;
+        if (is_ready[reader])
+        {
+          ready.erase(Key(std::make_pair(-score[reader], -(long)recent[reader]), reader));
+          score[reader]++;
+          ready.insert(Key(std::make_pair(-score[reader], -(long)recent[reader]), reader));
+        }
+        break;
+      }
+    }
+
+    for (size_t k=0; k<succ[j].size(); ++k)
+    {
+      size_t s = succ[j][k];
+      if (--npred[s] != 0)
+        continue;
+      long freed = 0;
+      for (size_t i=0; i<m_values[s].size(); ++i)
+      {
+        size_t v = m_values[s][i];
+        if (remaining[v] == 1)
+          freed++;
+        recent[s] = std::max(recent[s], pos[v]+1);
+      }
+      score[s] = freed - (m_readers[s].empty() ? 0 : 1);
+      ready.insert(Key(std::make_pair(-score[s], -(long)recent[s]), s));
+      is_ready[s] = true;
+    }
+  }
+  if (order.size() != n)
+    throw InternalError("Scheduler: cyclic dependencies between assignments");
+  return order;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+size_t Scheduler::getMaxLive(std::vector<size_t> const& order) const
+/*****************************************************************************/
+{
+  std::vector<size_t> remaining(m_readers.size());
+  for (size_t i=0; i<m_readers.size(); ++i)
+    remaining[i] = m_readers[i].size();
+  // Argumente und Ergebnis einer Zuweisung leben gleichzeitig
+  size_t live = 0, maxLive = 0;
+  for (size_t k=0; k<order.size(); ++k)
+  {
+    size_t j = order[k];
+    if (!m_readers[j].empty())
+      live++;
+    maxLive = std::max(maxLive, live);
+    for (size_t i=0; i<m_values[j].size(); ++i)
+      if (--remaining[m_values[j][i]] == 0)
+        live--;
+  }
+  return maxLive;
+}
+/*****************************************************************************/
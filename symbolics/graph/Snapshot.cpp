@@ -0,0 +1,679 @@
+#include "Snapshot.h"
+#include "Factory.h"
+#include "Arena.h"
+#include "str.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <unordered_map>
+
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+using namespace Symbolics;
+using namespace Graph;
+
+namespace
+{
+/*****************************************************************************/
+  // Dateiformat, alle Tabellen beginnen auf 8 Byte
+  const char SNAPSHOT_MAGIC[8] = {'P','Y','M','B','S','G','R','F'};
+  const uint32_t SNAPSHOT_VERSION = 1;
+  const uint32_t NONE = 0xffffffff;
+
+  // Kopf: flags
+  const uint32_t SNAPSHOT_OPTIMIZED = 0x01;
+  // Ausdruck: flags
+  const uint32_t EXPRESSION_SYMMETRIC = 0x01;
+
+  struct Table
+  {
+    uint64_t offset;
+    uint64_t count;
+  };
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t cseCounter;
+    Table strings;        // char
+    Table stringOffsets;  // uint64_t, Anzahl Strings + 1
+    Table expressions;    // ExpressionRecord, Argumente vor ihren Eltern
+    Table symbols;        // SymbolRecord, Zustand vor seiner Ableitung
+    Table equations;      // EquationRecord
+    Table nodes;          // uint32_t, Gleichung je Knoten
+    Table indices;        // uint32_t, Argumente, Zustandsmarkierungen, Gleichungen
+  };
+
+  struct ExpressionRecord
+  {
+    uint64_t payload;     // Symbol: Symbolindex, Int, Real (Bits), Bool, Unknown: Name
+    uint64_t firstArg;
+    uint32_t type;
+    uint32_t nargs;
+    uint32_t ndims;
+    uint32_t dim1;
+    uint32_t dim2;
+    uint32_t flags;
+  };
+
+  struct SymbolRecord
+  {
+    uint64_t firstFlag;   // getNumEl() Zustandsmarkierungen
+    uint32_t name;
+    uint32_t comment;
+    uint32_t kind;
+    uint32_t statekind;
+    uint32_t ndims;
+    uint32_t dim1;
+    uint32_t dim2;
+    uint32_t init;        // Startwert, NONE wenn nicht im Gleichungssystem
+    uint32_t state;       // Ableitung von, sonst NONE
+    uint32_t registered;  // im Gleichungssystem eingetragen
+  };
+
+  // Indizes ab first: lhs[nlhs], rhs[nlhs], je solveFor-Symbol: Symbol, kind, n, n*(dim1,dim2)
+  struct EquationRecord
+  {
+    uint64_t first;
+    uint32_t nlhs;
+    uint32_t nsolveFor;
+    uint32_t implicit;
+    uint32_t system;      // im Gleichungssystem, sonst nur Knoten
+  };
+
+/*****************************************************************************/
+  // Tabellen beim Schreiben
+  class Tables
+  {
+  public:
+    uint32_t addString(std::string const& s);
+    uint32_t addSymbol(Symbol const* s);
+    uint32_t addExpression(BasicPtr const& exp);
+
+    std::vector<char> strings;
+    std::vector<uint64_t> stringOffsets;
+    std::vector<ExpressionRecord> expressions;
+    std::vector<SymbolRecord> symbols;
+    std::vector<EquationRecord> equations;
+    std::vector<uint32_t> nodes;
+    std::vector<uint32_t> indices;
+
+  protected:
+    void addRecord(Basic const* b);
+
+    std::unordered_map<std::string,uint32_t> m_strings;
+    std::unordered_map<Basic const*,uint32_t> m_symbols;
+    std::unordered_map<Basic const*,uint32_t> m_expressions;
+  };
+
+/*****************************************************************************/
+  // Datei read-only einblenden
+  class MappedFile
+  {
+  public:
+    MappedFile(std::string const& file);
+    ~MappedFile();
+
+    char const* data;
+    size_t size;
+
+    // Tabelle pruefen und als Feld liefern
+    template<class T> T const* get(Table const& t) const
+    {
+      if ((t.offset % 8 != 0) || (t.offset > size) || (t.count > (size - t.offset) / sizeof(T)))
+        throw InternalError("Snapshot: table out of range!");
+      return reinterpret_cast<T const*>(data + t.offset);
+    };
+
+  private:
+    void close();
+
+#ifdef _WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#else
+    int m_fd;
+#endif
+  };
+/*****************************************************************************/
+};
+
+/*****************************************************************************/
+uint32_t Tables::addString(std::string const& s)
+/*****************************************************************************/
+{
+  std::unordered_map<std::string,uint32_t>::iterator ii = m_strings.find(s);
+  if (ii != m_strings.end())
+    return ii->second;
+  if (stringOffsets.empty())
+    stringOffsets.push_back(0);
+  uint32_t id = stringOffsets.size()-1;
+  strings.insert(strings.end(),s.begin(),s.end());
+  stringOffsets.push_back(strings.size());
+  m_strings[s] = id;
+  return id;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+uint32_t Tables::addSymbol(Symbol const* s)
+/*****************************************************************************/
+{
+  std::unordered_map<Basic const*,uint32_t>::iterator ii = m_symbols.find(s);
+  if (ii != m_symbols.end())
+    return ii->second;
+
+  // der Zustand muss beim Laden vor seiner Ableitung da sein
+  uint32_t state = NONE;
+  Symbol const* st = static_cast<Symbol const*>(s->getUserData(ID_UD_STATE));
+  if (st != NULL)
+    state = addSymbol(st);
+
+  SymbolRecord r;
+  r.name = addString(s->getName());
+  r.comment = NONE;
+  r.kind = s->getKind();
+  r.statekind = s->stateKind();
+  r.ndims = s->getShape().getNrDimensions();
+  r.dim1 = s->getShape().getDimension(1);
+  r.dim2 = s->getShape().getDimension(2);
+  r.init = NONE;
+  r.state = state;
+  r.registered = 0;
+  r.firstFlag = indices.size();
+  const size_t cols = s->getShape().getDimension(2);
+  for (size_t k=0;k<s->getShape().getNumEl();++k)
+    indices.push_back(s->is_State(k / cols, k % cols));
+
+  uint32_t id = symbols.size();
+  symbols.push_back(r);
+  m_symbols[s] = id;
+  return id;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+uint32_t Tables::addExpression(BasicPtr const& exp)
+/*****************************************************************************/
+{
+  // post-order ueber alle Wurzeln, gemeinsame Teilausdruecke nur einmal
+  if (m_expressions.find(exp.get()) == m_expressions.end())
+  {
+    std::vector<std::pair<Basic*,size_t> > stack;
+    stack.push_back(std::make_pair(exp.get(),0));
+    while (!stack.empty())
+    {
+      Basic *b = stack.back().first;
+      size_t &next = stack.back().second;
+      if (next < b->getArgsSize())
+      {
+        Basic *arg = b->getArg(next++).get();
+        if (m_expressions.find(arg) == m_expressions.end())
+          stack.push_back(std::make_pair(arg,0));
+        continue;
+      }
+      addRecord(b);
+      stack.pop_back();
+    }
+  }
+  return m_expressions[exp.get()];
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Tables::addRecord(Basic const* b)
+/*****************************************************************************/
+{
+  ExpressionRecord r;
+  r.payload = 0;
+  r.type = b->getType();
+  r.ndims = b->getShape().getNrDimensions();
+  r.dim1 = b->getShape().getDimension(1);
+  r.dim2 = b->getShape().getDimension(2);
+  r.flags = 0;
+  r.nargs = b->getArgsSize();
+  r.firstArg = indices.size();
+  for (size_t i=0;i<b->getArgsSize();++i)
+    indices.push_back(m_expressions[b->getArg(i).get()]);
+
+  switch (b->getType())
+  {
+  case Type_Symbol:
+    r.payload = addSymbol(static_cast<Symbol const*>(b));
+    break;
+  case Type_Int:
+    r.payload = static_cast<uint64_t>(static_cast<int64_t>(static_cast<Int const*>(b)->getValue()));
+    break;
+  case Type_Real:
+    {
+      double v = static_cast<Real const*>(b)->getValue();
+      memcpy(&r.payload,&v,sizeof(double));
+    }
+    break;
+  case Type_Bool:
+    r.payload = static_cast<Bool const*>(b)->getValue() ? 1 : 0;
+    break;
+  case Type_Unknown:
+    r.payload = addString(static_cast<Unknown const*>(b)->getName());
+    break;
+  case Type_Matrix:
+    if (dynamic_cast<SymmetricMatrix const*>(b) != NULL)
+      r.flags |= EXPRESSION_SYMMETRIC;
+    break;
+  default:
+    break;
+  }
+
+  m_expressions[b] = expressions.size();
+  expressions.push_back(r);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+MappedFile::MappedFile(std::string const& file): data(NULL), size(0)
+/*****************************************************************************/
+{
+#ifdef _WIN32
+  m_mapping = NULL;
+  m_file = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (m_file == INVALID_HANDLE_VALUE)
+    throw InternalError("Snapshot: could not open " + file + "!");
+  LARGE_INTEGER s;
+  GetFileSizeEx(m_file, &s);
+  size = static_cast<size_t>(s.QuadPart);
+  if (size > 0)
+  {
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping != NULL)
+      data = static_cast<char const*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  }
+#else
+  m_fd = open(file.c_str(), O_RDONLY);
+  if (m_fd < 0)
+    throw InternalError("Snapshot: could not open " + file + "!");
+  struct stat st;
+  if (fstat(m_fd, &st) == 0)
+    size = st.st_size;
+  if (size > 0)
+  {
+    void *p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (p != MAP_FAILED)
+      data = static_cast<char const*>(p);
+  }
+#endif
+  if (data == NULL)
+  {
+    close();
+    throw InternalError("Snapshot: could not map " + file + "!");
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+MappedFile::~MappedFile()
+/*****************************************************************************/
+{
+  close();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void MappedFile::close()
+/*****************************************************************************/
+{
+#ifdef _WIN32
+  if (data != NULL)
+    UnmapViewOfFile(data);
+  if (m_mapping != NULL)
+    CloseHandle(m_mapping);
+  if (m_file != INVALID_HANDLE_VALUE)
+    CloseHandle(m_file);
+  m_mapping = NULL;
+  m_file = INVALID_HANDLE_VALUE;
+#else
+  if (data != NULL)
+    munmap(const_cast<char*>(data), size);
+  if (m_fd >= 0)
+    ::close(m_fd);
+  m_fd = -1;
+#endif
+  data = NULL;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+static void writeTable(FILE *f, Table &t, void const* data, size_t count, size_t size)
+/*****************************************************************************/
+{
+  // auf 8 Byte auffuellen
+  static const char zeros[8] = {0};
+  long pos = ftell(f);
+  if (pos % 8 != 0)
+  {
+    fwrite(zeros, 1, 8 - pos % 8, f);
+    pos += 8 - pos % 8;
+  }
+  t.offset = pos;
+  t.count = count;
+  if (count > 0)
+    fwrite(data, size, count, f);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Snapshot::write(std::string const& file, EquationSystemPtr eqsys, NodeVec const& nodes, Info const& info)
+/*****************************************************************************/
+{
+  Tables t;
+  t.addString("");
+
+  // Symbole des Gleichungssystems mit Startwert und Kommentar
+  EquationSystem::StringSymbolMap &symbols = eqsys->getSymbols();
+  for (EquationSystem::StringSymbolMap::iterator ii=symbols.begin();ii!=symbols.end();++ii)
+    t.symbols[t.addSymbol(ii->second.get())].registered = 1;
+  for (EquationSystem::StringSymbolMap::iterator ii=symbols.begin();ii!=symbols.end();++ii)
+  {
+    uint32_t init = t.addExpression(eqsys->getinitVal(ii->second));
+    uint32_t comment = t.addString(eqsys->getComment(ii->second));
+    SymbolRecord &r = t.symbols[t.addSymbol(ii->second.get())];
+    r.init = init;
+    r.comment = comment;
+  }
+
+  // Gleichungen des Systems, dann die der Knoten, die dort nicht (mehr) stehen
+  EquationPtrVec equations;
+  std::unordered_map<Equation const*,uint32_t> ids;
+  EquationPtrSet eqns = eqsys->getEquations();
+  for (EquationPtrSet::iterator ii=eqns.begin();ii!=eqns.end();++ii)
+  {
+    ids[ii->get()] = equations.size();
+    equations.push_back(*ii);
+  }
+  for (size_t i=0;i<nodes.size();++i)
+  {
+    EquationPtr e = nodes[i]->getEqn();
+    if (ids.find(e.get()) != ids.end())
+      continue;
+    ids[e.get()] = equations.size();
+    equations.push_back(e);
+  }
+  for (size_t i=0;i<equations.size();++i)
+  {
+    Equation *e = equations[i].get();
+    std::vector<uint32_t> lhs, rhs;
+    for (size_t k=0;k<e->getLhsSize();++k)
+      lhs.push_back(t.addExpression(e->getLhs(k)));
+    for (size_t k=0;k<e->getRhsSize();++k)
+      rhs.push_back(t.addExpression(e->getRhs(k)));
+    if (lhs.size() != rhs.size())
+      throw InternalError("Snapshot: number of Lhs not equal to number of Rhs in Equation " + e->toString());
+    std::vector<uint32_t> solveFor;
+    SymbolPtrElemMap &sf = e->getSolveFor();
+    for (SymbolPtrElemMap::iterator ii=sf.begin();ii!=sf.end();++ii)
+    {
+      solveFor.push_back(t.addSymbol(ii->first.get()));
+      solveFor.push_back(ii->second.kind);
+      solveFor.push_back(ii->second.elements.size());
+      for (SizeTPairSet::iterator ie=ii->second.elements.begin();ie!=ii->second.elements.end();++ie)
+      {
+        solveFor.push_back(ie->first);
+        solveFor.push_back(ie->second);
+      }
+    }
+
+    EquationRecord r;
+    r.first = t.indices.size();
+    r.nlhs = lhs.size();
+    r.nsolveFor = sf.size();
+    r.implicit = e->is_Implicit() ? 1 : 0;
+    r.system = (eqns.find(equations[i]) != eqns.end()) ? 1 : 0;
+    t.indices.insert(t.indices.end(),lhs.begin(),lhs.end());
+    t.indices.insert(t.indices.end(),rhs.begin(),rhs.end());
+    t.indices.insert(t.indices.end(),solveFor.begin(),solveFor.end());
+    t.equations.push_back(r);
+  }
+  for (size_t i=0;i<nodes.size();++i)
+    t.nodes.push_back(ids[nodes[i]->getEqn().get()]);
+
+  FILE *f = fopen(file.c_str(), "wb");
+  if (f == NULL)
+    throw InternalError("Snapshot: could not open " + file + " for writing!");
+  Header h;
+  memset(&h, 0, sizeof(Header));
+  memcpy(h.magic, SNAPSHOT_MAGIC, 8);
+  h.version = SNAPSHOT_VERSION;
+  h.flags = info.optimized ? SNAPSHOT_OPTIMIZED : 0;
+  h.cseCounter = info.cseCounter;
+  // Kopf zum Schluss mit den Positionen
+  fwrite(&h, sizeof(Header), 1, f);
+  writeTable(f, h.strings, t.strings.data(), t.strings.size(), sizeof(char));
+  writeTable(f, h.stringOffsets, t.stringOffsets.data(), t.stringOffsets.size(), sizeof(uint64_t));
+  writeTable(f, h.expressions, t.expressions.data(), t.expressions.size(), sizeof(ExpressionRecord));
+  writeTable(f, h.symbols, t.symbols.data(), t.symbols.size(), sizeof(SymbolRecord));
+  writeTable(f, h.equations, t.equations.data(), t.equations.size(), sizeof(EquationRecord));
+  writeTable(f, h.nodes, t.nodes.data(), t.nodes.size(), sizeof(uint32_t));
+  writeTable(f, h.indices, t.indices.data(), t.indices.size(), sizeof(uint32_t));
+  fseek(f, 0, SEEK_SET);
+  fwrite(&h, sizeof(Header), 1, f);
+  bool ok = (ferror(f) == 0);
+  ok &= (fclose(f) == 0);
+  if (!ok)
+    throw InternalError("Snapshot: error while writing " + file + "!");
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Snapshot::Info Snapshot::read(std::string const& file, EquationSystemPtr eqsys, NodeVec &nodes, SymbolPtr const& time)
+/*****************************************************************************/
+{
+  MappedFile m(file);
+  if (m.size < sizeof(Header))
+    throw InternalError("Snapshot: " + file + " is too short!");
+  Header const* h = reinterpret_cast<Header const*>(m.data);
+  if (memcmp(h->magic, SNAPSHOT_MAGIC, 8) != 0)
+    throw InternalError("Snapshot: " + file + " is not a graph snapshot!");
+  if (h->version != SNAPSHOT_VERSION)
+    throw InternalError("Snapshot: " + file + " has version " + str(static_cast<size_t>(h->version)) + ", expected " + str(static_cast<size_t>(SNAPSHOT_VERSION)) + "!");
+
+  char const* strings = m.get<char>(h->strings);
+  uint64_t const* stringOffsets = m.get<uint64_t>(h->stringOffsets);
+  ExpressionRecord const* expressions = m.get<ExpressionRecord>(h->expressions);
+  SymbolRecord const* symbolRecords = m.get<SymbolRecord>(h->symbols);
+  EquationRecord const* equationRecords = m.get<EquationRecord>(h->equations);
+  uint32_t const* nodeRecords = m.get<uint32_t>(h->nodes);
+  uint32_t const* indices = m.get<uint32_t>(h->indices);
+  const uint64_t nstrings = (h->stringOffsets.count > 0) ? h->stringOffsets.count-1 : 0;
+  for (uint64_t i=0;i<nstrings;++i)
+    if ((stringOffsets[i] > stringOffsets[i+1]) || (stringOffsets[i+1] > h->strings.count))
+      throw InternalError("Snapshot: string table is corrupt!");
+  // Bereich in der Indextabelle
+  const uint64_t nindices = h->indices.count;
+  struct Check
+  {
+    static void range(uint64_t first, uint64_t n, uint64_t count)
+    {
+      if ((first > count) || (n > count - first))
+        throw InternalError("Snapshot: index table out of range!");
+    };
+  };
+  // Namen werden beim Anlegen der Symbole kopiert, sonst bleibt alles in der Datei
+  struct String
+  {
+    char const* strings;
+    uint64_t const* offsets;
+    uint64_t count;
+    std::string operator()(uint64_t id) const
+    {
+      if (id >= count)
+        return std::string();
+      return std::string(strings + offsets[id], offsets[id+1] - offsets[id]);
+    };
+  } getString = { strings, stringOffsets, nstrings };
+
+  // Symbole, Ableitungen ueber ihren Zustand
+  SymbolPtrVec symbols(h->symbols.count);
+  for (uint64_t i=0;i<h->symbols.count;++i)
+  {
+    SymbolRecord const& r = symbolRecords[i];
+    std::string name = getString(r.name);
+    if (r.registered && (name == time->getName()))
+    {
+      symbols[i] = time;
+      continue;
+    }
+    Shape shape(r.ndims, r.dim1, r.dim2);
+    Check::range(r.firstFlag, shape.getNumEl(), nindices);
+    if (r.state == NONE)
+      symbols[i] = new Symbol(name, shape, r.kind);
+    else
+    {
+      if (r.state >= i)
+        throw InternalError("Snapshot: derivative " + name + " is stored before its state!");
+      symbols[i] = symbols[r.state]->getDerivative();
+      if ((symbols[i]->getName() != name) || (symbols[i]->getShape() != shape))
+        throw InternalError("Snapshot: derivative " + name + " does not match its state!");
+    }
+    std::vector<size_t> flags(indices + r.firstFlag, indices + r.firstFlag + shape.getNumEl());
+    symbols[i]->setStateFlags(static_cast<SymbolElementKind>(r.statekind), flags);
+  }
+
+  // Ausdruecke, die Argumente stehen immer vor ihren Eltern
+  BasicPtrVec exps(h->expressions.count);
+  BasicPtrVec args;
+  for (uint64_t i=0;i<h->expressions.count;++i)
+  {
+    ExpressionRecord const& r = expressions[i];
+    Check::range(r.firstArg, r.nargs, nindices);
+    args.clear();
+    for (uint32_t k=0;k<r.nargs;++k)
+    {
+      uint32_t a = indices[r.firstArg+k];
+      if (a >= i)
+        throw InternalError("Snapshot: argument of expression " + str(i) + " is stored after it!");
+      args.push_back(exps[a]);
+    }
+    Shape shape(r.ndims, r.dim1, r.dim2);
+    switch (r.type)
+    {
+    case Type_Symbol:
+      if (r.payload >= symbols.size())
+        throw InternalError("Snapshot: unknown symbol " + str(r.payload) + "!");
+      exps[i] = symbols[r.payload];
+      break;
+    case Type_Int:
+      // nicht Int::New, Element braucht Int auch fuer 0
+      exps[i] = Arena::intern(new Int(static_cast<int>(static_cast<int64_t>(r.payload))));
+      break;
+    case Type_Real:
+      {
+        double v;
+        memcpy(&v,&r.payload,sizeof(double));
+        exps[i] = Real::New(v);
+      }
+      break;
+    case Type_Bool:
+      exps[i] = Bool::New(r.payload != 0);
+      break;
+    case Type_Zero:
+      exps[i] = (r.ndims == 0) ? Zero::getZero() : BasicPtr(new Zero(shape));
+      break;
+    case Type_Eye:
+      exps[i] = (r.ndims == 0) ? Eye::getEye() : BasicPtr(new Eye(shape));
+      break;
+    case Type_Matrix:
+      if (r.flags & EXPRESSION_SYMMETRIC)
+        exps[i] = BasicPtr(new SymmetricMatrix(args, shape));
+      else
+        exps[i] = BasicPtr(new Matrix(args, shape));
+      break;
+    case Type_Unknown:
+      exps[i] = Unknown::New(getString(r.payload), args);
+      break;
+    default:
+      exps[i] = Factory::newBasic(static_cast<Basic_Type>(r.type), args, shape);
+      break;
+    }
+  }
+  struct Expression
+  {
+    BasicPtrVec const& exps;
+    BasicPtr const& operator()(uint32_t id) const
+    {
+      if (id >= exps.size())
+        throw InternalError("Snapshot: unknown expression " + str(static_cast<size_t>(id)) + "!");
+      return exps[id];
+    };
+  } getExpression = { exps };
+
+  // im Gleichungssystem eintragen
+  for (uint64_t i=0;i<h->symbols.count;++i)
+  {
+    SymbolRecord const& r = symbolRecords[i];
+    if (!r.registered || (symbols[i] == time))
+      continue;
+    BasicPtr init = getExpression(r.init);
+    eqsys->addSymbol(symbols[i], init.get(), getString(r.comment));
+  }
+
+  EquationPtrVec equations;
+  for (uint64_t i=0;i<h->equations.count;++i)
+  {
+    EquationRecord const& r = equationRecords[i];
+    Check::range(r.first, 2*static_cast<uint64_t>(r.nlhs), nindices);
+    BasicPtrVec lhs, rhs;
+    for (uint32_t k=0;k<r.nlhs;++k)
+    {
+      lhs.push_back(getExpression(indices[r.first+k]));
+      rhs.push_back(getExpression(indices[r.first+r.nlhs+k]));
+    }
+    SymbolPtrElemMap solveFor;
+    uint64_t pos = r.first + 2*static_cast<uint64_t>(r.nlhs);
+    for (uint32_t k=0;k<r.nsolveFor;++k)
+    {
+      Check::range(pos, 3, nindices);
+      uint32_t s = indices[pos];
+      uint32_t kind = indices[pos+1];
+      uint32_t n = indices[pos+2];
+      pos += 3;
+      Check::range(pos, 2*static_cast<uint64_t>(n), nindices);
+      if (s >= symbols.size())
+        throw InternalError("Snapshot: unknown symbol " + str(static_cast<size_t>(s)) + "!");
+      SymbolElement elem;
+      elem.kind = static_cast<SymbolElementKind>(kind);
+      for (uint32_t l=0;l<n;++l)
+        elem.elements.insert(SizeTPair(indices[pos+2*l],indices[pos+2*l+1]));
+      pos += 2*static_cast<uint64_t>(n);
+      solveFor[symbols[s]] = elem;
+    }
+    EquationPtr eqn(new Equation(solveFor, lhs, rhs, r.implicit != 0));
+    if (r.system)
+      eqsys->addEquation(eqn);
+    equations.push_back(eqn);
+  }
+
+  // Knoten in der gespeicherten Reihenfolge
+  for (uint64_t i=0;i<h->nodes.count;++i)
+  {
+    if (nodeRecords[i] >= equations.size())
+      throw InternalError("Snapshot: unknown equation " + str(static_cast<size_t>(nodeRecords[i])) + "!");
+    nodes.push_back(NodePtr(new Node(equations[nodeRecords[i]], time)));
+  }
+  for (size_t i=0;i<nodes.size();++i)
+    nodes[i]->findParentsNodes();
+
+  Info info;
+  info.optimized = (h->flags & SNAPSHOT_OPTIMIZED) != 0;
+  info.cseCounter = h->cseCounter;
+  return info;
+}
+/*****************************************************************************/
@@ -0,0 +1,304 @@
+#include "StateJacobian.h"
+#include "str.h"
+
+using namespace Symbolics;
+using namespace Graph;
+
+/*****************************************************************************/
+StateJacobian::StateJacobian(EquationSystemPtr eqsys, std::vector<Assignment> const& equations, VariableVec const& states):
+m_eqsys(eqsys), m_dim(0), m_counter(0)
+/*****************************************************************************/
+{
+  // Zustaende: d(y[k])/d(y[k]) = 1
+  BasicPtrVec derivatives;
+  for (size_t i=0; i<states.size(); ++i)
+  {
+    const size_t n = states[i]->getShape().getNumEl();
+    for (size_t j=0; j<n; ++j)
+    {
+      BasicPtr e = getElement(states[i],j);
+      m_rows[e][m_dim] = Int::getOne();
+      derivatives.push_back(Der::New(e));
+      m_dim++;
+    }
+  }
+
+  for (std::vector<Assignment>::const_iterator ii=equations.begin(); ii!=equations.end(); ++ii)
+  {
+    if (ii->implizit)
+      throw InternalError("StateJacobian: implicit equations are not supported!");
+    for (size_t i=0; i<ii->lhs.size(); ++i)
+    {
+      BasicPtr const& lhs = ii->lhs[i];
+      BasicPtr const& rhs = ii->rhs[i];
+      if (rhs->getType() == Type_Solve)
+        addSolve(lhs, rhs);
+      else if (lhs->is_Scalar())
+        addScalar(lhs, rhs);
+      else
+        for (size_t k=0; k<lhs->getShape().getNumEl(); ++k)
+          addScalar(getElement(lhs,k), Util::simplify(getElement(rhs,k)));
+    }
+  }
+
+  // d(yd)/d(y)
+  m_entries.assign(m_dim*m_dim, BasicPtr());
+  for (size_t r=0; r<m_dim; ++r)
+  {
+    RowMap::const_iterator ii = m_rows.find(derivatives[r]);
+    if (ii == m_rows.end())
+      continue;
+    for (Row::const_iterator jj=ii->second.begin(); jj!=ii->second.end(); ++jj)
+      m_entries[r*m_dim + jj->first] = jj->second;
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+StateJacobian::~StateJacobian()
+/*****************************************************************************/
+{
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+SparseJacobian StateJacobian::getSparse() const
+/*****************************************************************************/
+{
+  SparseJacobian sparse;
+  sparse.shape = Shape(m_dim,m_dim);
+  sparse.colptr.push_back(0);
+  for (size_t c=0; c<m_dim; ++c)
+  {
+    for (size_t r=0; r<m_dim; ++r)
+    {
+      if (m_entries[r*m_dim+c].get() == NULL)
+        continue;
+      sparse.rowind.push_back(r);
+      sparse.values.push_back(m_entries[r*m_dim+c]);
+    }
+    sparse.colptr.push_back(sparse.rowind.size());
+  }
+  return sparse;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr StateJacobian::getElement(BasicPtr const& exp, size_t k)
+/*****************************************************************************/
+{
+  if (exp->is_Scalar())
+    return exp;
+  // der(q)[k] steht in den Gleichungen als der(q[k])
+  if (exp->getType() == Type_Der)
+    return Der::New(getElement(exp->getArg(0),k));
+  const size_t cols = exp->getShape().getDimension(2);
+  return Element::New(exp, k / cols, k % cols);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+StateJacobian::Row StateJacobian::getRow(BasicPtr const& exp)
+/*****************************************************************************/
+{
+  Row row;
+
+  // Variablen und Elemente, die selbst von den Zustaenden abhaengen
+  BasicPtrVec atoms;
+  BasicPtrHashMap subs;
+  BasicPtrVec order;
+  exp->getPostOrder(order);
+  for (size_t i=0; i<order.size(); ++i)
+  {
+    BasicPtr const& b = order[i];
+    if (b->getType() != Type_Symbol)
+      continue;
+    if (b->is_Scalar())
+    {
+      if (m_rows.find(b) == m_rows.end())
+        continue;
+      atoms.push_back(b);
+      subs[b] = getPlaceholder(b);
+      continue;
+    }
+    // ganze Variable: Matrix aus Platzhaltern, damit auch Matrixoperationen abgeleitet werden
+    const size_t n = b->getShape().getNumEl();
+    BasicPtrVec values;
+    bool found = false;
+    for (size_t k=0; k<n; ++k)
+    {
+      BasicPtr e = getElement(b,k);
+      if (m_rows.find(e) == m_rows.end())
+      {
+        values.push_back(e);
+        continue;
+      }
+      atoms.push_back(e);
+      values.push_back(getPlaceholder(e));
+      found = true;
+    }
+    if (found)
+      subs[b] = BasicPtr(new Matrix(values,b->getShape()));
+  }
+  if (atoms.empty())
+    return row;
+
+  Replacer toPlaceholders(subs);
+  BasicPtr e = Util::simplify(exp->iterateExp(toPlaceholders));
+  Replacer toAtoms(m_atoms);
+  std::map<size_t,BasicPtrVec> sums;
+  for (size_t i=0; i<atoms.size(); ++i)
+  {
+    BasicPtr d = Util::simplify(e->der(m_placeholders[atoms[i]]));
+    if (Util::is_Zero(d))
+      continue;
+    d = Util::simplify(d->iterateExp(toAtoms));
+    Row const& r = m_rows[atoms[i]];
+    for (Row::const_iterator jj=r.begin(); jj!=r.end(); ++jj)
+      sums[jj->first].push_back(Mul::New(d,jj->second));
+  }
+  for (std::map<size_t,BasicPtrVec>::iterator ii=sums.begin(); ii!=sums.end(); ++ii)
+  {
+    BasicPtr d = Util::simplify((ii->second.size() == 1) ? ii->second[0] : BasicPtr(new Add(ii->second)));
+    if (!Util::is_Zero(d))
+      row[ii->first] = d;
+  }
+  return row;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void StateJacobian::addScalar(BasicPtr const& lhs, BasicPtr const& exp)
+/*****************************************************************************/
+{
+  Row row = getRow(exp);
+  // Variable wird neu belegt
+  if (row.empty())
+  {
+    m_rows.erase(lhs);
+    return;
+  }
+  for (Row::iterator ii=row.begin(); ii!=row.end(); ++ii)
+    ii->second = getTemp(ii->second);
+  m_rows[lhs] = row;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void StateJacobian::addSolve(BasicPtr const& lhs, BasicPtr const& solve)
+/*****************************************************************************/
+{
+  // x = solve(A,b): dx = solve(A, db - dA*x)
+  BasicPtr const& A = solve->getArg(0);
+  BasicPtr const& b = solve->getArg(1);
+  if (!b->is_Vector())
+    throw InternalError("StateJacobian: Solve is only supported with a vector as right hand side!");
+  const size_t m = b->getShape().getNumEl();
+
+  std::map<size_t,BasicPtrVec> sums;
+  for (size_t k=0; k<m; ++k)
+  {
+    Row r = getRow(getElement(b,k));
+    for (Row::const_iterator jj=r.begin(); jj!=r.end(); ++jj)
+      sums[jj->first].resize(m);
+    for (Row::const_iterator jj=r.begin(); jj!=r.end(); ++jj)
+      sums[jj->first][k] = jj->second;
+    for (size_t l=0; l<m; ++l)
+    {
+      BasicPtr x = getElement(lhs,l);
+      Row a = getRow(Util::simplify(getElement(A,k*m+l)));
+      for (Row::const_iterator jj=a.begin(); jj!=a.end(); ++jj)
+      {
+        BasicPtrVec &s = sums[jj->first];
+        s.resize(m);
+        BasicPtr t = Neg::New(Mul::New(jj->second,x));
+        s[k] = (s[k].get() == NULL) ? t : Add::New(s[k],t);
+      }
+    }
+  }
+
+  for (size_t l=0; l<m; ++l)
+    m_rows.erase(getElement(lhs,l));
+  // eine Loesung je Spalte, wie die urspruengliche Gleichung
+  for (std::map<size_t,BasicPtrVec>::iterator ii=sums.begin(); ii!=sums.end(); ++ii)
+  {
+    BasicPtrVec &s = ii->second;
+    for (size_t k=0; k<m; ++k)
+      s[k] = (s[k].get() == NULL) ? Int::getZero() : Util::simplify(s[k]);
+    SymbolPtr t = newSymbol(b->getShape());
+    BasicPtrVec elements;
+    for (size_t k=0; k<m; ++k)
+      elements.push_back(getElement(t,k));
+    BasicPtr x(new Matrix(elements,b->getShape()));
+    m_equations.push_back(Assignment(x, Solve::New(A,BasicPtr(new Matrix(s,b->getShape())))));
+    for (size_t k=0; k<m; ++k)
+      m_rows[getElement(lhs,k)][ii->first] = elements[k];
+  }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr StateJacobian::getTemp(BasicPtr const& exp)
+/*****************************************************************************/
+{
+  BasicPtr e = exp;
+  if (e->getType() == Type_Neg)
+    e = e->getArg(0);
+  switch (e->getType())
+  {
+  case Type_Symbol:
+  case Type_Element:
+  case Type_Int:
+  case Type_Real:
+    return exp;
+  default:
+    break;
+  }
+  SymbolPtr t = newSymbol(Shape());
+  m_equations.push_back(Assignment(t, exp));
+  return t;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+SymbolPtr StateJacobian::newSymbol(Shape const& shape)
+/*****************************************************************************/
+{
+  std::string name;
+  do
+    name = "jac_" + str(m_counter++);
+  while (m_eqsys->hasSymbol(name));
+  SymbolPtr t(new Symbol(name, shape));
+  m_eqsys->addSymbol(t, NULL, "jacobian");
+  m_variables.push_back(t);
+  return t;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr StateJacobian::getPlaceholder(BasicPtr const& atom)
+/*****************************************************************************/
+{
+  BasicPtrHashMap::const_iterator ii = m_placeholders.find(atom);
+  if (ii != m_placeholders.end())
+    return ii->second;
+  // Name kann nicht mit Variablen des Modells kollidieren
+  BasicPtr p(new Symbol("$jac" + str(m_placeholders.size())));
+  m_placeholders[atom] = p;
+  m_atoms[p] = atom;
+  return p;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+BasicPtr StateJacobian::Replacer::process_Arg(BasicPtr const &p)
+/*****************************************************************************/
+{
+  if (p->getType() != Type_Symbol)
+    return p;
+  BasicPtrHashMap::const_iterator ii = m_map.find(p);
+  if (ii == m_map.end())
+    return p;
+  return ii->second;
+}
+/*****************************************************************************/
@@ -2,6 +2,7 @@
 #include "str.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 using namespace Symbolics;
 using namespace Graph;
@@ -12,6 +13,7 @@ SystemHandler(eqsys,nodes)
 /*****************************************************************************/
 {
   m_time = m_eqsys->getSymbol("time");
+  m_rowStart.push_back(0);
 
   // Incidence Matrix
   EquationSystem::StringSymbolMap symbolmap = m_eqsys->getSymbols();
@@ -57,10 +59,10 @@ SystemHandler(eqsys,nodes)
           MEquation* eq = new MEquation(e,0,0);
           eq->lhs = lhs->simplify();
           eq->rhs = rhs->simplify();
-          SymbolScanner scan(eq,m_time,m_incidencematrixT);
+          SymbolScanner scan(eq,m_time);
           eq->lhs->scanExp(scan);
           eq->rhs->scanExp(scan);
-          m_equations.push_back(eq);
+          addEquation(eq);
           meqns.push_back(eq);
         }
         else
@@ -73,10 +75,10 @@ SystemHandler(eqsys,nodes)
               MEquation* eq = new MEquation(e,k,l);
               eq->lhs = Element::New(lhs,k,l)->simplify();
               eq->rhs = Element::New(rhs,k,l)->simplify();
-              SymbolScanner scan(eq,m_time,m_incidencematrixT);
+              SymbolScanner scan(eq,m_time);
               eq->lhs->scanExp(scan);
               eq->rhs->scanExp(scan);
-              m_equations.push_back(eq);
+              addEquation(eq);
               meqns.push_back(eq);
             }
         }
@@ -95,9 +97,9 @@ UnMatchedSystem::~UnMatchedSystem()
   {
     delete m_equations[i];
   }
-  for(IncidenceMatrixT::iterator ii=m_incidencematrixT.begin();ii!=m_incidencematrixT.end();++ii)
+  for (size_t i=0;i<m_symbols.size();i++)
   {
-    delete ii->first;
+    delete m_symbols[i];
   }
 }
 /*****************************************************************************/
@@ -135,11 +137,7 @@ bool UnMatchedSystem::SymbolScanner::process_Arg(BasicPtr const &p, bool &stop)
         MSymbol *symbol = static_cast<MSymbol*>(s->getUserData(ID_UD_SYMBOL));
         if (symbol == NULL)
           throw InternalError("Symbol " + s->getName() + " without MSymbol");
-        m_incidencematrixT[symbol].push_back(m_equation);
-        if (symbol->state)
-          m_equation->states.insert(symbol);
-        else
-          m_equation->symbols.insert(symbol);
+        m_equation->scanned.push_back(symbol->id);
       }
       else
       {
@@ -148,11 +146,7 @@ bool UnMatchedSystem::SymbolScanner::process_Arg(BasicPtr const &p, bool &stop)
           throw InternalError("Symbol " + s->getName() + " without MSymbols");
         for(size_t u=0;u<syms->size();u++)
         {
-          m_incidencematrixT[(*syms)[u]].push_back(m_equation);
-          if ((*syms)[u]->state)
-            m_equation->states.insert((*syms)[u]);
-          else
-            m_equation->symbols.insert((*syms)[u]);
+          m_equation->scanned.push_back((*syms)[u]->id);
         }
       }
     }
@@ -179,11 +173,7 @@ bool UnMatchedSystem::SymbolScanner::process_Arg(BasicPtr const &p, bool &stop)
           MSymbol *symbol = static_cast<MSymbol*>(s->getUserData(ID_UD_SYMBOL));
           if (symbol == NULL)
             throw InternalError("Symbol " + s->getName() + " without MSymbol");
-          m_incidencematrixT[symbol].push_back(m_equation);
-          if (symbol->state)
-            m_equation->states.insert(symbol);
-          else
-            m_equation->symbols.insert(symbol);
+          m_equation->scanned.push_back(symbol->id);
         }
         else
         {
@@ -196,11 +186,7 @@ bool UnMatchedSystem::SymbolScanner::process_Arg(BasicPtr const &p, bool &stop)
             throw InternalError("Symbol " + s->getName() + " without MSymbols");
           size_t sdim2 = s->getShape().getDimension(2);
           size_t u = sdim2*dim1 + dim2;
-          m_incidencematrixT[(*syms)[u]].push_back(m_equation);
-          if ((*syms)[u]->state)
-            m_equation->states.insert((*syms)[u]);
-          else
-            m_equation->symbols.insert((*syms)[u]);
+          m_equation->scanned.push_back((*syms)[u]->id);
         }
       }
       return false;
@@ -218,7 +204,7 @@ BasicPtr UnMatchedSystem::SymbolRepl::process_Arg(BasicPtr const &p)
 {
   if (p->getType() == Type_Symbol)
   {
-    BasicPtrMap::iterator ii = m_symbolmap.find(p);
+    BasicPtrHashMap::iterator ii = m_symbolmap.find(p);
     if (ii != m_symbolmap.end())
       return ii->second;
   }
@@ -243,7 +229,7 @@ void UnMatchedSystem::addSymbolToIncidenceMatrix(SymbolPtr s)
         parameter = true;
     if (s->is_Scalar())
     {
-      MSymbol *symbol = new MSymbol(s,0,0);
+      MSymbol *symbol = newMSymbol(s,0,0);
       s->setUserData(static_cast<void*>(symbol),ID_UD_SYMBOL);
       if (state)
         m_states.insert(symbol);
@@ -251,7 +237,6 @@ void UnMatchedSystem::addSymbolToIncidenceMatrix(SymbolPtr s)
         m_parameter.insert(symbol);
       symbol->state = state;
       symbol->parameter = parameter;
-      m_incidencematrixT[symbol] = MEquationPtrVec();
     }
     else
     {
@@ -261,7 +246,7 @@ void UnMatchedSystem::addSymbolToIncidenceMatrix(SymbolPtr s)
       for (size_t i=0;i<dim1;i++)
         for (size_t j=0;j<dim2;j++)
         {
-          MSymbol *symbol = new MSymbol(s,i,j);
+          MSymbol *symbol = newMSymbol(s,i,j);
           if (s->is_State(i,j) & STATE)
           {
             m_states.insert(symbol);
@@ -270,7 +255,6 @@ void UnMatchedSystem::addSymbolToIncidenceMatrix(SymbolPtr s)
           else
             symbol->state = false;
           symbol->parameter = parameter;
-          m_incidencematrixT[symbol] = MEquationPtrVec();
           symbols->push_back(symbol);
         }
       s->setUserData(static_cast<void*>(symbols),ID_UD_SYMBOL);
@@ -297,6 +281,36 @@ void UnMatchedSystem::addSymbolToIncidenceMatrix(SymbolPtr s)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+UnMatchedSystem::MSymbol* UnMatchedSystem::newMSymbol(SymbolPtr s, size_t dim1, size_t dim2)
+/*****************************************************************************/
+{
+  MSymbol *symbol = new MSymbol(s,dim1,dim2);
+  symbol->id = m_symbols.size();
+  m_symbols.push_back(symbol);
+  m_symbolEqns.push_back(MEquationPtrVec());
+  return symbol;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void UnMatchedSystem::addEquation(MEquation* wrapper)
+/*****************************************************************************/
+{
+  // jedes Symbol nur einmal je Zeile, sortiert nach id
+  SizeTVec &scanned = wrapper->scanned;
+  std::sort(scanned.begin(),scanned.end());
+  scanned.erase(std::unique(scanned.begin(),scanned.end()),scanned.end());
+  wrapper->id = m_equations.size();
+  m_equations.push_back(wrapper);
+  m_rowSymbols.insert(m_rowSymbols.end(),scanned.begin(),scanned.end());
+  m_rowStart.push_back(m_rowSymbols.size());
+  for (size_t k=0;k<scanned.size();k++)
+    m_symbolEqns[scanned[k]].push_back(wrapper);
+  SizeTVec().swap(scanned);
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 void UnMatchedSystem::addEquationToIncidenceMatrix(MEquation* wrapper)
 /*****************************************************************************/
@@ -313,11 +327,7 @@ void UnMatchedSystem::addEquationToIncidenceMatrix(MEquation* wrapper)
         MSymbol *symbol = static_cast<MSymbol*>(m->first->getUserData(ID_UD_SYMBOL));
         if (symbol == NULL)
           throw InternalError("Symbol " + m->first->getName() + " without MSymbol");
-        m_incidencematrixT[symbol].push_back(wrapper);
-        if (symbol->state)
-          wrapper->states.insert(symbol);
-        else
-          wrapper->symbols.insert(symbol);
+        wrapper->scanned.push_back(symbol->id);
       }
       else
       {
@@ -326,15 +336,20 @@ void UnMatchedSystem::addEquationToIncidenceMatrix(MEquation* wrapper)
           throw InternalError("Symbol " + m->first->getName() + " without MSymbols");
         for(size_t u=0;u<syms->size();u++)
         {
-          m_incidencematrixT[(*syms)[u]].push_back(wrapper);
-          if ((*syms)[u]->state)
-            wrapper->states.insert((*syms)[u]);
-          else
-            wrapper->symbols.insert((*syms)[u]);
+          wrapper->scanned.push_back((*syms)[u]->id);
         }
       }
     }
   }
+  addEquation(wrapper);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+double UnMatchedSystem::updateGraph(EquationPtrSet const& removed, EquationPtrSet const& added)
+/*****************************************************************************/
+{
+  throw InternalError("updateGraph: only balanced systems could be updated, use buildGraph!");
 }
 /*****************************************************************************/
 
@@ -516,7 +531,7 @@ double UnMatchedSystem::matchSystem()
   if (debugmode)
     toGraphML("d:/Temp/PendulumDAE.graphml");
   // check size
-  if (m_equations.size() != (m_incidencematrixT.size() - m_states.size() - m_parameter.size()))
+  if (m_equations.size() != (m_symbols.size() - m_states.size() - m_parameter.size()))
   {
     toGraphML("IncidenceMatrix.graphml");
     return -1;
@@ -534,32 +549,44 @@ double UnMatchedSystem::matchSystem()
   Equation::DerRepl drder;
   size_t fname=1;
   SymbolRepl repl(symbolreplacemap);
+  // Markierungen nur einmal anlegen, markiert ist was den aktuellen Stempel traegt
+  MarkVec eqn_marks;
+  MarkVec sym_marks;
+  size_t mark = 0;
   // for node in nodes
   for (size_t i=0;i<m_equations.size();++i)
   {
-    SizeTSet eqn_marks;
-    MSymbolPtrSet sym_marks;
     if (m_equations[i]->symbol != NULL)
     {
       m_equations[i]->symbol->eqn = i+1;
       continue;
     }
+    // neue Gleichungen und Symbole aus der Indexreduktion sind unmarkiert
+    eqn_marks.resize(m_equations.size(),0);
+    sym_marks.resize(m_symbols.size(),0);
+    mark++;
     //double t5 = Util::getTime();
-    if (!pathFound(i,eqn_marks,sym_marks,m_equations[i]->c))
+    if (!pathFound(i,eqn_marks,sym_marks,mark,m_equations[i]->c))
     {
       // reduce index or make eqn scalar
       MSymbolPtrSet states;
       // get marged equations (eqn_marks)
-      for (SizeTSet::iterator jj=eqn_marks.begin();jj!=eqn_marks.end();jj++)
+      size_t neqns = eqn_marks.size();
+      for (size_t jj=0;jj<neqns;jj++)
       {
+        if (eqn_marks[jj] != mark)
+          continue;
         // states in eqn
-        for (MSymbolPtrSet::iterator s=m_equations[*jj]->states.begin();s!= m_equations[*jj]->states.end();s++)
-          states.insert(*s);
-        if (diffeqns.find(*jj) == diffeqns.end())
+        for (size_t const* s=rowBegin(jj);s!=rowEnd(jj);s++)
+        {
+          if (m_symbols[*s]->state)
+            states.insert(m_symbols[*s]);
+        }
+        if (diffeqns.find(jj) == diffeqns.end())
         {
           // differentiate equation
-          BasicPtr dlhs = m_equations[*jj]->lhs->der()->iterateExp(dr)->simplify();
-          BasicPtr drhs = m_equations[*jj]->rhs->der()->iterateExp(dr)->simplify();
+          BasicPtr dlhs = m_equations[jj]->lhs->der()->iterateExp(dr)->simplify();
+          BasicPtr drhs = m_equations[jj]->rhs->der()->iterateExp(dr)->simplify();
           EquationPtr deq(new Equation(SymbolPtrElemMap(),dlhs,drhs,false));
           if (dr.newsyms.size() > 0)
           {
@@ -575,12 +602,12 @@ double UnMatchedSystem::matchSystem()
           // add diff eqn
           eq->lhs = deq->getLhs(0)->iterateExp(repl)->simplify();
           eq->rhs = deq->getRhs(0)->iterateExp(repl)->simplify();
-          SymbolScanner scan(eq,m_time,m_incidencematrixT);
+          SymbolScanner scan(eq,m_time);
           eq->lhs->scanExp(scan);
           eq->rhs->scanExp(scan);
-          m_equations.push_back(eq);
+          addEquation(eq);
           deqnchecker[deq].insert(SizeTPair(eq->dim1,eq->dim2));
-          diffeqns.insert(*jj);
+          diffeqns.insert(jj);
         }
       }
       if (states.size() == 0)
@@ -655,13 +682,8 @@ double UnMatchedSystem::matchSystem()
           }
         }
       }
+      // in den Zeilen ab jetzt ein normales Symbol (state Flag)
       m_states.erase(dummystate);
-      MEquationPtrVec &dummystateeqns = m_incidencematrixT[dummystate];
-      for (MEquationPtrVec::iterator ik=dummystateeqns.begin();ik!=dummystateeqns.end();ik++)
-      {
-        (*ik)->states.erase(dummystate);
-        (*ik)->symbols.insert(dummystate);
-      }
       i--;
       if (debugmode)
         toGraphML("d:/Temp/PendulumDAE" + str(fname) + ".graphml");
@@ -673,9 +695,9 @@ double UnMatchedSystem::matchSystem()
   {
     std::ofstream f;
     f.open("d:/Temp/incidence.txt");
-    for (IncidenceMatrixT::iterator ii = m_incidencematrixT.begin();ii!=m_incidencematrixT.end();ii++)
+    for (MSymbolPtrVec::iterator ii = m_symbols.begin();ii!=m_symbols.end();ii++)
     {
-      f << ii->first->symbol->toString() << "[" << ii->first->dim1 << ", " << ii->first->dim2 << "] " << ii->first->state  << " : " << ii->first->eqn << std::endl;
+      f << (*ii)->symbol->toString() << "[" << (*ii)->dim1 << ", " << (*ii)->dim2 << "] " << (*ii)->state  << " : " << (*ii)->eqn << std::endl;
     }
     f.close();
   }
@@ -688,10 +710,7 @@ double UnMatchedSystem::matchSystem()
       MSymbol *symbol = static_cast<MSymbol*>((*ii)->getUserData(ID_UD_SYMBOL));
       if (symbol == NULL)
         throw InternalError("Symbol " + (*ii)->getName() + " without MSymbol");
-      IncidenceMatrixT::iterator kk = m_incidencematrixT.find(symbol);
-      if (kk == m_incidencematrixT.end())
-        throw InternalError("Symbol " + (*ii)->getName() + " not in  IncidenceMatrixT");
-      if (kk->second.size() != 0)
+      if (m_symbolEqns[symbol->id].size() != 0)
         m_eqsys->addSymbol(*ii);
     }
     else
@@ -702,10 +721,7 @@ double UnMatchedSystem::matchSystem()
         throw InternalError("Symbol " + (*ii)->getName() + " without MSymbols");
       for (size_t k=0;k<syms->size();k++)
       {
-        IncidenceMatrixT::iterator kk = m_incidencematrixT.find((*syms)[k]);
-        if (kk == m_incidencematrixT.end())
-          throw InternalError("Symbol " + (*ii)->getName() + " not in  IncidenceMatrixT");
-        if (kk->second.size() == 0)
+        if (m_symbolEqns[(*syms)[k]->id].size() == 0)
         {
           zerosymbols.push_back(Element::New((*syms)[k]->symbol,(*syms)[k]->dim1,(*syms)[k]->dim2));
         }
@@ -734,14 +750,14 @@ double UnMatchedSystem::matchSystem()
     if (ii->first->is_Scalar())
     {
       MSymbol *symbol = static_cast<MSymbol*>(ii->first->getUserData(ID_UD_SYMBOL));
-      MEquationPtrVec eqns = m_incidencematrixT[symbol];
+      MEquationPtrVec eqns = m_symbolEqns[symbol->id];
       for (size_t i=0;i<eqns.size();i++)
       {
         eqns[i]->eqn->findSymbols();
       }
       Symbol *ds = ii->first->getDerivative();
       symbol = static_cast<MSymbol*>(ds->getUserData(ID_UD_SYMBOL));
-      eqns = m_incidencematrixT[symbol];
+      eqns = m_symbolEqns[symbol->id];
       for (size_t i=0;i<eqns.size();i++)
       {
         eqns[i]->eqn->findSymbols();
@@ -752,7 +768,7 @@ double UnMatchedSystem::matchSystem()
       MSymbolPtrVec *symbols = static_cast<MSymbolPtrVec*>(ii->first->getUserData(ID_UD_SYMBOL));
       for (size_t l=0;l<symbols->size();l++)
       {
-        MEquationPtrVec eqns = m_incidencematrixT[(*symbols)[l]];
+        MEquationPtrVec eqns = m_symbolEqns[(*symbols)[l]->id];
         for (size_t i=0;i<eqns.size();i++)
         {
           eqns[i]->eqn->findSymbols();
@@ -762,7 +778,7 @@ double UnMatchedSystem::matchSystem()
       symbols = static_cast<MSymbolPtrVec*>(ds->getUserData(ID_UD_SYMBOL));
       for (size_t l=0;l<symbols->size();l++)
       {
-        MEquationPtrVec eqns = m_incidencematrixT[(*symbols)[l]];
+        MEquationPtrVec eqns = m_symbolEqns[(*symbols)[l]->id];
         for (size_t i=0;i<eqns.size();i++)
         {
           eqns[i]->eqn->findSymbols();
@@ -1159,12 +1175,14 @@ void UnMatchedSystem::strongConnect(size_t &i, MEquation* eqn,
   eqn->onStack = true;
   stack.push_back(eqn);
   // get all needed equations to calculate this equation
-  MSymbolPtrSet &symbols = eqn->symbols;
-  for (MSymbolPtrSet::iterator ii=symbols.begin();ii!=symbols.end();++ii)
+  for (size_t const* ii=rowBegin(eqn->id);ii!=rowEnd(eqn->id);++ii)
   {
-    if ((*ii) != eqn->symbol)
+    MSymbol *symbol = m_symbols[*ii];
+    if (symbol->state)
+      continue;
+    if (symbol != eqn->symbol)
     {
-      size_t userdata = (*ii)->eqn;
+      size_t userdata = symbol->eqn;
       if (userdata != 0)
       {
         MEquation *eq = m_equations[userdata-1];
@@ -1212,46 +1230,49 @@ void UnMatchedSystem::strongConnect(size_t &i, MEquation* eqn,
 /*****************************************************************************/
 
 /*****************************************************************************/
-bool UnMatchedSystem::pathFound(size_t e, SizeTSet &eqn_mark, MSymbolPtrSet &sym_mark,size_t &c)
+bool UnMatchedSystem::pathFound(size_t e, MarkVec &eqn_mark, MarkVec &sym_mark, size_t mark, size_t &c)
 /*****************************************************************************/
 {
   c++;
   // mark eqn
-  eqn_mark.insert(e);
+  eqn_mark[e] = mark;
   // try to find a free symbol
-  MSymbolPtrSet &eqnsymbols = m_equations[e]->symbols;
-  for (MSymbolPtrSet::iterator ii=eqnsymbols.begin();ii!=eqnsymbols.end();++ii)
+  size_t const* begin = rowBegin(e);
+  size_t const* end = rowEnd(e);
+  for (size_t const* ii=begin;ii!=end;++ii)
   {
-    if ((*ii)->state || (*ii)->parameter)
+    MSymbol *symbol = m_symbols[*ii];
+    if (symbol->state || symbol->parameter)
       continue;
     // is not assigned
-    if ((*ii)->eqn == 0)
+    if (symbol->eqn == 0)
     {
       // assign
-      m_equations[e]->symbol = (*ii);
-      (*ii)->eqn = e+1;
+      m_equations[e]->symbol = symbol;
+      symbol->eqn = e+1;
       return true;
     }
   }
   // get all not marked symbols of equation
   MSymbolPtrVec notmarkedsymbols;
-  notmarkedsymbols.reserve(eqnsymbols.size());
-  for (MSymbolPtrSet::iterator ii=eqnsymbols.begin();ii!=eqnsymbols.end();++ii)
+  notmarkedsymbols.reserve(end-begin);
+  for (size_t const* ii=begin;ii!=end;++ii)
   {
-   if ((*ii)->state || (*ii)->parameter)
+    MSymbol *symbol = m_symbols[*ii];
+    if (symbol->state || symbol->parameter)
       continue;
-    if (sym_mark.find((*ii)) == sym_mark.end())
-      notmarkedsymbols.push_back((*ii));
+    if (sym_mark[*ii] != mark)
+      notmarkedsymbols.push_back(symbol);
   }
   // try to free a symbol 
   for (size_t j=0;j<notmarkedsymbols.size();++j)
   {
-    sym_mark.insert(notmarkedsymbols[j]);
+    sym_mark[notmarkedsymbols[j]->id] = mark;
     size_t m = notmarkedsymbols[j]->eqn;
     if (m != 0)
     {
       m_equations[m-1]->c1++;
-      if (pathFound(m-1,eqn_mark,sym_mark,c))
+      if (pathFound(m-1,eqn_mark,sym_mark,mark,c))
       {
         // assign
         m_equations[e]->symbol = notmarkedsymbols[j];
@@ -1293,7 +1314,7 @@ void UnMatchedSystem::toGraphML( std::string file )
   // write symbols
   size_t id=0;
   std::map<std::string,size_t> symbolidmap;
-  for (IncidenceMatrixT::iterator ii =m_incidencematrixT.begin(); ii != m_incidencematrixT.end();++ii)
+  for (MSymbolPtrVec::iterator ii =m_symbols.begin(); ii != m_symbols.end();++ii)
   {
     f << "    <node id=\"n" << id << "\">" << std::endl;
     f << "      <data key=\"d5\"/>" << std::endl;
@@ -1301,10 +1322,10 @@ void UnMatchedSystem::toGraphML( std::string file )
     f << "        <y:ShapeNode>" << std::endl;
     f << "          <y:Geometry height=\"30.0\" width=\"30.0\" x=\"" << 40*(id+1) << "\" y=\"1.0\"/>" << std::endl;
     std::string color = "#000000";
-    size_t cat = ii->first->symbol->getKind();
+    size_t cat = (*ii)->symbol->getKind();
     if (cat & STATE)
     {
-      if (ii->first->state)
+      if ((*ii)->state)
         color = "#FF0000";
       else
       color = "#FFFFFF";
@@ -1325,9 +1346,9 @@ void UnMatchedSystem::toGraphML( std::string file )
     std::string bscolor = "000000";
     f << "          <y:BorderStyle color=\"" + bscolor + "\" type=\"line\" width=\"1.0\"/>" << std::endl;
     f << "          <y:NodeLabel alignment=\"center\" autoSizePolicy=\"content\" fontFamily=\"Dialog\" fontSize=\"12\" fontStyle=\"plain\" hasBackgroundColor=\"false\" hasLineColor=\"false\" height=\"18.701171875\" modelName=\"internal\" modelPosition=\"b\" rotationAngle=\"270.0\" textColor=\"#000000\" visible=\"true\" width=\"30.015625\" x=\"-0.0078125\" y=\"5.6494140625\">";
-    std::string name = ii->first->symbol->getName();
-    if (!ii->first->symbol->is_Scalar())
-      name += "[" + str(ii->first->dim1) +  "," + str(ii->first->dim2) + "]";
+    std::string name = (*ii)->symbol->getName();
+    if (!(*ii)->symbol->is_Scalar())
+      name += "[" + str((*ii)->dim1) +  "," + str((*ii)->dim2) + "]";
     f << name << "</y:NodeLabel>" << std::endl;
     symbolidmap[name] = id;
     f << "          <y:Shape type=\"rectangle\"/>" << std::endl;
@@ -1341,7 +1362,7 @@ void UnMatchedSystem::toGraphML( std::string file )
   size_t iid=0;
   for (MEquationPtrVec::iterator ii =m_equations.begin(); ii != m_equations.end();++ii)
   {
-    f << "    <node id=\"n" << id + m_incidencematrixT.size() << "\">" << std::endl;
+    f << "    <node id=\"n" << id + m_symbols.size() << "\">" << std::endl;
     f << "      <data key=\"d5\"/>" << std::endl;
     f << "      <data key=\"d6\">" << std::endl;
     f << "        <y:ShapeNode>" << std::endl;
@@ -1358,7 +1379,10 @@ void UnMatchedSystem::toGraphML( std::string file )
     f << "      </data>" << std::endl;
     f << "    </node>" << std::endl;
     id++;
-    for (MSymbolPtrSet::iterator jj =(*ii)->symbols.begin(); jj != (*ii)->symbols.end();++jj)
+    MSymbolPtrVec symbols, states;
+    for (size_t const* k=rowBegin((*ii)->id); k!=rowEnd((*ii)->id);++k)
+      (m_symbols[*k]->state ? states : symbols).push_back(m_symbols[*k]);
+    for (MSymbolPtrVec::iterator jj =symbols.begin(); jj != symbols.end();++jj)
     {
       std::string sname = (*jj)->symbol->getName();
       if (!(*jj)->symbol->is_Scalar())
@@ -1366,7 +1390,7 @@ void UnMatchedSystem::toGraphML( std::string file )
       std::map<std::string,size_t>::iterator kk =  symbolidmap.find(sname);
       if (kk != symbolidmap.end())
       {
-        f << "    <node id=\"n" << iid + m_incidencematrixT.size() + m_equations.size() << "\">" << std::endl;
+        f << "    <node id=\"n" << iid + m_symbols.size() + m_equations.size() << "\">" << std::endl;
         f << "      <data key=\"d5\"/>" << std::endl;
         f << "      <data key=\"d6\">" << std::endl;
         f << "        <y:ShapeNode>" << std::endl;
@@ -1383,7 +1407,7 @@ void UnMatchedSystem::toGraphML( std::string file )
         iid++;
       }
     }
-    for (MSymbolPtrSet::iterator jj =(*ii)->states.begin(); jj != (*ii)->states.end();++jj)
+    for (MSymbolPtrVec::iterator jj =states.begin(); jj != states.end();++jj)
     {
       std::string sname = (*jj)->symbol->getName();
       if (!(*jj)->symbol->is_Scalar())
@@ -1391,7 +1415,7 @@ void UnMatchedSystem::toGraphML( std::string file )
       std::map<std::string,size_t>::iterator kk =  symbolidmap.find(sname);
       if (kk != symbolidmap.end())
       {
-        f << "    <node id=\"n" << iid + m_incidencematrixT.size() + m_equations.size() << "\">" << std::endl;
+        f << "    <node id=\"n" << iid + m_symbols.size() + m_equations.size() << "\">" << std::endl;
         f << "      <data key=\"d5\"/>" << std::endl;
         f << "      <data key=\"d6\">" << std::endl;
         f << "        <y:ShapeNode>" << std::endl;
@@ -1501,7 +1525,7 @@ void UnMatchedSystem::toGraphML_Sorted( std::string file )
   {
     for (MEquationPtrVec::iterator ii =ia->begin(); ii != ia->end();++ii)
     {
-      f << "    <node id=\"n" << id + m_incidencematrixT.size() << "\">" << std::endl;
+      f << "    <node id=\"n" << id + m_symbols.size() << "\">" << std::endl;
       f << "      <data key=\"d5\"/>" << std::endl;
       f << "      <data key=\"d6\">" << std::endl;
       f << "        <y:ShapeNode>" << std::endl;
@@ -1518,7 +1542,10 @@ void UnMatchedSystem::toGraphML_Sorted( std::string file )
       f << "      </data>" << std::endl;
       f << "    </node>" << std::endl;
       id++;
-      for (MSymbolPtrSet::iterator jj =(*ii)->symbols.begin(); jj != (*ii)->symbols.end();++jj)
+      MSymbolPtrVec symbols, states;
+      for (size_t const* k=rowBegin((*ii)->id); k!=rowEnd((*ii)->id);++k)
+        (m_symbols[*k]->state ? states : symbols).push_back(m_symbols[*k]);
+      for (MSymbolPtrVec::iterator jj =symbols.begin(); jj != symbols.end();++jj)
       {
         std::string sname = (*jj)->symbol->getName();
         if (!(*jj)->symbol->is_Scalar())
@@ -1526,7 +1553,7 @@ void UnMatchedSystem::toGraphML_Sorted( std::string file )
         std::map<std::string,size_t>::iterator kk =  symbolidmap.find(sname);
         if (kk != symbolidmap.end())
         {
-          f << "    <node id=\"n" << iid + m_incidencematrixT.size() + m_equations.size() << "\">" << std::endl;
+          f << "    <node id=\"n" << iid + m_symbols.size() + m_equations.size() << "\">" << std::endl;
           f << "      <data key=\"d5\"/>" << std::endl;
           f << "      <data key=\"d6\">" << std::endl;
           f << "        <y:ShapeNode>" << std::endl;
@@ -1543,7 +1570,7 @@ void UnMatchedSystem::toGraphML_Sorted( std::string file )
           iid++;
         }
       }
-      for (MSymbolPtrSet::iterator jj =(*ii)->states.begin(); jj != (*ii)->states.end();++jj)
+      for (MSymbolPtrVec::iterator jj =states.begin(); jj != states.end();++jj)
       {
         std::string sname = (*jj)->symbol->getName();
         if (!(*jj)->symbol->is_Scalar())
@@ -1551,7 +1578,7 @@ void UnMatchedSystem::toGraphML_Sorted( std::string file )
         std::map<std::string,size_t>::iterator kk =  symbolidmap.find(sname);
         if (kk != symbolidmap.end())
         {
-          f << "    <node id=\"n" << iid + m_incidencematrixT.size() + m_equations.size() << "\">" << std::endl;
+          f << "    <node id=\"n" << iid + m_symbols.size() + m_equations.size() << "\">" << std::endl;
           f << "      <data key=\"d5\"/>" << std::endl;
           f << "      <data key=\"d6\">" << std::endl;
           f << "        <y:ShapeNode>" << std::endl;
@@ -5,8 +5,10 @@
 #include <map>
 #include "Symbolics.h"
 #include "Node.h"
+#include "EquationSystem.h"
 
 #include "intrusive_ptr.h"
+#include "RefCount.h"
 
 // Forward Declarations
 namespace Symbolics
@@ -44,6 +46,8 @@ namespace Symbolics
         {
         public:
             Assignment( NodePtr node);
+            // Hilfsvariable (CSEOptimisation)
+            Assignment( BasicPtr const& symbol, BasicPtr const& exp, Category_Type category = 0);
             ~Assignment();
             BasicPtrVec lhs;
             BasicPtrVec rhs;
@@ -61,13 +65,18 @@ namespace Symbolics
 
             VariableVec getVariables(Category_Type Category) const;
             std::vector<Graph::Assignment> getEquations(Category_Type exclude = 0x00) const;
+
+            // gemeinsame Teilausdruecke durch Hilfsvariablen ersetzen (siehe CSEOptimisation)
+            void eliminateCommonSubexpressions(EquationSystemPtr eqsys, size_t &counter);
+            // Reihenfolge fuer geringen Registerdruck (siehe Scheduler)
+            void schedule();
         protected:
             SymbolPtrVec m_symbols;
             std::vector<Graph::Assignment> m_assignments;
 
     private:
         // Boost Intrusive Ptr
-        unsigned int m_refCount;
+        RefCount m_refCount;
         // friend
         friend void ::boost::intrusive_ptr_add_ref( const Assignments* p);
         friend void ::boost::intrusive_ptr_release( const Assignments* p);
@@ -84,7 +93,7 @@ namespace boost
     {
         // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
         Symbolics::Graph::Assignments* b = const_cast<Symbolics::Graph::Assignments*>(p);
-        ++(b->m_refCount);
+        b->m_refCount.inc();
     }
 
     // decrement reference count, and delete object when reference count reaches 0
@@ -92,7 +101,7 @@ namespace boost
     {
         // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
         Symbolics::Graph::Assignments* b = const_cast<Symbolics::Graph::Assignments*>(p);
-        if (--(b->m_refCount) == 0)
+        if (b->m_refCount.dec())
             delete p;
     } 
 }; // namespace boost
@@ -0,0 +1,107 @@
+#ifndef __CSEOPTIMISATION_H_
+#define __CSEOPTIMISATION_H_
+
+#include <string>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include "Symbolics.h"
+#include "Assignments.h"
+#include "EquationSystem.h"
+
+
+namespace Symbolics
+{
+    namespace Graph
+    {
+
+/*****************************************************************************/
+        // Gemeinsame Teilausdruecke ueber alle Assignments
+        // Teilausdruecke, die mehrfach vorkommen, werden zu Hilfsvariablen (cse_<n>),
+        // die direkt vor ihrer ersten Verwendung berechnet werden. Bei Add und Mul
+        // zaehlen auch Teilmengen der Argumente (a*b in a*b*c und a*b*d).
+        class CSEOptimisation
+        {
+        public:
+            // Konstruktor
+            // counter: laufende Nummer der Hilfsvariablen (eindeutig ueber alle Assignments eines Graphen)
+            // die Hilfsvariablen werden in eqsys eingetragen (Anfangswert, Kommentar fuer die Writer)
+            CSEOptimisation(EquationSystemPtr eqsys, std::vector<Assignment> &assignments, SymbolPtrVec &symbols, size_t &counter);
+            // Destruktor
+            ~CSEOptimisation();
+
+            // run Optimization
+            void optimize();
+
+        protected:
+            EquationSystemPtr m_eqsys;
+            std::vector<Assignment> &m_assignments;
+            SymbolPtrVec &m_symbols;
+            size_t &m_counter;
+
+            typedef std::vector<size_t> IdVec;
+            // ein Teilausdruck, strukturell gleiche Ausdruecke haben die gleiche id
+            struct Entry
+            {
+                Entry(): count(0), rank(0) {};
+                BasicPtr exp;          // NULL: Teilmenge der Argumente eines Add/Mul, nicht im Ausdruck vorhanden
+                Basic_Type type;
+                IdVec args;            // bei Add und Mul sortiert
+                size_t count;          // Anzahl Verwendungen
+                BasicPtr repl;         // neuer Ausdruck bzw. Hilfsvariable
+                size_t rank;           // Hilfsvariablen: Reihenfolge unabhaengig von der Reihenfolge der Gleichungen
+                std::string name;
+            };
+            std::vector<Entry> m_entries;
+            typedef std::unordered_map<BasicPtr,size_t,BasicPtrHash,BasicPtrEqual> IdMap;
+            IdMap m_ids;
+            // Teilmengen der Argumente: Typ und sortierte Argumente -> id
+            std::map<std::pair<Basic_Type,IdVec>,size_t> m_factors;
+            // Add/Mul, die ein Argument enthalten (fuer die Suche nach Teilmengen)
+            std::map<std::pair<Basic_Type,size_t>,IdVec> m_containing;
+            // Teilmengen, die ein Argument enthalten (beim Ersetzen)
+            std::map<std::pair<Basic_Type,size_t>,IdVec> m_factorsContaining;
+
+            // Hilfsvariablen, die vor der aktuellen Gleichung eingefuegt werden
+            std::vector<Assignment> m_pending;
+
+            // bekommt eine Hilfsvariable, falls mehrfach verwendet
+            bool is_Eligible(Entry const& e) const;
+            static bool is_Nary(Basic_Type type);
+            // Add/Mul mit skalaren Argumenten, nur dort duerfen Teilmengen herausgezogen werden
+            bool is_Factorable(Entry const& e) const;
+            static bool is_SubSet(IdVec const& sub, IdVec const& set);
+            static IdVec getIntersection(IdVec const& a, IdVec const& b);
+
+            // Ausdruecke erfassen und Verwendungen zaehlen
+            size_t collect(BasicPtr const& exp);
+            void addUse(size_t id);
+            // Teilmengen der Argumente von Add und Mul suchen
+            void findFactors();
+            // Namen vorab nach Inhalt vergeben, damit das Ergebnis nicht von der
+            // Reihenfolge der Gleichungen (Threads in der PastOptimisation) abhaengt
+            void nameTemps();
+            size_t getHash(size_t id) const;
+            std::string getString(size_t id) const;
+            // Ausdruck mit Hilfsvariablen neu aufbauen
+            BasicPtr rebuild(BasicPtr const& exp);
+            BasicPtr getRepl(size_t id);
+            // nur einmal verwendete Hilfsvariablen wieder einsetzen, Kategorien setzen
+            class Inliner: public Basic::Iterator
+            {
+            public:
+                BasicPtr process_Arg(BasicPtr const &p);
+                BasicPtrHashMap m_defs;
+            };
+            void substitute(Assignment &a, Inliner &inliner, std::set<Basic*> const& symbols);
+            static bool is_Alias(Assignment const& temp, Assignment const& a, std::set<Basic*> const& temps);
+            void setCategories(std::vector<Assignment> &assignments, std::set<Basic*> const& temps,
+              bool skipAliases, std::map<Basic*,Category_Type> &categories);
+            void cleanup(std::vector<Assignment> &assignments, std::set<Basic*> const& temps);
+         };
+/*****************************************************************************/
+    };
+};
+
+#endif // __CSEOPTIMISATION_H_
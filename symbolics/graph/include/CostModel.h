@@ -0,0 +1,56 @@
+#ifndef __COSTMODEL_H_
+#define __COSTMODEL_H_
+
+#include <vector>
+#include "Symbolics.h"
+#include "Assignments.h"
+
+
+namespace Symbolics
+{
+    namespace Graph
+    {
+
+/*****************************************************************************/
+        // Anzahl Rechenoperationen im erzeugten Code
+        struct OperationCount
+        {
+            OperationCount(): adds(0), muls(0), divs(0), functions(0), temps(0) {};
+            size_t adds;           // Additionen, Subtraktionen, Negationen
+            size_t muls;           // Multiplikationen
+            size_t divs;           // Divisionen (x^-1)
+            size_t functions;      // sin, cos, pow, sqrt, abs, ...
+            size_t temps;          // Zwischenvariablen (keine Ausgaenge)
+
+            // Gleitkommaoperationen
+            inline size_t getFlops() const { return adds + muls + divs + functions; };
+            OperationCount& operator+= (OperationCount const& rhs);
+        };
+/*****************************************************************************/
+
+/*****************************************************************************/
+        // Kostenmodell: zaehlt die Operationen so, wie die Printer die Ausdruecke
+        // ausgeben, d.h. mehrfach verwendete Teilausdruecke ohne Hilfsvariable
+        // werden mehrfach gezaehlt. Matrixoperationen zaehlen elementweise.
+        class CostModel
+        {
+        public:
+            // Operationen eines Ausdrucks
+            static OperationCount count(BasicPtr const& exp);
+            // Operationen einer Gleichung, temps: Anzahl lhs, die nur Zwischenvariablen sind
+            static OperationCount count(Assignment const& a);
+            // Summe ueber alle Gleichungen
+            static OperationCount count(std::vector<Assignment> const& assignments);
+
+            // lhs ist weder Zustandsableitung noch Sensor o.ae.
+            static bool is_Temporary(BasicPtr const& lhs);
+
+        protected:
+            // Operationen des Knotens selbst (ohne Argumente)
+            static OperationCount getOwnCost(Basic const* exp);
+        };
+/*****************************************************************************/
+    };
+};
+
+#endif // __COSTMODEL_H_
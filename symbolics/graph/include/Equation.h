@@ -6,6 +6,7 @@
 #include "Symbolics.h"
 
 #include "intrusive_ptr.h"
+#include "RefCount.h"
 
 // Forward Declarations
 namespace Symbolics
@@ -90,6 +91,9 @@ namespace Symbolics
 
       void simplify();
 
+      // Ausdruecke in die Arena eintragen (nach parallelem simplify)
+      void intern();
+
       void findSymbols();
 
       void solve(BasicPtr const& exp);
@@ -171,7 +175,7 @@ namespace Symbolics
 
     private:
       // Boost Intrusive Ptr
-      unsigned int m_refCount;
+      RefCount m_refCount;
       // friend
       friend void ::boost::intrusive_ptr_add_ref( const Equation* p);
       friend void ::boost::intrusive_ptr_release( const Equation* p);
@@ -189,7 +193,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::Equation* b = const_cast<Symbolics::Graph::Equation*>(p);
-    ++(b->m_refCount);
+    b->m_refCount.inc();
   }
 
   // decrement reference count, and delete object when reference count reaches 0
@@ -197,7 +201,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::Equation* b = const_cast<Symbolics::Graph::Equation*>(p);
-    if (--(b->m_refCount) == 0)
+    if (b->m_refCount.dec())
       delete p;
   } 
 }; // namespace boost
@@ -105,6 +105,15 @@ namespace Symbolics
 
       void eraseEquation( EquationPtr eqn);
 
+      // Gleichung fuer solveFor durch eine neue ersetzen
+      // throws: VarUnknownError, ExpressionSolveForError, SymbolAlreadySolvedInError
+      void changeEquation( BasicPtr const& solveFor, BasicPtr const& exp, bool implicit=false);
+
+      // seit clearDirty hinzugefuegte und entfernte Gleichungen
+      inline EquationPtrSet const& getDirtyEquations() { return m_dirty; };
+      inline EquationPtrSet const& getRemovedEquations() { return m_removed; };
+      inline void clearDirty() { m_dirty.clear(); m_removed.clear(); };
+
       // scalar
       EquationSystemPtr makeScalar();
 
@@ -168,6 +177,9 @@ namespace Symbolics
 
       // Equation
       EquationPtrSet m_equations;
+      // Aenderungen fuer Graph::updateGraph
+      EquationPtrSet m_dirty;
+      EquationPtrSet m_removed;
       // States
       SymbolPtrElemMap m_states;
       SymbolPtrElemMap m_derstates;
@@ -227,10 +239,10 @@ namespace Symbolics
       class SymbolRepl: public Basic::Iterator
       {
       public:
-          SymbolRepl(BasicPtrMap &symbolmap):m_symbolmap(symbolmap) {;}
+          SymbolRepl(BasicPtrHashMap &symbolmap):m_symbolmap(symbolmap) {;}
           ~SymbolRepl() {;}
           
-          BasicPtrMap &m_symbolmap;
+          BasicPtrHashMap &m_symbolmap;
 
           BasicPtr process_Arg(BasicPtr const &p);
       };
@@ -240,7 +252,7 @@ namespace Symbolics
 
     private:
       // Boost Intrusive Ptr
-      unsigned int m_refCount;
+      RefCount m_refCount;
       // friend
       friend void ::boost::intrusive_ptr_add_ref( const EquationSystem* p);
       friend void ::boost::intrusive_ptr_release( const EquationSystem* p);
@@ -259,7 +271,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::EquationSystem* b = const_cast<Symbolics::Graph::EquationSystem*>(p);
-    ++(b->m_refCount);
+    b->m_refCount.inc();
   }
 
   // decrement reference count, and delete object when reference count reaches 0
@@ -267,7 +279,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::EquationSystem* b = const_cast<Symbolics::Graph::EquationSystem*>(p);
-    if (--(b->m_refCount) == 0)
+    if (b->m_refCount.dec())
       delete p;
   } 
 }; // namespace boost
@@ -8,6 +8,7 @@
 #include "EquationSystem.h"
 #include "SystemHandler.h"
 #include "Assignments.h"
+#include "StateJacobian.h"
 
 namespace Symbolics
 {
@@ -36,14 +37,42 @@ namespace Symbolics
             // throws: ExpressionSolveForError, SymbolAlreadySolvedInError, VarUnknownError
             void addExpression( BasicPtrVec const& solveFor, BasicPtrVec const& exp, bool implicit=false);
 
+            // Gleichung fuer solveFor ersetzen, danach updateGraph
+            // throws: InternalError, VarUnknownError, ExpressionSolveForError, SymbolAlreadySolvedInError
+            void changeExpression( BasicPtr const& solveFor, BasicPtr const& exp, bool implicit=false);
+
             // scalar
             void makeScalar();
 
-            // 
-            double buildGraph(bool optimize);
+            // threads: Anzahl Threads fuer die Vereinfachung in der PastOptimisation
+            double buildGraph(bool optimize, size_t threads = 1);
+
+            // nur geaenderte Gleichungen und ihre Kinder neu verknuepfen, ohne Optimierung
+            // throws: InternalError
+            double updateGraph();
+
+            // gebauten Graphen als Binaerabbild speichern
+            // throws: InternalError
+            void saveSnapshot(std::string const& file);
+
+            // gespeicherten Graphen in einen leeren Graphen laden, ersetzt buildGraph
+            // throws: InternalError
+            double loadSnapshot(std::string const& file);
+
+            // struktureller Hash des gebauten Graphen (Symbole und Gleichungen),
+            // unabhaengig von der Reihenfolge der Knoten im Speicher
+            // throws: InternalError
+            size_t getHash();
 
             // getsolved System
-            AssignmentsPtr getAssignments(Category_Type inc, Category_Type exclude=0x00);
+            // cse: gemeinsame Teilausdruecke zusammenfassen (nur nach buildGraph mit Optimierung).
+            // Das Ergebnis wird je inc/exclude gespeichert, weitere Aufrufe liefern eine Kopie
+            // davon und tragen keine neuen Hilfsvariablen in das Gleichungssystem ein
+            AssignmentsPtr getAssignments(Category_Type inc, Category_Type exclude=0x00, bool cse=true);
+
+            // Ableitung der Zustandsableitungen nach den Zustaenden, equations aus getAssignments(DER_STATE)
+            // throws: InternalError
+            StateJacobian getStateJacobian(std::vector<Assignment> const& equations, VariableVec const& states);
 
             // getSymbol
             // throws: VarUnknownError
@@ -73,6 +102,13 @@ namespace Symbolics
 
           NodeVec m_nodes;
 
+          // buildGraph mit Optimierung: getAssignments fasst gemeinsame Teilausdruecke zusammen
+          bool m_optimized;
+          // laufende Nummer der Hilfsvariablen (cse_<n>)
+          size_t m_cseCounter;
+          // getAssignments mit CSE je (inc, exclude), bis zum naechsten buildGraph
+          std::map<std::pair<Category_Type,Category_Type>, AssignmentsPtr> m_cseAssignments;
+
           typedef std::map<SymbolPtr, std::pair< size_t, SymbolPtr> > DerivativeOrderMap;
           DerivativeOrderMap m_derivativeOrder;
 
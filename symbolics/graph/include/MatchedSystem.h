@@ -25,6 +25,9 @@ namespace Symbolics
             // generate the internal graph
             double buildGraph();
 
+            // removed: Gleichungen, deren Knoten wegfallen, added: neue Gleichungen
+            double updateGraph(EquationPtrSet const& removed, EquationPtrSet const& added);
+
             // to GraphML
             void toGraphML( std::string file );
 
@@ -7,6 +7,7 @@
 #include "Equation.h"
 
 #include "intrusive_ptr.h"
+#include "RefCount.h"
 
 // Forward Declarations
 namespace Symbolics
@@ -100,6 +101,9 @@ namespace Symbolics
 
       void clear();
 
+      // aus dem Graphen loesen: bei den Eltern und den geloesten Symbolen austragen
+      void release();
+
       // subs
       void subs(ConstBasicPtr const& old_exp, BasicPtr const& new_exp);
 
@@ -136,7 +140,7 @@ namespace Symbolics
 
     private:
       // Boost Intrusive Ptr
-      unsigned int m_refCount;
+      RefCount m_refCount;
       // friend
       friend void ::boost::intrusive_ptr_add_ref( const Node* p);
       friend void ::boost::intrusive_ptr_release( const Node* p);
@@ -154,7 +158,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::Node* b = const_cast<Symbolics::Graph::Node*>(p);
-    ++(b->m_refCount);
+    b->m_refCount.inc();
   }
 
   // decrement reference count, and delete object when reference count reaches 0
@@ -162,7 +166,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::Node* b = const_cast<Symbolics::Graph::Node*>(p);
-    if (--(b->m_refCount) == 0)
+    if (b->m_refCount.dec())
       delete p;
   } 
 }; // namespace boost
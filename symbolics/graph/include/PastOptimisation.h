@@ -20,7 +20,8 @@ namespace Symbolics
         {
         public:
             // Konstruktor
-            PastOptimisation(EquationSystemPtr eqsys, NodeVec &nodes);
+            // threads > 1: die Gleichungen einer Ebene werden parallel vereinfacht
+            PastOptimisation(EquationSystemPtr eqsys, NodeVec &nodes, size_t threads = 1);
             // Destruktor
             ~PastOptimisation();
 
@@ -31,6 +32,7 @@ namespace Symbolics
 
           EquationSystemPtr m_eqsys;
           NodeVec &m_nodes;
+          size_t m_threads;
 
           class NodeOptimizer: public Node::Visitor, public Basic::Scanner
           {
@@ -55,6 +57,14 @@ namespace Symbolics
               void subs_Node(NodePtr p, SymbolPtr const& symbol, BasicPtr const& exp);
           };
 
+          // Ebenen (Abstand zur Wurzel) statt Tiefensuche, damit die Gleichungen einer
+          // Ebene vorab unabhaengig voneinander vereinfacht werden koennen
+          void optimizeLevels(NodeOptimizer &v);
+          // Ebenen und Reihenfolge der seriellen Tiefensuche, ohne Rekursion
+          void getLevels(std::map<Node*,size_t> &levels, NodeVec &order);
+          // vereinfacht die Gleichungen parallel, Gleichungen mit gemeinsamen Knoten im gleichen Thread
+          void simplifyParallel(NodeVec &nodes);
+
         private:
             BasicPtr m_time;
          };
@@ -0,0 +1,72 @@
+#ifndef __SCHEDULER_H_
+#define __SCHEDULER_H_
+
+#include <vector>
+#include <map>
+
+#include "Symbolics.h"
+#include "Assignments.h"
+
+
+namespace Symbolics
+{
+    namespace Graph
+    {
+
+/*****************************************************************************/
+        // Reihenfolge der Zuweisungen fuer wenige gleichzeitig lebende Werte (Registerdruck)
+        // Die Abhaengigkeiten bleiben erhalten: lesen nach schreiben, schreiben nach lesen
+        // und schreiben nach schreiben, bei Elementen einer Variablen je Element.
+        // Von den bereiten Zuweisungen wird jeweils die genommen, die die meisten Werte
+        // zum letzten Mal liest und selbst keinen neuen erzeugt; bei Gleichstand die, deren
+        // Argumente zuletzt berechnet wurden (Lokalitaet), dann die bisherige Reihenfolge.
+        class Scheduler
+        {
+        public:
+            // Konstruktor
+            Scheduler(std::vector<Assignment> &assignments);
+            // Destruktor
+            ~Scheduler();
+
+            // umsortieren, nur wenn danach weniger Werte gleichzeitig leben
+            // implizite Gleichungen: Reihenfolge bleibt
+            void schedule();
+
+            // hoechste Anzahl gleichzeitig lebender Werte (berechnet und spaeter noch gelesen)
+            static size_t getMaxLive(std::vector<Assignment> const& assignments);
+
+        protected:
+            std::vector<Assignment> &m_assignments;
+
+            // Variable: Symbol und ob die Ableitung (der_) gemeint ist
+            typedef std::pair<Basic*,bool> Var;
+            // Element (Zeile, Spalte), die ganze Variable ist (npos, npos)
+            typedef std::pair<size_t,size_t> Index;
+            static const Index whole;
+            struct Access
+            {
+                Access(): write(std::string::npos) {};
+                size_t write;                  // letzte schreibende Zuweisung
+                std::vector<size_t> reads;     // lesende Zuweisungen seitdem
+            };
+            std::map<Var, std::map<Index,Access> > m_access;
+
+            std::vector<std::vector<size_t> > m_pred;     // muessen vorher stehen
+            std::vector<std::vector<size_t> > m_values;   // gelesene Werte (Zuweisungen)
+            std::vector<std::vector<size_t> > m_readers;  // Zuweisungen, die den Wert lesen
+
+            void buildDependencies();
+            // elements = false: Elemente zaehlen als ganze Variable (Solve schreibt alle)
+            void addAccess(BasicPtr const& exp, size_t j, bool write, bool elements);
+            void addRead(Var const& v, Index const& e, size_t j);
+            void addWrite(Var const& v, Index const& e, size_t j);
+            void addEdge(size_t i, size_t j, bool value);
+            // Reihenfolge nach der Heuristik (Indizes in m_assignments)
+            std::vector<size_t> getOrder();
+            size_t getMaxLive(std::vector<size_t> const& order) const;
+        };
+/*****************************************************************************/
+    };
+};
+
+#endif // __SCHEDULER_H_
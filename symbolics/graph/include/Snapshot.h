@@ -0,0 +1,48 @@
+#ifndef __GRAPH_SNAPSHOT_H_
+#define __GRAPH_SNAPSHOT_H_
+
+#include <string>
+#include <vector>
+
+#include "Symbolics.h"
+#include "EquationSystem.h"
+#include "Node.h"
+
+namespace Symbolics
+{
+    namespace Graph
+    {
+
+/*****************************************************************************/
+        // Binaerabbild eines gebauten Graphen: Stringtabelle, Ausdrucksknoten in
+        // post-order mit Indextabelle der Argumente, Symbole mit Art und Zustand,
+        // Gleichungen und die Reihenfolge der Knoten. Alle Tabellen liegen mit
+        // fester Satzgroesse hintereinander, beim Laden wird die Datei nur
+        // eingeblendet (mmap) und direkt gelesen.
+        class Snapshot
+        {
+        public:
+            // Kopfdaten des Graphen, die nicht im Gleichungssystem stehen
+            struct Info
+            {
+              bool optimized;
+              size_t cseCounter;
+              Info(): optimized(false), cseCounter(0) {;};
+            };
+
+            // throws: InternalError
+            static void write(std::string const& file, EquationSystemPtr eqsys, NodeVec const& nodes, Info const& info);
+
+            // eqsys darf nur das Symbol time enthalten, nodes wird in der gespeicherten Reihenfolge gefuellt
+            // throws: InternalError
+            static Info read(std::string const& file, EquationSystemPtr eqsys, NodeVec &nodes, SymbolPtr const& time);
+
+        private:
+            Snapshot();
+            ~Snapshot();
+        };
+/*****************************************************************************/
+    };
+};
+
+#endif // __GRAPH_SNAPSHOT_H_
@@ -0,0 +1,90 @@
+#ifndef __STATEJACOBIAN_H_
+#define __STATEJACOBIAN_H_
+
+#include <map>
+#include <vector>
+#include <unordered_map>
+
+#include "Symbolics.h"
+#include "Assignments.h"
+#include "EquationSystem.h"
+
+
+namespace Symbolics
+{
+    namespace Graph
+    {
+
+/*****************************************************************************/
+        // Jacobimatrix d(yd)/d(y) der Zustandsableitungen nach den Zustaenden
+        // Vorwaertsmodus ueber die (skalaren) Gleichungen von der_state: jede
+        // Variable bekommt eine Zeile mit ihren Ableitungen nach den Zustaenden,
+        // zusammengesetzte Ableitungen werden zu Hilfsvariablen (jac_<n>).
+        // Die Gleichungen werden nach denen von der_state ausgewertet und
+        // verwenden deren Variablen (auch die Hilfsvariablen der CSEOptimisation).
+        class StateJacobian
+        {
+        public:
+            // equations: getAssignments(DER_STATE)->getEquations(...), explizit
+            // states: Zustaende in der Reihenfolge von y, y[i*n+j] = Element j von states[i]
+            // die Hilfsvariablen werden in eqsys eingetragen
+            // throws: InternalError
+            StateJacobian(EquationSystemPtr eqsys, std::vector<Assignment> const& equations, VariableVec const& states);
+            // Destruktor
+            ~StateJacobian();
+
+            // Anzahl Zustaende
+            inline size_t getDimension() const { return m_dim; };
+            // d(yd[row])/d(y[col]), NULL falls strukturell Null
+            inline BasicPtr const& get(size_t row, size_t col) const { return m_entries[row*m_dim+col]; };
+            // strukturell von Null verschiedene Eintraege, spaltenweise
+            SparseJacobian getSparse() const;
+            // Gleichungen fuer die Hilfsvariablen
+            inline std::vector<Assignment> const& getEquations() const { return m_equations; };
+            // Hilfsvariablen
+            inline VariableVec const& getVariables() const { return m_variables; };
+
+            // Element k (zeilenweise) eines Ausdrucks
+            static BasicPtr getElement(BasicPtr const& exp, size_t k);
+
+        protected:
+            EquationSystemPtr m_eqsys;
+            size_t m_dim;
+            BasicPtrVec m_entries;
+            std::vector<Assignment> m_equations;
+            VariableVec m_variables;
+            size_t m_counter;
+
+            // Spalte -> Ableitung
+            typedef std::map<size_t,BasicPtr> Row;
+            // Variable bzw. Element einer Variable -> Ableitungen nach den Zustaenden
+            typedef std::unordered_map<BasicPtr,Row,BasicPtrHash,BasicPtrEqual> RowMap;
+            RowMap m_rows;
+            // skalare Platzhalter fuer Variablen und Elemente, nach denen abgeleitet wird
+            BasicPtrHashMap m_placeholders;
+            BasicPtrHashMap m_atoms;
+
+            // Ableitungen eines Ausdrucks (Kettenregel ueber die Variablen)
+            Row getRow(BasicPtr const& exp);
+            void addScalar(BasicPtr const& lhs, BasicPtr const& exp);
+            void addSolve(BasicPtr const& lhs, BasicPtr const& solve);
+            // Ableitung als Hilfsvariable, falls sie nicht trivial ist
+            BasicPtr getTemp(BasicPtr const& exp);
+            SymbolPtr newSymbol(Shape const& shape);
+            BasicPtr getPlaceholder(BasicPtr const& atom);
+
+            // ersetzt Symbole nach einer Tabelle
+            class Replacer: public Basic::Iterator
+            {
+            public:
+                Replacer(BasicPtrHashMap const& map): m_map(map) {};
+                BasicPtr process_Arg(BasicPtr const &p);
+            protected:
+                BasicPtrHashMap const& m_map;
+            };
+         };
+/*****************************************************************************/
+    };
+};
+
+#endif // __STATEJACOBIAN_H_
@@ -5,6 +5,7 @@
 #include "Node.h"
 
 #include "intrusive_ptr.h"
+#include "RefCount.h"
 
 // Forward Declarations
 namespace Symbolics
@@ -40,6 +41,10 @@ namespace Symbolics
       // generate the internal graph
       virtual double buildGraph() = 0;
 
+      // nach Aenderungen am Gleichungssystem nur die betroffenen Knoten neu verknuepfen
+      // throws: InternalError
+      virtual double updateGraph(EquationPtrSet const& removed, EquationPtrSet const& added) = 0;
+
       // to GraphML
       virtual void toGraphML( std::string file ) = 0;
 
@@ -49,7 +54,7 @@ namespace Symbolics
 
     private:
       // Boost Intrusive Ptr
-      unsigned int m_refCount;
+      RefCount m_refCount;
       // friend
       friend void ::boost::intrusive_ptr_add_ref( const SystemHandler* p);
       friend void ::boost::intrusive_ptr_release( const SystemHandler* p);
@@ -65,7 +70,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::SystemHandler* b = const_cast<Symbolics::Graph::SystemHandler*>(p);
-    ++(b->m_refCount);
+    b->m_refCount.inc();
   }
 
   // decrement reference count, and delete object when reference count reaches 0
@@ -73,7 +78,7 @@ namespace boost
   {
     // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
     Symbolics::Graph::SystemHandler* b = const_cast<Symbolics::Graph::SystemHandler*>(p);
-    if (--(b->m_refCount) == 0)
+    if (b->m_refCount.dec())
       delete p;
   } 
 }; // namespace boost
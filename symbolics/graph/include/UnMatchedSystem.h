@@ -4,6 +4,7 @@
 #include <string>
 #include <map>
 #include <list>
+#include <vector>
 #include "Symbolics.h"
 #include "SystemHandler.h"
 
@@ -23,6 +24,10 @@ namespace Symbolics
       // 
       double buildGraph();
 
+      // nicht moeglich, die Zuordnung wird komplett neu gebildet
+      // throws: InternalError
+      double updateGraph(EquationPtrSet const& removed, EquationPtrSet const& added);
+
       // to GraphML
       void toGraphML( std::string file );
       void toGraphML_Sorted( std::string file );
@@ -31,15 +36,18 @@ namespace Symbolics
 
     protected:
 
+      typedef std::vector<size_t> SizeTVec;
+
       struct MSymbol
       {
         SymbolPtr symbol;
+        size_t id;
         size_t eqn;
         size_t dim1;
         size_t dim2;
         bool state;
         bool parameter;
-        MSymbol(SymbolPtr s, size_t d1, size_t d2): symbol(s), eqn(0),dim1(d1),dim2(d2), state(false), parameter(false) {;};
+        MSymbol(SymbolPtr s, size_t d1, size_t d2): symbol(s), id(0), eqn(0),dim1(d1),dim2(d2), state(false), parameter(false) {;};
       };
       typedef MSymbol* MSymbolPtr;
       typedef std::set<MSymbolPtr> MSymbolPtrSet;
@@ -52,8 +60,9 @@ namespace Symbolics
         BasicPtr rhs;
         size_t dim1;
         size_t dim2;
-        MSymbolPtrSet symbols;
-        MSymbolPtrSet states;
+        size_t id;
+        // ids der gefundenen Symbole (auch Zustaende), bis addEquation sie als Zeile uebernimmt
+        SizeTVec scanned;
         size_t number;
         size_t lowlink;
         MSymbol *symbol;
@@ -61,7 +70,7 @@ namespace Symbolics
         double t;
         size_t c;
         size_t c1;
-        MEquation(EquationPtr e, size_t d1, size_t d2): eqn(e),dim1(d1),dim2(d2),number(0),lowlink(0),symbol(NULL),onStack(false),t(0.0),c(0),c1(0) {;}; 
+        MEquation(EquationPtr e, size_t d1, size_t d2): eqn(e),dim1(d1),dim2(d2),id(0),number(0),lowlink(0),symbol(NULL),onStack(false),t(0.0),c(0),c1(0) {;}; 
       };
       typedef std::vector<MEquation*> MEquationPtrVec;
       MEquationPtrVec m_equations;
@@ -76,12 +85,21 @@ namespace Symbolics
       typedef std::map<EquationPtr,SizeTPairSet > EquationPtrSizeTSet;
       typedef std::map<SymbolPtr,SizeTPairSet > SymbolPtrSizeTSet;
 
-      typedef std::map<MSymbol*,MEquationPtrVec> IncidenceMatrixT;
-      IncidenceMatrixT m_incidencematrixT;
+      // Inzidenzmatrix ueber fortlaufende ids: MSymbol::id ist der Index in m_symbols,
+      // MEquation::id der Index in m_equations
+      MSymbolPtrVec m_symbols;
+      // Spalten: Gleichungen je Symbol
+      std::vector<MEquationPtrVec> m_symbolEqns;
+      // Zeilen (CSR): Symbole der Gleichung e sind m_rowSymbols[m_rowStart[e]] bis m_rowSymbols[m_rowStart[e+1]-1],
+      // Zustaende stehen mit drin (MSymbol::state)
+      SizeTVec m_rowStart;
+      SizeTVec m_rowSymbols;
+      inline size_t const* rowBegin( size_t e ) const { return m_rowSymbols.data() + m_rowStart[e]; };
+      inline size_t const* rowEnd( size_t e ) const { return m_rowSymbols.data() + m_rowStart[e+1]; };
       MSymbolPtrSet m_states;
       MSymbolPtrSet m_parameter;
 
-      std::map<BasicPtr,BasicPtr > symbolreplacemap;
+      BasicPtrHashMap symbolreplacemap;
 
       typedef std::map<MSymbol*,size_t> SymbolEqnMap;
       typedef std::map<size_t,MSymbol*> EqnSymbolMap;
@@ -89,17 +107,22 @@ namespace Symbolics
       double matchSystem();
 
       typedef std::set<size_t> SizeTSet;
-      bool pathFound(size_t e, SizeTSet &eqn_mark, MSymbolPtrSet &sym_mark,size_t &c);
+      // Stempel je id, markiert ist ein Eintrag gleich mark;
+      // die Symbole einer Gleichung werden in id (Anlege-) Reihenfolge besucht
+      typedef std::vector<size_t> MarkVec;
+      bool pathFound(size_t e, MarkVec &eqn_mark, MarkVec &sym_mark, size_t mark, size_t &c);
 
-      typedef std::vector<size_t> SizeTVec;
       typedef std::list<size_t> SizeTList;
       void strongConnect(size_t &i, MEquation* eqn, MEquationPtrVec &stack);
 
       void buildNodes();
 
       void addSymbolToIncidenceMatrix(SymbolPtr s);
+      MSymbol* newMSymbol(SymbolPtr s, size_t dim1, size_t dim2);
 
       void addEquationToIncidenceMatrix(MEquation* wrapper);
+      // Gleichung mit ihren gefundenen Symbolen als neue Zeile anhaengen
+      void addEquation(MEquation* wrapper);
 
       class DerRepl: public Basic::Iterator
       {
@@ -119,10 +142,10 @@ namespace Symbolics
       class SymbolRepl: public Basic::Iterator
       {
       public:
-          SymbolRepl(BasicPtrMap &symbolmap):m_symbolmap(symbolmap) {;}
+          SymbolRepl(BasicPtrHashMap &symbolmap):m_symbolmap(symbolmap) {;}
           ~SymbolRepl() {;}
           
-          BasicPtrMap &m_symbolmap;
+          BasicPtrHashMap &m_symbolmap;
 
           BasicPtr process_Arg(BasicPtr const &p);
       };
@@ -131,9 +154,9 @@ namespace Symbolics
       {
       public:
           SymbolScanner(MEquation* equation,
-            BasicPtr time, IncidenceMatrixT &incidencematrixT):
+            BasicPtr time):
             m_equation(equation), m_time(time),
-            m_incidencematrixT(incidencematrixT),inder(false) {;}
+            inder(false) {;}
           ~SymbolScanner() {;}
           bool process_Arg(BasicPtr const &p, bool &stop);
 
@@ -141,7 +164,6 @@ namespace Symbolics
           bool inder;
           MEquation* m_equation;
           BasicPtr m_time;
-          IncidenceMatrixT &m_incidencematrixT;
       };
     private:
       SymbolPtr m_time;
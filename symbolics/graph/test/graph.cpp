@@ -1,6 +1,12 @@
 #include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <set>
 #include "Symbolics.h"
 #include "Graph.h"
+#include "CostModel.h"
+#include "Scheduler.h"
 
 using namespace Symbolics;
 
@@ -187,6 +193,178 @@ int toGraphML( int &argc,  char *argv[])
 }
 
 
+std::vector<std::string> simplifiedModel( size_t threads )
+{
+    Graph::Graph gr;
+    SymbolPtr time = gr.getSymbol("time");
+    SymbolPtr c(new Symbol("c"));
+    gr.addSymbol(c);
+    gr.addExpression(c,BasicPtr(new Real(2.0)),false);
+    SymbolPtrVec z;
+    for (size_t j=0;j<20;++j)
+    {
+        SymbolPtr y(new Symbol("y"+str(j)));
+        z.push_back(SymbolPtr(new Symbol("z"+str(j))));
+        gr.addSymbol(y);
+        gr.addSymbol(z[j]);
+        // c wird eingesetzt, danach werden alle y parallel vereinfacht
+        gr.addExpression(y,Add::New(Mul::New(Sin::New(c),time),Mul::New(c,Int::New(j))),false);
+        gr.addExpression(z[j],Mul::New(Cos::New(y),Add::New(y,Mul::New(c,time))),false);
+    }
+    gr.buildGraph(true,threads);
+
+    std::vector<std::string> res;
+    std::vector<Graph::Assignment> eqns = gr.getAssignments(Symbolics::VARIABLE)->getEquations();
+    for (size_t i=0;i<eqns.size();++i)
+        res.push_back(eqns[i].lhs[0]->toString() + " = " + eqns[i].rhs[0]->toString());
+    std::sort(res.begin(),res.end());
+    return res;
+}
+
+size_t internedModel()
+{
+    // y haben zwei Kinder und bleiben erhalten
+    Graph::Graph gr;
+    SymbolPtr time = gr.getSymbol("time");
+    SymbolPtr c(new Symbol("c"));
+    gr.addSymbol(c);
+    gr.addExpression(c,BasicPtr(new Real(2.0)),false);
+    SymbolPtr q(new Symbol("q"));
+    gr.addSymbol(q);
+    gr.addExpression(Der::New(q),Sin::New(q),false);
+    SymbolPtrVec y;
+    for (size_t j=0;j<20;++j)
+    {
+        y.push_back(SymbolPtr(new Symbol("y"+str(j))));
+        SymbolPtr z(new Symbol("z"+str(j)));
+        SymbolPtr w(new Symbol("w"+str(j)));
+        gr.addSymbol(y[j]);
+        gr.addSymbol(z);
+        gr.addSymbol(w);
+        gr.addExpression(y[j],Add::New(Mul::New(Sin::New(c),q),Mul::New(c,Int::New(j))),false);
+        gr.addExpression(z,Mul::New(Cos::New(y[j]),Add::New(y[j],time)),false);
+        gr.addExpression(w,Mul::New(y[j],q),false);
+    }
+    gr.buildGraph(true,4);
+
+    // gleiche Teilausdruecke sind nach dem Eintragen in die Arena ein Knoten
+    std::set<Basic*> ptrs;
+    std::set<std::string> strs;
+    for (size_t j=0;j<y.size();++j)
+    {
+        BasicPtrVec order;
+        gr.getEquation(y[j])->getPostOrder(order);
+        for (size_t i=0;i<order.size();++i)
+        {
+            ptrs.insert(order[i].get());
+            strs.insert(order[i]->toString());
+        }
+    }
+    return ptrs.size() - strs.size();
+}
+
+int parallelSimplify( int &argc,  char *argv[])
+{
+    // Ergebnis darf nicht von der Anzahl der Threads abhaengen
+    std::vector<std::string> serial = simplifiedModel(1);
+    std::vector<std::string> parallel = simplifiedModel(4);
+    if (serial.size() != parallel.size()) return -20;
+    for (size_t i=0;i<serial.size();++i)
+    {
+        if (serial[i] != parallel[i])
+        {
+            std::cout << serial[i] << " != " << parallel[i] << std::endl;
+            return -21;
+        }
+    }
+    if (serial.size() == 0) return -22;
+    // ohne Arena im parallelen Abschnitt entstehen doppelte Teilausdruecke
+    if (internedModel() != 0) return -23;
+    return 0;
+}
+
+
+void buildCseModel( Graph::Graph &gr, bool optimize )
+{
+    SymbolPtr time = gr.getSymbol("time");
+    SymbolPtr a(new Symbol("a"));
+    SymbolPtr b(new Symbol("b"));
+    SymbolPtr z1(new Symbol("z1"));
+    SymbolPtr z2(new Symbol("z2"));
+    gr.addSymbol(a);
+    gr.addSymbol(b);
+    gr.addSymbol(z1);
+    gr.addSymbol(z2);
+    gr.addExpression(a,Sin::New(time),false);
+    gr.addExpression(b,Cos::New(time),false);
+    // a*b ist nur als Teil der Produkte vorhanden
+    BasicPtrVec args1;
+    args1.push_back(a);
+    args1.push_back(b);
+    args1.push_back(Sin::New(Mul::New(Int::New(3),time)));
+    BasicPtrVec args2;
+    args2.push_back(b);
+    args2.push_back(Cos::New(Mul::New(Int::New(5),time)));
+    args2.push_back(a);
+    gr.addExpression(z1,BasicPtr(new Mul(args1)),false);
+    gr.addExpression(z2,BasicPtr(new Mul(args2)),false);
+    gr.buildGraph(optimize);
+}
+
+std::vector<Graph::Assignment> cseModel( bool optimize )
+{
+    Graph::Graph gr;
+    buildCseModel(gr,optimize);
+    return gr.getAssignments(Symbolics::VARIABLE)->getEquations();
+}
+
+int commonSubexpressions( int &argc,  char *argv[])
+{
+    // ohne Optimierung keine Hilfsvariablen
+    std::vector<Graph::Assignment> eqns = cseModel(false);
+    for (size_t i=0;i<eqns.size();++i)
+        if (eqns[i].lhs[0]->toString().compare(0,4,"cse_") == 0) return -30;
+
+    eqns = cseModel(true);
+    size_t products = 0;
+    for (size_t i=0;i<eqns.size();++i)
+    {
+        if (eqns[i].lhs[0]->toString().compare(0,4,"cse_") != 0)
+            continue;
+        // vor der ersten Verwendung berechnet
+        for (size_t j=0;j<i;++j)
+            if (eqns[j].rhs[0]->has_FreeSymbol(eqns[i].lhs[0].get())) return -31;
+        if (eqns[i].rhs[0]->getType() != Type_Mul)
+            continue;
+        // a*b als Teilmenge beider Produkte
+        ++products;
+        if (eqns[i].rhs[0]->getArgsSize() != 2) return -32;
+        size_t uses = 0;
+        for (size_t j=i+1;j<eqns.size();++j)
+            if (eqns[j].rhs[0]->has_FreeSymbol(eqns[i].lhs[0].get())) ++uses;
+        if (uses != 2) return -33;
+    }
+    if (products != 1) return -34;
+
+    // wiederholter Aufruf: dieselben Hilfsvariablen, keine neuen Symbole
+    Graph::Graph gr;
+    buildCseModel(gr,true);
+    eqns = gr.getAssignments(Symbolics::VARIABLE)->getEquations();
+    size_t nvars = gr.getVariables(VARIABLE).size();
+    std::vector<Graph::Assignment> again = gr.getAssignments(Symbolics::VARIABLE)->getEquations();
+    if (gr.getVariables(VARIABLE).size() != nvars) return -35;
+    if (again.size() != eqns.size()) return -36;
+    for (size_t i=0;i<eqns.size();++i)
+        if ((again[i].lhs[0] != eqns[i].lhs[0]) || (again[i].rhs[0] != eqns[i].rhs[0])) return -36;
+    // cse = false (Keyword cse=False): keine Hilfsvariablen
+    again = gr.getAssignments(Symbolics::VARIABLE,0x00,false)->getEquations();
+    for (size_t i=0;i<again.size();++i)
+        if (again[i].lhs[0]->toString().compare(0,4,"cse_") == 0) return -37;
+    if (gr.getVariables(VARIABLE).size() != nvars) return -37;
+    return 0;
+}
+
+
 int LinearModel( int &argc,  char *argv[])
 {
     // Beispiel aufbauen
@@ -294,6 +472,313 @@ int NonLinearModel( int &argc,  char *argv[])
     return 0;
 }
 
+int operationCount( int &argc,  char *argv[])
+{
+    BasicPtr a(new Symbol("a"));
+    BasicPtr b(new Symbol("b"));
+    BasicPtr c(new Symbol("c"));
+
+    // a+b+c, 1/a
+    BasicPtrVec args;
+    args.push_back(a);
+    args.push_back(b);
+    args.push_back(c);
+    Graph::OperationCount n = Graph::CostModel::count(BasicPtr(new Add(args)));
+    if ((n.adds != 2) || (n.getFlops() != 2)) return -40;
+    n = Graph::CostModel::count(Pow::New(a,Int::getMinusOne()));
+    if ((n.divs != 1) || (n.getFlops() != 1)) return -41;
+    // ganzzahlige Potenzen als Multiplikationen: a^5 = (a^2)^2*a, a^-2 = 1/(a*a)
+    n = Graph::CostModel::count(Pow::New(a,Int::New(5)));
+    if ((n.muls != 3) || (n.functions != 0)) return -47;
+    n = Graph::CostModel::count(Pow::New(a,Int::New(-2)));
+    if ((n.muls != 1) || (n.divs != 1) || (n.functions != 0)) return -48;
+    n = Graph::CostModel::count(Pow::New(a,Real::New(0.5)));
+    if ((n.functions != 1) || (n.muls != 0)) return -49;
+
+    // s = sin(a)*b kommt zweimal vor und wird zweimal gezaehlt
+    BasicPtr s = Mul::New(Sin::New(a),b);
+    n = Graph::CostModel::count(Add::New(s,Mul::New(s,c)));
+    if ((n.adds != 1) || (n.muls != 3) || (n.functions != 2)) return -42;
+
+    // Matrix mal Vektor
+    BasicPtr M(new Symbol("M",Shape(3,3)));
+    BasicPtr v(new Symbol("v",Shape(3)));
+    n = Graph::CostModel::count(Mul::New(M,v));
+    if ((n.muls != 9) || (n.adds != 6)) return -43;
+
+    // Zwischenvariablen
+    if (!Graph::CostModel::is_Temporary(a)) return -44;
+    SymbolPtr q(new Symbol("q",Shape(1,1),STATE));
+    if (Graph::CostModel::is_Temporary(q)) return -45;
+    Graph::Assignment eq(a,Add::New(b,c));
+    n = Graph::CostModel::count(eq);
+    if ((n.temps != 1) || (n.adds != 1)) return -46;
+    return 0;
+}
+
+int stateJacobian( int &argc,  char *argv[])
+{
+    // der(q) = qd, der(qd) = -a*qd mit a = sin(q)
+    Graph::Graph gr;
+    SymbolPtr q(new Symbol("q"));
+    SymbolPtr qd(new Symbol("qd"));
+    SymbolPtr a(new Symbol("a"));
+    gr.addSymbol(q);
+    gr.addSymbol(qd);
+    gr.addSymbol(a);
+    gr.addExpression(a,Sin::New(q),false);
+    gr.addExpression(Der::New(q),qd,false);
+    gr.addExpression(Der::New(qd),Neg::New(Mul::New(a,qd)),false);
+    gr.buildGraph(false);
+    Graph::AssignmentsPtr as = gr.getAssignments(DER_STATE);
+    Graph::VariableVec states = as->getVariables(STATE);
+    Graph::StateJacobian jac = gr.getStateJacobian(as->getEquations(),states);
+    if (jac.getDimension() != 2) return -50;
+    size_t iq = (states[0]->toString() == "q") ? 0 : 1;
+    size_t iqd = 1-iq;
+    // d(der(q))/dq ist strukturell Null
+    if (jac.get(iq,iq).get() != NULL) return -51;
+    if (jac.get(iq,iqd) != Int::getOne()) return -52;
+    if (jac.get(iqd,iqd) != Neg::New(a)) return -53;
+    // -cos(q)*qd ueber eine Hilfsvariable
+    if (jac.get(iqd,iq).get() == NULL) return -54;
+    if (jac.getEquations().empty()) return -55;
+    for (size_t i=0;i<jac.getEquations().size();++i)
+        if (jac.getEquations()[i].lhs[0]->toString().compare(0,4,"jac_") != 0) return -56;
+    return 0;
+}
+
+// der(q) = c + d, c = b*b, b = a+1 bzw. b = 2*d, a = sin(q), d = cos(q)
+void incrementalModel( Graph::Graph &gr, bool changed )
+{
+    SymbolPtr q(new Symbol("q"));
+    SymbolPtr a(new Symbol("a"));
+    SymbolPtr b(new Symbol("b"));
+    SymbolPtr c(new Symbol("c"));
+    SymbolPtr d(new Symbol("d"));
+    gr.addSymbol(q);
+    gr.addSymbol(a);
+    gr.addSymbol(b);
+    gr.addSymbol(c);
+    gr.addSymbol(d);
+    gr.addExpression(a,Sin::New(q),false);
+    gr.addExpression(d,Cos::New(q),false);
+    if (changed)
+        gr.addExpression(b,Mul::New(Int::New(2),d),false);
+    else
+        gr.addExpression(b,Add::New(a,Int::getOne()),false);
+    gr.addExpression(c,Mul::New(b,b),false);
+    gr.addExpression(Der::New(q),Add::New(c,d),false);
+}
+
+std::vector<std::string> getAssignmentStrings( Graph::Graph &gr )
+{
+    std::vector<Graph::Assignment> const& eqns = gr.getAssignments(DER_STATE)->getEquations();
+    std::vector<std::string> res;
+    for (size_t i=0;i<eqns.size();++i)
+        res.push_back(eqns[i].lhs[0]->toString() + " = " + eqns[i].rhs[0]->toString());
+    return res;
+}
+
+int incrementalUpdate( int &argc,  char *argv[])
+{
+    Graph::Graph full;
+    incrementalModel(full,true);
+    full.buildGraph(false);
+    std::vector<std::string> expected = getAssignmentStrings(full);
+
+    Graph::Graph gr;
+    incrementalModel(gr,false);
+    gr.buildGraph(false);
+    if (getAssignmentStrings(gr).size() != 5) return -60;
+    SymbolPtr b = gr.getSymbol("b");
+    gr.changeExpression(b,Mul::New(Int::New(2),gr.getSymbol("d")));
+    gr.updateGraph();
+    std::vector<std::string> updated = getAssignmentStrings(gr);
+    // a wird nicht mehr gebraucht
+    if (updated.size() != 4) return -61;
+    // d vor b vor c
+    size_t id = std::find(updated.begin(),updated.end(),"d = cos(q)") - updated.begin();
+    size_t ib = std::find(updated.begin(),updated.end(),"b = (2 * d)") - updated.begin();
+    size_t ic = std::find(updated.begin(),updated.end(),"c = (b)^2") - updated.begin();
+    if ((ib >= updated.size()) || (id > ib) || (ib > ic)) return -62;
+    std::sort(expected.begin(),expected.end());
+    std::sort(updated.begin(),updated.end());
+    if (updated != expected) return -63;
+
+    // nicht geloeste Variable
+    SymbolPtr e(new Symbol("e"));
+    gr.addSymbol(e);
+    try
+    {
+        gr.changeExpression(e,Int::getOne());
+        return -64;
+    }
+    catch (Graph::VarUnknownError)
+    {
+    }
+
+    // nach der Optimierung sind die Gleichungen nicht mehr vollstaendig
+    Graph::Graph opt;
+    incrementalModel(opt,false);
+    opt.buildGraph(true);
+    try
+    {
+        opt.changeExpression(opt.getSymbol("b"),Int::getOne());
+        return -65;
+    }
+    catch (InternalError)
+    {
+    }
+    return 0;
+}
+
+int snapshot( int &argc,  char *argv[])
+{
+    std::string file = "graph_snapshot.bin";
+    std::vector<std::string> expected;
+    {
+        Graph::Graph gr;
+        incrementalModel(gr,false);
+        SymbolPtr m(new Symbol("m",PARAMETER));
+        gr.addSymbol(m,Real::New(2.5).get(),"mass");
+        gr.buildGraph(true);
+        expected = getAssignmentStrings(gr);
+        gr.saveSnapshot(file);
+    }
+
+    Graph::Graph gr;
+    gr.loadSnapshot(file);
+    std::vector<std::string> loaded = getAssignmentStrings(gr);
+    std::sort(expected.begin(),expected.end());
+    std::sort(loaded.begin(),loaded.end());
+    if (loaded != expected) return -70;
+    SymbolPtr m = gr.getSymbol("m");
+    if (m->getKind() != PARAMETER) return -71;
+    if (gr.getinitVal(m)->toString() != "2.5") return -72;
+    if (gr.getComment(m) != "mass") return -73;
+    if (gr.getVariables(STATE).size() != 1) return -74;
+
+    // nur in einen leeren Graphen
+    try
+    {
+        gr.loadSnapshot(file);
+        return -75;
+    }
+    catch (InternalError)
+    {
+    }
+
+    // keine Snapshot-Datei
+    {
+        std::ofstream f(file.c_str());
+        f << "no snapshot, but long enough for a header of a snapshot file......................................" << std::endl;
+    }
+    try
+    {
+        Graph::Graph g;
+        g.loadSnapshot(file);
+        return -76;
+    }
+    catch (InternalError)
+    {
+    }
+    std::remove(file.c_str());
+    return 0;
+}
+
+int scheduler( int &argc,  char *argv[])
+{
+    BasicPtr x(new Symbol("x"));
+    BasicPtr y(new Symbol("y",Shape(4)));
+    std::vector<BasicPtr> a;
+    std::vector<Graph::Assignment> eqns;
+    // y = 0, dann a_i = sin(i*x) fuer alle i und erst danach y[i] = a_i*a_i
+    eqns.push_back(Graph::Assignment(y,Zero::getZero(Shape(4))));
+    for (size_t i=0;i<4;++i)
+    {
+        a.push_back(BasicPtr(new Symbol("a_" + str(i))));
+        eqns.push_back(Graph::Assignment(a[i],Sin::New(Mul::New(Int::New(i+1),x))));
+    }
+    for (size_t i=0;i<4;++i)
+        eqns.push_back(Graph::Assignment(Element::New(y,i,0),Mul::New(a[i],a[i])));
+    if (Graph::Scheduler::getMaxLive(eqns) != 4) return -80;
+
+    std::vector<Graph::Assignment> scheduled(eqns);
+    Graph::Scheduler s(scheduled);
+    s.schedule();
+    if (scheduled.size() != eqns.size()) return -81;
+    if (Graph::Scheduler::getMaxLive(scheduled) != 1) return -82;
+    // y = 0 bleibt vor den Elementen, jedes y[i] direkt nach a_i
+    if (scheduled[0].lhs[0] != y) return -83;
+    for (size_t i=0;i<4;++i)
+    {
+        if (scheduled[1+2*i].lhs[0] != a[i]) return -84;
+        if (scheduled[2+2*i].rhs[0]->getArg(0) != a[i]) return -85;
+    }
+
+    // nichts zu gewinnen: Reihenfolge bleibt
+    std::vector<Graph::Assignment> chain;
+    chain.push_back(Graph::Assignment(a[0],Sin::New(x)));
+    chain.push_back(Graph::Assignment(a[1],Cos::New(a[0])));
+    chain.push_back(Graph::Assignment(a[2],Mul::New(a[0],a[1])));
+    scheduled = chain;
+    Graph::Scheduler(scheduled).schedule();
+    for (size_t i=0;i<chain.size();++i)
+        if (scheduled[i].lhs[0] != chain[i].lhs[0]) return -86;
+    return 0;
+}
+
+int matchedModel()
+{
+    // implizite Gleichungen 0 = x_1 + .. + x_k - k*(k+1)/2, die Loesung ist x_k = k;
+    // jede Gleichung nimmt zuerst das freie Symbol mit der kleinsten id, daher
+    // brauchen die Durchlaeufe erweiternde Pfade ueber schon markierte Symbole
+    const size_t n = 6;
+    Graph::Graph gr;
+    std::vector<SymbolPtr> x;
+    for (size_t k=0;k<n;++k)
+    {
+        x.push_back(SymbolPtr(new Symbol("x_" + str(k+1))));
+        gr.addSymbol(x[k]);
+    }
+    BasicPtr sum = Zero::getZero();
+    for (size_t k=0;k<n;++k)
+    {
+        sum = Add::New(sum,x[k]);
+        gr.addExpression(BasicPtr(),Add::New(sum,Int::New(-(int)((k+1)*(k+2)/2))),true);
+    }
+    gr.buildGraph(false);
+    std::vector<Graph::Assignment> eqns = gr.getAssignments(Symbolics::VARIABLE)->getEquations();
+    if (eqns.size() != n) return -87;
+    // der Reihe nach einsetzen, jede Zuweisung muss eine Zahl ergeben
+    std::map<BasicPtr,int> values;
+    for (size_t i=0;i<eqns.size();++i)
+    {
+        BasicPtr rhs = eqns[i].rhs[0];
+        for (std::map<BasicPtr,int>::iterator ii=values.begin();ii!=values.end();ii++)
+            rhs = rhs->subs(ii->first,Int::New(ii->second));
+        rhs = rhs->simplify();
+        if (rhs->getType() != Type_Int) return -88;
+        values[eqns[i].lhs[0]] = Util::getAsConstPtr<Int>(rhs)->getValue();
+    }
+    for (size_t k=0;k<n;++k)
+        if (values[x[k]] != (int)(k+1)) return -89;
+    return 0;
+}
+
+int matching( int &argc,  char *argv[])
+{
+    // die Gleichungen liegen in Zeigerreihenfolge vor, mehrere Aufbauten
+    // durchlaufen daher verschiedene Pfade
+    for (size_t i=0;i<16;++i)
+    {
+        int res = matchedModel();
+        if (res != 0) return res;
+    }
+    return 0;
+}
+
 int main( int argc,  char *argv[])
 {
     int res = 0;
@@ -308,6 +793,22 @@ int main( int argc,  char *argv[])
         if (res !=0) return res;
         res = toGraphML(argc,argv);
         if (res !=0) return res;
+        res = parallelSimplify(argc,argv);
+        if (res !=0) return res;
+        res = commonSubexpressions(argc,argv);
+        if (res !=0) return res;
+        res = operationCount(argc,argv);
+        if (res !=0) return res;
+        res = stateJacobian(argc,argv);
+        if (res !=0) return res;
+        res = incrementalUpdate(argc,argv);
+        if (res !=0) return res;
+        res = snapshot(argc,argv);
+        if (res !=0) return res;
+        res = scheduler(argc,argv);
+        if (res !=0) return res;
+        res = matching(argc,argv);
+        if (res !=0) return res;
     }
     if(!t)
     {
@@ -0,0 +1,33 @@
+#ifndef __ADJOINT_H_
+#define __ADJOINT_H_
+
+#include "Basic.h"
+
+// Declarations
+namespace Symbolics
+{
+    /*****************************************************************************/
+    // Rueckwaertsmodus (adjungierte Ableitung) ueber den Ausdrucksgraphen:
+    // Ein Durchlauf von der Wurzel zu den Blaettern liefert alle partiellen
+    // Ableitungen eines Skalars auf einmal. Die Adjungierte eines mehrfach
+    // verwendeten Teilausdrucks wird einmal gebildet und von allen Argumenten
+    // gemeinsam verwendet. Die lokalen Ableitungen kommen aus den der()
+    // der einzelnen Knoten, das Ergebnis stimmt daher mit jacobian() ueberein.
+    class Adjoint
+    {
+    private:
+        Adjoint();
+        ~Adjoint();
+
+    public:
+        // Gradient von exp (Skalar) nach symbols (Vektor aus Symbolen), Shape(n)
+        // throws: InternalError
+        static BasicPtr gradient( BasicPtr const& exp, BasicPtr const& symbols );
+
+    protected:
+        // lokale Ableitungen eines Knotens mit skalaren Argumenten nach diesen
+        static BasicPtrVec getPartials( BasicPtr const& node, std::vector<bool> const& active );
+    };
+    /*****************************************************************************/
+};
+#endif // __ADJOINT_H_
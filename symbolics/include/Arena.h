@@ -0,0 +1,75 @@
+#ifndef __ARENA_H_
+#define __ARENA_H_
+
+#include <unordered_map>
+#include "Basic.h"
+
+// Declarations
+namespace Symbolics
+{
+    /*****************************************************************************/
+    // Hash-Consing fuer Ausdruecke:
+    // Strukturell gleiche Knoten (gleicher Typ, Shape, Wert und identische
+    // Argument-Pointer) werden nur einmal angelegt. Die Tabelle haelt nur rohe
+    // Pointer (kein RefCount), ein Knoten traegt sich in seinem Destruktor aus.
+    // Symbol und Matrix werden nicht eingetragen, da sie nach dem Anlegen
+    // noch veraendert werden (Zustand bzw. set()).
+    class Arena
+    {
+    private:
+        Arena();
+        ~Arena();
+
+    public:
+        // frisch angelegten Knoten eintragen oder den vorhandenen gleichen zurueckgeben
+        static BasicPtr intern( Basic *node );
+
+        // Knoten austragen (aus ~Basic)
+        static void remove( Basic const* node );
+
+        // alle Knoten des Ausdrucks eintragen, von unten nach oben; Eltern, deren
+        // Argumente schon vorhanden waren, werden neu gebaut (nach ParallelSection)
+        static BasicPtr internTree( BasicPtr const& exp );
+
+        // Anzahl der eingetragenen Knoten
+        static size_t size();
+
+        // aus: intern() legt immer neue Knoten an (parallele Abschnitte, siehe
+        // PastOptimisation), darf nur ausserhalb der Threads umgeschaltet werden
+        static inline void setEnabled( bool enabled ) { s_enabled = enabled; };
+        static inline bool is_Enabled() { return s_enabled; };
+
+    protected:
+        typedef std::unordered_multimap<size_t, Basic*> NodeMap;
+        static NodeMap& getNodes();
+
+        static size_t calcKey( Basic const* node );
+        static bool isSame( Basic const* lhs, Basic const* rhs );
+
+        static bool s_enabled;
+    };
+    /*****************************************************************************/
+
+    /*****************************************************************************/
+    // Arena und Elternlisten fuer die Dauer paralleler Threads umschalten
+    // (PastOptimisation, Writer::runStages), nur ausserhalb der Threads anlegen
+    class ParallelSection
+    {
+    public:
+        ParallelSection(): m_arena(Arena::is_Enabled())
+        {
+            // gemeinsame Knoten aus der Arena wuerden die Threads verbinden
+            Arena::setEnabled(false);
+            Basic::setLockParents(true);
+        }
+        ~ParallelSection()
+        {
+            Basic::setLockParents(false);
+            Arena::setEnabled(m_arena);
+        }
+    protected:
+        bool m_arena;
+    };
+    /*****************************************************************************/
+};
+#endif // __ARENA_H_
@@ -0,0 +1,81 @@
+#ifndef __ARGUMENT_LIST_H_
+#define __ARGUMENT_LIST_H_
+
+#include <new>
+#include <utility>
+#include "Basic.h"
+
+namespace Symbolics
+{
+    /*****************************************************************************/
+    // Argumente eines NaryOp
+    // Bis zu InlineSize Argumente liegen direkt im Knoten (keine Allokation),
+    // erst darueber wird Speicher angefordert. Beim Umziehen werden die
+    // Argumente verschoben, nicht kopiert, damit die Eltern-Registrierung
+    // im Kind nur umgehaengt wird.
+    class ArgumentList
+    {
+    public:
+        static const size_t InlineSize = 4;
+
+        // Konstruktor
+        ArgumentList(): m_data(reinterpret_cast<Argument*>(m_inline)), m_size(0), m_capacity(InlineSize) {};
+        // Destruktor
+        ~ArgumentList()
+        {
+            clear();
+            if (!is_Inline())
+                ::operator delete(m_data);
+        };
+
+        inline size_t size() const { return m_size; };
+        inline Argument& operator[](size_t i) { return m_data[i]; };
+        inline Argument const& operator[](size_t i) const { return m_data[i]; };
+
+        inline void reserve(size_t n) { if (n > m_capacity) grow(n); };
+        // Argument direkt an seinem Platz anlegen
+        inline void push_back(Basic* parent, BasicPtr const& arg)
+        {
+            if (m_size == m_capacity)
+                grow(2*m_capacity);
+            new (m_data+m_size) Argument(parent,arg);
+            ++m_size;
+        };
+        inline void clear()
+        {
+            for (size_t i=0; i<m_size; ++i)
+                m_data[i].~Argument();
+            m_size = 0;
+        };
+
+    protected:
+        inline bool is_Inline() const { return m_data == reinterpret_cast<Argument const*>(m_inline); };
+
+        void grow(size_t n)
+        {
+            Argument *data = static_cast<Argument*>(::operator new(n*sizeof(Argument)));
+            for (size_t i=0; i<m_size; ++i)
+            {
+                new (data+i) Argument(std::move(m_data[i]));
+                m_data[i].~Argument();
+            }
+            if (!is_Inline())
+                ::operator delete(m_data);
+            m_data = data;
+            m_capacity = n;
+        };
+
+        Argument *m_data;
+        size_t m_size;
+        size_t m_capacity;
+        alignas(Argument) unsigned char m_inline[InlineSize*sizeof(Argument)];
+
+    private:
+        // nicht kopierbar, die Argumente gehoeren zu genau einem Knoten
+        ArgumentList( ArgumentList const& );
+        ArgumentList& operator=( ArgumentList const& );
+    };
+    /*****************************************************************************/
+};
+
+#endif // __ARGUMENT_LIST_H_
@@ -5,16 +5,20 @@
 #include <string>
 #include <set>
 #include <map>
+#include <functional>
+#include <mutex>
 #include "Shape.h"
 #include <cassert>
 
 #include "intrusive_ptr.h"
+#include "RefCount.h"
 
 // Forward Declarations
 namespace Symbolics
 {
     class Basic;
     class Argument;
+    class Arena;
 };
 
 namespace boost
@@ -103,6 +107,7 @@ namespace Symbolics
 
         // Vereinfachen, wenn unver�ndert, dann NULL
         virtual BasicPtr simplify()  = 0;
+        inline bool is_Simplified() const { return m_simplified; };
 
         // Vergleich
         virtual bool operator==(  Basic const& rhs ) const  = 0;
@@ -122,6 +127,13 @@ namespace Symbolics
         BasicSizeTMap getAtomsAmound();
         virtual void getAtoms(BasicSizeTMap &atoms)  = 0;
 
+        // freie Symbole, nach Adresse sortiert; einmal von unten nach oben berechnet und am
+        // Knoten gemerkt, bis changed() oder ein neues Argument (hashChanged()) sie verwirft
+        typedef std::vector< Basic* > FreeSymbols;
+        FreeSymbols const& getFreeSymbols();
+        // kommt das Symbol (oder eines mit gleichem Namen) im Ausdruck vor
+        bool has_FreeSymbol( Basic const* symbol );
+
         // args
         virtual size_t getArgsSize() const = 0;
         virtual BasicPtr const& getArg(size_t i) const = 0;
@@ -133,47 +145,69 @@ namespace Symbolics
 
         BasicPtr solve(BasicPtr exp);
 
-        // hash
-        virtual inline size_t getHash() const { return m_hash; };
+        // hash, strukturell: gleiche Ausdruecke (operator==) haben den gleichen Hash
+        virtual inline size_t getHash() const { if (!m_hashValid) const_cast<Basic*>(this)->calcHash(); return m_hash; };
+        // zwei Knoten aus der Arena an verschiedenen Adressen: ungleich, wenn der Hash verschieden
+        // ist (gleich sein koennen sie nur ueber gleichnamige Symbole, die nicht eingetragen werden)
+        inline bool is_InternedDifferent( Basic const& rhs ) const { return m_interned && rhs.m_interned && (this != &rhs) && (getHash() != rhs.getHash()); };
+
+        // Singletons (Int::one, Zero::zero, ...) werden nie freigegeben und nicht gezaehlt
+        static inline BasicPtr immortal( Basic *b ) { b->m_refCount.setImmortal(); return BasicPtr(b); };
+
+        // alle Knoten von unten nach oben (post-order), gemeinsame Teilausdruecke nur einmal;
+        // eigener Stack statt Rekursion, Grundlage fuer iterateExp, getAtoms und Util::simplify
+        void getPostOrder(BasicPtrVec &order);
 
         // iterate through the expression
+        // process_Arg wird von unten nach oben aufgerufen, fuer gemeinsame Teilausdruecke
+        // nur einmal (ein Iterator darf daher nicht zaehlen)
         class Iterator
         {
         public:
           virtual BasicPtr process_Arg(BasicPtr const &p) = 0;
         };
-        virtual  BasicPtr iterateExp(Iterator &v);
+        BasicPtr iterateExp(Iterator &v);
+        // neuer Knoten gleicher Art mit anderen Argumenten (iterateExp), Blaetter liefern sich selbst
+        virtual BasicPtr newBasic( BasicPtrVec &args );
 
         class Scanner
         {
         public:
-            virtual bool process_Arg(BasicPtr const &p, bool &stop) = 0;
+          // unique: gemeinsame Teilausdruecke nur einmal durchsuchen, nur fuer Scanner, die nicht zaehlen
+          Scanner( bool unique = false ): m_unique(unique) {;}
+          virtual bool process_Arg(BasicPtr const &p, bool &stop) = 0;
+          inline bool is_Unique() const { return m_unique; };
+        protected:
+          bool m_unique;
         };
         // stops if Scanner return false, itterates the expression top-down
-        virtual void scanExp(Scanner &s);
+        void scanExp(Scanner &s);
 
   		// Parent
         // Wir halten hier direkt den Pointer, damit der Refcount nicht erhoeht wird und sich keine zirkulaeren Bezuege ergeben
-		    inline void addParent( ArgumentPtr parent ) { m_parents.insert( parent ); };
-		    inline void removeParent( ArgumentPtr parent ) 
-		    { 
-			    if(m_parents.erase( parent ) != 1) 
-				    throw InternalError("Hier ist was faul mit Papi");
-		    };
-		    inline void clearParents() { m_parents.clear(); };
-		    typedef std::set<ArgumentPtr> ArgumentPtrSet;
-		    inline ArgumentPtrSet& getParents() { return m_parents; };
-        inline size_t getParentsSize() const { return m_parents.size(); };
+        // Die Eltern bilden eine doppelt verkettete Liste ueber die Arguments (ohne Allokation)
+		    inline void addParent( ArgumentPtr parent );
+		    inline void removeParent( ArgumentPtr parent );
+		    // Argument ist umgezogen (ArgumentList), nur umhaengen
+		    inline void moveParent( ArgumentPtr from, ArgumentPtr to );
+		    // erstes Argument, weiter mit Argument::getNextParent()
+		    inline ArgumentPtr getFirstParent() const { return m_firstParent; };
+        inline size_t getParentsSize() const { return m_parentsSize; };
+        // an: Elternliste wird beim Aendern gesperrt (Symbole und Konstanten werden von
+        // mehreren Threads geteilt), darf nur ausserhalb der Threads umgeschaltet werden
+        static inline void setLockParents( bool lock ) { s_lockParents = lock; };
 
         class LookFor: public Scanner
         {
         public:
-            LookFor(BasicPtr const &lookfor) :m_lookfor(lookfor),found(false) {;}
+            LookFor(BasicPtr const &lookfor) :Scanner(true),m_lookfor(lookfor),m_symbols(lookfor->getFreeSymbols()),found(false) {;}
             ~LookFor() {;}
             bool process_Arg(BasicPtr const &p, bool &stop);
             bool found;
         protected:
             BasicPtr m_lookfor;
+            // nur Teilausdruecke mit allen diesen Symbolen koennen m_lookfor enthalten
+            FreeSymbols m_symbols;
         };
 
     protected:
@@ -185,18 +219,55 @@ namespace Symbolics
         bool m_simplified;
         // hash
         size_t m_hash;
+        bool m_hashValid;
 
+        // berechnet m_hash aus Typ, Shape und den Hashes der Argumente
         virtual void calcHash();
 
+        // freie Symbole, Symbol: sich selbst (Konstruktor), andere Blaetter: leer
+        FreeSymbols m_freeSymbols;
+        bool m_freeSymbolsValid;
+
+        // getAtoms ohne Rekursion (fuer UnaryOp, BinaryOp, NaryOp)
+        void collectAtoms(BasicSet &atoms);
+        void collectAtoms(BasicSizeTMap &atoms);
+        // Hash und freie Symbole ungueltig machen, bei allen Eltern ebenfalls
+        void hashChanged();
+        static inline void hashCombine( size_t &seed, size_t value ) { seed ^= value + 0x9e3779b9 + (seed<<6) + (seed>>2); };
+        // Konstanten: Int(2) == Real(2.0), daher ueber den Zahlenwert
+        static inline size_t hashValue( double value ) { return std::hash<double>()(value); };
+
 		    // Referenz auf Parent, Referenz damit RefCount nicht veraendert wird und sich damit keine zirulaere Referenz ergibt
-		    ArgumentPtrSet m_parents;
+		    ArgumentPtr m_firstParent;
+		    size_t m_parentsSize;
+		    inline void linkParent( ArgumentPtr parent );
+		    inline void unlinkParent( ArgumentPtr parent );
+		    inline void relinkParent( ArgumentPtr from, ArgumentPtr to );
+		    std::mutex& getParentsMutex() const;
+		    static bool s_lockParents;
+
+        // Kopie ohne Eltern, RefCount und Arena-Eintrag
+        Basic( Basic const& src );
 
         void changed();
 
+        // Ergebnis von simplify(), falls es nicht dieser Knoten selbst ist (dann m_simplified),
+        // wird durch Einsetzen (changed()) oder neue Argumente, auch tiefer im Baum
+        // (hashChanged()), verworfen. Der Hash wird vorher berechnet, damit hashChanged()
+        // von unten nicht vor diesem Knoten abbricht.
+        BasicPtr m_simplifyCache;
+        inline BasicPtr const& setSimplifyCache( BasicPtr const& res ) { if (res.get() != this) { getHash(); m_simplifyCache = res; } return res; };
+        inline void clearSimplifyCache() { if (m_simplifyCache.get() != NULL) m_simplifyCache = BasicPtr(); };
+
+        // Hash-Consing (siehe Arena)
+        bool m_interned;
+        size_t m_arenaKey;
+        friend class Arena;
+
         class LookForMultiple: public Scanner
         {
         public:
-            LookForMultiple(BasicSet &lookfor) :m_lookfor(lookfor),found(false) {;}
+            LookForMultiple(BasicSet &lookfor) :Scanner(true),m_lookfor(lookfor),found(false) {;}
             ~LookForMultiple() {;}
             bool process_Arg(BasicPtr const &p, bool &stop);
             bool found;
@@ -205,7 +276,10 @@ namespace Symbolics
         };
     private:
         // Boost Intrusive Ptr
-        unsigned int m_refCount;
+        RefCount m_refCount;
+        // loescht den Knoten; Argumente, die dabei frei werden, erst danach
+        // (Schleife statt Rekursion, tiefe Ausdruecke sprengen sonst den Stack)
+        static void destroy( Basic* b );
         // friend
         friend void ::boost::intrusive_ptr_add_ref( const Basic* p);
         friend void ::boost::intrusive_ptr_release( const Basic* p);
@@ -217,15 +291,21 @@ namespace Symbolics
       {
       public:
         // Konstruktor
-        Argument(): m_parent(0)  {;}
-        Argument(Basic* parent): m_parent(0) { if(parent) m_parent = parent;}
-        Argument(Basic* parent, BasicPtr arg): m_parent(0) { if(parent) m_parent = parent; setArg(arg); }
-        Argument(BasicPtr arg): m_parent(0) { setArg(arg); }
-        Argument(const Argument& a): m_parent(0)
+        Argument(): m_parent(0), m_prevParent(0), m_nextParent(0)  {;}
+        Argument(Basic* parent): m_parent(0), m_prevParent(0), m_nextParent(0) { if(parent) m_parent = parent;}
+        Argument(Basic* parent, BasicPtr arg): m_parent(0), m_prevParent(0), m_nextParent(0) { if(parent) m_parent = parent; setArg(arg); }
+        Argument(BasicPtr arg): m_parent(0), m_prevParent(0), m_nextParent(0) { setArg(arg); }
+        Argument(const Argument& a): m_parent(0), m_prevParent(0), m_nextParent(0)
         {
           setArg(a.m_arg);
           registerParent(a.m_parent);
         };
+        // Verschieben: Registrierung beim Kind wird nur umgehaengt
+        Argument(Argument&& a) noexcept: m_parent(a.m_parent), m_prevParent(0), m_nextParent(0)
+        {
+          m_arg.swap(a.m_arg);
+          if (m_arg.get() != NULL) m_arg->moveParent(&a,this);
+        };
         // Destruktor
         ~Argument() { unregisterParent(); }
         // Argument
@@ -235,13 +315,94 @@ namespace Symbolics
         inline void registerParent( Basic* parent ) { if(parent) m_parent = parent; }
         inline void unregisterParent() { m_parent=0; if (m_arg.get() != NULL) m_arg->removeParent(this); m_arg=NULL; }
         inline BasicPtr getParent() const { return BasicPtr(m_parent); };
+        // naechstes Argument, das auf das gleiche Kind zeigt
+        inline Argument* getNextParent() const { return m_nextParent; };
       protected:
         // Argument
         BasicPtr m_arg;
         // Parent
         Basic* m_parent;
+        // Verkettung in der Elternliste des Kindes (Basic::m_firstParent)
+        Argument* m_prevParent;
+        Argument* m_nextParent;
+
+        friend class Basic;
       };
     /*****************************************************************************/
+
+    /*****************************************************************************/
+    inline void Basic::addParent( ArgumentPtr parent )
+    {
+        if (s_lockParents)
+        {
+            std::lock_guard<std::mutex> lock(getParentsMutex());
+            linkParent(parent);
+        }
+        else
+            linkParent(parent);
+    }
+
+    inline void Basic::removeParent( ArgumentPtr parent )
+    {
+        if (s_lockParents)
+        {
+            std::lock_guard<std::mutex> lock(getParentsMutex());
+            unlinkParent(parent);
+        }
+        else
+            unlinkParent(parent);
+    }
+
+    inline void Basic::moveParent( ArgumentPtr from, ArgumentPtr to )
+    {
+        if (s_lockParents)
+        {
+            std::lock_guard<std::mutex> lock(getParentsMutex());
+            relinkParent(from,to);
+        }
+        else
+            relinkParent(from,to);
+    }
+
+    inline void Basic::linkParent( ArgumentPtr parent )
+    {
+        parent->m_prevParent = NULL;
+        parent->m_nextParent = m_firstParent;
+        if (m_firstParent != NULL)
+            m_firstParent->m_prevParent = parent;
+        m_firstParent = parent;
+        ++m_parentsSize;
+    }
+
+    inline void Basic::unlinkParent( ArgumentPtr parent )
+    {
+        if (parent->m_prevParent != NULL)
+            parent->m_prevParent->m_nextParent = parent->m_nextParent;
+        else if (m_firstParent == parent)
+            m_firstParent = parent->m_nextParent;
+        else
+            throw InternalError("Hier ist was faul mit Papi");
+        if (parent->m_nextParent != NULL)
+            parent->m_nextParent->m_prevParent = parent->m_prevParent;
+        parent->m_prevParent = NULL;
+        parent->m_nextParent = NULL;
+        --m_parentsSize;
+    }
+
+    inline void Basic::relinkParent( ArgumentPtr from, ArgumentPtr to )
+    {
+        to->m_prevParent = from->m_prevParent;
+        to->m_nextParent = from->m_nextParent;
+        if (to->m_prevParent != NULL)
+            to->m_prevParent->m_nextParent = to;
+        else
+            m_firstParent = to;
+        if (to->m_nextParent != NULL)
+            to->m_nextParent->m_prevParent = to;
+        from->m_prevParent = NULL;
+        from->m_nextParent = NULL;
+    }
+    /*****************************************************************************/
 };
 
 /*****************************************************************************/
@@ -252,7 +413,7 @@ namespace boost
     {
         // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
         Symbolics::Basic* b = const_cast<Symbolics::Basic*>(p);
-        ++(b->m_refCount);
+        b->m_refCount.inc();
     }
 
     // decrement reference count, and delete object when reference count reaches 0
@@ -260,8 +421,8 @@ namespace boost
     {
         // Muss sein, da ich sonst keine  Basics in intrusive Ptr legen kann
         Symbolics::Basic* b = const_cast<Symbolics::Basic*>(p);
-        if (--(b->m_refCount) == 0)
-            delete p;
+        if (b->m_refCount.dec())
+            Symbolics::Basic::destroy(b);
     } 
 
 }; // namespace boost
@@ -47,8 +47,8 @@ namespace Symbolics
         void getAtoms(BasicSizeTMap &atoms);
 
     protected:
-        inline void setArg1( BasicPtr const& arg) { m_arg1.setArg(arg); };
-        inline void setArg2( BasicPtr const& arg) { m_arg2.setArg(arg); };
+        inline void setArg1( BasicPtr const& arg) { m_arg1.setArg(arg); hashChanged(); };
+        inline void setArg2( BasicPtr const& arg) { m_arg2.setArg(arg); hashChanged(); };
         inline void simplifyArgs() { setArg1(getArg1()->simplify()); setArg2(getArg2()->simplify()); };
 
     private:
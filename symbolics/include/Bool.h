@@ -22,7 +22,7 @@ namespace Symbolics
         
         inline bool getValue() const { return m_value; };
 
-        static BasicPtr New( const bool b) { return BasicPtr(new Bool(b)); };
+        static BasicPtr New( const bool b);
 
         inline std::string toString() const { return str(m_value); };
 
@@ -38,7 +38,7 @@ namespace Symbolics
 
         // Ersetzen
          BasicPtr subs( ConstBasicPtr const& old_exp,  BasicPtr const& new_exp);
-         BasicPtr iterateExp(Symbolics::Basic::Iterator &v);
+         BasicPtr newBasic( BasicPtrVec &args );
 
         // atoms
          inline void getAtoms(BasicSet &atoms) {};
@@ -55,6 +55,8 @@ namespace Symbolics
     protected:
          bool m_value;
 
+         void calcHash();
+
          static BasicPtr getArgres;
     };
 
@@ -32,7 +32,7 @@ namespace Symbolics
 
         // Ersetzen
         BasicPtr subs( ConstBasicPtr const& old_exp,  BasicPtr const& new_exp);
-        BasicPtr iterateExp(Symbolics::Basic::Iterator &v);
+        BasicPtr newBasic( BasicPtrVec &args );
 
         // atoms
         inline void getAtoms(BasicSet &atoms) {};
@@ -17,6 +17,8 @@ namespace filesystem
     void copy(std::string src_path, std::string dst_path);
     void remove(std::string path);
     bool is_regular(std::string path);
+    // Groesse und Aenderungszeit (Sekunden), false wenn es die Datei nicht gibt
+    bool file_info(std::string path, long long &size, long long &mtime);
 }
 
 #endif // __FILESYSTEM_H_
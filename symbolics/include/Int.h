@@ -53,7 +53,7 @@ namespace Symbolics
 
         // Ersetzen
         BasicPtr subs( ConstBasicPtr const& old_exp,  BasicPtr const& new_exp);
-        BasicPtr iterateExp(Symbolics::Basic::Iterator &v);
+        BasicPtr newBasic( BasicPtrVec &args );
 
         // atoms
         inline void getAtoms(BasicSet &atoms) {};
@@ -75,6 +75,8 @@ namespace Symbolics
     protected:
         int m_value;
 
+        void calcHash();
+
         static BasicPtr one;
         static BasicPtr minusOne;
 
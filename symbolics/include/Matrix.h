@@ -30,7 +30,7 @@ namespace Symbolics
         // Vereinfachen, wenn unver�ndert, dann NULL
         BasicPtr simplify();
 
-        BasicPtr iterateExp(Symbolics::Basic::Iterator &v);
+        BasicPtr newBasic( BasicPtrVec &args );
 
         // Vergleich
         bool operator==( Basic const& rhs) const;
@@ -154,6 +154,8 @@ namespace Symbolics
         
     protected:
         virtual inline size_t getIndex(size_t row, size_t col) const { return row*m_shape.getDimension(2) + col; };
+
+        void calcHash();
         
         inline void changeShape( Shape const& newShape, bool fillZeros=true )
         {
@@ -2,6 +2,7 @@
 #define __NARY_OP_H_
 
 #include "Basic.h"
+#include "ArgumentList.h"
 #include <vector>
 
 namespace Symbolics
@@ -39,15 +40,15 @@ namespace Symbolics
         std::string join( std::string const& posSep,
                            std::string const& negSep) const;
 
-        inline void setArg(size_t i, BasicPtr const& arg) { m_args[i].setArg(arg); };
-        inline void clearArgs() {	m_args.clear(); };
+        inline void setArg(size_t i, BasicPtr const& arg) { m_args[i].setArg(arg); hashChanged(); };
+        inline void clearArgs() {	m_args.clear(); hashChanged(); };
         inline void reserveArgs(size_t n) { m_args.reserve(n); };
-        inline void addArg( BasicPtr const& arg ) { m_args.push_back(Argument(this,arg)); };
+        inline void addArg( BasicPtr const& arg ) { m_args.push_back(this,arg); hashChanged(); };
         inline void simplifyArgs() { for (size_t i=0; i<m_args.size(); ++i) setArg(i,m_args[i].getArg()->simplify()); };
         
     private:
         // Arguments
-        ArgumentPtrVec m_args;
+        ArgumentList m_args;
     };
 
     typedef boost::intrusive_ptr< NaryOp> ConstNaryOpPtr;
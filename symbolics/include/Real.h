@@ -22,7 +22,7 @@ namespace Symbolics
         Real(  const Int i );
         ~Real();
         
-        static BasicPtr New( const double r) { return BasicPtr(new Real(r)); };
+        static BasicPtr New( const double r);
 
         inline double getValue() const { return m_value; };
 
@@ -53,7 +53,7 @@ namespace Symbolics
 
         // Ersetzen
          BasicPtr subs( ConstBasicPtr const& old_exp,  BasicPtr const& new_exp);
-         BasicPtr iterateExp(Symbolics::Basic::Iterator &v);
+         BasicPtr newBasic( BasicPtrVec &args );
 
         // atoms
          inline void getAtoms(BasicSet &atoms) {};
@@ -70,6 +70,8 @@ namespace Symbolics
     protected:
          double m_value;
 
+         void calcHash();
+
          static BasicPtr getArgres;
     };
 
@@ -0,0 +1,65 @@
+#ifndef __REF_COUNT_H_
+#define __REF_COUNT_H_
+
+#ifdef SYMBOLICS_ATOMIC_REFCOUNT
+#include <atomic>
+#endif
+
+namespace Symbolics
+{
+    /*****************************************************************************/
+    // Zaehler fuer boost::intrusive_ptr
+    // Mit SYMBOLICS_ATOMIC_REFCOUNT (CMake Option) wird atomar gezaehlt, damit
+    // Ausdruecke aus mehreren Threads referenziert werden koennen.
+    // Unsterbliche Objekte (Int::one, Zero::zero, Scopes, ...) werden gar nicht
+    // gezaehlt, so wird die Cache-Line der Singletons nicht zwischen den
+    // Threads hin- und hergeschoben.
+    class RefCount
+    {
+    public:
+        static const unsigned int Immortal = 0x80000000u;
+
+        RefCount(): m_count(0) {};
+        explicit RefCount( unsigned int count ): m_count(count) {};
+        // Kopien eines Objekts fangen wieder bei 0 an
+        RefCount( RefCount const& ): m_count(0) {};
+        RefCount& operator=( RefCount const& ) { return *this; };
+
+#ifdef SYMBOLICS_ATOMIC_REFCOUNT
+        inline void inc()
+        {
+            if (m_count.load(std::memory_order_relaxed) & Immortal) return;
+            m_count.fetch_add(1, std::memory_order_relaxed);
+        };
+        // true, falls das Objekt geloescht werden muss
+        inline bool dec()
+        {
+            if (m_count.load(std::memory_order_relaxed) & Immortal) return false;
+            return (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1);
+        };
+        inline void setImmortal() { m_count.fetch_or(Immortal, std::memory_order_relaxed); };
+        inline unsigned int get() const { return m_count.load(std::memory_order_relaxed) & ~Immortal; };
+    private:
+        std::atomic<unsigned int> m_count;
+#else
+        inline void inc()
+        {
+            if (m_count & Immortal) return;
+            ++m_count;
+        };
+        // true, falls das Objekt geloescht werden muss
+        inline bool dec()
+        {
+            if (m_count & Immortal) return false;
+            return (--m_count == 0);
+        };
+        inline void setImmortal() { m_count |= Immortal; };
+        inline unsigned int get() const { return m_count & ~Immortal; };
+    private:
+        unsigned int m_count;
+#endif
+    };
+    /*****************************************************************************/
+};
+
+#endif // __REF_COUNT_H_
@@ -74,6 +74,8 @@ namespace Symbolics
         void setState();
         void setState(size_t dim1, size_t dim2);
         void setVariable(size_t dim1, size_t dim2);
+        // Zustand aller Elemente direkt setzen (gespeicherter Graph), flags: getNumEl() Eintraege
+        void setStateFlags(SymbolElementKind kind, std::vector<size_t> const& flags);
 
         Symbol* getDerivative();
 
@@ -89,7 +91,7 @@ namespace Symbolics
         inline BasicPtr const& getArg(size_t i) const { return getArgres; };
 
         // iterate through the expression
-         BasicPtr iterateExp(Iterator &v);
+         BasicPtr newBasic( BasicPtrVec &args );
 
         // user Data
         inline void setUserData(void *d, size_t id) { while(m_userData.size()<=id) { m_userData.push_back(NULL);}; m_userData[id]=d; };
@@ -22,7 +22,7 @@ namespace Symbolics
 
         BasicPtr subs( ConstBasicPtr const& old_exp, BasicPtr const& new_exp);
 
-        BasicPtr iterateExp(Symbolics::Basic::Iterator &v);
+        BasicPtr newBasic( BasicPtrVec &args );
 
          // Operatoren
         SymmetricMatrix operator+( SymmetricMatrix const& rhs) const;
@@ -24,8 +24,8 @@ namespace Symbolics
         // Argument bekommen
         inline BasicPtr const& getArg() const { return m_arg.getArg(); };
 
-        inline void getAtoms(Basic::BasicSet &atoms) { getArg()->getAtoms(atoms);} ;
-        inline void getAtoms(BasicSizeTMap &atoms) { getArg()->getAtoms(atoms);} ;
+        inline void getAtoms(Basic::BasicSet &atoms) { collectAtoms(atoms);} ;
+        inline void getAtoms(BasicSizeTMap &atoms) { collectAtoms(atoms);} ;
 
         // Ersetzen
         BasicPtr subs( ConstBasicPtr const& old_exp,  BasicPtr const& new_exp);
@@ -35,7 +35,7 @@ namespace Symbolics
         inline BasicPtr const& getArg(size_t i) const { return getArg(); };
 
     protected:
-        inline void setArg( BasicPtr const& arg) { m_arg.setArg(arg); };
+        inline void setArg( BasicPtr const& arg) { m_arg.setArg(arg); hashChanged(); };
         inline void simplifyArg() { setArg(getArg()->simplify()); };
     
     private:
@@ -31,7 +31,7 @@ namespace Symbolics
 
         // Ersetzen
         BasicPtr subs( ConstBasicPtr const& old_exp,  BasicPtr const& new_exp);
-        BasicPtr iterateExp(Symbolics::Basic::Iterator &v);
+        BasicPtr newBasic( BasicPtrVec &args );
 
         // atoms
         inline void getAtoms(BasicSet &atoms) {};
@@ -50,6 +50,8 @@ namespace Symbolics
         inline BasicPtr der(BasicPtr const& symbol) { return BasicPtr(this); };
 
     protected:
+        void calcHash();
+
         static BasicPtr zero;
 
         static BasicPtr getArgres;
@@ -78,9 +78,6 @@ public:
         if(p_ != 0) intrusive_ptr_release(p_);
     }
 
-    virtual void intrusive_ptr_add_ref(const T* p) {}
-    
-    virtual void intrusive_ptr_release(const T* p) {}
 
     template<class U> intrusive_ptr(intrusive_ptr<U> const & rhs): p_(rhs.get())
     {
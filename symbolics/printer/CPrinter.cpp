@@ -42,27 +42,38 @@ std::string CPrinter::dimension( const BasicPtr &b )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Abs( const Abs *s )
+void CPrinter::print_Abs( const Abs *s, std::string &out )
 /*****************************************************************************/
 { // Wir arbeiten ja immer mit doubles...
 	if (s == NULL) throw InternalError("CPrinter: Abs is NULL");
-	return "fabs(" + print(s->getArg()) + ")";
+	out += "fabs(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Element( const Element *e )
+void CPrinter::print_Element( const Element *e, std::string &out )
 /*****************************************************************************/
 { 
 	if (e == NULL) throw InternalError("CPrinter: Element is NULL");
 	if (e->getArg(0)->is_Vector())
 	{
 		if (e->getRow() > 0)
-			return print(e->getArg(0)) + "[" + str(e->getRow()) + "]";
+		{
+			print(e->getArg(0), out);
+			out += "[" + str(e->getRow()) + "]";
+			return;
+		}
 		else
-			return print(e->getArg(0)) + "[" + str(e->getCol()) + "]";
+		{
+			print(e->getArg(0), out);
+			out += "[" + str(e->getCol()) + "]";
+			return;
+		}
 	}
-	return print(e->getArg(0)) + "[" + str(e->getRow()) + "][" + str(e->getCol()) + "]";
+	print(e->getArg(0), out);
+	out += "[" + str(e->getRow()) + "][" + str(e->getCol()) + "]";
 }
 /*****************************************************************************/
 
@@ -75,11 +86,11 @@ std::string CPrinter::print_Element( const Element *e )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Matrix( const Matrix *mat )
+void CPrinter::print_Matrix( const Matrix *mat, std::string &out )
 /*****************************************************************************/
 { // Diese Syntax ist nur zum initialisieren von Matrizen geeignet
     if (mat == NULL) throw InternalError("CPrinter: Matrix is NULL");
-    return Printer::print_Matrix(mat, ',', ',',
+    Printer::print_Matrix(mat, out, ',', ',',
                                       '{', '}',
                                       '{', '}',
                                       "\n        ", true);
@@ -87,65 +98,81 @@ std::string CPrinter::print_Matrix( const Matrix *mat )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Pow( const Pow *pow )
+void CPrinter::print_Pow( const Pow *pow, std::string &out )
 /*****************************************************************************/
 {
 	if (pow == NULL) throw InternalError("CPrinter: Pow is NULL");
-	return "pow(" + print(pow->getBase()) + "," + print(pow->getExponent()) + ")";
+	out += "pow(";
+	print(pow->getBase(), out);
+	out += ",";
+	print(pow->getExponent(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Skew( const Skew *s )
+void CPrinter::print_Skew( const Skew *s, std::string &out )
 /*****************************************************************************/
 {
-	return error("CPrinter: Skew: Matrix operations not implemented in C");
+	out += error("CPrinter: Skew: Matrix operations not implemented in C");
 	//if (s == NULL) return "Internal Error: Skew";
 	//return "skew(" + print(s->getArg()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Solve( const Solve *s )
+void CPrinter::print_Solve( const Solve *s, std::string &out )
 /*****************************************************************************/
 {
-    return error("CPrinter: Solve not possible at this point (cannot be inline)");
+    out += error("CPrinter: Solve not possible at this point (cannot be inline)");
 //	if (s == NULL) throw InternalError("CPrinter: Solve is NULL");
 //	return "solve(" + print(s->getArg1()) + "," + print(s->getArg2()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Transpose( const Transpose *s )
+void CPrinter::print_Transpose( const Transpose *s, std::string &out )
 /*****************************************************************************/
 {
-	return error("CPrinter: Transpose: Matrix operations not implemented in C");
+	out += error("CPrinter: Transpose: Matrix operations not implemented in C");
 	//if (s == NULL) return "Internal Error: Transpose";
 	//return "transpose(" + print(s->getArg()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Zero( const Zero *z )
+void CPrinter::print_Zero( const Zero *z, std::string &out )
 /*****************************************************************************/
 { 
 	if (z==NULL) throw InternalError("CPrinter: Zero is NULL");
     if (z->is_Scalar())
-		return "0";
+    {
+		out += "0";
+		return;
+    }
     if (z->is_Vector())
-	    return "{0}"; 
-    return "{{0}}";
+    {
+	    out += "{0}";
+	    return;
+    } 
+    out += "{{0}}";
     // C initialisiert nicht angegebene Werte immer mit 0, darum passt dies f�r alle Vektoren und Matrizen
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_If( const If *e )
+void CPrinter::print_If( const If *e, std::string &out )
 /*****************************************************************************/
 { 
 	if (e==NULL) throw InternalError("CPrinter: If is NULL");
     //Es muss die inline expression sein, da es ja kein Gleichheitszeichen als function gibt
-    return "(" + print(e->getArg(0)) + " ? " + print(e->getArg(1)) + " : " + print(e->getArg(2)) + ")";
+    out += "(";
+    print(e->getArg(0), out);
+    out += " ? ";
+    print(e->getArg(1), out);
+    out += " : ";
+    print(e->getArg(2), out);
+    out += ")";
   //  return "if (" + print(e->getArg(0)) + ")\n        "
   //          + print(e->getArg(1)) + ";\n    else\n        "
   //          + print(e->getArg(2));
@@ -153,24 +180,28 @@ std::string CPrinter::print_If( const If *e )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Sign( const Sign *s )
+void CPrinter::print_Sign( const Sign *s, std::string &out )
 /*****************************************************************************/
 { 
 	if (s==NULL) throw InternalError("CPrinter: Sign is NULL");
-	return "(" + print(s->getArg()) + ">0?1:(" + print(s->getArg()) + "<0?-1:0))";
+	out += "(";
+	print(s->getArg(), out);
+	out += ">0?1:(";
+	print(s->getArg(), out);
+	out += "<0?-1:0))";
     //Alternativ:
     //return "(" + print(s->getArg()) + "?(" + print(s->getArg()) + ">0?1:-1):0)";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CPrinter::print_Bool( const Bool *b )
+void CPrinter::print_Bool( const Bool *b, std::string &out )
 /*****************************************************************************/
 {
     if (b == NULL) throw InternalError("CPrinter: Bool is NULL");
     if (b->getValue())
-        return "1";
+        out += "1";
     else
-        return "0";
+        out += "0";
 }
 /*****************************************************************************/
\ No newline at end of file
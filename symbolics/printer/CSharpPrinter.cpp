@@ -41,25 +41,36 @@ std::string CSharpPrinter::dimension( const BasicPtr &b )
 
 
 
-std::string CSharpPrinter::print_Abs( const Abs *s )
+void CSharpPrinter::print_Abs( const Abs *s, std::string &out )
 {
 	if (s == NULL) throw InternalError("CSharpPrinter: Abs is NULL");
-	return "Math.Abs(" + print(s->getArg()) + ")";
+	out += "Math.Abs(";
+	print(s->getArg(), out);
+	out += ")";
 }
 
 
 
-std::string CSharpPrinter::print_Element( const Element *e )
+void CSharpPrinter::print_Element( const Element *e, std::string &out )
 { 
 	if (e == NULL) throw InternalError("CSharpPrinter: Element is NULL");
 	if (e->getArg(0)->is_Vector())
 	{
 		if (e->getRow() > 0)
-			return print(e->getArg(0)) + "[" + str(e->getRow()) + "]";
+		{
+			print(e->getArg(0), out);
+			out += "[" + str(e->getRow()) + "]";
+			return;
+		}
 		else
-			return print(e->getArg(0)) + "[" + str(e->getCol()) + "]";
+		{
+			print(e->getArg(0), out);
+			out += "[" + str(e->getCol()) + "]";
+			return;
+		}
 	}
-	return print(e->getArg(0)) + "[" + str(e->getRow()) + "," + str(e->getCol()) + "]";
+	print(e->getArg(0), out);
+	out += "[" + str(e->getRow()) + "," + str(e->getCol()) + "]";
 }
 
 
@@ -72,11 +83,11 @@ std::string CSharpPrinter::print_Element( const Element *e )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Matrix( const Matrix *mat )
+void CSharpPrinter::print_Matrix( const Matrix *mat, std::string &out )
 /*****************************************************************************/
 { // Diese Syntax ist nur zum initialisieren von Matrizen geeignet
     if (mat == NULL) throw InternalError("CSharpPrinter: Matrix is NULL");
-    return Printer::print_Matrix(mat, ',', ',',
+    Printer::print_Matrix(mat, out, ',', ',',
                                       '{', '}',
                                       '{', '}',
                                       "\n        ", true);
@@ -84,155 +95,190 @@ std::string CSharpPrinter::print_Matrix( const Matrix *mat )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Pow( const Pow *pow )
+void CSharpPrinter::print_Pow( const Pow *pow, std::string &out )
 /*****************************************************************************/
 {
 	if (pow == NULL) throw InternalError("CSharpPrinter: Pow is NULL");
-	return "Math.Pow(" + print(pow->getBase()) + "," + print(pow->getExponent()) + ")";
+	out += "Math.Pow(";
+	print(pow->getBase(), out);
+	out += ",";
+	print(pow->getExponent(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Skew( const Skew *s )
+void CSharpPrinter::print_Skew( const Skew *s, std::string &out )
 /*****************************************************************************/
 {
-	return error("CSharpPrinter: Skew: Matrix operations not implemented in C#");
+	out += error("CSharpPrinter: Skew: Matrix operations not implemented in C#");
 	//if (s == NULL) return "Internal Error: Skew";
 	//return "skew(" + print(s->getArg()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Solve( const Solve *s )
+void CSharpPrinter::print_Solve( const Solve *s, std::string &out )
 /*****************************************************************************/
 {
-    return error("CSharpPrinter: Solve not possible at this point (cannot be inline)");
+    out += error("CSharpPrinter: Solve not possible at this point (cannot be inline)");
 //	if (s == NULL) throw InternalError("CSharpPrinter: Solve is NULL");
 //	return "solve(" + print(s->getArg1()) + "," + print(s->getArg2()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Transpose( const Transpose *s )
+void CSharpPrinter::print_Transpose( const Transpose *s, std::string &out )
 /*****************************************************************************/
 {
     if (s == NULL) throw InternalError("CSharpPrinter: Transpose is NULL");
 	
-	return print(s->getArg()) + ".Transpose()";
+	print(s->getArg(), out);
+	out += ".Transpose()";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Zero( const Zero *z )
+void CSharpPrinter::print_Zero( const Zero *z, std::string &out )
 /*****************************************************************************/
 { 
 	if (z==NULL) throw InternalError("CSharpPrinter: Zero is NULL");
     if (z->is_Scalar())
-		return "0";
+    {
+		out += "0";
+		return;
+    }
     if (z->is_Vector())
-	    return "0";       // Todo: write constructors for zero vector and matrix 
-    return "0";
+    {
+	    out += "0";       // Todo: write constructors for zero vector and matrix 
+	    return;
+    }
+    out += "0";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_If( const If *e )
+void CSharpPrinter::print_If( const If *e, std::string &out )
 /*****************************************************************************/
 { 
 	if (e==NULL) throw InternalError("CSharpPrinter: If is NULL");
     //Es muss die inline expression sein, da es ja kein Gleichheitszeichen als function gibt
-    return print(e->getArg(0)) + " ? " + print(e->getArg(1)) + " : " + print(e->getArg(2));
+    print(e->getArg(0), out);
+    out += " ? ";
+    print(e->getArg(1), out);
+    out += " : ";
+    print(e->getArg(2), out);
 }
 /*****************************************************************************/
 
 
-std::string CSharpPrinter::print_Jacobian( const Jacobian *j )
+void CSharpPrinter::print_Jacobian( const Jacobian *j, std::string &out )
 {    
     throw InternalError("CSharpPrinter: Jacobian not implemented");
 
     if (j == NULL) throw InternalError("CSharpPrinter: Jacobian is NULL");
-    return print(j->getArg(0)) + ".Jacobian(???)";
+    print(j->getArg(0), out);
+    out += ".Jacobian(???)";
 }
 
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Inverse( const Inverse *c )
+void CSharpPrinter::print_Inverse( const Inverse *c, std::string &out )
 /*****************************************************************************/
 {
 	if (c==NULL) throw InternalError("CSharpPrinter: Inverse is NULL");
-	return print(c->getArg()) + ".Inverse()";
+	print(c->getArg(), out);
+	out += ".Inverse()";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Sign( const Sign *s )
+void CSharpPrinter::print_Sign( const Sign *s, std::string &out )
 /*****************************************************************************/
 { 
 	if (s==NULL) throw InternalError("CSharpPrinter: Sign is NULL");
-	return "Math.Sign(" + print(s->getArg()) + ")";
+	out += "Math.Sign(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CSharpPrinter::print_Bool( const Bool *b )
+void CSharpPrinter::print_Bool( const Bool *b, std::string &out )
 /*****************************************************************************/
 {
     if (b == NULL) throw InternalError("CSharpPrinter: Bool is NULL");
     if (b->getValue())
-        return "true";
+        out += "true";
     else
-        return "false";
+        out += "false";
 }
 /*****************************************************************************/
 
 
 
-std::string CSharpPrinter::print_Acos( const Acos *s )
+void CSharpPrinter::print_Acos( const Acos *s, std::string &out )
 {
     if (s == NULL) throw InternalError("CSharpPrinter: Acos is NUll");
-    return "Math.Acos(" + print(s->getArg()) + ")";
+    out += "Math.Acos(";
+    print(s->getArg(), out);
+    out += ")";
 }
 
 
-std::string CSharpPrinter::print_Asin( const Asin *s )
+void CSharpPrinter::print_Asin( const Asin *s, std::string &out )
 {
     if (s == NULL) throw InternalError("CSharpPrinter: Asin is NUll");
-    return "Math.Asin(" + print(s->getArg()) + ")";
+    out += "Math.Asin(";
+    print(s->getArg(), out);
+    out += ")";
 }
 
 
-std::string CSharpPrinter::print_Atan( const Atan *s )
+void CSharpPrinter::print_Atan( const Atan *s, std::string &out )
 {
     if (s == NULL) throw InternalError("CSharpPrinter: Atan is NUll");
-    return "Math.Atan(" + print(s->getArg()) + ")";
+    out += "Math.Atan(";
+    print(s->getArg(), out);
+    out += ")";
 }
 
 
-std::string CSharpPrinter::print_Atan2( const Atan2 *s )
+void CSharpPrinter::print_Atan2( const Atan2 *s, std::string &out )
 {
     if (s == NULL) throw InternalError("CSharpPrinter: Atan2 is NUll");
-    return "Math.Atan2(" + print(s->getArg1()) + "," + print(s->getArg2()) + ")";
+    out += "Math.Atan2(";
+    print(s->getArg1(), out);
+    out += ",";
+    print(s->getArg2(), out);
+    out += ")";
 }
 
 
-std::string CSharpPrinter::print_Cos( const Cos *c )
+void CSharpPrinter::print_Cos( const Cos *c, std::string &out )
 {
     if (c == NULL) throw InternalError("CSharpPrinter: Cos is NUll");
-    return "Math.Cos(" + print(c->getArg()) + ")";
+    out += "Math.Cos(";
+    print(c->getArg(), out);
+    out += ")";
 }
 
 
-std::string CSharpPrinter::print_Sin( const Sin *s )
+void CSharpPrinter::print_Sin( const Sin *s, std::string &out )
 {
     if (s == NULL) throw InternalError("CSharpPrinter: Sin is NUll");
-    return "Math.Sin(" + print(s->getArg()) + ")";
+    out += "Math.Sin(";
+    print(s->getArg(), out);
+    out += ")";
 }
 
 
-std::string CSharpPrinter::print_Tan( const Tan *s )
+void CSharpPrinter::print_Tan( const Tan *s, std::string &out )
 {
     if (s == NULL) throw InternalError("CSharpPrinter: Tan is NUll");
-    return "Math.Tan(" + print(s->getArg()) + ")";
+    out += "Math.Tan(";
+    print(s->getArg(), out);
+    out += ")";
 }
\ No newline at end of file
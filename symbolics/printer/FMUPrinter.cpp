@@ -20,7 +20,7 @@ FMUPrinter::~FMUPrinter()
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FMUPrinter::print_Symbol( const Symbol *symbol )
+void FMUPrinter::print_Symbol( const Symbol *symbol, std::string &out )
 /*****************************************************************************/
 {
 	if (symbol == NULL) throw InternalError("FMUPrinter: Symbol is NULL");
@@ -28,21 +28,30 @@ std::string FMUPrinter::print_Symbol( const Symbol *symbol )
 //	std::map<std::string,int>::const_iterator it = m_valueReferencesP->find(name);
 //	if (it!=m_valueReferencesP->end())
     if (name == "time")
-        return "comp->time";
+    {
+        out += "comp->time";
+        return;
+    }
 	if (m_valueReferencesP->count(name))
-		return "r(" + name + "_)";
-	return name;
+	{
+		out += "r(" + name + "_)";
+		return;
+	}
+	out += name;
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FMUPrinter::print_Element( const Element *e )
+void FMUPrinter::print_Element( const Element *e, std::string &out )
 /*****************************************************************************/
 { 
 	if (e == NULL) throw InternalError("FMUPrinter: Element is NULL");
 	BasicPtr arg = e->getArg(0);
 	if (arg->is_Scalar()) //Ja - im FMUWriter werden skalare Elemente erstellt...
-		return print(arg);
+	{
+		print(arg, out);
+		return;
+	}
 	if (arg->getType() == Type_Symbol) 
 	{
 		const Symbol *s = Util::getAsConstPtr<Symbol>(arg);
@@ -52,42 +61,54 @@ std::string FMUPrinter::print_Element( const Element *e )
 		else
 			name =  s->getName() + "_" + str(e->getRow()) + "_" + str(e->getCol());
 		if (m_valueReferencesP->count(name))
-			return "r(" + name + "_)";
+		{
+			out += "r(" + name + "_)";
+			return;
+		}
 	}
 
 	if (arg->is_Vector())
 	{
 		if (e->getRow() > 0)
-			return print(arg) + "[" + str(e->getRow()) + "]";
+		{
+			print(arg, out);
+			out += "[" + str(e->getRow()) + "]";
+			return;
+		}
 		else
-			return print(arg) + "[" + str(e->getCol()) + "]";
+		{
+			print(arg, out);
+			out += "[" + str(e->getCol()) + "]";
+			return;
+		}
 	}
-	return print(arg) + "[" + str(e->getRow()) + "][" + str(e->getCol()) + "]";
+	print(arg, out);
+	out += "[" + str(e->getRow()) + "][" + str(e->getCol()) + "]";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FMUPrinter::print_Der( const Der *d )
+void FMUPrinter::print_Der( const Der *d, std::string &out )
 /*****************************************************************************/
 {
 	if (d == NULL) throw InternalError("FMUPrinter: Der is NULL");
-	std::string args = print(d->getArg());
-	if (args.find("r(") == 0) //String beginnt mit "r(" (gefunden an Position 0)
-		args.insert(2, "der_");
+	size_t start = out.size();
+	print(d->getArg(), out);
+	if (out.compare(start, 2, "r(") == 0) //Ausgabe beginnt mit "r("
+		out.insert(start+2, "der_");
 	else
-		args = "der_" + args;
-	return args;
+		out.insert(start, "der_");
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FMUPrinter::print_Bool( const Bool *b )
+void FMUPrinter::print_Bool( const Bool *b, std::string &out )
 /*****************************************************************************/
 {
     if (b == NULL) throw InternalError("FMUPrinter: Bool is NULL");
     if (b->getValue())
-        return "fmiTrue";
+        out += "fmiTrue";
     else
-        return "fmiFalse";
+        out += "fmiFalse";
 }
 /*****************************************************************************/
@@ -39,68 +39,77 @@ std::string FortranPrinter::dimension( const BasicPtr &b )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Mul( const Mul *mul )
+void FortranPrinter::print_Mul( const Mul *mul, std::string &out )
 /*****************************************************************************/
 {
 	if (mul == NULL) throw InternalError("FortranPrinter: Mul is NULL");
-	std::string s="(", t="";
+	size_t start = out.size(); // fuer ein eventuelles "scalar" davor
+	std::string t="";
+	out += "(";
     size_t n = mul->getArgsSize();
     bool includes_matmul = false;
     for (size_t i=0; i<n-1; ++i)
     {
 		if (!mul->getArg(i)->is_Scalar() && !mul->getArg(i+1)->is_Scalar()) {
-			s += "matmul(" + print(mul->getArg(i)) + ",";
+			out += "matmul(";
+			print(mul->getArg(i), out);
+			out += ",";
 			t += ")";
 			includes_matmul = true;
 		} else {
-			s+= print(mul->getArg(i)) + t + "*";
+			print(mul->getArg(i), out);
+			out += t + "*";
 			t="";
 		}
     }
-    s += print(mul->getArg(n-1)) + t + ")";
+    print(mul->getArg(n-1), out);
+    out += t + ")";
 	if (includes_matmul && mul->is_Scalar()) //TODO: was ist mit (1,1) Matrizen? 
-		s = "scalar" + s; //keine Klammern n�tig, diese sollten schon da sein
-    return s;
+		out.insert(start, "scalar"); //keine Klammern n�tig, diese sollten schon da sein
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Element( const Element *e )
+void FortranPrinter::print_Element( const Element *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e == NULL) throw InternalError("FortranPrinter: Element is NULL");
     if (e->getArg(0)->getType() != Type_Symbol)
         error("FortranPrinter: Element: Is only possible for Symbols, but here it is: " 
                 + print(e->getArg(0)) + "(" + str(e->getRow()+1) + "," + str(e->getCol()+1) + ")");
-	return print(e->getArg(0)) + "(" + str(e->getRow()+1) + "," + str(e->getCol()+1) + ")";
+	print(e->getArg(0), out);
+	out += "(" + str(e->getRow()+1) + "," + str(e->getCol()+1) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Int( const Int *c )
+void FortranPrinter::print_Int( const Int *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("FortranPrinter: Int is NULL");
     int val = c->getValue();
     if (val < 0)
-        return "(" + str(val) + "d0)"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
+        out += "(" + str(val) + "d0)"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
     else
-	    return str(val) + "d0"; // Gibt keinen Int, alle Real :-)
+	    out += str(val) + "d0"; // Gibt keinen Int, alle Real :-)
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Matrix( const Matrix *mat )
+void FortranPrinter::print_Matrix( const Matrix *mat, std::string &out )
 /*****************************************************************************/
 {
 	if (mat == NULL) throw InternalError("FortranPrinter: Matrix is NULL");
 
 	// Skalar
 	if (mat->is_Scalar())
-		return print((*mat)(0));
+	{
+		print((*mat)(0), out);
+		return;
+	}
 
 	//Vektor und Matrix
-	std::string s = "reshape((/";
+	out += "reshape((/";
 
 	size_t rows = mat->getShape().getDimension(1);
 	size_t cols = mat->getShape().getDimension(2);
@@ -108,51 +117,67 @@ std::string FortranPrinter::print_Matrix( const Matrix *mat )
 		for (size_t m=0;m<cols;++m)
 		{
 			for (size_t n=0;n<rows;++n) {
-				s += print((*mat)(n,m));
+				print((*mat)(n,m), out);
 				if ((m+1)*(n+1) < rows*cols) //immer Komma au�er am Ende
-					s += ", "; 
+					out += ", "; 
 			}
 			if (cols > 1 && m < (rows-1)) //Matritzen mit Zeilenumbr�chen zur besseren Lesbarkeit
-				s += "&\n        ";
+				out += "&\n        ";
 		}
 	
-	s += "/), (/";
+	out += "/), (/";
 	
-	s+= str(rows) + "," + str(cols) + "/))";
-	return s;
+	out += str(rows) + "," + str(cols) + "/))";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Inverse( const Inverse *c )
+void FortranPrinter::print_Inverse( const Inverse *c, std::string &out )
 /*****************************************************************************/
 { //TODO: Untested weil kein Beispiel vorhanden?
   if (c == NULL) throw InternalError("FortranPrinter: Inverse is NULL");
-  return "MIGS(" + print(c->getArg()) + ")";
+  out += "MIGS(";
+  print(c->getArg(), out);
+  out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Pow( const Pow *pow )
+void FortranPrinter::print_Pow( const Pow *pow, std::string &out )
 /*****************************************************************************/
 {
 	if (pow == NULL) throw InternalError("FortranPrinter: Pow is NULL");
 	if (pow->getBase()->is_Scalar())
-		return "(" + print(pow->getBase()) + "**" + print(pow->getExponent()) + ")";
+	{
+		out += "(";
+		print(pow->getBase(), out);
+		out += "**";
+		print(pow->getExponent(), out);
+		out += ")";
+		return;
+	}
     
     if (!pow->getBase()->is_Matrix())
-        return error("FortranPrinter: Pow: Base is neither Scalar nor Matrix, it expands to: '" + print(pow->getBase()) + "'");
+    {
+        out += error("FortranPrinter: Pow: Base is neither Scalar nor Matrix, it expands to: '" + print(pow->getBase()) + "'");
+        return;
+    }
 	if (pow->getExponent()->getType() != Type_Int)
-		return error("FortranPrinter: Pow: Base is matrix but exponent is no Integer, it is of type '"
+	{
+		out += error("FortranPrinter: Pow: Base is matrix but exponent is no Integer, it is of type '"
                     + str(pow->getExponent()->getType()) + "' and expands to '" + print(pow->getExponent()) + "'");
+		return;
+	}
     int exp_value = Util::getAsConstPtr<Int>(pow->getExponent())->getValue();
-	return "matpow(" + print(pow->getBase()) + "," + str(exp_value) + ")"; 
+	out += "matpow(";
+	print(pow->getBase(), out);
+	out += "," + str(exp_value) + ")"; 
     //Exponent darf nicht mit print ausgegeben werden, da ein "echter" Integer benoetigt wird.
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Real( const Real *c )
+void FortranPrinter::print_Real( const Real *c, std::string &out )
 /*****************************************************************************/
 { //TODO: eigentlich unsch�ne gehackte L�sung. Andere Ideen?
     if (c == NULL) throw InternalError("FortranPrinter: Real is NULL");
@@ -165,60 +190,71 @@ std::string FortranPrinter::print_Real( const Real *c )
 		s+="d0";
 
     if (c->getValue() < 0.0)
-        return "(" + s + ")"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
+        out += "(" + s + ")"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
     else
-        return s;
+        out += s;
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Scalar( const Scalar *s )
+void FortranPrinter::print_Scalar( const Scalar *s, std::string &out )
 /*****************************************************************************/
 {  // Diese Funktion sollte so funktionieren, wird aber scheinbar kaum genutzt - momentan wird es in mul "emuliert"
 	if (s == NULL) throw InternalError("FortranPrinter: Scalar is NULL");
-	return "scalar(" + print(s->getArg()) + ")";
+	out += "scalar(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Skew( const Skew *s )
+void FortranPrinter::print_Skew( const Skew *s, std::string &out )
 /*****************************************************************************/
 { 
 	if (s == NULL) throw InternalError("FortranPrinter: Skew is NULL");
-    return "skew(" + print(s->getArg()) + ")";
+    out += "skew(";
+    print(s->getArg(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Solve( const Solve *s )
+void FortranPrinter::print_Solve( const Solve *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("FortranPrinter: Solve is NULL");
-	return "LEGS(" + print(s->getArg1()) + ", " + print(s->getArg2()) + ")";
+	out += "LEGS(";
+	print(s->getArg1(), out);
+	out += ", ";
+	print(s->getArg2(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Symbol( const Symbol *symbol )
+void FortranPrinter::print_Symbol( const Symbol *symbol, std::string &out )
 /*****************************************************************************/
 {
 	if (symbol == NULL) throw InternalError("FortranPrinter: Symbol is NULL");
 	std::string name = symbol->getName();
 	char c = name.at(0);
 	if ((c >= 'A' && c <='Z') || (c >= 'a' && c <= 'z'))
-		return name;
+		out += name;
 	else
-		return "F" + name;
+		out += "F" + name;
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Zero( const Zero *z )
+void FortranPrinter::print_Zero( const Zero *z, std::string &out )
 /*****************************************************************************/
 {
 	if (z==NULL) throw InternalError("FortranPrinter: Zero is NULL");
 	if (z->is_Scalar())
-		return "0d0";
+	{
+		out += "0d0";
+		return;
+	}
 	Shape const& sh = z->getShape();
 	size_t el = sh.getNumEl();
 	std::string s = "(/";
@@ -227,7 +263,7 @@ std::string FortranPrinter::print_Zero( const Zero *z )
 		if (i+1 < el)
 			s += ", ";
 	}		
-	return "reshape(" + s + "/),(/" + str(sh.getDimension(1)) + "," + str(sh.getDimension(2)) + "/))";
+	out += "reshape(" + s + "/),(/" + str(sh.getDimension(1)) + "," + str(sh.getDimension(2)) + "/))";
 }
 /*****************************************************************************/
 
@@ -241,23 +277,25 @@ std::string FortranPrinter::print_Zero( const Zero *z )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Sign( const Sign *s )
+void FortranPrinter::print_Sign( const Sign *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s==NULL) throw InternalError("FortranPrinter: Sign is NULL");
-	return "sign(1d0, " + print(s->getArg()) + ")"; 
+	out += "sign(1d0, ";
+	print(s->getArg(), out);
+	out += ")"; 
     //Achtung: 0 ergibt hier +1 statt 0 wie in den anderen Sprachen
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string FortranPrinter::print_Bool( const Bool *b )
+void FortranPrinter::print_Bool( const Bool *b, std::string &out )
 /*****************************************************************************/
 {
     if (b == NULL) throw InternalError("FortranPrinter: Bool is NULL");
     if (b->getValue())
-        return ".TRUE.";
+        out += ".TRUE.";
     else
-        return ".FALSE.";
+        out += ".FALSE.";
 }
 /*****************************************************************************/
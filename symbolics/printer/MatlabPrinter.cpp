@@ -30,110 +30,128 @@ std::string MatlabPrinter::comment( const std::string &c ) const
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Matrix( const Matrix *c )
+void MatlabPrinter::print_Matrix( const Matrix *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("MatlabPrinter: Matrix is NULL");
-    return Printer::print_Matrix(c, ',', ';',
+    Printer::print_Matrix(c, out, ',', ';',
                                     '[', ']',
                                     '[', ']');
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Pow( const Pow *pow )
+void MatlabPrinter::print_Pow( const Pow *pow, std::string &out )
 /*****************************************************************************/
 {
     if (pow == NULL) throw InternalError("MatlabPrinter: Pow is NULL");
-    return "(" + print(pow->getBase()) + "^" + print(pow->getExponent()) + ")";
+    out += "(";
+    print(pow->getBase(), out);
+    out += "^";
+    print(pow->getExponent(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Solve( const Solve *s )
+void MatlabPrinter::print_Solve( const Solve *s, std::string &out )
 /*****************************************************************************/
 {
     if (s == NULL) throw InternalError("MatlabPrinter: Solve is NULL");
 	//Was ist mit dsolve/solve/linsolve? --> wir nutzen "Backslash"-Solve
-    return "(" + print(s->getArg1()) + "\\" + print(s->getArg2()) + ")";
+    out += "(";
+    print(s->getArg1(), out);
+    out += "\\";
+    print(s->getArg2(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 //*****************************************************************************/
-std::string MatlabPrinter::print_Element( const Element *e )
+void MatlabPrinter::print_Element( const Element *e, std::string &out )
 //*****************************************************************************/
 {
     if (e == NULL) throw InternalError("MatlabPrinter: Element is NULL");
     if (e->getArg(0)->getType() != Type_Symbol)
         error("MatlabPrinter: Element: Is only possible for Symbols, but here it is: " 
                 + print(e->getArg(0)) + "(" + str(e->getRow()+1) + "," + str(e->getCol()+1) + ")");
-    return print(e->getArg(0)) + "(" + str(e->getRow()+1) + "," + str(e->getCol()+1) + ")";
+    print(e->getArg(0), out);
+    out += "(" + str(e->getRow()+1) + "," + str(e->getCol()+1) + ")";
 }
 //*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Skew( const Skew *s )
+void MatlabPrinter::print_Skew( const Skew *s, std::string &out )
 /*****************************************************************************/
 {
     if (s == NULL) throw InternalError("MatlabPrinter: Skew is NULL");
     if (s->getArg()->getType() != Type_Symbol)
         error("MatlabPrinter: Skew: Is only possible for Symbols, but the Argument is: " + print(s->getArg()));
 	std::string v = print(s->getArg());
-    return "[[0,-" + v + "(3), " + v + "(2)];\n         [" + v + "(3), 0, -" + v + "(1)];\n         [-" + v + "(2), " + v + "(1), 0]]";
+    out += "[[0,-" + v + "(3), " + v + "(2)];\n         [" + v + "(3), 0, -" + v + "(1)];\n         [-" + v + "(2), " + v + "(1), 0]]";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Zero( const Zero *z )
+void MatlabPrinter::print_Zero( const Zero *z, std::string &out )
 /*****************************************************************************/
 {
 	if (z == NULL) throw InternalError("MatlabPrinter: Zero is NULL");
 	if (z->is_Scalar())
-		return "0";
-	return "zeros(" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ")";
+	{
+		out += "0";
+		return;
+	}
+	out += "zeros(" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Symbol( const Symbol *symbol )
+void MatlabPrinter::print_Symbol( const Symbol *symbol, std::string &out )
 /*****************************************************************************/
 {
 	if (symbol == NULL) throw InternalError("MatlabPrinter: Symbol is NULL");
 	std::string name = symbol->getName();
 	char c = name.at(0);
 	if ((c >= 'A' && c <='Z') || (c >= 'a' && c <= 'z'))
-		return name;
+		out += name;
 	else
-		return "M" + name;
+		out += "M" + name;
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Inverse( const Inverse *c )
+void MatlabPrinter::print_Inverse( const Inverse *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("MatlabPrinter: Inverse is NULL");
-	return "inv(" + print(c->getArg()) + ")";
+	out += "inv(";
+	print(c->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Jacobian( const Jacobian *j )
+void MatlabPrinter::print_Jacobian( const Jacobian *j, std::string &out )
 /*****************************************************************************/
 {
 	if (j==NULL) throw InternalError("MatlabPrinter: Jacobian is NULL");
-	return "jacobian(" + print(j->getArg1()) + "," + print(j->getArg2()) + ")";
+	out += "jacobian(";
+	print(j->getArg1(), out);
+	out += ",";
+	print(j->getArg2(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabPrinter::print_Bool( const Bool *b )
+void MatlabPrinter::print_Bool( const Bool *b, std::string &out )
 /*****************************************************************************/
 {
     if (b == NULL) throw InternalError("MatlabPrinter: Bool is NULL");
     if (b->getValue())
-        return "true";
+        out += "true";
     else
-        return "false";
+        out += "false";
 }
 /*****************************************************************************/
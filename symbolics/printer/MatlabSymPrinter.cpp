@@ -31,23 +31,35 @@ std::string MatlabSymPrinter::dimension( const BasicPtr &b )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabSymPrinter::print_Atan2( const Atan2 *s )
+void MatlabSymPrinter::print_Atan2( const Atan2 *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Atan2 is NULL");
     std::cerr << "Warning: MatlabSymPrinter: Atan2 replaced by approximation, since Atan2 function cannot be used with Matlabs Symbolic Math Toolbox." << std::endl;
-	return "(2*atan(" + print(s->getArg1()) + "/((" + print(s->getArg2()) + "^2 + " + print(s->getArg1()) + "^2)^0.5 + " + print(s->getArg2()) + ")))";
+	out += "(2*atan(";
+	print(s->getArg1(), out);
+	out += "/((";
+	print(s->getArg2(), out);
+	out += "^2 + ";
+	print(s->getArg1(), out);
+	out += "^2)^0.5 + ";
+	print(s->getArg2(), out);
+	out += ")))";
     //Alternativ k�nnte man auch einfach atan2 durch atan ersetzen:
     //return "atan(" + print(s->getArg1()) + "/" + print(s->getArg2()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string MatlabSymPrinter::print_Sign( const Sign *s )
+void MatlabSymPrinter::print_Sign( const Sign *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s==NULL) throw InternalError("Printer: Sign is NULL");
     std::cerr << "Note: MatlabSymPrinter: Sign(X) replaced by X/abs(X), since Sign function cannot be used with Matlabs Symbolic Math Toolbox." << std::endl;
-    return "(" + print(s->getArg()) + "/abs(" + print(s->getArg()) + "))";
+    out += "(";
+    print(s->getArg(), out);
+    out += "/abs(";
+    print(s->getArg(), out);
+    out += "))";
 }
 /*****************************************************************************/
@@ -39,7 +39,7 @@ std::string ModelicaPrinter::dimension( const BasicPtr &b )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Mul( const Mul *mul )
+void ModelicaPrinter::print_Mul( const Mul *mul, std::string &out )
 /*****************************************************************************/
 {
 
@@ -50,18 +50,26 @@ std::string ModelicaPrinter::print_Mul( const Mul *mul )
 			if ( ! mul->getArg(i)->is_Scalar())
 				makeScalar = true;
 	if (makeScalar) // Wenn das Ergebnis der Multiplikation Skalar ist, in der Mul. jedoch Matritzen enthalten sind muss das Ergebnis skalarisiert werden
-		return "scalar(" + join(ConstBasicPtr(mul), " * ") + ")";
+	{
+		out += "scalar(";
+		join(ConstBasicPtr(mul), " * ", out);
+		out += ")";
+	}
 	else
-		return "(" + join(ConstBasicPtr(mul), " * ") + ")";
+	{
+		out += "(";
+		join(ConstBasicPtr(mul), " * ", out);
+		out += ")";
+	}
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Matrix( const Matrix *c )
+void ModelicaPrinter::print_Matrix( const Matrix *c, std::string &out )
 /*****************************************************************************/
 {
     if (c==NULL) throw InternalError("ModelicaPrinter: Matrix is NULL");
-	return Printer::print_Matrix(c, ',', ',',
+	Printer::print_Matrix(c, out, ',', ',',
 									'{', '}',
 									'{', '}',
 									"\n    " );
@@ -70,47 +78,58 @@ std::string ModelicaPrinter::print_Matrix( const Matrix *c )
 
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Inverse( const Inverse *c )
+void ModelicaPrinter::print_Inverse( const Inverse *c, std::string &out )
 /*****************************************************************************/
 {
   if (c == NULL) throw InternalError("ModelicaPrinter: Inverse is NULL");
-  return "Modelica.Math.Matrices.inv(" + print(c->getArg()) + ")";
+  out += "Modelica.Math.Matrices.inv(";
+  print(c->getArg(), out);
+  out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Pow( const Pow *pow )
+void ModelicaPrinter::print_Pow( const Pow *pow, std::string &out )
 /*****************************************************************************/
 {
     if (pow == NULL) throw InternalError("ModelicaPrinter: Pow is NULL");
-    return "(" + print(pow->getBase()) + "^" + print(pow->getExponent()) + ")";
+    out += "(";
+    print(pow->getBase(), out);
+    out += "^";
+    print(pow->getExponent(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Der( const Der *d )
+void ModelicaPrinter::print_Der( const Der *d, std::string &out )
 /*****************************************************************************/
 {
     if (d == NULL) throw InternalError("ModelicaPrinter: Der is NULL");
-    return "der(" + print(d->getArg()) + ")";
+    out += "der(";
+    print(d->getArg(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Element( const Element *e )
+void ModelicaPrinter::print_Element( const Element *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e == NULL) throw InternalError("ModelicaPrinter: Element is NULL");
-	return print(e->getArg(0)) + "[" + str(e->getRow()+1) + "," + str(e->getCol()+1) + "]";
+	print(e->getArg(0), out);
+	out += "[" + str(e->getRow()+1) + "," + str(e->getCol()+1) + "]";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Skew( const Skew *s )
+void ModelicaPrinter::print_Skew( const Skew *s, std::string &out )
 /*****************************************************************************/
 {
     if (s == NULL) throw InternalError("ModelicaPrinter: Skew is NULL");
-	return "skew(vector( " + print(s->getArg()) + "))";
+	out += "skew(vector( ";
+	print(s->getArg(), out);
+	out += "))";
 	//Alternativ ginge auch:
 	//std::string v = print(s->getArg());
     //return "{{0,-" + v + "[3,1], " + v + "[2,1]}, {" + v + "[3,1], 0, -" + v + "[1,1]}, {-" + v + "[2,1], " + v + "[1,1], 0}}";  
@@ -120,52 +139,67 @@ std::string ModelicaPrinter::print_Skew( const Skew *s )
 
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Solve( const Solve *s )
+void ModelicaPrinter::print_Solve( const Solve *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("ModelicaPrinter: Solve is NULL");
-	return "Modelica.Math.Matrices.solve2(" + print(s->getArg1()) + ", " + print(s->getArg2()) + ")";
+	out += "Modelica.Math.Matrices.solve2(";
+	print(s->getArg1(), out);
+	out += ", ";
+	print(s->getArg2(), out);
+	out += ")";
 	//solve2 erspart vector() und matrix() Umwandlungen, da Arg2 auch eine Matrix sein kann.
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Zero( const Zero *z )
+void ModelicaPrinter::print_Zero( const Zero *z, std::string &out )
 /*****************************************************************************/
 {
     if (z == NULL) throw InternalError("ModelicaPrinter: Zero is NULL");
 	if (z->is_Scalar())
-		return "0";
-	return "zeros(" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ")";
+	{
+		out += "0";
+		return;
+	}
+	out += "zeros(" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_If( const If *e )
+void ModelicaPrinter::print_If( const If *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e==NULL) throw InternalError("ModelicaPrinter: If is NULL");
-    return "(if " + print(e->getArg(0)) + " then " + print(e->getArg(1)) + " else " + print(e->getArg(2)) + ")";
+    out += "(if ";
+    print(e->getArg(0), out);
+    out += " then ";
+    print(e->getArg(1), out);
+    out += " else ";
+    print(e->getArg(2), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Scalar( const Scalar *s )
+void ModelicaPrinter::print_Scalar( const Scalar *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("ModelicaPrinter: Scalar is NULL");
-    return "scalar(" + print(s->getArg()) + ")";
+    out += "scalar(";
+    print(s->getArg(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string ModelicaPrinter::print_Bool( const Bool *b )
+void ModelicaPrinter::print_Bool( const Bool *b, std::string &out )
 /*****************************************************************************/
 {
     if (b == NULL) throw InternalError("ModelicaPrinter: Bool is NULL");
     if (b->getValue())
-        return "true";
+        out += "true";
     else
-        return "false";
+        out += "false";
 }
 /*****************************************************************************/
\ No newline at end of file
@@ -56,77 +56,130 @@ std::string Printer::dimension( const BasicPtr &b )
 /*****************************************************************************/
 std::string Printer::print( BasicPtr const& basic )
 /*****************************************************************************/
+{
+    std::string s;
+    print(basic, s);
+    return s;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Printer::print( BasicPtr const& basic, std::ostream &os )
+/*****************************************************************************/
+{
+    m_buffer.clear();
+    print(basic, m_buffer);
+    os << m_buffer;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Printer::print( BasicPtr const& basic, std::string &out )
+/*****************************************************************************/
 {
 	if (basic.get() == NULL) throw InternalError("Printer: Basic is NULL");
 	// Nach Typ unterscheiden
 	switch(basic->getType())
 	{
 	case Type_Abs:
-		return print_Abs( Util::getAsConstPtr<Abs>(basic) );
+		print_Abs( Util::getAsConstPtr<Abs>(basic), out );
+		break;
 	case Type_Acos:
-		return print_Acos( Util::getAsConstPtr<Acos>(basic) );
+		print_Acos( Util::getAsConstPtr<Acos>(basic), out );
+		break;
 	case Type_Add:
-		return print_Add( Util::getAsConstPtr<Add>(basic) );
+		print_Add( Util::getAsConstPtr<Add>(basic), out );
+		break;
 	case Type_Asin:
-		return print_Asin( Util::getAsConstPtr<Asin>(basic) );
+		print_Asin( Util::getAsConstPtr<Asin>(basic), out );
+		break;
 	case Type_Atan:
-		return print_Atan( Util::getAsConstPtr<Atan>(basic) );
+		print_Atan( Util::getAsConstPtr<Atan>(basic), out );
+		break;
 	case Type_Atan2:
-		return print_Atan2( Util::getAsConstPtr<Atan2>(basic) );
+		print_Atan2( Util::getAsConstPtr<Atan2>(basic), out );
+		break;
 	case Type_Cos:
-		return print_Cos( Util::getAsConstPtr<Cos>(basic) );
+		print_Cos( Util::getAsConstPtr<Cos>(basic), out );
+		break;
 	case Type_Der:
-		return print_Der( Util::getAsConstPtr<Der>(basic) );
+		print_Der( Util::getAsConstPtr<Der>(basic), out );
+		break;
 	case Type_Element:
-		return print_Element( Util::getAsConstPtr<Element>(basic) );
+		print_Element( Util::getAsConstPtr<Element>(basic), out );
+		break;
 	case Type_Equal:
-		return print_Equal( Util::getAsConstPtr<Equal>(basic) );
+		print_Equal( Util::getAsConstPtr<Equal>(basic), out );
+		break;
 	case Type_Greater:
-		return print_Greater( Util::getAsConstPtr<Greater>(basic) );
+		print_Greater( Util::getAsConstPtr<Greater>(basic), out );
+		break;
 	case Type_If:
-		return print_If( Util::getAsConstPtr<If>(basic) );
+		print_If( Util::getAsConstPtr<If>(basic), out );
+		break;
 	case Type_Int:
-		return print_Int( Util::getAsConstPtr<Int>(basic) );
+		print_Int( Util::getAsConstPtr<Int>(basic), out );
+		break;
 	case Type_Inverse:
-		return print_Inverse( Util::getAsConstPtr<Inverse>(basic) );
+		print_Inverse( Util::getAsConstPtr<Inverse>(basic), out );
+		break;
 	case Type_Jacobian:
-		return print_Jacobian( Util::getAsConstPtr<Jacobian>(basic) );
+		print_Jacobian( Util::getAsConstPtr<Jacobian>(basic), out );
+		break;
 	case Type_Less:
-		return print_Less( Util::getAsConstPtr<Less>(basic) );
+		print_Less( Util::getAsConstPtr<Less>(basic), out );
+		break;
 	case Type_Matrix:
-		return print_Matrix( Util::getAsConstPtr<Matrix>(basic) );
+		print_Matrix( Util::getAsConstPtr<Matrix>(basic), out );
+		break;
 	case Type_Mul:
-		return print_Mul( Util::getAsConstPtr<Mul>(basic) );
+		print_Mul( Util::getAsConstPtr<Mul>(basic), out );
+		break;
 	case Type_Neg:
-		return print_Neg( Util::getAsConstPtr<Neg>(basic) );
+		print_Neg( Util::getAsConstPtr<Neg>(basic), out );
+		break;
 	case Type_Pow:
-		return print_Pow( Util::getAsConstPtr<Pow>(basic) );
+		print_Pow( Util::getAsConstPtr<Pow>(basic), out );
+		break;
 	case Type_Outer:
-		return print_Outer( Util::getAsConstPtr<Outer>(basic) );
+		print_Outer( Util::getAsConstPtr<Outer>(basic), out );
+		break;
 	case Type_Real:
-		return print_Real( Util::getAsConstPtr<Real>(basic) );
+		print_Real( Util::getAsConstPtr<Real>(basic), out );
+		break;
 	case Type_Scalar:
-		return print_Scalar( Util::getAsConstPtr<Scalar>(basic) );
+		print_Scalar( Util::getAsConstPtr<Scalar>(basic), out );
+		break;
 	case Type_Sign:
-		return print_Sign( Util::getAsConstPtr<Sign>(basic) );
+		print_Sign( Util::getAsConstPtr<Sign>(basic), out );
+		break;
 	case Type_Sin:
-		return print_Sin( Util::getAsConstPtr<Sin>(basic) );
+		print_Sin( Util::getAsConstPtr<Sin>(basic), out );
+		break;
 	case Type_Skew:
-		return print_Skew( Util::getAsConstPtr<Skew>(basic) );
+		print_Skew( Util::getAsConstPtr<Skew>(basic), out );
+		break;
 	case Type_Solve:
-		return print_Solve( Util::getAsConstPtr<Solve>(basic) );
+		print_Solve( Util::getAsConstPtr<Solve>(basic), out );
+		break;
 	case Type_Symbol:
-		return print_Symbol( Util::getAsConstPtr<Symbol>(basic) );
+		print_Symbol( Util::getAsConstPtr<Symbol>(basic), out );
+		break;
 	case Type_Tan:
-		return print_Tan( Util::getAsConstPtr<Tan>(basic) );
+		print_Tan( Util::getAsConstPtr<Tan>(basic), out );
+		break;
 	case Type_Transpose:
-		return print_Transpose( Util::getAsConstPtr<Transpose>(basic) );
+		print_Transpose( Util::getAsConstPtr<Transpose>(basic), out );
+		break;
 	case Type_Zero:
-		return print_Zero( Util::getAsConstPtr<Zero>(basic) );
+		print_Zero( Util::getAsConstPtr<Zero>(basic), out );
+		break;
     case Type_Unknown:
-        return print_Unknown( Util::getAsConstPtr<Unknown>(basic) );
+        print_Unknown( Util::getAsConstPtr<Unknown>(basic), out );
+		break;
     case Type_Bool:
-        return print_Bool( Util::getAsConstPtr<Bool>(basic) );
+        print_Bool( Util::getAsConstPtr<Bool>(basic), out );
+		break;
 	default:
 		throw InternalError("Printer: 'print' called with unrecognized type!");
 	}
@@ -136,62 +189,68 @@ std::string Printer::print( BasicPtr const& basic )
 //Implementationsbeispiele der komplett virtuellen Funktionen
 
 /*****************************************************************************/
-//std::string Printer::print_Element( const Element *e )
+//void Printer::print_Element( const Element *e, std::string &out )
 /*****************************************************************************/
 //{
 //	if (e == NULL) throw InternalError("Printer: Element is NULL");
-//	return print(e->getArg(0)) + "[" + str(e->getRow()) + "," + str(e->getCol()) + "]";
+//	print(e->getArg(0), out);
+//	out += "[" + str(e->getRow()) + "," + str(e->getCol()) + "]";
 //}
 /*****************************************************************************/
 
 /*****************************************************************************/
-//std::string Printer::print_Matrix( const Matrix *c )
+//void Printer::print_Matrix( const Matrix *c, std::string &out )
 /*****************************************************************************/
 //{
 //  if (c == NULL) throw InternalError("Printer: Matrix is NULL");
-//	return print_Matrix(c, ',', ',',
+//	print_Matrix(c, out, ',', ',',
 //		'[', ']',
 //		'[', ']');
 //}
 /*****************************************************************************/
 
 ///*****************************************************************************/
-//std::string Printer::print_Pow( const Pow *pow )
+//void Printer::print_Pow( const Pow *pow, std::string &out )
 /*****************************************************************************/
 //{
 //	if (pow == NULL) throw InternalError("Printer: Pow is NULL");
-//	return "pow(" + print(pow->getBase()) + "," + str(pow->getExponent()) + ")";
+//	out += "pow(";
+//	print(pow->getBase(), out);
+//	out += "," + str(pow->getExponent()) + ")";
 //}
 /*****************************************************************************/
 
 /*****************************************************************************/
-//std::string Printer::print_Skew( const Skew *s )
+//void Printer::print_Skew( const Skew *s, std::string &out )
 /*****************************************************************************/
 //{
 //	if (s == NULL) throw InternalError("Printer: Skew is NULL");
-//	return "skew(" + print(s->getArg()) + ")";
+//	out += "skew(";
+//	print(s->getArg(), out);
+//	out += ")";
 //}
 /*****************************************************************************/
 
 /*****************************************************************************/
-//std::string Printer::print_Zero( const Zero *z )
+//void Printer::print_Zero( const Zero *z, std::string &out )
 /*****************************************************************************/
 //{
 //	if (z==NULL) throw InternalError("Printer: Zero is NULL");
 //  if (z->is_Scalar())
-//      return "0";
-//  return "zero(" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ")";
+//      out += "0";
+//  else
+//      out += "zero(" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ")";
 //}
 /*****************************************************************************/
 
 //Die nur mit Fehlerausgabe implementierten Funktionen:
 
 /*****************************************************************************/
-std::string Printer::print_If( const If *e )
+void Printer::print_If( const If *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e==NULL) throw InternalError("Printer: If is NULL");
-    return error ("Printer: Function 'If' not implemented in chosen export language");
+    out += error ("Printer: Function 'If' not implemented in chosen export language");
     //Beispielimplementierung:
     //you need to use an inline expression, since there is no function for an assignement operator
 	//return "if (" + print(e->getArg(0)) + ") " + print(e->getArg(1)) + " else " + print(e->getArg(2));
@@ -199,44 +258,44 @@ std::string Printer::print_If( const If *e )
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Inverse( const Inverse *c )
+void Printer::print_Inverse( const Inverse *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("Printer: Inverse is NULL");
-    return error ("Printer: Function 'Inverse' not implemented in chosen export language");
+    out += error ("Printer: Function 'Inverse' not implemented in chosen export language");
     //Beispielimplementierung:
 	//return "inv(" + print(c->getArg()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Jacobian( const Jacobian *j )
+void Printer::print_Jacobian( const Jacobian *j, std::string &out )
 /*****************************************************************************/
 {
 	if (j==NULL) throw InternalError("Printer: Jacobian is NULL");
-	return error ("Printer: Function 'Jacobian' not implemented in chosen export language");
+	out += error ("Printer: Function 'Jacobian' not implemented in chosen export language");
     //Beispielimplementierung:
 	//return "jacobian(" + print(j->getArg1()) + "," + print(j->getArg2()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Scalar( const Scalar *s )
+void Printer::print_Scalar( const Scalar *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Scalar is NULL");
-    return error ("Printer: Function 'Scalar' not implemented in chosen export language");
+    out += error ("Printer: Function 'Scalar' not implemented in chosen export language");
     //Beispielimplementierung:
 	//return "scalar(" + print(s->getArg()) + ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Solve( const Solve *s )
+void Printer::print_Solve( const Solve *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Solve is NULL");
-    return error ("Printer: Function 'Solve' not implemented in chosen export language");
+    out += error ("Printer: Function 'Solve' not implemented in chosen export language");
     //Beispielimplementierung:
 	//return "solve(" + print(s->getArg1()) + "," + print(s->getArg2()) + ")";
 }
@@ -246,183 +305,218 @@ std::string Printer::print_Solve( const Solve *s )
 //Implementation der Standardausgaben der restlichen Funktionen
 
 /*****************************************************************************/
-std::string Printer::print_Abs( const Abs *s )
+void Printer::print_Abs( const Abs *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Abs is NULL");
-	return "abs(" + print(s->getArg()) + ")";
+	out += "abs(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Sign( const Sign *s )
+void Printer::print_Sign( const Sign *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s==NULL) throw InternalError("Printer: Sign is NULL");
-    return "sign(" + print(s->getArg()) + ")";
+    out += "sign(";
+    print(s->getArg(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Acos( const Acos *s )
+void Printer::print_Acos( const Acos *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Acos is NULL");
-	return "acos(" + print(s->getArg()) + ")";
+	out += "acos(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Add( const Add *add )
+void Printer::print_Add( const Add *add, std::string &out )
 /*****************************************************************************/
 {
 	if (add == NULL) throw InternalError("Printer: Add is NULL");
-	return "(" + join(ConstBasicPtr(add), " + ", " - ") + ")";
+	out += "(";
+	join(ConstBasicPtr(add), " + ", " - ", out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Asin( const Asin *s )
+void Printer::print_Asin( const Asin *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Asin is NULL");
-	return "asin(" + print(s->getArg()) + ")";
+	out += "asin(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Atan( const Atan *s )
+void Printer::print_Atan( const Atan *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Atan is NULL");
-	return "atan(" + print(s->getArg()) + ")";
+	out += "atan(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Atan2( const Atan2 *s )
+void Printer::print_Atan2( const Atan2 *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Atan2 is NULL");
-	return "atan2(" + print(s->getArg1()) + "," + print(s->getArg2()) + ")";
+	out += "atan2(";
+	print(s->getArg1(), out);
+	out += ",";
+	print(s->getArg2(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Cos( const Cos *c )
+void Printer::print_Cos( const Cos *c, std::string &out )
 /*****************************************************************************/
 {
 	if (c == NULL) throw InternalError("Printer: Cos is NULL");
-	return "cos(" + print(c->getArg()) + ")";
+	out += "cos(";
+	print(c->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Der( const Der *d )
+void Printer::print_Der( const Der *d, std::string &out )
 /*****************************************************************************/
 {
 	if (d == NULL) throw InternalError("Printer: Der is NULL");
     const BasicPtr arg = d->getArg();
     if ( ! (arg->getType() == Type_Symbol || (arg->getType() == Type_Element && arg->getArg(0)->getType() == Type_Symbol)))
-        return error("Printer: Der: Argument of Der can only be Symbol or Element of Symbol in chosen export language, but it is of type '" 
-                    + str(arg->getType()) + "' and expands to: '" + print(arg) + "'");
-	return "der_" + print(arg);
+    {
+        out += error("Printer: Der: Argument of Der can only be Symbol or Element of Symbol in chosen export language, but it is of type '" 
+                + str(arg->getType()) + "' and expands to: '" + print(arg) + "'");
+        return;
+    }
+	out += "der_";
+	print(arg, out);
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Int( const Int *c )
+void Printer::print_Int( const Int *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("Printer: Int is NULL");
     int val = c->getValue();
     if (val < 0)
-	    return "(" + str(val) + ")"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
+	    out += "(" + str(val) + ")"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
     else
-        return str(val);
+        out += str(val);
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Mul( const Mul *mul )
+void Printer::print_Mul( const Mul *mul, std::string &out )
 /*****************************************************************************/
 {
 	if (mul == NULL) throw InternalError("Printer: Mul is NULL");
-	return "(" + join(ConstBasicPtr(mul), " * ") + ")";
+	out += "(";
+	join(ConstBasicPtr(mul), " * ", out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Neg( const Neg *neg )
+void Printer::print_Neg( const Neg *neg, std::string &out )
 /*****************************************************************************/
 {
 	if (neg == NULL) throw InternalError("Printer: Neg is NULL");
-	return "(-" + print(neg->getArg()) + ")";
+	out += "(-";
+	print(neg->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Real( const Real *c )
+void Printer::print_Real( const Real *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("Printer: Real is NULL");
     double val = c->getValue();
     if (val < 0.0)
-	    return "(" + str(val) + ")"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
+	    out += "(" + str(val) + ")"; // Klammern, damit das Minus nicht direkt auf einen anderen Operator folgt 
     else
-        return str(val);
+        out += str(val);
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Sin( const Sin *s )
+void Printer::print_Sin( const Sin *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Sin is NULL");
-	return "sin(" + print(s->getArg()) + ")";
+	out += "sin(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Symbol( const Symbol *symbol )
+void Printer::print_Symbol( const Symbol *symbol, std::string &out )
 /*****************************************************************************/
 {
 	if (symbol == NULL) throw InternalError("Printer: Symbol is NULL");
-	return symbol->getName();
+	out += symbol->getName();
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Tan( const Tan *s )
+void Printer::print_Tan( const Tan *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Tan is NULL");
-	return "tan(" + print(s->getArg()) + ")";
+	out += "tan(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Transpose( const Transpose *s )
+void Printer::print_Transpose( const Transpose *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Transpose is NULL");
-	return "transpose(" + print(s->getArg()) + ")";
+	out += "transpose(";
+	print(s->getArg(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string Printer::print_Unknown( const Unknown *s )
+void Printer::print_Unknown( const Unknown *s, std::string &out )
 /*****************************************************************************/
 {
 	if (s == NULL) throw InternalError("Printer: Unknown is NULL");
-	return s->getName() + "(" + join(ConstBasicPtr(s), ",") + ")";
+	out += s->getName();
+	out += "(";
+	join(ConstBasicPtr(s), ",", out);
+	out += ")";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string Printer::join( ConstBasicPtr const& arg,  std::string const& sep)
+void Printer::join( ConstBasicPtr const& arg,  std::string const& sep, std::string &out )
 /*****************************************************************************/
 {
 	// Groesse
@@ -430,25 +524,24 @@ std::string Printer::join( ConstBasicPtr const& arg,  std::string const& sep)
 
 	// Muss ein Zeichen eingefuegt werden
 	if (n == 0)
-		return "";
+		return;
 
 	// Zusammenbauen
-	std::string s = print(arg->getArg(0));
+	print(arg->getArg(0), out);
 	for(size_t i=1; i<n; ++i)
 	{
-		s += sep + print(arg->getArg(i));
+		out += sep;
+		print(arg->getArg(i), out);
 	}
-
-	// Fertig
-	return s;
 };
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string Printer::join( ConstBasicPtr const& arg,
+void Printer::join( ConstBasicPtr const& arg,
 						  std::string const& posSep,
-						  std::string const& negSep)
+						  std::string const& negSep,
+						  std::string &out )
 /*****************************************************************************/
 {
 	// Groesse
@@ -456,10 +549,10 @@ std::string Printer::join( ConstBasicPtr const& arg,
 
 	// Muss ein Zeichen eingefuegt werden
 	if (n == 0)
-		return "";
+		return;
 
 	// Zusammenbauen
-	std::string s = print(arg->getArg(0));
+	print(arg->getArg(0), out);
 	for(size_t i=1; i<n; ++i)
 	{
 		BasicPtr a = arg->getArg(i);
@@ -469,35 +562,46 @@ std::string Printer::join( ConstBasicPtr const& arg,
 		case Type_Neg:
 			{
 				const Neg *neg = Util::getAsConstPtr<Neg>(a);
-				s += negSep + print(neg->getArg());
+				out += negSep;
+				print(neg->getArg(), out);
 				break;
 			}
 		case Type_Int:
 			{
 				const Int *i = Util::getAsConstPtr<Int>(a);
 				if (i->getValue() < 0)
-					s += negSep + print( Int::New( -i->getValue() ) );
+				{
+					out += negSep;
+					print( Int::New( -i->getValue() ), out );
+				}
 				else
-					s += posSep + print( a );
+				{
+					out += posSep;
+					print( a, out );
+				}
 				break;
 			}
 		case Type_Real:
 			{
 				const Real *r = Util::getAsConstPtr<Real>(a);
 				if (r->getValue() < 0)
-					s += negSep + print( new Real( -r->getValue() ) );
+				{
+					out += negSep;
+					print( new Real( -r->getValue() ), out );
+				}
 				else
-					s += posSep + print( a );
+				{
+					out += posSep;
+					print( a, out );
+				}
 				break;
 			}
 		default:
-			s += posSep + print(a);
+			out += posSep;
+			print(a, out);
 			break;
 		}
 	}
-
-	// Fertig
-	return s;
 };
 /*****************************************************************************/
 
@@ -510,7 +614,7 @@ std::string Printer::join( ConstBasicPtr const& arg,
 // womit allerdings die Information ob es sich um einen Zeilen oder Spaltenvektor handelt verloren geht.
 
 /*****************************************************************************/
-std::string Printer::print_Matrix( const Matrix *mat,
+void Printer::print_Matrix( const Matrix *mat, std::string &out,
 								   char colSep,  char rowSep, 
 								   char leftConstr,  char rightConstr,
 								   char leftRowBracket,  char rightRowBracket,
@@ -523,11 +627,11 @@ std::string Printer::print_Matrix( const Matrix *mat,
 	// Skalar
 	if (mat->is_Scalar())
 	{
-		return print((*mat)(0));
+		print((*mat)(0), out);
+		return;
 	}
 
 	// Vektor
-	std::string s = "";
 	if (mat->is_Vector() && (colSep != rowSep || forceNoMatrixVectors))
 	{
 		// Gesamtgroesse
@@ -540,16 +644,17 @@ std::string Printer::print_Matrix( const Matrix *mat,
 			Sep = colSep;
 		//else throw InternalError("Printer: Unexpected error (Matrix is Vector but no dimension is > 1)");
 		//Es kann wohl auftreten wenn Skalare als Vektoren deklariert sind. Aber dann sollte der Seperator nicht gebraucht werden -> wenn ein � im Code auftaucht ist was faul
-		s += leftConstr; //TODO: Klammernunterscheidung (gibts �berhaupt ne Sprache die sowas hat?)
+		out += leftConstr; //TODO: Klammernunterscheidung (gibts �berhaupt ne Sprache die sowas hat?)
 		for (size_t l=0;l<size;++l)
 		{
 			// Element anhaengen
-			s += print((*mat)(l));
+			print((*mat)(l), out);
 			// Hinter letztem Zeichen kein Trennzeichen
 
-			if (l<(size-1)) s += Sep;
+			if (l<(size-1)) out += Sep;
 		}
-		return s + rightConstr;
+		out += rightConstr;
+		return;
 	}
 
 	// Matrix
@@ -559,64 +664,80 @@ std::string Printer::print_Matrix( const Matrix *mat,
 		size_t rows = mat->getShape().getDimension(1);
 		size_t cols = mat->getShape().getDimension(2);
 
-		s += leftConstr;
+		out += leftConstr;
 		for (size_t m=0;m<rows;++m)
 		{
-			s += leftRowBracket;
+			out += leftRowBracket;
 			for (size_t n=0;n<cols;++n)
 			{
 				// Element anhaengen
-				s += print((*mat)(m,n));
+				print((*mat)(m,n), out);
 				// Wenn wir noch nicht am Ende der Zeile sind
 				if (n < (cols-1))
-					s += colSep;
+					out += colSep;
 			}
-			s += rightRowBracket;
+			out += rightRowBracket;
 			if (m < (rows-1))
-				s = s+ rowSep + (mat->is_Vector() ? "" : matrixLineBreak ); //Vektoren ohne Zeilenumbruch ausgeben
+			{
+				out += rowSep;
+				if (!mat->is_Vector()) out += matrixLineBreak; //Vektoren ohne Zeilenumbruch ausgeben
+			}
 		}
-		return s + rightConstr;
+		out += rightConstr;
+		return;
 	}
 
 	// Error
-	return error("Printer: Matrix: Element must be either Scalar, Vector or Matrix");
+	out += error("Printer: Matrix: Element must be either Scalar, Vector or Matrix");
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Outer( const Outer *o )
+void Printer::print_Outer( const Outer *o, std::string &out )
 /*****************************************************************************/
 {
 	if (o==NULL) throw InternalError("Printer: Outer is NULL");
 	BasicPtr mul = Mul::New( o->getArg1(), Transpose::New(o->getArg2()));
-	return print(mul);
+	print(mul, out);
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Equal( const Equal *e )
+void Printer::print_Equal( const Equal *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e==NULL) throw InternalError("Printer: Equal is NULL");
-    return "(" + print(e->getArg1()) + " == " + print(e->getArg2()) + ")";
+    out += "(";
+    print(e->getArg1(), out);
+    out += " == ";
+    print(e->getArg2(), out);
+    out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Greater( const Greater *e )
+void Printer::print_Greater( const Greater *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e==NULL) throw InternalError("Printer: Greater is NULL");
-	return "(" + print(e->getArg1()) + ">" + print(e->getArg2()) + ")";
+	out += "(";
+	print(e->getArg1(), out);
+	out += ">";
+	print(e->getArg2(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string Printer::print_Less( const Less *e )
+void Printer::print_Less( const Less *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e==NULL) throw InternalError("Printer: Less is NULL");
-	return "(" + print(e->getArg1()) + "<" + print(e->getArg2()) + ")";
+	out += "(";
+	print(e->getArg1(), out);
+	out += "<";
+	print(e->getArg2(), out);
+	out += ")";
 }
 /*****************************************************************************/
 
@@ -30,29 +30,35 @@ std::string PythonPrinter::comment( const std::string &c ) const
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Matrix( const Matrix *c )
+void PythonPrinter::print_Matrix( const Matrix *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("PythonPrinter: Matrix is NULL");
-    return "matrix(" + Printer::print_Matrix(c, ',', ',',
-                                                '[', ']',
-                                                '[', ']' ) + ", dtype=float)";
+    out += "matrix(";
+    Printer::print_Matrix(c, out, ',', ',',
+                                   '[', ']',
+                                   '[', ']' );
+    out += ", dtype=float)";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Pow( const Pow *pow )
+void PythonPrinter::print_Pow( const Pow *pow, std::string &out )
 /*****************************************************************************/
 {
     if (pow == NULL) throw InternalError("PythonPrinter: Pow is NULL");
-		return "(" + print(pow->getBase()) + "**" + print(pow->getExponent()) + ")";
+		out += "(";
+		print(pow->getBase(), out);
+		out += "**";
+		print(pow->getExponent(), out);
+		out += ")";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Mul( const Mul *mul )
+void PythonPrinter::print_Mul( const Mul *mul, std::string &out )
 /*****************************************************************************/
 {
 
@@ -63,104 +69,128 @@ std::string PythonPrinter::print_Mul( const Mul *mul )
 			if ( ! mul->getArg(i)->is_Scalar())
 				includesMatrix = true;
 	if (includesMatrix) // Wenn das Ergebnis der Multiplikation Skalar ist, in der Mul. jedoch Matritzen enthalten sind muss das Ergebnis skalarisiert werden
-		return "(" + join(ConstBasicPtr(mul), " * ") + ")[0,0]";
-	return "(" + join(ConstBasicPtr(mul), " * ") + ")";
+	{
+		out += "(";
+		join(ConstBasicPtr(mul), " * ", out);
+		out += ")[0,0]";
+		return;
+	}
+	out += "(";
+	join(ConstBasicPtr(mul), " * ", out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Element( const Element *e )
+void PythonPrinter::print_Element( const Element *e, std::string &out )
 /*****************************************************************************/
 {
     if (e == NULL) throw InternalError("PythonPrinter: Element is NULL");
-	return print(e->getArg(0)) + "[" + str(e->getRow()) + "," + str(e->getCol()) + "]";
+	print(e->getArg(0), out);
+	out += "[" + str(e->getRow()) + "," + str(e->getCol()) + "]";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Solve( const Solve *s )
+void PythonPrinter::print_Solve( const Solve *s, std::string &out )
 /*****************************************************************************/
 {
     if (s == NULL) throw InternalError("PythonPrinter: Solve is NULL");
-    return "matrix(linalg.solve(" + print(s->getArg1()) + "," + print(s->getArg2()) + "))";
+    out += "matrix(linalg.solve(";
+    print(s->getArg1(), out);
+    out += ",";
+    print(s->getArg2(), out);
+    out += "))";
 	// Das Ergebnis von solve ist ein ndarray, muss somit "matrifiziert" werden
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Transpose( const Transpose *t )
+void PythonPrinter::print_Transpose( const Transpose *t, std::string &out )
 /*****************************************************************************/
 {
     if (t == NULL) throw InternalError("PythonPrinter: Transpose is NULL");
-    return print(t->getArg()) + ".T";
+    print(t->getArg(), out);
+    out += ".T";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Scalar( const Scalar *s )
+void PythonPrinter::print_Scalar( const Scalar *s, std::string &out )
 /*****************************************************************************/
 {
     if (s == NULL) throw InternalError("PythonPrinter: Scalar is NULL");
-    return print(s->getArg()) + "[0,0]";
+    print(s->getArg(), out);
+    out += "[0,0]";
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Skew( const Skew *s )
+void PythonPrinter::print_Skew( const Skew *s, std::string &out )
 /*****************************************************************************/
 {
     if (s == NULL) throw InternalError("PythonPrinter: Skew is NULL");
     std::string v = print(s->getArg());
-    return "matrix([[0,-" + v + "[2,0], " + v + "[1,0]], [" + v + "[2,0], 0, -" + v + "[0,0]], [-" + v + "[1,0], " + v + "[0,0], 0]])";  
+    out += "matrix([[0,-" + v + "[2,0], " + v + "[1,0]], [" + v + "[2,0], 0, -" + v + "[0,0]], [-" + v + "[1,0], " + v + "[0,0], 0]])";  
 
 }
 /*****************************************************************************/
 
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Zero( const Zero *z )
+void PythonPrinter::print_Zero( const Zero *z, std::string &out )
 /*****************************************************************************/
 {
     if ( z == NULL) throw InternalError("PythonPrinter: Zero is NULL");
     if (z->is_Scalar())
-		return "0";
+    {
+		out += "0";
+		return;
+    }
     // Auch zero muss "matrifiziert" werden
-    return "matrix(zeros( (" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ") ))";
+    out += "matrix(zeros( (" + str(z->getShape().getDimension(1)) + "," + str(z->getShape().getDimension(2)) + ") ))";
 
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string PythonPrinter::print_If( const If *e )
+void PythonPrinter::print_If( const If *e, std::string &out )
 /*****************************************************************************/
 {
 	if (e==NULL) throw InternalError("Printer: If is NULL");
     //we need to use an inline expression, since there is no function for an assignement operator
-	return "(" + print(e->getArg(1)) + " if " + print(e->getArg(0)) + " else " + print(e->getArg(2)) + ")";
+	out += "(";
+	print(e->getArg(1), out);
+	out += " if ";
+	print(e->getArg(0), out);
+	out += " else ";
+	print(e->getArg(2), out);
+	out += ")";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Inverse( const Inverse *c )
+void PythonPrinter::print_Inverse( const Inverse *c, std::string &out )
 /*****************************************************************************/
 {
     if (c == NULL) throw InternalError("Printer: Inverse is NULL");
-	return print(c->getArg()) + ".I";
+	print(c->getArg(), out);
+	out += ".I";
 }
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string PythonPrinter::print_Bool( const Bool *b )
+void PythonPrinter::print_Bool( const Bool *b, std::string &out )
 /*****************************************************************************/
 {
     if (b == NULL) throw InternalError("PythonPrinter: Bool is NULL");
     if (b->getValue())
-        return "True";
+        out += "True";
     else
-        return "False";
+        out += "False";
 }
 /*****************************************************************************/
@@ -20,21 +20,21 @@ namespace Symbolics
 
     protected:
         //geforderte Funktionen �berschreiben
-        std::string print_Element( const Element *e );
-        std::string print_Matrix( const Matrix *mat );
-        std::string print_Skew( const Skew *s );  // Nur Fehlermeldung
-        std::string print_Pow( const Pow *pow );
-        std::string print_Zero( const Zero *z );
-        std::string print_Bool( const Bool *b );
+        void print_Element( const Element *e, std::string &out );
+        void print_Matrix( const Matrix *mat, std::string &out );
+        void print_Skew( const Skew *s, std::string &out );  // Nur Fehlermeldung
+        void print_Pow( const Pow *pow, std::string &out );
+        void print_Zero( const Zero *z, std::string &out );
+        void print_Bool( const Bool *b, std::string &out );
 
 		//Funktionen die sich vom Standard unterscheiden, ueberschreiben
-		std::string print_Abs ( const Abs *s );
-        std::string print_If( const If *e );
-        //std::string print_Int( const Int *c ); //Ints als doubles ausgeben?
-        //std::string print_Inverse ( const Inverse *c );
-        std::string print_Sign( const Sign *s );
-        std::string print_Solve( const Solve *s ); // Nur Fehlermeldung hier
-        std::string print_Transpose( const Transpose *s ); //Nur Fehlermeldung
+		void print_Abs( const Abs *s, std::string &out );
+        void print_If( const If *e, std::string &out );
+        //void print_Int( const Int *c, std::string &out ); //Ints als doubles ausgeben?
+        //void print_Inverse( const Inverse *c, std::string &out );
+        void print_Sign( const Sign *s, std::string &out );
+        void print_Solve( const Solve *s, std::string &out ); // Nur Fehlermeldung hier
+        void print_Transpose( const Transpose *s, std::string &out ); //Nur Fehlermeldung
     };
 };
 
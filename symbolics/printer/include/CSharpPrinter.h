@@ -20,31 +20,31 @@ namespace Symbolics
 
     protected:
         // Overwrite methods
-        std::string print_Element( const Element *e );
-        std::string print_Matrix( const Matrix *mat );
-        std::string print_Skew( const Skew *s );
-        std::string print_Pow( const Pow *pow );
-        std::string print_Zero( const Zero *z );
-        std::string print_Bool( const Bool *b );
+        void print_Element( const Element *e, std::string &out );
+        void print_Matrix( const Matrix *mat, std::string &out );
+        void print_Skew( const Skew *s, std::string &out );
+        void print_Pow( const Pow *pow, std::string &out );
+        void print_Zero( const Zero *z, std::string &out );
+        void print_Bool( const Bool *b, std::string &out );
 
 		// Overwrite methods different from standard
-		std::string print_Abs ( const Abs *s );
-        std::string print_If( const If *e );
-        //std::string print_Int( const Int *c );
+		void print_Abs( const Abs *s, std::string &out );
+        void print_If( const If *e, std::string &out );
+        //void print_Int( const Int *c, std::string &out );
         
-        std::string print_Jacobian( const Jacobian *j );
-        std::string print_Inverse ( const Inverse *c );
-        std::string print_Sign( const Sign *s );
-        std::string print_Solve( const Solve *s );
-        std::string print_Transpose( const Transpose *s );  
+        void print_Jacobian( const Jacobian *j, std::string &out );
+        void print_Inverse( const Inverse *c, std::string &out );
+        void print_Sign( const Sign *s, std::string &out );
+        void print_Solve( const Solve *s, std::string &out );
+        void print_Transpose( const Transpose *s, std::string &out );  
         
-        std::string print_Acos( const Acos *s );
-        std::string print_Asin( const Asin *s );
-        std::string print_Atan( const Atan *s );
-        std::string print_Atan2( const Atan2 *s );
-        std::string print_Cos( const Cos *c );
-        std::string print_Sin( const Sin *s );
-        std::string print_Tan( const Tan *s );
+        void print_Acos( const Acos *s, std::string &out );
+        void print_Asin( const Asin *s, std::string &out );
+        void print_Atan( const Atan *s, std::string &out );
+        void print_Atan2( const Atan2 *s, std::string &out );
+        void print_Cos( const Cos *c, std::string &out );
+        void print_Sin( const Sin *s, std::string &out );
+        void print_Tan( const Tan *s, std::string &out );
     };
 };
 
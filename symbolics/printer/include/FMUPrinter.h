@@ -18,10 +18,10 @@ namespace Symbolics
 		const std::map<std::string, int> *m_valueReferencesP;
 
 		// Funktionen die sich vom CPrinter unterscheiden, ueberschreiben
-        std::string print_Symbol( const Symbol *symbol );
-		std::string print_Element( const Element *e );
-		std::string print_Der( const Der *d );
-        std::string print_Bool( const Bool *b );
+        void print_Symbol( const Symbol *symbol, std::string &out );
+		void print_Element( const Element *e, std::string &out );
+		void print_Der( const Der *d, std::string &out );
+        void print_Bool( const Bool *b, std::string &out );
 
     };
 };
@@ -18,8 +18,8 @@ namespace Symbolics
 
     protected:
         // Funktionen die sich vom Standard unterscheiden, ueberschreiben
-        std::string print_Atan2( const Atan2 *s );
-        std::string print_Sign( const Sign *s );
+        void print_Atan2( const Atan2 *s, std::string &out );
+        void print_Sign( const Sign *s, std::string &out );
 
     };
 };
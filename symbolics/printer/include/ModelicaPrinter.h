@@ -20,20 +20,20 @@ namespace Symbolics
 
     protected:
         //geforderte Funktionen �berschreiben
-        std::string print_Element( const Element *e );
-        std::string print_Matrix( const Matrix *mat );
-        std::string print_Skew( const Skew *s ); 
-        std::string print_Pow( const Pow *pow );
-        std::string print_Zero( const Zero *z );
-        std::string print_Bool( const Bool *b );
+        void print_Element( const Element *e, std::string &out );
+        void print_Matrix( const Matrix *mat, std::string &out );
+        void print_Skew( const Skew *s, std::string &out ); 
+        void print_Pow( const Pow *pow, std::string &out );
+        void print_Zero( const Zero *z, std::string &out );
+        void print_Bool( const Bool *b, std::string &out );
 
         // Funktionen die sich vom Standard unterscheiden, ueberschreiben
-        std::string print_Der( const Der *d );
-		std::string print_Mul( const Mul *m );
-        std::string print_If( const If *e );
-        std::string print_Inverse( const Inverse *c );
-        std::string print_Scalar( const Scalar *s );
-        std::string print_Solve( const Solve *s );
+        void print_Der( const Der *d, std::string &out );
+		void print_Mul( const Mul *m, std::string &out );
+        void print_If( const If *e, std::string &out );
+        void print_Inverse( const Inverse *c, std::string &out );
+        void print_Scalar( const Scalar *s, std::string &out );
+        void print_Solve( const Solve *s, std::string &out );
     };
 };
 
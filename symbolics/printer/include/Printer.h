@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <ostream>
 #include "Symbolics.h"
 #include "Graph.h"
 
@@ -18,6 +19,11 @@ namespace Symbolics
 
         // Methode die alle Arten von Ausdr�cken in Strings in der korrekten Syntax der Ausgabesprache verwandelt
         std::string print( BasicPtr const& basic );
+        // wie oben, haengt aber an out an: die print_* Funktionen schreiben alle in
+        // denselben Puffer, es entsteht kein temporaerer String je Teilausdruck
+        void print( BasicPtr const& basic, std::string &out );
+        // direkt in einen Stream, ueber einen wiederverwendeten Puffer
+        void print( BasicPtr const& basic, std::ostream &os );
 
         // Gibt den �bergebenen String mit Kommentarzeichen oder einen leeren String zur�ck
         // muss in abgeleiteten Klassen �berschrieben werden
@@ -39,59 +45,59 @@ namespace Symbolics
         // Essentielle Funktionen f�r die es keinen sinnvollen Standard gibt, 
         // da sie in jeder Programmiersprache eine andere Syntax haben
         // Beispielimplementierungen sind auskommentiert in Printer.cpp
-        virtual std::string print_Element( const Element *e ) = 0;
-        virtual std::string print_Matrix( const Matrix *c ) = 0;
-        virtual std::string print_Pow( const Pow *pow ) = 0;
-        virtual std::string print_Skew( const Skew *s ) = 0;
-        virtual std::string print_Zero( const Zero *z ) = 0;
-        virtual std::string print_Bool( const Bool *b ) = 0;
+        virtual void print_Element( const Element *e, std::string &out ) = 0;
+        virtual void print_Matrix( const Matrix *c, std::string &out ) = 0;
+        virtual void print_Pow( const Pow *pow, std::string &out ) = 0;
+        virtual void print_Skew( const Skew *s, std::string &out ) = 0;
+        virtual void print_Zero( const Zero *z, std::string &out ) = 0;
+        virtual void print_Bool( const Bool *b, std::string &out ) = 0;
 
 
         // Funktionen die �berschreiben werden k�nnen wenn sie von der jeweiligen Sprache unterst�tzt werden sollen.
         // Standardm��ig geben diese Funktionen nur eine Fehlermeldung aus
-        virtual std::string print_If( const If *e );
-        virtual std::string print_Inverse( const Inverse *c );
-        virtual std::string print_Jacobian( const Jacobian *j );
-        virtual std::string print_Scalar( const Scalar *s ); //k�nnte evtl. auch nach unten, aber wo und wof�r wird es �berhaupt gebraucht?
-        virtual std::string print_Solve( const Solve *s );
+        virtual void print_If( const If *e, std::string &out );
+        virtual void print_Inverse( const Inverse *c, std::string &out );
+        virtual void print_Jacobian( const Jacobian *j, std::string &out );
+        virtual void print_Scalar( const Scalar *s, std::string &out ); //k�nnte evtl. auch nach unten, aber wo und wof�r wird es �berhaupt gebraucht?
+        virtual void print_Solve( const Solve *s, std::string &out );
 
 
         // Funktionen die hier mit einem sinnvollen Standard implementiert sind, 
         // der für viele Sprachen passen sollte:
 
         //allgemeine Funktionen
-        virtual std::string print_Abs( const Abs *s );
-        virtual std::string print_Add( const Add *add );
-        virtual std::string print_Der( const Der *d );
-        virtual std::string print_Int( const Int *c );
-        virtual std::string print_Mul( const Mul *mul );
-        virtual std::string print_Neg( const Neg *neg );
-        virtual std::string print_Outer( const Outer *o );
-        virtual std::string print_Real( const Real *c );
-        virtual std::string print_Sign( const Sign *s );
-        virtual std::string print_Symbol( const Symbol *symbol );
-        virtual std::string print_Transpose( const Transpose *s );
-        virtual std::string print_Unknown( const Unknown *u );
+        virtual void print_Abs( const Abs *s, std::string &out );
+        virtual void print_Add( const Add *add, std::string &out );
+        virtual void print_Der( const Der *d, std::string &out );
+        virtual void print_Int( const Int *c, std::string &out );
+        virtual void print_Mul( const Mul *mul, std::string &out );
+        virtual void print_Neg( const Neg *neg, std::string &out );
+        virtual void print_Outer( const Outer *o, std::string &out );
+        virtual void print_Real( const Real *c, std::string &out );
+        virtual void print_Sign( const Sign *s, std::string &out );
+        virtual void print_Symbol( const Symbol *symbol, std::string &out );
+        virtual void print_Transpose( const Transpose *s, std::string &out );
+        virtual void print_Unknown( const Unknown *u, std::string &out );
 
         //trigonometrische Funktionen
-        virtual std::string print_Acos( const Acos *s );
-        virtual std::string print_Asin( const Asin *s );
-        virtual std::string print_Atan( const Atan *s );
-        virtual std::string print_Atan2( const Atan2 *s );
-        virtual std::string print_Cos( const Cos *c );
-        virtual std::string print_Sin( const Sin *s );
-        virtual std::string print_Tan( const Tan *s );
+        virtual void print_Acos( const Acos *s, std::string &out );
+        virtual void print_Asin( const Asin *s, std::string &out );
+        virtual void print_Atan( const Atan *s, std::string &out );
+        virtual void print_Atan2( const Atan2 *s, std::string &out );
+        virtual void print_Cos( const Cos *c, std::string &out );
+        virtual void print_Sin( const Sin *s, std::string &out );
+        virtual void print_Tan( const Tan *s, std::string &out );
 
         //Vergleichsoperationen
-        virtual std::string print_Equal( const Equal *e );
-        virtual std::string print_Greater( const Greater *e );
-        virtual std::string print_Less( const Less *e );
+        virtual void print_Equal( const Equal *e, std::string &out );
+        virtual void print_Greater( const Greater *e, std::string &out );
+        virtual void print_Less( const Less *e, std::string &out );
 
 
         // Helferlein
-        // std::vector von Basics mit Trennzeichen zu einem String zusammenfuegen
-        std::string join( ConstBasicPtr const& arg,  std::string const& sep);
-        std::string join( ConstBasicPtr const& arg,  std::string const& posSep,  std::string const& negSep);
+        // std::vector von Basics mit Trennzeichen an out anhaengen
+        void join( ConstBasicPtr const& arg,  std::string const& sep, std::string &out );
+        void join( ConstBasicPtr const& arg,  std::string const& posSep,  std::string const& negSep, std::string &out );
         
         // Eine Matrix (Constant_Dbl, Constant_Int, Matrix) mit definierten Trennzeichen ausgeben:
 		// Matrix = <leftConstr> <leftRowBracket> ... <rightRowBracket> <rowSep> <leftRowBracket> ... <rightRowBracket> <rightConstr>
@@ -101,7 +107,7 @@ namespace Symbolics
 		// Bei identischem rowSep und colSep werden Vektoren wie Matrizen ausgeben, au�er es ist forceNoMatrixVectors gesetzt,
 		// womit allerdings die Information ob es sich um einen Zeilen oder Spaltenvektor handelt verloren geht.
         // 
-        std::string print_Matrix( const Matrix *mat, 
+        void print_Matrix( const Matrix *mat, std::string &out,
                                   char colSep,  char rowSep, 
                                   char leftConstr,  char rightConstr,
                                   char leftRowBracket,  char rightRowBracket,
@@ -112,6 +118,10 @@ namespace Symbolics
         std::string error(std::string errorMessage);
 
         int m_errorcount; // Z�hler f�r Fehlermeldungen
+
+    private:
+        // Puffer fuer print(basic, os), behaelt seine Kapazitaet
+        std::string m_buffer;
     };
 };
 
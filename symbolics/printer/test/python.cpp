@@ -1,4 +1,5 @@
 #include <iostream>
+#include <sstream>
 #include "Symbolics.h"
 #include "PythonPrinter.h"
 
@@ -454,6 +455,29 @@ int pyTestBool()
     return 0;
 }
 
+int pyTestSink()
+{
+    std::string out = "";
+    BasicPtr a(new Symbol("a"));
+    BasicPtr b(new Symbol("b"));
+    BasicPtr e = Add::New(a, Sin::New(b));
+    std::string s = "x = ";
+    pp.print(e, s);
+    if ( s.compare("x = " + pp.print(e)) )
+        out += "TEST_ERROR: Sink test 1: "+ s + "\n";
+
+    std::ostringstream os;
+    pp.print(e, os);
+    pp.print(a, os);
+    if ( os.str().compare(pp.print(e) + "a") )
+        out += "TEST_ERROR: Sink test 2: "+ os.str() + "\n";
+
+    std::cout << out;
+    if (out.compare(""))
+        return -16777216;
+    return 0;
+}
+
 int pyMain()
 {
     std::cout << "started PythonPrinter tests..." << std::endl;
@@ -479,6 +503,7 @@ int pyMain()
     res += pyTestVergl();
     res += pyTestIf();
     res += pyTestBool();
+    res += pyTestSink();
 
     res += pyTestComment();
     
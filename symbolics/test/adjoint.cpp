@@ -0,0 +1,79 @@
+#include <iostream>
+#include <cmath>
+#include "Symbolics.h"
+#include "Adjoint.h"
+
+using namespace Symbolics;
+
+// Zahlenwert nach Einsetzen von a, b, c
+double value( BasicPtr const& exp, BasicPtrVec const& symbols, BasicPtrVec const& values )
+{
+    BasicPtr e = exp;
+    for (size_t i=0;i<symbols.size();++i)
+        e = e->subs(symbols[i],values[i]);
+    e = Util::simplify(e);
+    if (e->getType() == Type_Real) return Util::getAsConstPtr<Real>(e)->getValue();
+    if (e->getType() == Type_Int) return Util::getAsConstPtr<Int>(e)->getValue();
+    if (e->getType() == Type_Zero) return 0;
+    std::cout << "not a number: " << e->toString() << std::endl;
+    return NAN;
+}
+
+int main( int argc,  char *argv[])
+{
+    BasicPtr a(new Symbol("a"));
+    BasicPtr b(new Symbol("b"));
+    BasicPtr c(new Symbol("c"));
+    BasicPtr d(new Symbol("d"));
+    BasicPtrVec symbols;
+    symbols.push_back(a);
+    symbols.push_back(b);
+    symbols.push_back(c);
+    symbols.push_back(d);
+    BasicPtr vec(new Matrix(symbols,Shape(4)));
+    BasicPtrVec values;
+    values.push_back(Real::New(0.3));
+    values.push_back(Real::New(-1.2));
+    values.push_back(Real::New(2.5));
+    values.push_back(Real::New(0.7));
+
+    // s = sin(a*b) kommt mehrfach vor, d gar nicht
+    BasicPtr s = Sin::New(Mul::New(a,b));
+    BasicPtrVec args;
+    args.push_back(Mul::New(s,s));
+    args.push_back(Mul::New(s,c));
+    args.push_back(Mul::New(Cos::New(b),Util::pow(c,-1)));
+    args.push_back(Atan2::New(a,c));
+    args.push_back(Util::pow(Add::New(a,b),3));
+    args.push_back(Neg::New(Util::sqrt(Mul::New(c,c))));
+    BasicPtr f(new Add(args));
+
+    BasicPtr g = Adjoint::gradient(f,vec);
+    if (g->getShape() != Shape(4)) return -1;
+    // wie die Vorwaertsableitung
+    for (size_t i=0;i<4;++i)
+    {
+        double reverse = value(Element::New(g,i,0),symbols,values);
+        double forward = value(f->der(symbols[i]),symbols,values);
+        if (!(fabs(reverse-forward) < 1e-10*(1+fabs(forward))))
+        {
+            std::cout << i << ": " << reverse << " != " << forward << std::endl;
+            return -2;
+        }
+    }
+    if (!Util::is_Zero(Element::New(g,3,0))) return -3;
+
+    // Skalar ohne Abhaengigkeit
+    if (!Util::is_Zero(Adjoint::gradient(Int::New(2),vec))) return -4;
+
+    // nur Vektoren aus Symbolen
+    try
+    {
+        Adjoint::gradient(f,BasicPtr(new Matrix(args,Shape(6))));
+        return -5;
+    }
+    catch (InternalError)
+    {
+    }
+    return 0;
+}
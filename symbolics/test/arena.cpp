@@ -0,0 +1,59 @@
+#include <iostream>
+#include "Symbolics.h"
+#include "Arena.h"
+
+using namespace Symbolics;
+
+int main( int argc,  char *argv[])
+{
+    BasicPtr a(new Symbol("a"));
+    BasicPtr b(new Symbol("b"));
+
+    // gleiche Ausdruecke sind derselbe Knoten
+    BasicPtr exp1 = Add::New(a,Sin::New(b));
+    BasicPtr exp2 = Add::New(a,Sin::New(b));
+    if (exp1.get() != exp2.get()) return -1;
+
+    BasicPtr exp3 = Mul::New(Real::New(2.5),Cos::New(a));
+    BasicPtr exp4 = Mul::New(Real::New(2.5),Cos::New(a));
+    if (exp3.get() != exp4.get()) return -2;
+
+    // verschiedene Ausdruecke bleiben verschieden
+    BasicPtr exp5 = Add::New(b,Sin::New(a));
+    if (exp1.get() == exp5.get()) return -3;
+    if (Real::New(0.0).get() == Real::New(-0.0).get()) return -4;
+    if (Int::New(2).get() == Real::New(2.0).get()) return -5;
+
+    // Symbole werden nicht zusammengelegt
+    BasicPtr a1(new Symbol("a"));
+    if (Sin::New(a).get() == Sin::New(a1).get()) return -6;
+
+    // Element unterscheidet Zeile und Spalte
+    BasicPtr v(new Symbol("v",Shape(3)));
+    if (Element::New(v,1,0).get() != Element::New(v,1,0).get()) return -7;
+    if (Element::New(v,1,0).get() == Element::New(v,2,0).get()) return -8;
+
+    // Factory (subs, iterateExp) liefert ebenfalls den vorhandenen Knoten
+    BasicPtr exp6 = exp5->subs(b,a);
+    BasicPtr exp7 = Add::New(a,Sin::New(a));
+    if (exp6.get() != exp7.get()) return -9;
+
+    // Duplikate werden nicht eingetragen
+    BasicPtr exp8 = Atan2::New(a,Pow::New(b,Real::New(3.5)));
+    size_t before = Arena::size();
+    BasicPtr exp9 = Atan2::New(a,Pow::New(b,Real::New(3.5)));
+    if (Arena::size() != before) return -10;
+    if (exp8.get() != exp9.get()) return -11;
+
+    // das Duplikat wird wieder freigegeben und haengt nicht mehr bei seinen Argumenten
+    size_t parents = a->getParentsSize();
+    Atan2::New(a,Pow::New(b,Real::New(3.5)));
+    if (a->getParentsSize() != parents) return -12;
+
+    // eingetragene Knoten: verschieden ohne Rekursion, gleich ueber gleichnamige Symbole
+    if (*exp1 == *exp5) return -13;
+    if (!(*Sin::New(a) == *Sin::New(a1))) return -14;
+    if (exp1 == exp5) return -15;
+
+    return 0;
+}
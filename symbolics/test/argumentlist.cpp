@@ -0,0 +1,63 @@
+#include <iostream>
+#include "Symbolics.h"
+
+using namespace Symbolics;
+
+int main( int argc,  char *argv[])
+{
+    BasicPtr a(new Symbol("a"));
+    BasicPtr b(new Symbol("b"));
+
+    // wenige Argumente, inline
+    BasicPtrVec args;
+    args.push_back(a);
+    args.push_back(b);
+    BasicPtr add1(new Add(args));
+    if (add1->getArgsSize() != 2) return -1;
+    if (a->getParentsSize() != 1) return -2;
+
+    // mehr als inline Platz, Argumente ziehen um
+    BasicPtrVec symbols;
+    args.clear();
+    for (size_t i=0; i<10; ++i)
+    {
+        BasicPtr s(new Symbol("s" + str(i)));
+        symbols.push_back(s);
+        args.push_back(Mul::New(s,a));
+    }
+    BasicPtr add2(new Add(args));
+    if (add2->getArgsSize() != 10) return -3;
+    for (size_t i=0; i<10; ++i)
+    {
+        if (add2->getArg(i) != args[i]) return -4;
+        if (args[i]->getParentsSize() != 1) return -5;
+    }
+
+    // Matrix waechst ueber set und addArg
+    Matrix *mat = new Matrix(Shape(3,3));
+    BasicPtr matp(mat);
+    for (size_t i=0; i<9; ++i)
+        mat->set(i/3,i%3,symbols[i]);
+    for (size_t i=0; i<9; ++i)
+        if (symbols[i]->getParentsSize() != 2) return -6;
+
+    // Eltern sind nach dem Umziehen noch richtig eingetragen
+    BasicPtr c(new Symbol("c"));
+    symbols[9]->subs(c);
+    if (add2->getArg(9) != Mul::New(c,a)) return -7;
+    symbols[0]->subs(c);
+    if (mat->get(0,0) != c) return -8;
+
+    // Elternliste: subs haengt alle Eltern um
+    if (symbols[0]->getParentsSize() != 0) return -9;
+    if (symbols[0]->getFirstParent() != NULL) return -10;
+    size_t n = 0;
+    for (ArgumentPtr p = c->getFirstParent(); p != NULL; p = p->getNextParent()) ++n;
+    if (n != c->getParentsSize()) return -11;
+    BasicPtr d(new Symbol("d"));
+    c->subs(d);
+    if (c->getParentsSize() != 0) return -12;
+    if (mat->get(0,0) != d) return -13;
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <iostream>
+#include "Symbolics.h"
+
+using namespace Symbolics;
+
+int main( int argc,  char *argv[])
+{
+    BasicPtr a(new Symbol("a"));
+    BasicPtr b(new Symbol("b"));
+    BasicPtr c(new Symbol("c"));
+
+    // gleiche Ausdruecke, gleicher Hash
+    BasicPtr exp1(new Add(a,Sin::New(b)));
+    BasicPtr exp2(new Add(a,Sin::New(b)));
+    if (exp1.get() == exp2.get()) return -1;
+    if (exp1->getHash() != exp2->getHash()) return -2;
+
+    // Add ist vertauschbar
+    BasicPtr exp3(new Add(Sin::New(b),a));
+    if (exp1 != exp3) return -3;
+    if (exp1->getHash() != exp3->getHash()) return -4;
+
+    // Konstanten ueber den Wert
+    if (BasicPtr(new Int(2))->getHash() != BasicPtr(new Real(2.0))->getHash()) return -5;
+    Matrix *mat = new Matrix(Shape(2));
+    mat->set(0,Int::getZero());
+    mat->set(1,Real::New(0.0));
+    BasicPtr zeromat(mat);
+    if (zeromat != Zero::getZero()) return -6;
+    if (zeromat->getHash() != Zero::getZero()->getHash()) return -7;
+
+    // verschiedene Ausdruecke
+    BasicPtr exp4(new Add(b,Sin::New(a)));
+    if (exp1->getHash() == exp4->getHash()) return -8;
+
+    // in-place subs aktualisiert den Hash der Eltern
+    BasicPtr s(new Symbol("s"));
+    BasicPtr exp5(new Add(a,Cos::New(s)));
+    BasicPtr exp6(new Add(a,Cos::New(c)));
+    size_t hash5 = exp5->getHash();
+    s->subs(c);
+    if (exp5->getHash() == hash5) return -9;
+    if (exp5->getHash() != exp6->getHash()) return -10;
+
+    // Hash-Tabelle
+    BasicPtrHashMap map;
+    map[exp1] = a;
+    map[exp4] = b;
+    BasicPtrHashMap::iterator ii = map.find(exp3);
+    if (ii == map.end()) return -11;
+    if (ii->second != a) return -12;
+    if (map.size() != 2) return -13;
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "Symbolics.h"
+#include "RefCount.h"
+#include "Arena.h"
+
+using namespace Symbolics;
+
+int main( int argc,  char *argv[])
+{
+    // normales Zaehlen
+    RefCount rc;
+    rc.inc();
+    rc.inc();
+    if (rc.get() != 2) return -1;
+    if (rc.dec()) return -2;
+    if (!rc.dec()) return -3;
+
+    // Kopien fangen bei 0 an
+    rc.inc();
+    RefCount copy(rc);
+    if (copy.get() != 0) return -4;
+
+    // unsterblich: wird nie 0
+    RefCount im;
+    im.inc();
+    im.setImmortal();
+    if (im.dec()) return -5;
+    if (im.dec()) return -6;
+
+    // Singletons
+    BasicPtr one = Int::getOne();
+    BasicPtr zero = Zero::getZero();
+    {
+        BasicPtr tmp = one;
+        tmp = zero;
+    }
+    if (Int::getOne()->getType() != Type_Int) return -7;
+
+    // der letzte BasicPtr gibt den Knoten frei (und traegt ihn aus der Arena aus)
+    BasicPtr x(new Symbol("x"));
+    size_t before = Arena::size();
+    {
+        BasicPtr e = Add::New(x,Sin::New(x));
+        if (Arena::size() != before+2) return -9;
+    }
+    if (Arena::size() != before) return -10;
+
+    // tiefe Ausdruecke werden ohne Rekursion freigegeben
+    {
+        BasicPtr deep = x;
+        for (int i=0; i<200000; ++i)
+            deep = Sin::New(deep);
+    }
+    if (Arena::size() != before) return -11;
+
+#ifdef SYMBOLICS_ATOMIC_REFCOUNT
+    // mehrere Threads teilen sich einen Ausdruck
+    BasicPtr a(new Symbol("a"));
+    BasicPtr exp = Add::New(a,Int::getOne());
+    std::vector<std::thread> threads;
+    for (int t=0; t<4; ++t)
+        threads.push_back(std::thread([&exp]()
+        {
+            for (int i=0; i<10000; ++i)
+            {
+                BasicPtr c1 = exp;
+                BasicPtr c2 = exp->getArg(0);
+            }
+        }));
+    for (size_t t=0; t<threads.size(); ++t)
+        threads[t].join();
+    if (exp->getArgsSize() != 2) return -8;
+    // alle Kopien der Threads sind wieder weg
+    before = Arena::size();
+    exp = BasicPtr();
+    if (Arena::size() != before-1) return -12;
+#endif
+
+    return 0;
+}
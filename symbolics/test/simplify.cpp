@@ -520,6 +520,100 @@ int common( int &argc,  char *argv[])
 }
 
 
+int cache( int &argc,  char *argv[])
+{
+    BasicPtr a(new Symbol("a"));
+    BasicPtr b(new Symbol("b"));
+    BasicPtr s(new Symbol("s"));
+
+    // gemeinsamer Teilausdruck, wird zu einem anderen Knoten vereinfacht
+    BasicPtr shared(new Add(Mul::New(Int::New(2),s),Mul::New(Int::New(3),s)));
+    BasicPtr p1(new Sin(shared));
+    BasicPtr p2(new Cos(shared));
+    BasicPtr r1 = p1->simplify();
+    BasicPtr r2 = p2->simplify();
+    if (r1->getArg(0).get() != r2->getArg(0).get()) return -1;
+    if (r1->getArg(0) != Mul::New(Int::New(5),s)) return -2;
+    if (shared->simplify().get() != r1->getArg(0).get()) return -3;
+
+    // Einsetzen verwirft das Ergebnis
+    BasicPtr exp(new Add(Mul::New(a,b),Mul::New(a,b)));
+    BasicPtr e1 = exp->simplify();
+    if (e1 != Mul::New(Int::New(2),Mul::New(a,b))) return -4;
+    a->subs(Int::New(0));
+    BasicPtr e2 = exp->simplify();
+    if (e2 != Zero::getZero()) return -5;
+
+    // Aenderung tiefer im Baum verwirft das Ergebnis aller Vorfahren
+    BasicPtr x(new Symbol("x"));
+    Matrix *row = new Matrix(Shape(1,2));
+    row->set(0,0,x);
+    row->set(0,1,x);
+    Matrix *col = new Matrix(Shape(2,1));
+    col->set(0,0,x);
+    col->set(1,0,x);
+    BasicPtr prod(new Mul(BasicPtr(row),BasicPtr(col)));
+    BasicPtr m1 = prod->simplify();
+    if (m1->getType() != Type_Matrix) return -6;
+    // das Ergebnis ist jetzt Argument von prod, ein Element wird ersetzt
+    Util::getAsPtr<Matrix>(m1)->set(0,0,BasicPtr(new Add(x,Neg::New(x))));
+    if (!Util::is_Zero(prod->simplify())) return -7;
+
+    return 0;
+}
+
+
+class CountIterator: public Basic::Iterator
+{
+public:
+    CountIterator(): count(0) {;}
+    BasicPtr process_Arg(BasicPtr const &p) { count++; return p; }
+    size_t count;
+};
+
+
+int deep( int &argc,  char *argv[])
+{
+    BasicPtr a(new Symbol("a"));
+    BasicPtr s(new Symbol("s"));
+
+    // sehr tiefer Ausdruck, darf den Stack nicht sprengen
+    BasicPtr exp = s;
+    for (int i=0; i<20000; ++i)
+        exp = BasicPtr(new Add(BasicPtr(new Sin(exp)),Mul::New(Int::New(0),a)));
+    BasicPtr res = Util::simplify(exp);
+    if (!res->is_Simplified()) return -1;
+    BasicPtr arg = res;
+    for (int i=0; i<20000; ++i)
+    {
+        if (arg->getType() != Type_Sin) return -2;
+        arg = arg->getArg(0);
+    }
+    if (arg != s) return -3;
+    Basic::BasicSet atoms;
+    res->getAtoms(atoms);
+    if ((atoms.size() != 1) || (atoms.count(s) != 1)) return -4;
+
+    // gemeinsame Teilausdruecke werden nur einmal besucht, gezaehlt wird trotzdem jedes Vorkommen
+    BasicPtr dag = s;
+    for (int i=0; i<20; ++i)
+        dag = BasicPtr(new Add(dag,BasicPtr(new Sin(dag))));
+    Basic::BasicSizeTMap counts;
+    dag->getAtoms(counts);
+    if (counts[s] != (size_t(1) << 20)) return -5;
+    BasicPtrVec order;
+    dag->getPostOrder(order);
+    if (order.size() != 41) return -6;
+    if (order.back().get() != dag.get()) return -7;
+    // Iterator einmal je Knoten, nicht je Pfad
+    CountIterator it;
+    dag->iterateExp(it);
+    if (it.count != order.size()) return -8;
+
+    return 0;
+}
+
+
 int main( int argc,  char *argv[])
 {
     int res = 0;
@@ -537,6 +631,10 @@ int main( int argc,  char *argv[])
     if (res !=0) return -6000 + res;
 	res = common(argc,argv);
 	if (res !=0) return -7000 + res;
+    res = cache(argc,argv);
+    if (res !=0) return -8000 + res;
+    res = deep(argc,argv);
+    if (res !=0) return -9000 + res;
 
     return 0;
 }
\ No newline at end of file
@@ -92,5 +92,39 @@ int main( int argc,  char *argv[])
     BasicPtr exp13 = dera->subs(Der::New(a),b);
     if (exp13 != b) return -22;
 
+    // freie Symbole werden am Knoten gemerkt und beim Einsetzen verworfen
+    BasicPtr x(new Symbol("x"));
+    BasicPtr y(new Symbol("y"));
+    BasicPtr z(new Symbol("z"));
+    BasicPtr inner(new Sin(BasicPtr(new Mul(x,y))));
+    BasicPtr exp14(new Add(inner,BasicPtr(new Cos(inner))));
+    if (exp14->getFreeSymbols().size() != 2) return -23;
+    if (!exp14->has_FreeSymbol(x.get())) return -24;
+    if (exp14->has_FreeSymbol(z.get())) return -25;
+    BasicPtr x1(new Symbol("x"));
+    if (!exp14->has_FreeSymbol(x1.get())) return -26;
+    y->subs(z);
+    if (exp14->has_FreeSymbol(y.get())) return -27;
+    if (!exp14->has_FreeSymbol(z.get())) return -28;
+    Basic::LookFor lookfor1(z);
+    exp14->scanExp(lookfor1);
+    if (!lookfor1.found) return -29;
+    Basic::LookFor lookfor2(BasicPtr(new Mul(x,z)));
+    exp14->scanExp(lookfor2);
+    if (!lookfor2.found) return -30;
+    Basic::LookFor lookfor3(BasicPtr(new Mul(x,y)));
+    exp14->scanExp(lookfor3);
+    if (lookfor3.found) return -31;
+
+    // neues Argument, ohne dass der Hash berechnet wurde
+    Matrix *mat = new Matrix(Shape(2));
+    BasicPtr vec(mat);
+    mat->set(0,x);
+    mat->set(1,y);
+    if (vec->getFreeSymbols().size() != 2) return -32;
+    mat->set(1,Int::New(1));
+    if (vec->getFreeSymbols().size() != 1) return -33;
+    if (vec->has_FreeSymbol(y.get())) return -34;
+
     return 0;
 }
\ No newline at end of file
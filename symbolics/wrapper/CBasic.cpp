@@ -457,7 +457,7 @@ static PyObject* CBasic_simplify(CBasicObject *self, PyObject *args)
     try
     {
 		// Simplify ausfuehren
-		self->m_basic = self->m_basic->simplify();
+		self->m_basic = Util::simplify(self->m_basic);
 
     self->ob_type = PyFactory::ObjectType(self->m_basic);
     
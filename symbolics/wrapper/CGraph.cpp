@@ -52,8 +52,12 @@ static PyObject* CGraph_getVariables(CGraphObject *self, PyObject *args);
 static PyObject* CGraph_getAssignments(CGraphObject *self, PyObject *args);
 static PyObject* CGraph_getinitVal(CGraphObject *self, PyObject *args);
 static PyObject* CGraph_addEquation(CGraphObject *self, PyObject *args);
+static PyObject* CGraph_changeEquation(CGraphObject *self, PyObject *args);
 static PyObject* CGraph_getShape(CGraphObject *self, PyObject *args);
 static PyObject* CGraph_buildGraph(CGraphObject *self, PyObject *args);
+static PyObject* CGraph_updateGraph(CGraphObject *self, PyObject *args);
+static PyObject* CGraph_saveSnapshot(CGraphObject *self, PyObject *args);
+static PyObject* CGraph_loadSnapshot(CGraphObject *self, PyObject *args);
 static PyObject* CGraph_writeOutput(CGraphObject *self, PyObject *args, PyObject *kwds);
 
 // Tabelle mit allen Funktionen
@@ -64,8 +68,12 @@ static PyMethodDef CGraph_methods[] = {
 	{"getAssignments",			(PyCFunction)CGraph_getAssignments,				METH_VARARGS, "get all assignments from the graph for a given kind"},
 	{"getinitVal",				(PyCFunction)CGraph_getinitVal,					METH_VARARGS, "get a initialisation value of a variable from the graph, returns None if not found"},
 	{"addEquation",				(PyCFunction)CGraph_addEquation,				METH_VARARGS, "add an equation or a block of equations, throws exception if not successful"},
+	{"changeEquation",			(PyCFunction)CGraph_changeEquation,				METH_VARARGS, "replace the equation of a variable, call updateGraph afterwards"},
 	{"getShape",				(PyCFunction)CGraph_getShape,					METH_VARARGS, "return the shape of an expression"},
 	{"buildGraph",				(PyCFunction)CGraph_buildGraph,					METH_VARARGS, "build graph and perform optimizations"},
+	{"updateGraph",				(PyCFunction)CGraph_updateGraph,				METH_NOARGS, "relink only the changed equations of a graph built without optimizations"},
+	{"saveSnapshot",			(PyCFunction)CGraph_saveSnapshot,				METH_VARARGS, "write the built graph to a binary snapshot file"},
+	{"loadSnapshot",			(PyCFunction)CGraph_loadSnapshot,				METH_VARARGS, "load a snapshot file into an empty graph instead of building it"},
 	{"writeOutput",				(PyCFunction)CGraph_writeOutput,	METH_VARARGS | METH_KEYWORDS, "write code, throws exception if not successful"},
 	{NULL}
 };
@@ -442,6 +450,33 @@ static PyObject* CGraph_addEquation(CGraphObject *self, PyObject *args)
 /*****************************************************************************/
 
 
+/*****************************************************************************/
+static PyObject* CGraph_changeEquation(CGraphObject *self, PyObject *args)
+	/*****************************************************************************/
+{
+	try
+	{
+		PyObject *lhs_Object = NULL;
+		PyObject *rhs_Object = NULL;
+		PyObject *implicit_Object = Py_False;
+
+		// Argumente parsen
+		if (!PyArg_ParseTuple(args, "OO|O", &lhs_Object, &rhs_Object, &implicit_Object))
+			return NULL;
+
+		// Graphen aufrufen
+		self->m_graph->changeExpression( toBasic(lhs_Object, self->m_graph),
+			toBasic(rhs_Object, self->m_graph), implicit_Object == Py_True );
+	}
+	STD_ERROR_HANDLER(NULL);
+
+	// Refcount vorher erhoehen
+	Py_IncRef(Py_None);
+	return Py_None;
+}
+/*****************************************************************************/
+
+
 /*****************************************************************************/
 static PyObject* CGraph_getShape(CGraphObject *self, PyObject *args)
 	/*****************************************************************************/
@@ -476,16 +511,81 @@ static PyObject* CGraph_buildGraph(CGraphObject *self, PyObject *args)
 	{
 		// Expression extrahieren
 		PyObject *o;
+		int threads = 1;
 
 		// Argumente parsen
-		if (!PyArg_ParseTuple(args, "O", &o))
+		if (!PyArg_ParseTuple(args, "O|i", &o, &threads))
 			return NULL;
 
 		// Optimierung an oder aus?
 		bool optimize = (o == Py_True);
+		if (threads < 1)
+			threads = 1;
 
 		// Graphen aufbauen
-		double t = self->m_graph->buildGraph( optimize );
+		double t = self->m_graph->buildGraph( optimize, threads );
+		return PyFloat_FromDouble(t);
+	}
+	STD_ERROR_HANDLER(NULL);
+	// Refcount vorher erhoehen
+	Py_IncRef(Py_None);
+	return Py_None;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+static PyObject* CGraph_updateGraph(CGraphObject *self, PyObject *args)
+	/*****************************************************************************/
+{
+	try
+	{
+		double t = self->m_graph->updateGraph();
+		return PyFloat_FromDouble(t);
+	}
+	STD_ERROR_HANDLER(NULL);
+	// Refcount vorher erhoehen
+	Py_IncRef(Py_None);
+	return Py_None;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+static PyObject* CGraph_saveSnapshot(CGraphObject *self, PyObject *args)
+	/*****************************************************************************/
+{
+	try
+	{
+		const char *file = NULL;
+
+		// Argumente parsen
+		if (!PyArg_ParseTuple(args, "s", &file))
+			return NULL;
+
+		self->m_graph->saveSnapshot( file );
+	}
+	STD_ERROR_HANDLER(NULL);
+	// Refcount vorher erhoehen
+	Py_IncRef(Py_None);
+	return Py_None;
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+static PyObject* CGraph_loadSnapshot(CGraphObject *self, PyObject *args)
+	/*****************************************************************************/
+{
+	try
+	{
+		const char *file = NULL;
+
+		// Argumente parsen
+		if (!PyArg_ParseTuple(args, "s", &file))
+			return NULL;
+
+		double t = self->m_graph->loadSnapshot( file );
 		return PyFloat_FromDouble(t);
 	}
 	STD_ERROR_HANDLER(NULL);
@@ -580,6 +680,42 @@ static PyObject* CGraph_writeOutput(CGraphObject *self, PyObject *args, PyObject
 		if(!strcmp(typeString, "fmu"))
 			writer = new FMUWriter(keywords);
 
+		// Kostenbericht fuer alle Writer
+		if (keywords.find("cost_report") != keywords.end())
+			writer->setCostReport(keywords["cost_report"] == "True");
+
+		// Dateien parallel schreiben (C, Fortran, Python, Matlab)
+		if (keywords.find("threads") != keywords.end())
+		{
+			int threads = atoi(keywords["threads"].c_str());
+			writer->setThreads((threads > 1) ? threads : 1);
+		}
+
+		// der_state in Funktionen zu chunk_size Gleichungen teilen (C, Fortran)
+		if (keywords.find("chunk_size") != keywords.end())
+		{
+			int chunkSize = atoi(keywords["chunk_size"].c_str());
+			writer->setChunkSize((chunkSize > 0) ? chunkSize : 0);
+		}
+
+		// Zuweisungen nach Registerdruck umsortieren (C, Fortran, Python, Matlab)
+		if (keywords.find("schedule") != keywords.end())
+			writer->setSchedule(keywords["schedule"] == "True");
+
+		// cse=False: keine Hilfsvariablen fuer gemeinsame Teilausdruecke
+		if (keywords.find("cse") != keywords.end())
+			writer->setCSE(keywords["cse"] == "True");
+
+		// Cache: Sprache und alle anderen Keywords gehoeren zum Schluessel
+		if (keywords.find("cache") != keywords.end())
+		{
+			std::string options = typeString;
+			for (std::map<std::string, std::string>::iterator ii = keywords.begin(); ii != keywords.end(); ++ii)
+				if (ii->first != "cache")
+					options += "|" + ii->first + "=" + ii->second;
+			writer->setCache(keywords["cache"] == "True", options);
+		}
+
 		// Code schreiben
 		t = writer->generateTarget(name, path, *(self->m_graph), true);
 		return PyFloat_FromDouble(t);
@@ -24,6 +24,7 @@
 #include "CSign.h"
 #include "COuter.h"
 #include "CJacobian.h"
+#include "CGradient.h"
 #include "CInverse.h"
 #include "CLess.h"
 #include "CGreater.h"
@@ -142,6 +143,9 @@ PyMODINIT_FUNC PyInit_symbolics(void)
     // CJacobian
     if (!registerObject( &CJacobianObjectType, "jacobian", m))
         return NULL;
+    // CGradient
+    if (!registerObject( &CGradientObjectType, "gradient", m))
+        return NULL;
     // CInverse
     if (!registerObject( &CInverseObjectType, "inv", m))
         return NULL;
@@ -0,0 +1,24 @@
+#ifndef __CGRADIENT_H_
+#define __CGRADIENT_H_
+
+#include <Python.h>
+#include "Symbolics.h"
+#include "CBasic.h"
+
+using namespace Symbolics;
+
+namespace Symbolics
+{
+    namespace Python
+    {
+        struct _CGradient_Object_ : public CBasicObject  
+        {
+        };
+        
+        typedef struct _CGradient_Object_ CGradientObject;
+
+        extern PyTypeObject CGradientObjectType;
+    };
+};
+
+#endif // __CGRADIENT_H_
\ No newline at end of file
@@ -70,7 +70,7 @@ double CSharpWriter::generateDerState(Graph::Graph& g, int &dim)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	if (states.empty())
@@ -88,7 +88,7 @@ double CSharpWriter::generateDerState(Graph::Graph& g, int &dim)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_der_state.cs";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "/* " << getHeaderLine() << " */" << std::endl;
 	f << "using System;" << std::endl;
@@ -195,7 +195,7 @@ double CSharpWriter::generateVisual(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR_VISUAL);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR_VISUAL);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR);
@@ -215,7 +215,7 @@ double CSharpWriter::generateVisual(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_visual.cs";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "/* " << getHeaderLine() << " */" << std::endl;
 		
@@ -319,7 +319,7 @@ double CSharpWriter::generateSensors(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR_VISUAL);
@@ -343,7 +343,7 @@ double CSharpWriter::generateSensors(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_sensors.cs";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "/* " << getHeaderLine() << " */" << std::endl;
 	
@@ -424,7 +424,7 @@ std::string CSharpWriter::writeEquations(std::vector<Graph::Assignment> const& e
 		//Folgendes falls mehrere Gleichungen in einer verpackt sind (wird aber scheinbar kaum genutzt)
 		for (size_t i=0; i < it->lhs.size(); ++i)
         {
-            BasicPtr simple_exp = it->rhs[i]->simplify();
+            BasicPtr simple_exp = Util::simplify(it->rhs[i]);
             if (simple_exp.get() == NULL) throw InternalError("CSharpWriter: Value of Rhs is not Valid!");
 
 			//Workaround: Solve muss speziell behandelt werden TODO: Irgendwie ist das nicht sch�n und deckt bestimmt nicht alle F�lle ab
@@ -440,7 +440,9 @@ std::string CSharpWriter::writeEquations(std::vector<Graph::Assignment> const& e
 				s << "    }" << std::endl;
 			} else {
 				// ordinary equation
-				s << "    " << m_p->print(it->lhs[i]) << " = " << m_p->print(simple_exp) << ";" << std::endl;
+				s << "    " << m_p->print(it->lhs[i]) << " = ";
+				m_p->print(simple_exp, s);
+				s << ";" << std::endl;
 			}
         }
     }
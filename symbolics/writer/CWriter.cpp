@@ -5,6 +5,7 @@
 #include "str.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <algorithm>
 
@@ -13,7 +14,7 @@ using namespace Symbolics;
 
 /*****************************************************************************/
 CWriter::CWriter( std::map<std::string, std::string> &kwds ): 
-	Writer(true), m_pymbs_wrapper(false), m_simulink_sfunction(false), m_include_visual(true)
+	Writer(true), m_pymbs_wrapper(false), m_simulink_sfunction(false), m_include_visual(true), m_sparse_solve(false), m_batch(false), m_jacobian("")
 /*****************************************************************************/
 {
 	m_p = new CPrinter();
@@ -26,6 +27,18 @@ CWriter::CWriter( std::map<std::string, std::string> &kwds ):
 		m_simulink_sfunction = (kwds["sfunction"] == "True");
 	if (kwds.find("include_visual") != kwds.end())
 		m_include_visual = (kwds["include_visual"] == "True");
+	if (kwds.find("sparse_solve") != kwds.end())
+		m_sparse_solve = (kwds["sparse_solve"] == "True");
+	if (kwds.find("batch") != kwds.end())
+		m_batch = (kwds["batch"] == "True");
+	if (kwds.find("jacobian") != kwds.end())
+	{
+		m_jacobian = kwds["jacobian"];
+		if ((m_jacobian == "True") || (m_jacobian == "dense"))
+			m_jacobian = "dense";
+		else if (m_jacobian != "sparse")
+			m_jacobian = "";
+	}
 
 }
 /*****************************************************************************/
@@ -33,7 +46,18 @@ CWriter::CWriter( std::map<std::string, std::string> &kwds ):
 
 /*****************************************************************************/
 CWriter::CWriter(): 
-	Writer(true), m_pymbs_wrapper(false), m_simulink_sfunction(false), m_include_visual(true)
+	Writer(true), m_pymbs_wrapper(false), m_simulink_sfunction(false), m_include_visual(true), m_sparse_solve(false), m_batch(false), m_jacobian("")
+/*****************************************************************************/
+{
+	m_p = new CPrinter();
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+CWriter::CWriter( CWriter const& src ): 
+	Writer(src), m_pymbs_wrapper(src.m_pymbs_wrapper), m_simulink_sfunction(src.m_simulink_sfunction), m_include_visual(src.m_include_visual),
+	m_sparse_solve(src.m_sparse_solve), m_batch(src.m_batch), m_jacobian(src.m_jacobian)
 /*****************************************************************************/
 {
 	m_p = new CPrinter();
@@ -41,6 +65,26 @@ CWriter::CWriter():
 /*****************************************************************************/
 
 
+/*****************************************************************************/
+Writer* CWriter::clone() const
+/*****************************************************************************/
+{
+	return new CWriter(*this);
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+void CWriter::mergeStage(Writer const& stage)
+/*****************************************************************************/
+{
+	// functionmodule.c braucht die ldlt_solve aller Schritte
+	std::set<int> const& dims = static_cast<CWriter const&>(stage).m_ldltDims;
+	m_ldltDims.insert(dims.begin(), dims.end());
+}
+/*****************************************************************************/
+
+
 /*****************************************************************************/
 CWriter::~CWriter()
 /*****************************************************************************/
@@ -67,17 +111,35 @@ double CWriter::generateTarget_Impl(Graph::Graph &g)
 	}
 	else
 	{
-		double t1 = generateDerState(g, dim);
-		double t2 = 0;
+		std::vector<Graph::Category_Type> categories;
+		std::vector<Stage> stages;
+		double t1 = 0;
+		if (m_jacobian.empty())
+		{
+			categories.push_back(DER_STATE);
+			stages.push_back([&g, &dim](Writer &w) { return static_cast<CWriter&>(w).generateDerState(g, dim); });
+		}
+		else // die Jacobimatrix legt Symbole im Gleichungssystem an, also vorher und allein
+		{
+			t1 = generateDerState(g, dim);
+			if (m_pymbs_wrapper) // liest die Eingaenge von der_state
+				categories.push_back(DER_STATE);
+		}
 		if (m_include_visual)
-			t2 = generateVisual(g);
-		double t3 = generateSensors(g);
-		double t4 = generateFunctionmodule(dim);
-		double t5 = 0.0;
+		{
+			categories.push_back(SENSOR_VISUAL);
+			stages.push_back([&g](Writer &w) { return static_cast<CWriter&>(w).generateVisual(g); });
+		}
+		categories.push_back(SENSOR);
+		stages.push_back([&g](Writer &w) { return static_cast<CWriter&>(w).generateSensors(g); });
 		if (m_pymbs_wrapper)
-			t5 = generatePymbsWrapper(g);
+			stages.push_back([&g](Writer &w) { return static_cast<CWriter&>(w).generatePymbsWrapper(g); });
+		double t2 = runStages(g, categories, stages);
 
-		return t1+t2+t3+t4+t5;
+		// erst wenn alle ldlt_solve bekannt sind
+		double t3 = generateFunctionmodule(dim);
+
+		return t1+t2+t3;
 	}
 }
 /*****************************************************************************/
@@ -89,17 +151,13 @@ double CWriter::generateDerState(Graph::Graph& g, int &dim)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	if (states.empty())
 		throw InternalError("Error: Models without states are not yet implemented in C!");
-	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR|SENSOR_VISUAL);
 	Graph::VariableVec inputs = a->getVariables(INPUT);
-	Graph::VariableVec parameter = a->getVariables(PARAMETER);
-	Graph::VariableVec constants = a->getVariables(CONSTANT);
 	Graph::VariableVec controller = a->getVariables(CONTROLLER);
-	Graph::VariableVec userexp = a->getVariables(USER_EXP);
 
 	// StateVariables Vector sortieren:
 	std::sort(states.begin(),states.end(), sortVariableVec);
@@ -108,13 +166,24 @@ double CWriter::generateDerState(Graph::Graph& g, int &dim)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_der_state.c";
-    f.open(filename.c_str());
+    openFile(f, filename);
+
+	std::vector<Graph::Assignment> assignments = a->getEquations(PARAMETER | CONSTANT | INPUT );
+	std::vector<Chunk> chunks = splitEquations(assignments);
+	std::set<SymbolPtr> local = getChunkLocals(chunks);
 
 	f << "/* " << getHeaderLine() << " */" << std::endl;
 	f << "#include <math.h>" << std::endl;
 	f << "#include \"functionmodule.c\"" << std::endl;
 	f << std::endl;
 
+	if (chunks.size() > 1)
+	{
+		for (size_t k=0; k < chunks.size(); ++k)
+			f << chunkSignature(chunks[k], k+1) << ";" << std::endl;
+		f << std::endl;
+	}
+
 	f << "__declspec(dllexport) int "<< m_name <<"_der_state(double time, double * y, double * yd"; 
 	for (Graph::VariableVec::iterator it=inputs.begin();it!=inputs.end();++it)
 		f << ", double " << m_p->print(*it) << m_p->dimension(*it); 
@@ -123,25 +192,145 @@ double CWriter::generateDerState(Graph::Graph& g, int &dim)
 	f << ")" << std::endl;  //evtl noch die statesize mit�bergeben, aber die kenn wir eigentlich auch
 	f << "{" << std::endl;
 
+	dim = states.back()->getShape().getNumEl();
+	writeDeclarations(f, g, a, states, local);
+
+	f << "/* calculate state derivative */" << std::endl;
+	std::string equations;
+	if (chunks.size() > 1)
+	{
+		for (size_t k=0; k < chunks.size(); ++k)
+		{
+			generateDerStateChunk(g, chunks[k], k+1, dim, assignments);
+			f << "    " << chunkCall(chunks[k], k+1) << ";" << std::endl;
+		}
+	}
+	else
+	{
+		equations = writeEquations(assignments);
+		f << equations << std::endl;
+	}
+	removeChunkFiles(m_path + "/" + m_name + "_der_state_", "c", chunks.size() > 1 ? chunks.size()+1 : 1);
+    f << std::endl;
+
+	writeReturnValues(f, states, false);
+	f << std::endl; 
+
+	////Jetzt wieder Datei schreiben, zun�chst noch zwei Zeilen an den Anfang setzen
+	//f << "    int tobefreedIndex = 0;" << std::endl;
+	//f << "    double *tobefreed[100];" << std::endl;
+
+	//f << ss.rdbuf();
+
+	f << "	return 0;" << std::endl;
+	f << "}" << std::endl;
+
+	if (m_batch)
+	{
+		f << std::endl;
+		// die Schleife ueber die Instanzen bleibt ungeteilt
+		if (chunks.size() > 1)
+			equations = writeEquations(assignments);
+		writeDerStateBatch(f, g, a, states, inputs, controller, equations);
+	}
+
+	if (!m_jacobian.empty())
+	{
+		f << std::endl;
+		writeJacobian(f, g, a, states, inputs, controller, assignments);
+	}
+
+	f.close();
+
+    if (m_p->getErrorcount())
+        std::cerr << "There have been " << m_p->getErrorcount(true) << " error(s) during generation of " 
+                  << m_name << "_der_state.c. Please have a look at that file to see where the error(s) occured." << std::endl;
+
+	return Util::getTime() - t1;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+static std::string getLanes(std::string const& array, size_t offset, size_t n)
+/*****************************************************************************/
+{
+	// ein Eintrag je Element, bei Matrizen als Initialisierungsliste
+	std::string s = (n > 1) ? "{" : "";
+	for (size_t j=0; j < n; ++j)
+		s += array + "[" + str(offset+j) + "*lanes + lane]" + ((j+1 < n) ? ", " : "");
+	return s + ((n > 1) ? "}" : "");
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+static bool isGivenParameter(Graph::Graph& g, SymbolPtr const& p)
+/*****************************************************************************/
+{
+	// Parameter, die sich aus anderen berechnen, sind nicht vorgegeben
+	return g.getEquation(p)->getFreeSymbols().empty();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CWriter::writeDeclarations(std::ostream &f, Graph::Graph& g, Graph::AssignmentsPtr const& a, Graph::VariableVec const& states,
+								std::set<SymbolPtr> const& local, Graph::VariableVec const* lanes)
+/*****************************************************************************/
+{
+	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR|SENSOR_VISUAL);
+	Graph::VariableVec parameter = a->getVariables(PARAMETER);
+	Graph::VariableVec constants = a->getVariables(CONSTANT);
+	Graph::VariableVec userexp = a->getVariables(USER_EXP);
+
 	f << "/* declare state variables */" << std::endl;
 	for (size_t i=0; i < states.size(); ++i)
 	{
 		size_t n = states.at(i)->getShape().getNumEl();
-		dim = n;
-		f << "    double "  << m_p->print(states.at(i)) << m_p->dimension(states.at(i)) << " = " << ( n>1 ? "{" : "");
-		for (size_t j=0; j < n ; ++j)
-			f << "y[" << i*n+j << "]" << (j+1 < n ? ", " : "");
-		f << ( n>1 ? "}" : "") << ";" << m_p->comment2(g, states.at(i)) << std::endl;
+		f << "    double "  << m_p->print(states.at(i)) << m_p->dimension(states.at(i)) << " = ";
+		if (lanes)
+			f << getLanes("y", i*n, n);
+		else
+		{
+			f << ( n>1 ? "{" : "");
+			for (size_t j=0; j < n ; ++j)
+				f << "y[" << i*n+j << "]" << (j+1 < n ? ", " : "");
+			f << ( n>1 ? "}" : "");
+		}
+		f << ";" << m_p->comment2(g, states.at(i)) << std::endl;
 		f << "    double " << "der_" << m_p->print(states.at(i)) << m_p->dimension(states.at(i)) << " = " 
           << m_p->print(Zero::getZero(states.at(i)->getShape())) << ";" << std::endl;	
 	}
 	f << std::endl; 
 
 	f << "/* Parameters */" << std::endl;
+	size_t k = 0;
 	for (Graph::VariableVec::iterator it=parameter.begin();it!=parameter.end();++it)
-		f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "=" << m_p->print(g.getEquation(*it)) << "; " << m_p->comment2(g,*it) <<  std::endl;
+	{
+		f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "=";
+		if (lanes && isGivenParameter(g, *it))
+		{
+			size_t n = (*it)->getShape().getNumEl();
+			f << getLanes("p_lanes", k, n);
+			k += n;
+		}
+		else
+			f << m_p->print(g.getEquation(*it));
+		f << "; " << m_p->comment2(g,*it) <<  std::endl;
+	}
 	f << std::endl;
 
+	if (lanes)
+	{
+		f << "/* Inputs */" << std::endl;
+		k = 0;
+		for (Graph::VariableVec::const_iterator it=lanes->begin();it!=lanes->end();++it)
+		{
+			size_t n = (*it)->getShape().getNumEl();
+			f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "=" << getLanes("u_lanes", k, n) << "; " << m_p->comment2(g,*it) << std::endl;
+			k += n;
+		}
+		f << std::endl;
+	}
+
 	f << "/* Constants */" << std::endl;
 	for (Graph::VariableVec::iterator it=constants.begin();it!=constants.end();++it)
         f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "=" << m_p->print(g.getEquation(*it)) << "; " << m_p->comment2(g,*it) <<  std::endl;
@@ -154,44 +343,257 @@ double CWriter::generateDerState(Graph::Graph& g, int &dim)
 
 	f << "/* ordinary variables */" << std::endl;
     for (Graph::VariableVec::iterator it=variables.begin();it!=variables.end();++it)
-        f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "= " << m_p->print(g.getinitVal(*it)) << "; " << m_p->comment2(g,*it) <<  std::endl;
+		if (local.find(*it) == local.end())
+			f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "= " << m_p->print(g.getinitVal(*it)) << "; " << m_p->comment2(g,*it) <<  std::endl;
 	f << std::endl;
-	
-	f << "/* calculate state derivative */" << std::endl;
-	f << writeEquations(a->getEquations(PARAMETER | CONSTANT | INPUT )) << std::endl;
-    f << std::endl;
+}
+/*****************************************************************************/
 
+/*****************************************************************************/
+void CWriter::writeReturnValues(std::ostream &f, Graph::VariableVec const& states, bool lanes) const
+/*****************************************************************************/
+{
 	f << "/* set return values */" << std::endl;
 	for (size_t i=0;i < states.size(); ++i)
 	{
 		size_t n = states.at(i)->getShape().getNumEl();
 		for (size_t j=0; j < n ; ++j) 
 		{
-			f << "    yd[" << i*n+j << "] = der_" << m_p->print(states.at(i));
+			f << "    yd[" << i*n+j << (lanes ? "*lanes + lane" : "") << "] = der_" << m_p->print(states.at(i));
 			if (n>1) // hm.. was ist schneller "n-1" oder "n>1"?
 				f << "[" << j << "];" << std::endl;
 			else 
 				f << ";" << std::endl; 
 		}
 	}
-	f << std::endl; 
+}
+/*****************************************************************************/
 
-	////Jetzt wieder Datei schreiben, zun�chst noch zwei Zeilen an den Anfang setzen
-	//f << "    int tobefreedIndex = 0;" << std::endl;
-	//f << "    double *tobefreed[100];" << std::endl;
+/*****************************************************************************/
+void CWriter::generateDerStateChunk(Graph::Graph& g, Chunk const& chunk, size_t k, int dim, std::vector<Graph::Assignment> const& all)
+/*****************************************************************************/
+{
+	std::ofstream f;
+    std::string filename= m_path + "/" + m_name + "_der_state_" + str(k) + ".c";
+    openFile(f, filename);
 
-	//f << ss.rdbuf();
+	std::string equations = writeEquations(chunk.equations, &all);
 
-	f << "	return 0;" << std::endl;
+	f << "/* " << getHeaderLine() << " */" << std::endl;
+	f << "#include <math.h>" << std::endl;
+	f << std::endl;
+	// aus functionmodule.c, das in <name>_der_state.c eingebunden ist
+	writeFunctionmodulePrototypes(f, dim);
+	f << std::endl;
+
+	f << chunkSignature(chunk, k) << std::endl;
+	f << "{" << std::endl;
+	for (Graph::VariableVec::const_iterator it=chunk.inout.begin();it!=chunk.inout.end();++it)
+		if (m_p->dimension(*it).empty())
+			f << "    double " << m_p->print(*it) << " = *ptr_" << m_p->print(*it) << ";" << std::endl;
+	for (Graph::VariableVec::const_iterator it=chunk.der.begin();it!=chunk.der.end();++it)
+		if (m_p->dimension(*it).empty())
+			f << "    double der_" << m_p->print(*it) << " = *ptr_der_" << m_p->print(*it) << ";" << std::endl;
+	for (Graph::VariableVec::const_iterator it=chunk.local.begin();it!=chunk.local.end();++it)
+		f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "= " << m_p->print(g.getinitVal(*it)) << "; " << m_p->comment2(g,*it) <<  std::endl;
+	f << std::endl;
+
+	f << equations << std::endl;
+
+	for (Graph::VariableVec::const_iterator it=chunk.inout.begin();it!=chunk.inout.end();++it)
+		if (m_p->dimension(*it).empty())
+			f << "    *ptr_" << m_p->print(*it) << " = " << m_p->print(*it) << ";" << std::endl;
+	for (Graph::VariableVec::const_iterator it=chunk.der.begin();it!=chunk.der.end();++it)
+		if (m_p->dimension(*it).empty())
+			f << "    *ptr_der_" << m_p->print(*it) << " = der_" << m_p->print(*it) << ";" << std::endl;
 	f << "}" << std::endl;
 
 	f.close();
+}
+/*****************************************************************************/
 
-    if (m_p->getErrorcount())
-        std::cerr << "There have been " << m_p->getErrorcount(true) << " error(s) during generation of " 
-                  << m_name << "_der_state.c. Please have a look at that file to see where the error(s) occured." << std::endl;
+/*****************************************************************************/
+std::string CWriter::chunkSignature(Chunk const& chunk, size_t k) const
+/*****************************************************************************/
+{
+	std::string s = "void " + m_name + "_der_state_" + str(k) + "(";
+	std::string sep = "";
+	for (Graph::VariableVec::const_iterator it=chunk.in.begin();it!=chunk.in.end();++it, sep=", ")
+		s += sep + "double " + m_p->print(*it) + m_p->dimension(*it);
+	for (Graph::VariableVec::const_iterator it=chunk.inout.begin();it!=chunk.inout.end();++it, sep=", ")
+	{
+		if (m_p->dimension(*it).empty())
+			s += sep + "double *ptr_" + m_p->print(*it);
+		else
+			s += sep + "double " + m_p->print(*it) + m_p->dimension(*it);
+	}
+	for (Graph::VariableVec::const_iterator it=chunk.der.begin();it!=chunk.der.end();++it, sep=", ")
+	{
+		if (m_p->dimension(*it).empty())
+			s += sep + "double *ptr_der_" + m_p->print(*it);
+		else
+			s += sep + "double der_" + m_p->print(*it) + m_p->dimension(*it);
+	}
+	return s + (sep.empty() ? "void)" : ")");
+}
+/*****************************************************************************/
 
-	return Util::getTime() - t1;
+/*****************************************************************************/
+std::string CWriter::chunkCall(Chunk const& chunk, size_t k) const
+/*****************************************************************************/
+{
+	std::string s = m_name + "_der_state_" + str(k) + "(";
+	std::string sep = "";
+	for (Graph::VariableVec::const_iterator it=chunk.in.begin();it!=chunk.in.end();++it, sep=", ")
+		s += sep + m_p->print(*it);
+	for (Graph::VariableVec::const_iterator it=chunk.inout.begin();it!=chunk.inout.end();++it, sep=", ")
+		s += sep + (m_p->dimension(*it).empty() ? "&" : "") + m_p->print(*it);
+	for (Graph::VariableVec::const_iterator it=chunk.der.begin();it!=chunk.der.end();++it, sep=", ")
+		s += sep + (m_p->dimension(*it).empty() ? "&der_" : "der_") + m_p->print(*it);
+	return s + ")";
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CWriter::writeJacobian(std::ostream &f, Graph::Graph& g, Graph::AssignmentsPtr const& a, Graph::VariableVec const& states,
+							Graph::VariableVec const& inputs, Graph::VariableVec const& controller, std::vector<Graph::Assignment> const& equations)
+/*****************************************************************************/
+{
+	Graph::StateJacobian jac = g.getStateJacobian(equations, states);
+	const size_t n = jac.getDimension();
+	const bool sparse = (m_jacobian == "sparse");
+
+	// Besetzungsmuster, spaltenweise
+	SparseJacobian pattern = jac.getSparse();
+	std::vector<size_t> const& colptr = pattern.colptr;
+	std::vector<size_t> const& rowind = pattern.rowind;
+
+	if (sparse)
+	{
+		f << "/* sparsity pattern of the jacobian d(yd)/d(y) (compressed sparse columns), returns the number of nonzeros */" << std::endl;
+		f << "__declspec(dllexport) int "<< m_name <<"_jac_sparsity(int * colptr, int * rowind)" << std::endl;
+		f << "{" << std::endl;
+		f << "    int i;" << std::endl;
+		f << "    static const int c[" << n+1 << "] = {";
+		for (size_t i=0; i < colptr.size(); ++i)
+			f << colptr[i] << (i+1 < colptr.size() ? ", " : "");
+		f << "};" << std::endl;
+		f << "    static const int r[" << std::max<size_t>(rowind.size(),1) << "] = {";
+		for (size_t i=0; i < rowind.size(); ++i)
+			f << rowind[i] << (i+1 < rowind.size() ? ", " : "");
+		f << (rowind.empty() ? "0" : "") << "};" << std::endl;
+		f << "    for (i = 0; i < " << n+1 << "; ++i) colptr[i] = c[i];" << std::endl;
+		f << "    for (i = 0; i < " << rowind.size() << "; ++i) rowind[i] = r[i];" << std::endl;
+		f << "    return " << rowind.size() << ";" << std::endl;
+		f << "}" << std::endl;
+		f << std::endl;
+		f << "/* jacobian d(yd)/d(y): nonzeros in the order of " << m_name << "_jac_sparsity */" << std::endl;
+		f << "__declspec(dllexport) int "<< m_name <<"_jac_csc(double time, double * y, double * J"; 
+	}
+	else
+	{
+		f << "/* jacobian d(yd)/d(y), column major: J[col*" << n << " + row] = d(yd[row])/d(y[col]) */" << std::endl;
+		f << "__declspec(dllexport) int "<< m_name <<"_jac(double time, double * y, double * J"; 
+	}
+	for (Graph::VariableVec::const_iterator it=inputs.begin();it!=inputs.end();++it)
+		f << ", double " << m_p->print(*it) << m_p->dimension(*it); 
+	for (Graph::VariableVec::const_iterator it=controller.begin();it!=controller.end();++it)
+		f << ", double " << m_p->print(*it) << m_p->dimension(*it); 
+	f << ")" << std::endl;
+	f << "{" << std::endl;
+
+	writeDeclarations(f, g, a, states);
+
+	f << "/* jacobian variables */" << std::endl;
+	Graph::VariableVec const& variables = jac.getVariables();
+	for (Graph::VariableVec::const_iterator it=variables.begin();it!=variables.end();++it)
+		f << "    double " << m_p->print(*it) << m_p->dimension(*it) << "= " << m_p->print(g.getinitVal(*it)) << ";" << std::endl;
+	f << std::endl;
+
+	// gleiche Variablen wie der_state, die Ableitungen folgen danach
+	std::vector<Graph::Assignment> all = equations;
+	all.insert(all.end(), jac.getEquations().begin(), jac.getEquations().end());
+	f << "/* calculate state derivative and jacobian */" << std::endl;
+	f << writeEquations(all) << std::endl;
+	f << std::endl;
+
+	f << "/* set return values */" << std::endl;
+	if (sparse)
+	{
+		for (size_t k=0; k < pattern.getNNZ(); ++k)
+			f << "    J[" << k << "] = " << m_p->print(pattern.values[k]) << ";" << std::endl;
+	}
+	else
+	{
+		f << "    {" << std::endl;
+		f << "        int i;" << std::endl;
+		f << "        for (i = 0; i < " << n*n << "; ++i) J[i] = 0;" << std::endl;
+		f << "    }" << std::endl;
+		for (size_t c=0; c < n; ++c)
+			for (size_t k=colptr[c]; k < colptr[c+1]; ++k)
+				f << "    J[" << c*n+rowind[k] << "] = " << m_p->print(pattern.values[k]) << ";" << std::endl;
+	}
+	f << std::endl;
+	f << "	return 0;" << std::endl;
+	f << "}" << std::endl;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void CWriter::writeDerStateBatch(std::ostream &f, Graph::Graph& g, Graph::AssignmentsPtr const& a, Graph::VariableVec const& states,
+								 Graph::VariableVec const& inputs, Graph::VariableVec const& controller, std::string const& equations)
+/*****************************************************************************/
+{
+	Graph::VariableVec parameter = a->getVariables(PARAMETER);
+	// Eingaenge und Regler liegen gemeinsam in u_lanes
+	Graph::VariableVec u = inputs;
+	u.insert(u.end(),controller.begin(),controller.end());
+
+	// Struktur aus Arrays: Element k der Instanz lane liegt bei [k*lanes + lane]
+	f << "/* batched state derivative: lanes instances, element k of instance lane at [k*lanes + lane]" << std::endl;
+	f << "   y, yd: states; p_lanes: parameters; u_lanes: inputs and controller (in this order)" << std::endl;
+	size_t k = 0;
+	for (Graph::VariableVec::iterator it=parameter.begin();it!=parameter.end();++it)
+	{
+		if (!isGivenParameter(g, *it)) continue;
+		f << "   p_lanes[" << k << "] " << m_p->print(*it) << m_p->dimension(*it) << std::endl;
+		k += (*it)->getShape().getNumEl();
+	}
+	k = 0;
+	for (Graph::VariableVec::iterator it=u.begin();it!=u.end();++it)
+	{
+		f << "   u_lanes[" << k << "] " << m_p->print(*it) << m_p->dimension(*it) << std::endl;
+		k += (*it)->getShape().getNumEl();
+	}
+	f << "*/" << std::endl;
+	f << "__declspec(dllexport) int "<< m_name <<"_der_state_batch(int lanes, double * time_lanes, double * y, double * yd, double * p_lanes, double * u_lanes)" << std::endl;
+	f << "{" << std::endl;
+	f << "    int lane;" << std::endl;
+	// gerade Folge von Anweisungen ohne Abhaengigkeiten zwischen den Instanzen
+	f << "#if defined(_OPENMP)" << std::endl;
+	f << "    #pragma omp simd" << std::endl;
+	f << "#endif" << std::endl;
+	f << "    for (lane = 0; lane < lanes; ++lane)" << std::endl;
+	f << "    {" << std::endl;
+	// gleiche Deklarationen wie der_state, nur je Instanz aus y, p_lanes und u_lanes
+	std::ostringstream b;
+	b << "double time = time_lanes[lane];" << std::endl;
+	writeDeclarations(b, g, a, states, std::set<SymbolPtr>(), &u);
+
+	b << "/* calculate state derivative */" << std::endl;
+	b << equations << std::endl;
+	b << std::endl;
+
+	writeReturnValues(b, states, true);
+	// Rumpf der Schleife einruecken
+	std::istringstream lines(b.str());
+	std::string line;
+	while (std::getline(lines, line))
+		f << (line.empty() ? "" : "    ") << line << std::endl;
+	f << "    }" << std::endl;
+	f << std::endl; 
+	f << "	return 0;" << std::endl;
+	f << "}" << std::endl;
 }
 /*****************************************************************************/
 
@@ -202,7 +604,7 @@ double CWriter::generateVisual(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR_VISUAL);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR_VISUAL);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR);
@@ -224,7 +626,7 @@ double CWriter::generateVisual(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_visual.c";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "/* " << getHeaderLine() << " */" << std::endl;
 	
@@ -294,7 +696,7 @@ double CWriter::generateSensors(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR_VISUAL);
@@ -318,7 +720,7 @@ double CWriter::generateSensors(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_sensors.c";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "/* " << getHeaderLine() << " */" << std::endl;
 	
@@ -386,7 +788,7 @@ double CWriter::generateSensors(Graph::Graph& g)
 /*****************************************************************************/
 
 /*****************************************************************************/
-std::string CWriter::writeEquations(std::vector<Graph::Assignment> const& equations) const
+std::string CWriter::writeEquations(std::vector<Graph::Assignment> const& equations, std::vector<Graph::Assignment> const* all) const
 /*****************************************************************************/
 {
 	std::stringstream s;
@@ -398,7 +800,7 @@ std::string CWriter::writeEquations(std::vector<Graph::Assignment> const& equati
 		//Folgendes falls mehrere Gleichungen in einer verpackt sind (wird aber scheinbar kaum genutzt)
 		for (size_t i=0; i < it->lhs.size(); ++i)
         {
-            BasicPtr simple_exp = it->rhs[i]->simplify();
+            BasicPtr simple_exp = Util::simplify(it->rhs[i]);
             if (simple_exp.get() == NULL) throw InternalError("CWriter: Value of Rhs is not Valid!");
 
 			//Workaround: Solve muss speziell behandelt werden TODO: Irgendwie ist das nicht sch�n und deckt bestimmt nicht alle F�lle ab
@@ -407,6 +809,35 @@ std::string CWriter::writeEquations(std::vector<Graph::Assignment> const& equati
 				const Solve *solve = Util::getAsConstPtr<Solve>(it->rhs[i]);
 				//Util::getAsConstPtr<Element>(it->lhs[i]->getArg(0)->getArg(0));
 				int dim = solve->getArg2()->getShape().getDimension(1);
+				BasicPtrVec entries;
+				// LDL^T pivotisiert nicht, weder dicht noch mit sparse_solve,
+				// nur fuer positiv definite Matrizen, sonst legs()
+				bool ldlt = is_PositiveDefinite(solve->getArg1()) &&
+					getMatrixEntries(solve->getArg1(), (all != NULL) ? *all : equations, entries) && is_Symmetric(entries, dim);
+				if (ldlt && m_sparse_solve)
+				{
+					s << "    {" << std::endl;
+					s << "        double solve_b[" << dim << "] = " << m_p->print(solve->getArg2()) << ";" << std::endl;
+					s << writeSparseSolve(solve->getArg1(), entries, it->lhs[i]->getArg(0)->getArg(0), dim);
+					s << "    }" << std::endl;
+					continue;
+				}
+				if (ldlt)
+				{
+					// symmetrisch positiv definit (Massenmatrix): A wird nur gelesen, daher keine Kopie einer Variablen
+					std::string A = "solve_A";
+					BasicPtr symbol = getMatrixSymbol(solve->getArg1());
+					s << "    {" << std::endl;
+					if (symbol.get() != NULL)
+						A = m_p->print(symbol);
+					else
+						s << "        double solve_A[" << dim << "][" << dim << "] = " << m_p->print(solve->getArg1()) << ";" << std::endl;
+					s << "        double solve_b[" << dim << "] = " << m_p->print(solve->getArg2()) << ";" << std::endl;
+					s << "        ldlt_solve_" << dim << "(" << A << ", solve_b, " << m_p->print(it->lhs[i]->getArg(0)->getArg(0)) << ");" << std::endl;
+					s << "    }" << std::endl;
+					m_ldltDims.insert(dim);
+					continue;
+				}
 				s << "    {" << std::endl;
 				s << "        double solve_A[" << dim << "][" << dim << "] = " << m_p->print(solve->getArg1()) << ";" << std::endl;
 				s << "        double solve_b[" << dim << "] = " << m_p->print(solve->getArg2()) << ";" << std::endl;
@@ -414,7 +845,9 @@ std::string CWriter::writeEquations(std::vector<Graph::Assignment> const& equati
 				s << "    }" << std::endl;
 			} else {
 				// ordinary equation
-				s << "    " << m_p->print(it->lhs[i]) << " = " << m_p->print(simple_exp) << ";" << std::endl;
+				s << "    " << m_p->print(it->lhs[i]) << " = ";
+				m_p->print(simple_exp, s);
+				s << ";" << std::endl;
 			}
         }
     }
@@ -423,6 +856,265 @@ std::string CWriter::writeEquations(std::vector<Graph::Assignment> const& equati
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+BasicPtr CWriter::getMatrixSymbol(BasicPtr const& A)
+/*****************************************************************************/
+{
+	if (A->getType() == Type_Symbol)
+		return A;
+	if (A->getType() != Type_Matrix)
+		return BasicPtr();
+	// Matrix aus den eigenen Elementen einer Variable: {{M_[0][0],M_[0][1],..},..}
+	const Matrix *mat = Util::getAsConstPtr<Matrix>(A);
+	size_t dim1 = A->getShape().getDimension(1);
+	size_t dim2 = A->getShape().getDimension(2);
+	BasicPtr symbol;
+	for (size_t r=0; r<dim1; ++r)
+	{
+		for (size_t c=0; c<dim2; ++c)
+		{
+			BasicPtr const& e = mat->get(r,c);
+			if (e->getType() != Type_Element)
+				return BasicPtr();
+			const Element *element = Util::getAsConstPtr<Element>(e);
+			if ((element->getRow() != r) || (element->getCol() != c) || (e->getArg(0)->getType() != Type_Symbol))
+				return BasicPtr();
+			if (symbol.get() == NULL)
+				symbol = e->getArg(0);
+			else if (symbol != e->getArg(0))
+				return BasicPtr();
+		}
+	}
+	if ((symbol.get() == NULL) || (symbol->getShape() != A->getShape()))
+		return BasicPtr();
+	return symbol;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CWriter::getMatrixEntries(BasicPtr const& A, std::vector<Graph::Assignment> const& equations, BasicPtrVec &entries) const
+/*****************************************************************************/
+{
+	// SymmetricMatrix ist ebenfalls Type_Matrix, get(r,c) liefert beide Haelften
+	size_t dim = A->getShape().getDimension(1);
+	if ((!A->is_Matrix()) || (dim != A->getShape().getDimension(2)))
+		return false;
+
+	entries.assign(dim*dim, BasicPtr());
+	BasicPtr symbol = getMatrixSymbol(A);
+	if (symbol.get() != NULL)
+	{
+		// Variable (M_), die Elemente werden in equations belegt
+		bool found = false;
+		for (std::vector<Graph::Assignment>::const_iterator it=equations.begin(); it!=equations.end(); ++it)
+		{
+			for (size_t i=0; i < it->lhs.size(); ++i)
+			{
+				BasicPtr const& lhs = it->lhs[i];
+				if (lhs == symbol)
+				{
+					if (it->rhs[i]->getType() != Type_Matrix)
+						return false;
+					const Matrix *mat = Util::getAsConstPtr<Matrix>(it->rhs[i]);
+					for (size_t r=0; r<dim; ++r)
+						for (size_t c=0; c<dim; ++c)
+							entries[r*dim+c] = mat->get(r,c);
+					found = true;
+				}
+				else if ((lhs->getType() == Type_Element) && (lhs->getArg(0) == symbol))
+				{
+					const Element *e = Util::getAsConstPtr<Element>(lhs);
+					entries[e->getRow()*dim+e->getCol()] = it->rhs[i];
+					found = true;
+				}
+			}
+		}
+		if (!found)
+			return false;
+	}
+	else if (A->getType() == Type_Matrix)
+	{
+		const Matrix *mat = Util::getAsConstPtr<Matrix>(A);
+		for (size_t r=0; r<dim; ++r)
+			for (size_t c=0; c<dim; ++c)
+				entries[r*dim+c] = mat->get(r,c);
+	}
+	else
+		return false;
+	return true;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CWriter::is_PositiveDefinite(BasicPtr const& A)
+/*****************************************************************************/
+{
+	if (dynamic_cast<SymmetricMatrix const*>(A.get()) != NULL)
+		return true;
+	// Massenmatrix der Generatoren
+	BasicPtr symbol = getMatrixSymbol(A);
+	return (symbol.get() != NULL) && (Util::getAsConstPtr<Symbol>(symbol)->getName() == "M_");
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool CWriter::is_Symmetric(BasicPtrVec const& entries, size_t dim)
+/*****************************************************************************/
+{
+	if (entries.size() != dim*dim)
+		return false;
+	for (size_t r=0; r<dim; ++r)
+	{
+		for (size_t c=0; c<r; ++c)
+		{
+			BasicPtr const& lower = entries[r*dim+c];
+			BasicPtr const& upper = entries[c*dim+r];
+			bool lowerzero = (lower.get() == NULL) || Util::is_Zero(lower);
+			bool upperzero = (upper.get() == NULL) || Util::is_Zero(upper);
+			if (lowerzero && upperzero)
+				continue;
+			if (lowerzero || upperzero || (lower != upper))
+				return false;
+		}
+	}
+	return true;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::vector<size_t> CWriter::getMinimumDegreeOrder(std::vector<bool> const& pattern, size_t dim)
+/*****************************************************************************/
+{
+	// Eliminationsgraph: Knoten = Zeilen, Kanten = Nicht-Null-Eintraege ausserhalb der Diagonale
+	std::vector< std::set<size_t> > adj(dim);
+	for (size_t r=0; r<dim; ++r)
+		for (size_t c=0; c<r; ++c)
+			if (pattern[r*dim+c])
+			{
+				adj[r].insert(c);
+				adj[c].insert(r);
+			}
+
+	std::vector<size_t> order;
+	std::vector<bool> eliminated(dim, false);
+	for (size_t k=0; k<dim; ++k)
+	{
+		// bei gleichem Grad die kleinere Zeile, damit die Reihenfolge reproduzierbar ist
+		size_t v = dim;
+		for (size_t i=0; i<dim; ++i)
+			if (!eliminated[i] && ((v == dim) || (adj[i].size() < adj[v].size())))
+				v = i;
+		// Nachbarn von v werden untereinander verbunden (Fill-in)
+		for (std::set<size_t>::const_iterator n1=adj[v].begin(); n1!=adj[v].end(); ++n1)
+		{
+			adj[*n1].erase(v);
+			for (std::set<size_t>::const_iterator n2=adj[v].begin(); n2!=adj[v].end(); ++n2)
+				if (*n1 != *n2)
+					adj[*n1].insert(*n2);
+		}
+		adj[v].clear();
+		eliminated[v] = true;
+		order.push_back(v);
+	}
+	return order;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::string CWriter::writeSparseSolve(BasicPtr const& A, BasicPtrVec const& entries, BasicPtr const& x, size_t dim) const
+/*****************************************************************************/
+{
+	// A = L*D*L^T mit P*A*P^T, L und D werden als einzelne Variablen ausgegeben,
+	// es bleibt reiner Geradeaus-Code ohne Schleifen und Verzweigungen
+	std::stringstream s;
+	BasicPtr symbol = getMatrixSymbol(A);
+
+	// Besetzungsmuster, es wird nur die untere Haelfte gelesen
+	std::vector<bool> pattern(dim*dim, false);
+	for (size_t r=0; r<dim; ++r)
+		for (size_t c=0; c<=r; ++c)
+			pattern[r*dim+c] = (entries[r*dim+c].get() != NULL) && !Util::is_Zero(entries[r*dim+c]);
+
+	std::vector<size_t> p = getMinimumDegreeOrder(pattern, dim);
+
+	// symbolische Faktorisierung: nz[i*dim+j] = L(i,j) != 0 (permutiert, i>j)
+	std::vector<bool> nz(dim*dim, false);
+	for (size_t j=0; j<dim; ++j)
+		for (size_t i=j+1; i<dim; ++i)
+		{
+			size_t r = std::max(p[i],p[j]);
+			size_t c = std::min(p[i],p[j]);
+			nz[i*dim+j] = pattern[r*dim+c];
+			for (size_t k=0; (k<j) && !nz[i*dim+j]; ++k)
+				nz[i*dim+j] = nz[i*dim+k] && nz[j*dim+k];
+		}
+
+	std::vector<std::string> a(dim*dim);
+	for (size_t i=0; i<dim; ++i)
+		for (size_t j=0; j<=i; ++j)
+		{
+			size_t r = std::max(p[i],p[j]);
+			size_t c = std::min(p[i],p[j]);
+			if (!pattern[r*dim+c])
+				continue;
+			if (symbol.get() != NULL)
+				a[i*dim+j] = m_p->print(Element::New(symbol,r,c));
+			else
+				a[i*dim+j] = "(" + m_p->print(entries[r*dim+c]) + ")";
+		}
+	std::vector<std::string> xs(dim);
+	for (size_t i=0; i<dim; ++i)
+		xs[i] = m_p->print(Element::New(x,p[i],0));
+
+	// Zerlegung, spaltenweise
+	for (size_t j=0; j<dim; ++j)
+	{
+		std::string D = "solve_D_" + str(j);
+		s << "        double " << D << " = " << (a[j*dim+j].empty() ? std::string("0.0") : a[j*dim+j]);
+		for (size_t k=0; k<j; ++k)
+			if (nz[j*dim+k])
+				s << " - solve_L_" << j << "_" << k << "*solve_L_" << j << "_" << k << "*solve_D_" << k;
+		s << ";" << std::endl;
+		for (size_t i=j+1; i<dim; ++i)
+		{
+			if (!nz[i*dim+j])
+				continue;
+			std::stringstream terms;
+			for (size_t k=0; k<j; ++k)
+				if (nz[i*dim+k] && nz[j*dim+k])
+					terms << " - solve_L_" << i << "_" << k << "*solve_L_" << j << "_" << k << "*solve_D_" << k;
+			s << "        double solve_L_" << i << "_" << j << " = ";
+			if (terms.str().empty())
+				s << a[i*dim+j];
+			else
+				s << "(" << (a[i*dim+j].empty() ? std::string("0.0") : a[i*dim+j]) << terms.str() << ")";
+			s << "/" << D << ";" << std::endl;
+		}
+	}
+
+	// Vorwaertseinsetzen L*y = P*b
+	for (size_t i=0; i<dim; ++i)
+	{
+		s << "        " << xs[i] << " = solve_b[" << p[i] << "]";
+		for (size_t k=0; k<i; ++k)
+			if (nz[i*dim+k])
+				s << " - solve_L_" << i << "_" << k << "*" << xs[k];
+		s << ";" << std::endl;
+	}
+	// Rueckwaertseinsetzen D*L^T*x = y
+	for (size_t i=dim; i-- > 0; )
+	{
+		s << "        " << xs[i] << " = " << xs[i] << "/solve_D_" << i;
+		for (size_t k=i+1; k<dim; ++k)
+			if (nz[k*dim+i])
+				s << " - solve_L_" << k << "_" << i << "*" << xs[k];
+		s << ";" << std::endl;
+	}
+
+	return s.str();
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 double CWriter::generatePymbsWrapper(Graph::Graph& g)
 /*****************************************************************************/
@@ -434,8 +1126,8 @@ double CWriter::generatePymbsWrapper(Graph::Graph& g)
 
 	PythonPrinter p; //zur Abkürzung
 
-	Graph::VariableVec state_inputs = g.getAssignments(DER_STATE)->getVariables(INPUT);
-    Graph::VariableVec controller = g.getAssignments(DER_STATE)->getVariables(CONTROLLER);
+	Graph::VariableVec state_inputs = getAssignments(g, DER_STATE)->getVariables(INPUT);
+    Graph::VariableVec controller = getAssignments(g, DER_STATE)->getVariables(CONTROLLER);
     Graph::VariableVec sensors = g.getVariables(SENSOR);
 
 	// Sensors Vector sortieren: 
@@ -445,7 +1137,7 @@ double CWriter::generatePymbsWrapper(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_der_state_CWrapper.py";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "# " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -540,7 +1232,7 @@ double CWriter::generatePymbsWrapper(Graph::Graph& g)
 	std::sort(sens_vis.begin(),sens_vis.end(), sortVariableVec);
 
     filename= m_path + "/" + m_name + "_visual_CWrapper.py";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "# " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -597,12 +1289,12 @@ double CWriter::generatePymbsWrapper(Graph::Graph& g)
                   << m_name << "_visual_CWrapper.py. Please have a look at that file to see where the error(s) occured." << std::endl;
 
 
-    Graph::VariableVec sens_inputs = g.getAssignments(SENSOR)->getVariables(INPUT);
+    Graph::VariableVec sens_inputs = getAssignments(g, SENSOR)->getVariables(INPUT);
     // Inputs Vector sortieren: 
 	std::sort(sens_inputs.begin(),sens_inputs.end(), sortVariableVec);
 
     filename= m_path + "/" + m_name + "_sensors_CWrapper.py";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "# " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -695,6 +1387,17 @@ double CWriter::generatePymbsWrapper(Graph::Graph& g)
 /*****************************************************************************/
 
 
+/*****************************************************************************/
+void CWriter::writeFunctionmodulePrototypes(std::ostream &f, int n) const
+/*****************************************************************************/
+{
+	f << "void legs (double A[" << n << "][" << n << "], double *b, double *x);" << std::endl;
+	f << "void elgs (double A[" << n << "][" << n << "], int *indx);" << std::endl;
+	for (std::set<int>::const_iterator it=m_ldltDims.begin(); it!=m_ldltDims.end(); ++it)
+		f << "void ldlt_solve_" << *it << " (double A[" << *it << "][" << *it << "], double *b, double *x);" << std::endl;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 double CWriter::generateFunctionmodule(int n)
 /*****************************************************************************/
@@ -704,7 +1407,7 @@ double CWriter::generateFunctionmodule(int n)
 
 	std::ofstream f;
     std::string filename= m_path + "/functionmodule.c";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "/* " << getHeaderLine() << " */" << std::endl;
 	f << std::endl;
@@ -726,7 +1429,7 @@ double CWriter::generateFunctionmodule(int n)
 	f << "#include <math.h>" << std::endl;
 	f << "#define n " << n << std::endl;
 	f << std::endl;
-	f << "void elgs(double A[n][n], int *indx);" << std::endl;
+	writeFunctionmodulePrototypes(f, n);
 	f << std::endl;
 	f << "void legs (double A[n][n], double *b, double *x)" << std::endl;
 	f << "/* Function to solve the equation A[n][n]*x[n] = b[n] with the" << std::endl;
@@ -831,6 +1534,57 @@ double CWriter::generateFunctionmodule(int n)
 	f << "}" << std::endl;
 	f << std::endl;
 
+	// LDL^T fuer symmetrisch positiv definite Matrizen (Massenmatrix), je Dimension eine Funktion
+	for (std::set<int>::const_iterator it=m_ldltDims.begin(); it!=m_ldltDims.end(); ++it)
+	{
+		std::string d = str(*it);
+		f << "void ldlt_solve_" << d << " (double A[" << d << "][" << d << "], double *b, double *x)" << std::endl;
+		f << "/* Function to solve the equation A[" << d << "][" << d << "]*x[" << d << "] = b[" << d << "] for a" << std::endl;
+		f << "   symmetric positive definite A with an LDL^T decomposition." << std::endl;
+		f << "   Only the lower triangle of A is read, A and b are not changed. */" << std::endl;
+		f << "{" << std::endl;
+		f << "  double L[" << d << "][" << d << "];" << std::endl;
+		f << "  double D[" << d << "];" << std::endl;
+		f << "  int i, j, k;" << std::endl;
+		f << std::endl;
+		f << "  for (j = 0; j < " << d << "; ++j)" << std::endl;
+		f << "  {" << std::endl;
+		f << "    double dj = A[j][j];" << std::endl;
+		f << "    for (k = 0; k < j; ++k)" << std::endl;
+		f << "      dj -= L[j][k]*L[j][k]*D[k];" << std::endl;
+		f << "    D[j] = dj;" << std::endl;
+		f << "    for (i = j+1; i < " << d << "; ++i)" << std::endl;
+		f << "    {" << std::endl;
+		f << "      double lij = A[i][j];" << std::endl;
+		f << "      for (k = 0; k < j; ++k)" << std::endl;
+		f << "        lij -= L[i][k]*L[j][k]*D[k];" << std::endl;
+		f << "      L[i][j] = lij/dj;" << std::endl;
+		f << "    }" << std::endl;
+		f << "  }" << std::endl;
+		f << std::endl;
+		f << "/* L*y = b */" << std::endl;
+		f << std::endl;
+		f << "  for (i = 0; i < " << d << "; ++i)" << std::endl;
+		f << "  {" << std::endl;
+		f << "    double yi = b[i];" << std::endl;
+		f << "    for (k = 0; k < i; ++k)" << std::endl;
+		f << "      yi -= L[i][k]*x[k];" << std::endl;
+		f << "    x[i] = yi;" << std::endl;
+		f << "  }" << std::endl;
+		f << std::endl;
+		f << "/* D*L^T*x = y */" << std::endl;
+		f << std::endl;
+		f << "  for (i = " << d << "-1; i >= 0; --i)" << std::endl;
+		f << "  {" << std::endl;
+		f << "    double xi = x[i]/D[i];" << std::endl;
+		f << "    for (k = i+1; k < " << d << "; ++k)" << std::endl;
+		f << "      xi -= L[k][i]*x[k];" << std::endl;
+		f << "    x[i] = xi;" << std::endl;
+		f << "  }" << std::endl;
+		f << "}" << std::endl;
+		f << std::endl;
+	}
+
 	f.close();
 	return Util::getTime() - t1;
 }
@@ -845,12 +1599,12 @@ double CWriter::generateAll(Graph::Graph& g, int &dim)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + ".c"; 
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	Symbolics::Graph::Category_Type cats = DER_STATE|SENSOR;
 	if (m_include_visual)
 		cats |= SENSOR_VISUAL;
-	Graph::AssignmentsPtr a = g.getAssignments(cats);
+	Graph::AssignmentsPtr a = getAssignments(g, cats);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	cats = VARIABLE;
@@ -909,19 +1663,7 @@ double CWriter::generateAll(Graph::Graph& g, int &dim)
 	f << writeEquations(a->getEquations(PARAMETER | CONSTANT | INPUT )) << std::endl;
     f << std::endl;
 
-	f << "/* set return values */" << std::endl;
-	for (size_t i=0;i < states.size(); ++i)
-	{
-		size_t n = states.at(i)->getShape().getNumEl();
-		for (size_t j=0; j < n ; ++j) 
-		{
-			f << "    yd[" << i*n+j << "] = der_" << m_p->print(states.at(i));
-			if (n>1) // hm.. was ist schneller "n-1" oder "n>1"?
-				f << "[" << j << "];" << std::endl;
-			else 
-				f << ";" << std::endl; 
-		}
-	}
+	writeReturnValues(f, states, false);
 	f << std::endl; 
 	
 	f.close();
@@ -201,6 +201,7 @@ double FMUWriter::generateTarget_Impl(Graph::Graph &g)
 
 	std::string cmd = "\"\"" + m_7_Zip_app + "\" a -tzip \"" + fmu_file + "\" \"" + m_path + "/*\"\"";
 	system(cmd.c_str());
+	m_files.push_back(fmu_file);
 
 
 	// TODO: Ordner wieder l�schen - oder auch nicht... oder konfigurierbar?
@@ -221,9 +222,9 @@ double FMUWriter::generateXML(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/modelDescription.xml"; 
-    f.open(filename.c_str());
+    openFile(f, filename);
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE|SENSOR|SENSOR_VISUAL);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE|SENSOR|SENSOR_VISUAL);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	//Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR|SENSOR_VISUAL);
@@ -419,9 +420,9 @@ double FMUWriter::generateModel(Graph::Graph& g, int &dim)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + ".c"; 
-    f.open(filename.c_str());
+    openFile(f, filename);
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE|SENSOR|SENSOR_VISUAL);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE|SENSOR|SENSOR_VISUAL);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec variables = a->getVariables(VARIABLE);
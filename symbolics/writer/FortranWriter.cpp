@@ -4,6 +4,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <set>
 #include <algorithm>
 #include <cctype>
 
@@ -32,6 +33,25 @@ FortranWriter::FortranWriter():Writer(false)
 /*****************************************************************************/
 
 
+/*****************************************************************************/
+FortranWriter::FortranWriter( FortranWriter const& src ):Writer(src)
+/*****************************************************************************/
+{
+	m_pymbs_wrapper=src.m_pymbs_wrapper;
+    m_p = new FortranPrinter();
+}
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+Writer* FortranWriter::clone() const
+/*****************************************************************************/
+{
+    return new FortranWriter(*this);
+}
+/*****************************************************************************/
+
+
 /*****************************************************************************/
 FortranWriter::~FortranWriter()
 /*****************************************************************************/
@@ -44,15 +64,19 @@ FortranWriter::~FortranWriter()
 double FortranWriter::generateTarget_Impl(Graph::Graph &g)
 /*****************************************************************************/
 {
-	double t1 = generateDerState(g);
-	double t2 = generateSensors(g);
-	double t3 = generateVisual(g);
-	double t4 = generateFunctionmodule();
-	double t5 = 0.0;
+	std::vector<Graph::Category_Type> categories;
+	categories.push_back(DER_STATE);
+	categories.push_back(SENSOR);
+	categories.push_back(SENSOR_VISUAL);
+	std::vector<Stage> stages;
+	stages.push_back([&g](Writer &w) { return static_cast<FortranWriter&>(w).generateDerState(g); });
+	stages.push_back([&g](Writer &w) { return static_cast<FortranWriter&>(w).generateSensors(g); });
+	stages.push_back([&g](Writer &w) { return static_cast<FortranWriter&>(w).generateVisual(g); });
+	stages.push_back([](Writer &w) { return static_cast<FortranWriter&>(w).generateFunctionmodule(); });
 	if (m_pymbs_wrapper)
-		t5 = generatePymbsWrapper(g);
+		stages.push_back([&g](Writer &w) { return static_cast<FortranWriter&>(w).generatePymbsWrapper(g); });
 
-	return t1+t2+t3+t4+t5;
+	return runStages(g, categories, stages);
 }
 /*****************************************************************************/
 
@@ -63,7 +87,7 @@ double FortranWriter::generateDerState(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	if (states.empty())
@@ -80,9 +104,12 @@ double FortranWriter::generateDerState(Graph::Graph& g)
     // Inputs Vector sortieren: 
 	std::sort(inputs.begin(),inputs.end(), sortVariableVec);
 
+	std::vector<Chunk> chunks = splitEquations(a->getEquations(PARAMETER | CONSTANT | INPUT ));
+	std::set<SymbolPtr> local = getChunkLocals(chunks);
+
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_der_state.f90";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "! " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -131,7 +158,8 @@ double FortranWriter::generateDerState(Graph::Graph& g)
 
 	f << "!declare variables" << std::endl;
     for (Graph::VariableVec::iterator it=variables.begin();it!=variables.end();++it)
-        f << "    double precision" << m_p->dimension(*it) << " :: " << m_p->print(*it) << m_p->comment2(g,*it) <<  std::endl;
+		if (local.find(*it) == local.end())
+			f << "    double precision" << m_p->dimension(*it) << " :: " << m_p->print(*it) << m_p->comment2(g,*it) <<  std::endl;
 	f << std::endl;
 
 	f << "!Additional temporary variables (code export specific)" << std::endl;
@@ -157,7 +185,17 @@ double FortranWriter::generateDerState(Graph::Graph& g)
 
 	fss << "!calculate state derivative" << std::endl;
 	std::vector<std::string> additionalVarDefs;
-	fss << writeEquations(a->getEquations(PARAMETER | CONSTANT | INPUT ), additionalVarDefs) << std::endl;
+	if (chunks.size() > 1)
+	{
+		for (size_t k=0; k < chunks.size(); ++k)
+		{
+			generateDerStateChunk(g, chunks[k], k+1);
+			fss << "    call " << m_name << "_der_state_" << k+1 << "(" << chunkArguments(chunks[k]) << ")" << std::endl;
+		}
+	}
+	else
+		fss << writeEquations(chunks[0].equations, additionalVarDefs) << std::endl;
+	removeChunkFiles(m_path + "/" + m_name + "_der_state_", "f90", chunks.size() > 1 ? chunks.size()+1 : 1);
     fss << std::endl;
 
 	// Jetzt sind die tempor�ren Variablen bekannt
@@ -185,6 +223,60 @@ double FortranWriter::generateDerState(Graph::Graph& g)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+void FortranWriter::generateDerStateChunk(Graph::Graph& g, Chunk const& chunk, size_t k)
+/*****************************************************************************/
+{
+	std::ofstream f;
+    std::string filename= m_path + "/" + m_name + "_der_state_" + str(k) + ".f90";
+    openFile(f, filename);
+
+	std::vector<std::string> additionalVarDefs;
+	std::string equations = writeEquations(chunk.equations, additionalVarDefs);
+
+	f << "! " << getHeaderLine() << std::endl;
+	f << std::endl;
+
+	f << "subroutine " << m_name << "_der_state_" << k << "(" << chunkArguments(chunk) << ")" << std::endl;
+	f << "use functionmodule" << std::endl;
+	f << "implicit none" << std::endl;
+	f << std::endl;
+
+	for (Graph::VariableVec::const_iterator it=chunk.in.begin();it!=chunk.in.end();++it)
+		f << "    double precision, intent(in)" << m_p->dimension(*it) << " :: " << m_p->print(*it) << std::endl;
+	for (Graph::VariableVec::const_iterator it=chunk.inout.begin();it!=chunk.inout.end();++it)
+		f << "    double precision, intent(inout)" << m_p->dimension(*it) << " :: " << m_p->print(*it) << std::endl;
+	for (Graph::VariableVec::const_iterator it=chunk.der.begin();it!=chunk.der.end();++it)
+		f << "    double precision, intent(inout)" << m_p->dimension(*it) << " :: der_" << m_p->print(*it) << std::endl;
+	for (Graph::VariableVec::const_iterator it=chunk.local.begin();it!=chunk.local.end();++it)
+		f << "    double precision" << m_p->dimension(*it) << " :: " << m_p->print(*it) << m_p->comment2(g,*it) << std::endl;
+	for (std::vector<std::string>::iterator it = additionalVarDefs.begin(); it != additionalVarDefs.end(); ++it)
+		f << "    " << *it << std::endl;
+	f << std::endl;
+
+	f << equations << std::endl;
+
+	f << "end subroutine" << std::endl;
+
+	f.close();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::string FortranWriter::chunkArguments(Chunk const& chunk) const
+/*****************************************************************************/
+{
+	std::string s;
+	for (Graph::VariableVec::const_iterator it=chunk.in.begin();it!=chunk.in.end();++it)
+		s += (s.empty() ? "" : ", ") + m_p->print(*it);
+	for (Graph::VariableVec::const_iterator it=chunk.inout.begin();it!=chunk.inout.end();++it)
+		s += (s.empty() ? "" : ", ") + m_p->print(*it);
+	for (Graph::VariableVec::const_iterator it=chunk.der.begin();it!=chunk.der.end();++it)
+		s += (s.empty() ? "der_" : ", der_") + m_p->print(*it);
+	return s;
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 double FortranWriter::generateSensors(Graph::Graph& g)
 /*****************************************************************************/
@@ -192,7 +284,7 @@ double FortranWriter::generateSensors(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR_VISUAL);
@@ -216,7 +308,7 @@ double FortranWriter::generateSensors(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_sensors.f90";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "! " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -325,7 +417,7 @@ double FortranWriter::generateVisual(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR_VISUAL);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR_VISUAL);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR);
@@ -347,7 +439,7 @@ double FortranWriter::generateVisual(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_visual.f90";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "! " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -451,7 +543,7 @@ std::string FortranWriter::writeEquations(std::vector<Graph::Assignment> const&
 		//Folgendes falls mehrere Gleichungen in einer verpackt sind (wird aber scheinbar kaum genutzt)
 		for (size_t i=0; i < it->lhs.size(); ++i)
         {
-            BasicPtr simple_exp = it->rhs[i]->simplify();
+            BasicPtr simple_exp = Util::simplify(it->rhs[i]);
             if (simple_exp.get() == NULL) throw InternalError("FortranWriter: Value of Rhs is not Valid!");
             
 			//Workaround: links Matrix (also mehrere Ergebnisse)
@@ -465,14 +557,18 @@ std::string FortranWriter::writeEquations(std::vector<Graph::Assignment> const&
 							s << "    " << m_p->print(mat->get(j,k)) << " = " << m_p->print(simple_exp) << "(" << j+1<< "," << k+1 << ")" << std::endl;
 				} else 	{  // Es muss eine tempor�re Variable eingef�hrt werden
 					additionalVarDefs.push_back("double precision" + m_p->dimension(it->lhs[i]) + " :: temp_var_" + str(additionalVarDefs.size() + 1));
-					s << "    temp_var_" << additionalVarDefs.size() << " = " << m_p->print(simple_exp) << std::endl; 
+					s << "    temp_var_" << additionalVarDefs.size() << " = ";
+					m_p->print(simple_exp, s);
+					s << std::endl; 
 					for (size_t j=0; j < mat->getShape().getDimension(1); j++)
 						for (size_t k=0; k < mat->getShape().getDimension(2); k++)
 							s << "    " << m_p->print(mat->get(j,k)) << " = temp_var_1(" << j+1<< "," << k+1 << ")" << std::endl;
 				}
 			} else {
 				// ordinary equation
-				s << "    " << m_p->print(it->lhs[i]) << " = " << m_p->print(simple_exp) << std::endl;
+				s << "    " << m_p->print(it->lhs[i]) << " = ";
+				m_p->print(simple_exp, s);
+				s << std::endl;
 				//s << "write (*,*) \"" << m_p->print(it->lhs[i]) << ": \", " << m_p->print(it->lhs[i]) << std::endl; //for Debug
 			}
         }
@@ -497,13 +593,13 @@ double FortranWriter::generatePymbsWrapper(Graph::Graph& g)
 	std::string m_name_lower = m_name;
 	std::transform(m_name_lower.begin(), m_name_lower.end(), m_name_lower.begin(), ::tolower);
 	
-	Graph::VariableVec der_state_inputs = g.getAssignments(DER_STATE)->getVariables(INPUT);
+	Graph::VariableVec der_state_inputs = getAssignments(g, DER_STATE)->getVariables(INPUT);
     // Inputs Vector sortieren: 
 	std::sort(der_state_inputs.begin(),der_state_inputs.end(), sortVariableVec);
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_der_state_F90Wrapper.py";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "# " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -536,12 +632,12 @@ double FortranWriter::generatePymbsWrapper(Graph::Graph& g)
                   << m_name << "_der_state_F90Wrapper.py. Please have a look at that file to see where the error(s) occured." << std::endl;
 
 
-	Graph::VariableVec sens_vis = g.getAssignments(SENSOR_VISUAL)->getVariables(SENSOR_VISUAL);
+	Graph::VariableVec sens_vis = getAssignments(g, SENSOR_VISUAL)->getVariables(SENSOR_VISUAL);
 	// Visual_sensors Vector sortieren:
 	std::sort(sens_vis.begin(),sens_vis.end(), sortVariableVec);
 
     filename= m_path + "/" + m_name + "_visual_F90Wrapper.py";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "# " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -569,13 +665,13 @@ double FortranWriter::generatePymbsWrapper(Graph::Graph& g)
                   << m_name << "_visual_F90Wrapper.py. Please have a look at that file to see where the error(s) occured." << std::endl;
 
 
-    Graph::VariableVec sensor = g.getAssignments(SENSOR)->getVariables(SENSOR);
+    Graph::VariableVec sensor = getAssignments(g, SENSOR)->getVariables(SENSOR);
     if (sensor.empty()) {
         std::cerr << "Warning: FortranWriter: Not generating sensors wrapper file, since there are no sensors." << std::endl;
         return Util::getTime() - t1;
     }
 
-    Graph::VariableVec sensor_inputs = g.getAssignments(SENSOR)->getVariables(INPUT);
+    Graph::VariableVec sensor_inputs = getAssignments(g, SENSOR)->getVariables(INPUT);
     // Inputs Vector sortieren: 
 	std::sort(sensor_inputs.begin(),sensor_inputs.end(), sortVariableVec);
 
@@ -583,7 +679,7 @@ double FortranWriter::generatePymbsWrapper(Graph::Graph& g)
 	std::sort(sensor.begin(),sensor.end(), sortVariableVec);
 
     filename= m_path + "/" + m_name + "_sensors_F90Wrapper.py";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "# " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -637,7 +733,7 @@ double FortranWriter::generateFunctionmodule()
 
 	std::ofstream f;
     std::string filename= m_path + "/functionmodule.f90";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "! " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -30,6 +30,26 @@ MatlabWriter::MatlabWriter():Writer(false)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+MatlabWriter::MatlabWriter( MatlabWriter const& src ):Writer(src)
+/*****************************************************************************/
+{
+    m_symbolicmode=src.m_symbolicmode;
+    if (m_symbolicmode)
+        m_p = new MatlabSymPrinter();
+    else
+        m_p = new MatlabPrinter();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Writer* MatlabWriter::clone() const
+/*****************************************************************************/
+{
+    return new MatlabWriter(*this);
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 MatlabWriter::~MatlabWriter()
 /*****************************************************************************/
@@ -43,19 +63,22 @@ MatlabWriter::~MatlabWriter()
 double MatlabWriter::generateTarget_Impl(Graph::Graph &g)
 /*****************************************************************************/
 {
-	double t1=0, t2=0, t3=0, t4=0;
+	std::vector<Graph::Category_Type> categories;
+	categories.push_back(DER_STATE);
+	categories.push_back(SENSOR);
+	std::vector<Stage> stages;
 	if (!m_symbolicmode) {
-		t1 = generateBasicSim(g);
-		t2 = generateDerState(g);
-		t3 = generateInputs(g);
-		t4 = generateSensors(g);
+		stages.push_back([&g](Writer &w) { return static_cast<MatlabWriter&>(w).generateBasicSim(g); });
+		stages.push_back([&g](Writer &w) { return static_cast<MatlabWriter&>(w).generateDerState(g); });
+		stages.push_back([&g](Writer &w) { return static_cast<MatlabWriter&>(w).generateInputs(g); });
+		stages.push_back([&g](Writer &w) { return static_cast<MatlabWriter&>(w).generateSensors(g); });
 	} else {
-		t2 = generateSymDerState(g);
-		t4 = generateSymSensors(g);
+		stages.push_back([&g](Writer &w) { return static_cast<MatlabWriter&>(w).generateSymDerState(g); });
+		stages.push_back([&g](Writer &w) { return static_cast<MatlabWriter&>(w).generateSymSensors(g); });
 	}
 
-	return t1+t2+t3+t4;
-	
+	return runStages(g, categories, stages);
+
 }
 /*****************************************************************************/
 
@@ -68,9 +91,9 @@ double MatlabWriter::generateBasicSim(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_sim.m";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE);
 
 	Graph::VariableVec sensors = a->getVariables(SENSOR);
 	Graph::VariableVec states = a->getVariables(STATE);
@@ -153,7 +176,7 @@ double MatlabWriter::generateDerState(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	if (states.empty())
@@ -167,7 +190,7 @@ double MatlabWriter::generateDerState(Graph::Graph& g)
 	
 	std::ofstream f;
 	std::string filename= m_path + "/" + m_name + "_der_state.m";
-	f.open(filename.c_str());
+	openFile(f, filename);
 
 	f << "% " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -227,9 +250,9 @@ double MatlabWriter::generateSymDerState(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_der_state_symbolic.m";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE);
 
 	Graph::VariableVec states = a->getVariables(STATE);
     Graph::VariableVec variables = a->getVariables(VARIABLE|SENSOR|SENSOR_VISUAL);
@@ -301,7 +324,7 @@ double MatlabWriter::generateInputs(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_inputs.m";
-    f.open(filename.c_str());
+    openFile(f, filename);
 	Graph::VariableVec inputs = g.getVariables(INPUT);
 
 	f << "% " << getHeaderLine() << std::endl;
@@ -336,7 +359,7 @@ double MatlabWriter::generateSensors(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec inputs = a->getVariables(INPUT);
@@ -354,7 +377,7 @@ double MatlabWriter::generateSensors(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_sensors.m";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "% " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -416,7 +439,7 @@ double MatlabWriter::generateSymSensors(Graph::Graph& g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(SENSOR);
+	Graph::AssignmentsPtr a = getAssignments(g, SENSOR);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec inputs = a->getVariables(INPUT);
@@ -434,7 +457,7 @@ double MatlabWriter::generateSymSensors(Graph::Graph& g)
 
 	std::ofstream f;
     std::string filename= m_path + "/" + m_name + "_sensors_symbolic.m";
-    f.open(filename.c_str());
+    openFile(f, filename);
 
 	f << "% " << getHeaderLine() << std::endl;
 	f << std::endl;
@@ -506,7 +529,7 @@ std::string MatlabWriter::writeEquations(std::vector<Graph::Assignment> const& e
 		//Folgendes falls mehrere Gleichungen in einer verpackt sind (wird aber scheinbar kaum genutzt)
 		for (size_t i=0; i < it->lhs.size(); ++i)
         {
-            BasicPtr simple_exp = it->rhs[i]->simplify();
+            BasicPtr simple_exp = Util::simplify(it->rhs[i]);
             if (simple_exp.get() == NULL) throw InternalError("MatlabWriter: Value of Rhs is not Valid!");
 
 			//Workaround: links mehrere Ergebnisse
@@ -519,14 +542,18 @@ std::string MatlabWriter::writeEquations(std::vector<Graph::Assignment> const& e
 						for (size_t k=0; k < mat->getShape().getDimension(2); k++)
 							s << "    " << m_p->print(mat->get(j,k)) << " = " << m_p->print(simple_exp) << "(" << j+1<< "," << k+1 << ")" << (m_symbolicmode ? "" : ";") << std::endl;
 				} else 	{  // Es muss eine tempor�re Variable eingef�hrt werden
-					s << "    temp_var_1 = " << m_p->print(simple_exp) << (m_symbolicmode ? "" : ";") << std::endl; // TODO: So ein fester Name ist nicht sch�n, wie lassen sich Kollisionen vermeiden?
+					s << "    temp_var_1 = ";
+					m_p->print(simple_exp, s);
+					s << (m_symbolicmode ? "" : ";") << std::endl; // TODO: So ein fester Name ist nicht sch�n, wie lassen sich Kollisionen vermeiden?
 					for (size_t j=0; j < mat->getShape().getDimension(1); j++)
 						for (size_t k=0; k < mat->getShape().getDimension(2); k++)
 							s << "    " << m_p->print(mat->get(j,k)) << " = temp_var_1(" << j+1<< "," << k+1 << ")" << (m_symbolicmode ? "" : ";") << std::endl;
 				}
 			} else 	{
 				// ordinary equation
-				s << "	" << m_p->print(it->lhs[i]) << " = " << m_p->print(simple_exp) << (m_symbolicmode ? "" : ";") << std::endl;
+				s << "	" << m_p->print(it->lhs[i]) << " = ";
+				m_p->print(simple_exp, s);
+				s << (m_symbolicmode ? "" : ";") << std::endl;
 			}
         }
     }
@@ -45,11 +45,11 @@ double ModelicaWriter::generateTarget_Impl(Graph::Graph &g)
   // open file
   std::ofstream f;
   std::string filename= m_path + "/" + m_name + ".mo";
-  f.open(filename.c_str());
+  openFile(f, filename);
 
   //f.close();
   double t1 = Util::getTime();
-  Graph::AssignmentsPtr a = g.getAssignments(DER_STATE | SENSOR | SENSOR_VISUAL);
+  Graph::AssignmentsPtr a = getAssignments(g, DER_STATE | SENSOR | SENSOR_VISUAL);
 
   Graph::VariableVec states = a->getVariables(STATE);
   Graph::VariableVec variables = a->getVariables(VARIABLE);
@@ -140,10 +140,12 @@ double ModelicaWriter::generateTarget_Impl(Graph::Graph &g)
   {
     for (size_t i=0; i < ii->lhs.size(); ++i)
     {
-      BasicPtr simple_exp = ii->rhs[i]->simplify();
+      BasicPtr simple_exp = Util::simplify(ii->rhs[i]);
       if (simple_exp.get() == NULL)
         throw InternalError("ModelicaWriter: Value of Rhs is not Valid!");
-      f << "  " << p.print(ii->lhs[i]) << " = " << p.print(simple_exp) << ";" << std::endl;
+      f << "  " << p.print(ii->lhs[i]) << " = ";
+      p.print(simple_exp, f);
+      f << ";" << std::endl;
     }
   }
   f << "end " << m_name << ";" << std::endl;
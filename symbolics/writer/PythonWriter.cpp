@@ -38,6 +38,22 @@ PythonWriter::PythonWriter():Writer(false)
 }
 /*****************************************************************************/
 
+/*****************************************************************************/
+PythonWriter::PythonWriter( PythonWriter const& src ):Writer(src)
+/*****************************************************************************/
+{
+    m_p = new PythonPrinter();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Writer* PythonWriter::clone() const
+/*****************************************************************************/
+{
+    return new PythonWriter(*this);
+}
+/*****************************************************************************/
+
 /*****************************************************************************/
 PythonWriter::~PythonWriter()
 /*****************************************************************************/
@@ -51,10 +67,16 @@ PythonWriter::~PythonWriter()
 double PythonWriter::generateTarget_Impl(Graph::Graph &g)
 /*****************************************************************************/
 {
-	double t1 = generateStateDerivative(g);
-	double t2 = generateVisualSensors(g);
-	double t3 = generateSensors(g);
-	return t1+t2+t3;
+	// der_state liest auch SENSOR
+	std::vector<Graph::Category_Type> categories;
+	categories.push_back(DER_STATE);
+	categories.push_back(Writer::SENSOR);
+	categories.push_back(Writer::SENSOR_VISUAL);
+	std::vector<Stage> stages;
+	stages.push_back([&g](Writer &w) { return static_cast<PythonWriter&>(w).generateStateDerivative(g); });
+	stages.push_back([&g](Writer &w) { return static_cast<PythonWriter&>(w).generateVisualSensors(g); });
+	stages.push_back([&g](Writer &w) { return static_cast<PythonWriter&>(w).generateSensors(g); });
+	return runStages(g, categories, stages);
 }
 
 /*****************************************************************************/
@@ -64,7 +86,7 @@ double PythonWriter::generateStateDerivative(Graph::Graph &g)
 	//get timestamp and catch variables from graph
 	double t1 = Util::getTime();
 
-	Graph::AssignmentsPtr a = g.getAssignments(DER_STATE);
+	Graph::AssignmentsPtr a = getAssignments(g, DER_STATE);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	if (states.empty())
@@ -76,7 +98,7 @@ double PythonWriter::generateStateDerivative(Graph::Graph &g)
 
 	std::vector<Graph::Assignment> equations = a->getEquations(PARAMETER | CONSTANT | INPUT | CONTROLLER);
 
-	Graph::AssignmentsPtr b = g.getAssignments(Writer::SENSOR);
+	Graph::AssignmentsPtr b = getAssignments(g, Writer::SENSOR);
 	Graph::VariableVec sensors = b->getVariables(Writer::SENSOR);
 
 	// StateVariables Vector sortieren:
@@ -85,7 +107,7 @@ double PythonWriter::generateStateDerivative(Graph::Graph &g)
 	// open file
 	std::ofstream f;
 	std::string filename= m_path + "/" + m_name + "_der_state.py";
-	f.open(filename.c_str());
+	openFile(f, filename);
 
 
 	// create header line and import statements
@@ -223,7 +245,7 @@ double PythonWriter::generateVisualSensors(Graph::Graph &g)
 	double t1 = Util::getTime();
 
 	// get equations of visual sensors
-	Graph::AssignmentsPtr a = g.getAssignments(Writer::SENSOR_VISUAL);
+	Graph::AssignmentsPtr a = getAssignments(g, Writer::SENSOR_VISUAL);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec inputs = a->getVariables(INPUT);
@@ -244,7 +266,7 @@ double PythonWriter::generateVisualSensors(Graph::Graph &g)
 	// open file
 	std::ofstream f;
 	std::string filename = m_path + "/" + m_name + "_visual.py";
-	f.open(filename.c_str());
+	openFile(f, filename);
 
 
 	// create header line and import statements
@@ -353,7 +375,7 @@ double PythonWriter::generateSensors(Graph::Graph &g)
 	double t1 = Util::getTime();
 
 	// get equations of visual sensors
-	Graph::AssignmentsPtr a = g.getAssignments(Writer::SENSOR);
+	Graph::AssignmentsPtr a = getAssignments(g, Writer::SENSOR);
 
 	Graph::VariableVec states = a->getVariables(STATE);
 	Graph::VariableVec inputs = a->getVariables(INPUT);
@@ -374,7 +396,7 @@ double PythonWriter::generateSensors(Graph::Graph &g)
 	// open file
 	std::ofstream f;
 	std::string filename = m_path + "/" + m_name + "_sensors.py";
-	f.open(filename.c_str());
+	openFile(f, filename);
 
 
 	// create header line and import statements
@@ -491,7 +513,7 @@ std::string PythonWriter::writeEquations(std::vector<Graph::Assignment> const& e
 		// Multi-dimensional equation, i.e. matrix equation (seems to be hardly used)
 		for (size_t i=0; i < it->lhs.size(); ++i)
 		{
-			BasicPtr simple_exp = it->rhs[i]->simplify();
+			BasicPtr simple_exp = Util::simplify(it->rhs[i]);
 			if (simple_exp.get() == NULL) throw InternalError("PythonWriter: Value of Rhs is not Valid!");
 
 			// Matrix at left hand side (= multiple results)
@@ -503,9 +525,13 @@ std::string PythonWriter::writeEquations(std::vector<Graph::Assignment> const& e
 				for (size_t j=0; j < n.getDimension(1); j++)
 					for (size_t k=0; k < n.getDimension(2); k++)
 						s << (j+k ? ", " : "") << m_p->print(mat->get(j,k));
-				s << " = " << m_p->print(simple_exp) << ".getA1()" << std::endl;
+				s << " = ";
+				m_p->print(simple_exp, s);
+				s << ".getA1()" << std::endl;
 			} else { // ordinary equation
-				s << "    " << m_p->print(it->lhs[i]) << " = " << m_p->print(simple_exp) << std::endl;
+				s << "    " << m_p->print(it->lhs[i]) << " = ";
+				m_p->print(simple_exp, s);
+				s << std::endl;
 				//f << "    print \"" << m_p->print(equations[i].lhs[l]) << ": %s\"%" << m_p->print(equations[i].lhs[l]) << std::endl; //for debug
 			}
 		}
@@ -1,5 +1,14 @@
 #include "Writer.h"
+#include "CostModel.h"
 #include "str.h"
+#include "Filesystem.h"
+#include "Arena.h"
+#include <fstream>
+#include <set>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #ifdef WIN32
   #include <time.h>
@@ -10,7 +19,7 @@
 using namespace Symbolics;
 
 /*****************************************************************************/
-Writer::Writer(bool makeScalar):m_scalar(makeScalar)
+Writer::Writer(bool makeScalar):m_scalar(makeScalar), m_cost_report(false), m_cache(false), m_threads(1), m_chunk_size(0), m_schedule(false), m_cse(true)
 /*****************************************************************************/
 {
 }
@@ -44,8 +53,444 @@ double Writer::generateTarget(std::string name, std::string path, Graph::Graph&
     m_path = path;
 
     m_name = name;
+    m_files.clear();
+
+    // unveraenderter Graph, Dateien vom letzten Lauf noch da
+    std::string cacheFile;
+    if (m_cache)
+    {
+        cacheFile = getCacheFile(g);
+        if (isCached(cacheFile))
+            return 0;
+    }
+
     // 
-    return generateTarget_Impl(g);
+    double t = generateTarget_Impl(g);
+
+    if (m_cost_report)
+        writeCostReport(g);
+
+    if (m_cache)
+        writeCacheFile(cacheFile);
+
+    return t;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Writer* Writer::clone() const
+/*****************************************************************************/
+{
+    throw InternalError("Writer: parallel generation is not supported for this target");
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+Graph::AssignmentsPtr Writer::getAssignments(Graph::Graph& g, Graph::Category_Type category)
+/*****************************************************************************/
+{
+    std::map<Graph::Category_Type, Graph::AssignmentsPtr>::const_iterator ii = m_assignments.find(category);
+    if (ii != m_assignments.end())
+        return ii->second;
+    Graph::AssignmentsPtr a = g.getAssignments(category, 0x00, m_cse);
+    if (m_schedule)
+        a->schedule();
+    return a;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Writer::warmCaches(BasicPtr const& exp)
+/*****************************************************************************/
+{
+    exp->getHash();
+    exp->getFreeSymbols();
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Writer::warmCaches(Graph::Graph& g, Graph::AssignmentsPtr const& a)
+/*****************************************************************************/
+{
+    // Parameter und Konstanten werden mit ihrer Gleichung deklariert, die uebrigen
+    // Variablen mit ihrem Startwert
+    Graph::VariableVec symbols = a->getVariables(PARAMETER|CONSTANT);
+    for (Graph::VariableVec::iterator it=symbols.begin(); it!=symbols.end(); ++it)
+        warmCaches(g.getEquation(*it));
+    symbols = a->getVariables(STATE|VARIABLE|SENSOR|SENSOR_VISUAL|USER_EXP|INPUT|CONTROLLER);
+    for (Graph::VariableVec::iterator it=symbols.begin(); it!=symbols.end(); ++it)
+    {
+        try
+        {
+            warmCaches(g.getinitVal(*it));
+        }
+        catch (InternalError&)
+        {
+            // ohne Startwert liest ihn auch kein Schritt
+        }
+    }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+double Writer::runStages(Graph::Graph& g, std::vector<Graph::Category_Type> const& categories, std::vector<Stage> const& stages)
+/*****************************************************************************/
+{
+    if ((m_threads < 2) || (stages.size() < 2))
+    {
+        double t = 0;
+        for (size_t i=0; i<stages.size(); ++i)
+            t += stages[i](*this);
+        return t;
+    }
+
+    double t1 = Util::getTime();
+
+    // getAssignments markiert Knoten und legt mit der CSE Symbole an, simplify,
+    // Hash und freie Symbole fuellen die Caches der Ausdruecke: alles hier,
+    // danach wird nur gelesen
+    for (size_t i=0; i<categories.size(); ++i)
+    {
+        if (m_assignments.count(categories[i]))
+            continue;
+        Graph::AssignmentsPtr a = getAssignments(g, categories[i]);
+        std::vector<Graph::Assignment> equations = a->getEquations();
+        for (std::vector<Graph::Assignment>::iterator it=equations.begin(); it!=equations.end(); ++it)
+        {
+            for (size_t k=0; k<it->lhs.size(); ++k)
+                warmCaches(it->lhs[k]);
+            for (size_t k=0; k<it->rhs.size(); ++k)
+            {
+                warmCaches(it->rhs[k]);
+                warmCaches(Util::simplify(it->rhs[k]));
+            }
+        }
+        warmCaches(g, a);
+        m_assignments[categories[i]] = a;
+    }
+
+    std::vector<Writer*> writers;
+    for (size_t i=0; i<stages.size(); ++i)
+    {
+        writers.push_back(clone());
+        writers.back()->m_files.clear();
+    }
+
+    // jeder Thread holt sich den naechsten freien Schritt
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errormutex;
+    auto worker = [&]()
+    {
+        for (size_t i=next.fetch_add(1); i<stages.size(); i=next.fetch_add(1))
+        {
+            try
+            {
+                stages[i](*writers[i]);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errormutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+
+    {
+        ParallelSection section;
+        std::vector<std::thread> threads;
+        size_t num = std::min(m_threads, stages.size());
+        for (size_t t=1; t<num; ++t)
+            threads.push_back(std::thread(worker));
+        worker();
+        for (size_t t=0; t<threads.size(); ++t)
+            threads[t].join();
+    }
+
+    // Dateien in der Reihenfolge der Schritte
+    for (size_t i=0; i<writers.size(); ++i)
+    {
+        m_files.insert(m_files.end(), writers[i]->m_files.begin(), writers[i]->m_files.end());
+        mergeStage(*writers[i]);
+        delete writers[i];
+    }
+    m_assignments.clear();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return Util::getTime() - t1;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Writer::openFile(std::ofstream &f, std::string const& filename)
+/*****************************************************************************/
+{
+    f.open(filename.c_str());
+    m_files.push_back(filename);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+static void addSymbols(BasicPtr const& exp, std::set<SymbolPtr> &symbols, std::set<SymbolPtr> &ders)
+/*****************************************************************************/
+{
+    // getPostOrder statt getAtoms: legt keine Caches an, die Schritte laufen evtl. parallel
+    BasicPtrVec nodes;
+    exp->getPostOrder(nodes);
+    for (BasicPtrVec::const_iterator it=nodes.begin(); it!=nodes.end(); ++it)
+    {
+        if ((*it)->getType() == Type_Symbol)
+            symbols.insert(SymbolPtr(Util::getAsPtr<Symbol>(*it)));
+        else if ((*it)->getType() == Type_Der)
+        {
+            BasicPtr const& arg = (*it)->getArg(0);
+            BasicPtr const& state = (arg->getType() == Type_Element) ? arg->getArg(0) : arg;
+            if (state->getType() == Type_Symbol)
+                ders.insert(SymbolPtr(Util::getAsPtr<Symbol>(state)));
+        }
+    }
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::vector<Writer::Chunk> Writer::splitEquations(std::vector<Graph::Assignment> const& equations) const
+/*****************************************************************************/
+{
+    std::vector<Chunk> chunks;
+    if ((m_chunk_size == 0) || (equations.size() <= m_chunk_size))
+    {
+        chunks.push_back(Chunk());
+        chunks.back().equations = equations;
+        return chunks;
+    }
+
+    size_t n = (equations.size() + m_chunk_size - 1) / m_chunk_size;
+    chunks.resize(n);
+    // je Abschnitt: vor dem ersten Schreiben gelesen (ue), geschrieben (def), ganz
+    // ueberschrieben (kill, nur Skalare; Felder werden oft elementweise geschrieben)
+    std::vector<std::set<SymbolPtr> > ue(n), def(n), kill(n), used(n), ders(n);
+    for (size_t i=0; i < equations.size(); ++i)
+    {
+        size_t k = i / m_chunk_size;
+        chunks[k].equations.push_back(equations[i]);
+        std::set<SymbolPtr> reads, writes;
+        for (size_t j=0; j < equations[i].lhs.size(); ++j)
+        {
+            // der_<Zustand> = ..., der Zustand selbst wird nicht geschrieben
+            if (equations[i].lhs[j]->getType() == Type_Der)
+            {
+                std::set<SymbolPtr> state;
+                addSymbols(equations[i].lhs[j], state, ders[k]);
+            }
+            else
+                addSymbols(equations[i].lhs[j], writes, ders[k]);
+            addSymbols(equations[i].rhs[j], reads, ders[k]);
+        }
+        for (std::set<SymbolPtr>::const_iterator it=reads.begin(); it!=reads.end(); ++it)
+            if (kill[k].find(*it) == kill[k].end())
+                ue[k].insert(*it);
+        used[k].insert(reads.begin(), reads.end());
+        used[k].insert(writes.begin(), writes.end());
+        def[k].insert(writes.begin(), writes.end());
+        for (size_t j=0; j < equations[i].lhs.size(); ++j)
+            if ((equations[i].lhs[j]->getType() == Type_Symbol) && equations[i].lhs[j]->is_Scalar())
+                kill[k].insert(SymbolPtr(Util::getAsPtr<Symbol>(equations[i].lhs[j])));
+    }
+
+    // Lebendigkeit an den Abschnittsgrenzen, von hinten: lebt vor k = ue[k] und was nach k
+    // lebt, ohne kill[k]. Nach dem letzten Abschnitt liest der_state nur die Ableitungen.
+    std::vector<std::set<SymbolPtr> > liveOut(n);
+    std::set<SymbolPtr> live;
+    for (size_t k=n; k-- > 0; )
+    {
+        liveOut[k] = live;
+        std::set<SymbolPtr> liveIn = ue[k];
+        for (std::set<SymbolPtr>::const_iterator it=live.begin(); it!=live.end(); ++it)
+            if (kill[k].find(*it) == kill[k].end())
+                liveIn.insert(*it);
+        live.swap(liveIn);
+    }
+
+    // Argument, wenn der Wert in den Abschnitt hinein oder aus ihm heraus lebt, sonst lokal
+    for (size_t k=0; k < n; ++k)
+    {
+        for (std::set<SymbolPtr>::const_iterator it=used[k].begin(); it!=used[k].end(); ++it)
+        {
+            bool written = (def[k].find(*it) != def[k].end());
+            if ((ue[k].find(*it) != ue[k].end()) || (written && (liveOut[k].find(*it) != liveOut[k].end())))
+            {
+                if (written)
+                    chunks[k].inout.push_back(*it);
+                else
+                    chunks[k].in.push_back(*it);
+            }
+            else
+                chunks[k].local.push_back(*it);
+        }
+        chunks[k].der.assign(ders[k].begin(), ders[k].end());
+        std::sort(chunks[k].in.begin(), chunks[k].in.end(), sortVariableVec);
+        std::sort(chunks[k].inout.begin(), chunks[k].inout.end(), sortVariableVec);
+        std::sort(chunks[k].local.begin(), chunks[k].local.end(), sortVariableVec);
+        std::sort(chunks[k].der.begin(), chunks[k].der.end(), sortVariableVec);
+    }
+    return chunks;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::set<SymbolPtr> Writer::getChunkLocals(std::vector<Chunk> const& chunks)
+/*****************************************************************************/
+{
+    std::set<SymbolPtr> local, passed;
+    for (size_t k=0; k < chunks.size(); ++k)
+    {
+        local.insert(chunks[k].local.begin(), chunks[k].local.end());
+        passed.insert(chunks[k].in.begin(), chunks[k].in.end());
+        passed.insert(chunks[k].inout.begin(), chunks[k].inout.end());
+    }
+    // lokal in einem Abschnitt, in einem anderen Argument: deklariert der_state
+    for (std::set<SymbolPtr>::const_iterator it=passed.begin(); it!=passed.end(); ++it)
+        local.erase(*it);
+    return local;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Writer::removeChunkFiles(std::string const& prefix, std::string const& ext, size_t first)
+/*****************************************************************************/
+{
+    for (size_t k=first; filesystem::exists(prefix + str(k) + "." + ext); ++k)
+        filesystem::remove(prefix + str(k) + "." + ext);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+std::string Writer::getCacheFile(Graph::Graph& g)
+/*****************************************************************************/
+{
+    size_t key = g.getHash();
+    std::string options = m_cache_options + "|" + m_name + "|" + (m_scalar ? "scalar" : "");
+    key ^= std::hash<std::string>()(options) + 0x9e3779b9 + (key<<6) + (key>>2);
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+    return m_path + "/.pymbs_cache/" + hex;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+bool Writer::isCached(std::string const& cacheFile)
+/*****************************************************************************/
+{
+    std::ifstream f(cacheFile.c_str());
+    if (!f.is_open())
+        return false;
+
+    // je Zeile: Groesse, Aenderungszeit, Datei
+    std::string line;
+    if (!std::getline(f, line) || (line != "pymbs cache 1"))
+        return false;
+    size_t n = 0;
+    long long size, mtime;
+    while (f >> size >> mtime)
+    {
+        std::string filename;
+        f.get();
+        std::getline(f, filename);
+        long long s, t;
+        if (!filesystem::file_info(filename, s, t) || (s != size) || (t != mtime))
+            return false;
+        ++n;
+    }
+    return n > 0;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Writer::writeCacheFile(std::string const& cacheFile)
+/*****************************************************************************/
+{
+    std::string lines = "pymbs cache 1\n";
+    for (size_t i=0; i<m_files.size(); ++i)
+    {
+        long long size, mtime;
+        // nicht geschrieben, dann lieber beim naechsten Mal neu erzeugen
+        if (!filesystem::file_info(m_files[i], size, mtime))
+            return;
+        lines += str(static_cast<size_t>(size)) + " " + str(static_cast<size_t>(mtime)) + " " + m_files[i] + "\n";
+    }
+
+    // m_path kann der Writer veraendert haben (FMU)
+    filesystem::create_directory(cacheFile.substr(0, cacheFile.rfind('/')));
+    std::ofstream f(cacheFile.c_str());
+    f << lines;
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+static std::string toJSON(Graph::OperationCount const& c)
+/*****************************************************************************/
+{
+    return "\"adds\": " + str(c.adds) + ", \"muls\": " + str(c.muls) + ", \"divs\": " + str(c.divs) +
+        ", \"functions\": " + str(c.functions) + ", \"temps\": " + str(c.temps) + ", \"flops\": " + str(c.getFlops());
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+static std::string quoteJSON(std::string const& s)
+/*****************************************************************************/
+{
+    std::string q = "\"";
+    for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+        if ((*it == '"') || (*it == '\\'))
+            q += '\\';
+        q += *it;
+    }
+    return q + "\"";
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+void Writer::writeCostReport(Graph::Graph& g)
+/*****************************************************************************/
+{
+    const char* names[] = { "der_state", "sensors", "visual" };
+    Graph::Category_Type cats[] = { DER_STATE, SENSOR, SENSOR_VISUAL };
+
+    std::ofstream f;
+    std::string filename = m_path + "/" + m_name + "_cost.json";
+    openFile(f, filename);
+
+    f << "{" << std::endl;
+    f << "  \"model\": " << quoteJSON(m_name) << "," << std::endl;
+    f << "  \"outputs\": {" << std::endl;
+    for (size_t i=0; i<3; ++i)
+    {
+        // wie in den Writern: Parameter, Konstanten und Eingaenge werden nicht berechnet
+        std::vector<Graph::Assignment> equations = getAssignments(g, cats[i])->getEquations(PARAMETER | CONSTANT | INPUT);
+
+        f << "    \"" << names[i] << "\": {" << std::endl;
+        f << "      \"total\": { " << toJSON(Graph::CostModel::count(equations)) << " }," << std::endl;
+        f << "      \"assignments\": [" << std::endl;
+        for (size_t j=0; j<equations.size(); ++j)
+        {
+            std::string lhs;
+            for (size_t k=0; k<equations[j].lhs.size(); ++k)
+                lhs += (k > 0 ? ", " : "") + equations[j].lhs[k]->toString();
+            f << "        { \"lhs\": " << quoteJSON(lhs) << ", " << toJSON(Graph::CostModel::count(equations[j])) << " }"
+              << (j+1 < equations.size() ? "," : "") << std::endl;
+        }
+        f << "      ]" << std::endl;
+        f << "    }" << (i+1 < 3 ? "," : "") << std::endl;
+    }
+    f << "  }" << std::endl;
+    f << "}" << std::endl;
+
+    f.close();
 }
 /*****************************************************************************/
 
@@ -57,10 +502,16 @@ std::string Writer::getHeaderLine()
 
     time_t st;
     st=time(NULL);
-    struct tm* gmt=gmtime(&st); //VisualStudio complains about unsafe function - ignore it, otherwise its not cross platform.
+    // gmtime teilt einen Puffer, die Schritte von runStages schreiben ihre Kopfzeilen parallel
+    struct tm gmt;
+#ifdef WIN32
+    gmtime_s(&gmt, &st);
+#else
+    gmtime_r(&st, &gmt);
+#endif
 	//If someone finds a way to output the timezone in a reasonable way, one can switch back to localtime here
 	char time_gmt_str[20];
-	strftime(time_gmt_str, sizeof(time_gmt_str), "%Y-%m-%d %H:%M:%S", gmt);
+	strftime(time_gmt_str, sizeof(time_gmt_str), "%Y-%m-%d %H:%M:%S", &gmt);
 
     return s + time_gmt_str +" UTC";
 }
@@ -1,6 +1,8 @@
 #ifndef __C_WRITER_H_
 #define __C_WRITER_H_
 
+#include <set>
+#include <ostream>
 #include "Writer.h"
 #include "CPrinter.h"
 
@@ -16,19 +18,64 @@ namespace Symbolics
         ~CWriter();
 
     protected:
+        // Kopie fuer runStages, mit eigenem Printer
+        CWriter( CWriter const& src );
+        Writer* clone() const;
+        void mergeStage(Writer const& stage);
+
         double generateTarget_Impl(Graph::Graph& g);
 
 		CPrinter *m_p; // Der Hauptprinter dieser Writerklasse
 
-		std::string writeEquations(std::vector<Graph::Assignment> const& equations) const;
+		// all: alle Gleichungen, wenn equations nur ein Abschnitt ist (fuer getMatrixEntries)
+		std::string writeEquations(std::vector<Graph::Assignment> const& equations, std::vector<Graph::Assignment> const* all = NULL) const;
 		double generateFunctionmodule(int n);
+		// alle Funktionen von functionmodule.c, dort vor den Definitionen und in jedem Abschnitt von der_state
+		void writeFunctionmodulePrototypes(std::ostream &f, int n) const;
+
+		// Elemente von A (zeilenweise, NULL = nicht belegt), bei Variablen aus equations
+		bool getMatrixEntries(BasicPtr const& A, std::vector<Graph::Assignment> const& equations, BasicPtrVec &entries) const;
+		// Solve mit symmetrischer (Massen-)Matrix: LDL^T statt legs()
+		static bool is_Symmetric(BasicPtrVec const& entries, size_t dim);
+		// SymmetricMatrix oder die Massenmatrix M_, nur dann ist LDL^T ohne Pivotsuche stabil
+		static bool is_PositiveDefinite(BasicPtr const& A);
+		// LDL^T bereits beim Generieren ausfuehren, nur die Nicht-Null-Eintraege ausgeben
+		std::string writeSparseSolve(BasicPtr const& A, BasicPtrVec const& entries, BasicPtr const& x, size_t dim) const;
+		// Reihenfolge minimalen Grades fuer das Besetzungsmuster (weniger Fill-in)
+		static std::vector<size_t> getMinimumDegreeOrder(std::vector<bool> const& pattern, size_t dim);
+		// Variable, falls A nur die Variable selbst bzw. ihre Elemente der Reihe nach enthaelt
+		static BasicPtr getMatrixSymbol(BasicPtr const& A);
+		// Dimensionen, fuer die functionmodule.c ein ldlt_solve_<dim> enthalten muss
+		mutable std::set<int> m_ldltDims;
 
     private:
 		bool m_pymbs_wrapper;
 		bool m_simulink_sfunction;
 		bool m_include_visual;
+		bool m_sparse_solve;
+		bool m_batch;
+		// "", "dense" oder "sparse"
+		std::string m_jacobian;
 
 		double generateDerState(Graph::Graph& g, int &dim);
+		// Zustaende, Parameter, Konstanten und Variablen von der_state deklarieren
+		// ohne local, die deklarieren die Abschnitte selbst; mit lanes kommen Zustaende,
+		// vorgegebene Parameter und die Eingaenge lanes je Instanz aus y, p_lanes und u_lanes
+		void writeDeclarations(std::ostream &f, Graph::Graph& g, Graph::AssignmentsPtr const& a, Graph::VariableVec const& states,
+							   std::set<SymbolPtr> const& local = std::set<SymbolPtr>(), Graph::VariableVec const* lanes = NULL);
+		// yd aus den der_-Variablen setzen, mit lanes bei [k*lanes + lane]
+		void writeReturnValues(std::ostream &f, Graph::VariableVec const& states, bool lanes) const;
+		// Abschnitt k von der_state als eigene Uebersetzungseinheit <name>_der_state_<k>.c
+		void generateDerStateChunk(Graph::Graph& g, Chunk const& chunk, size_t k, int dim, std::vector<Graph::Assignment> const& all);
+		// Kopf und Aufruf der Abschnittsfunktion, geschriebene Skalare werden als Zeiger uebergeben
+		std::string chunkSignature(Chunk const& chunk, size_t k) const;
+		std::string chunkCall(Chunk const& chunk, size_t k) const;
+		// d(yd)/d(y) dicht (spaltenweise) oder als CSC, mit den Gleichungen von der_state
+		void writeJacobian(std::ostream &f, Graph::Graph& g, Graph::AssignmentsPtr const& a, Graph::VariableVec const& states,
+						   Graph::VariableVec const& inputs, Graph::VariableVec const& controller, std::vector<Graph::Assignment> const& equations);
+		// der_state fuer viele Instanzen auf einmal (Struktur aus Arrays, Schleife ueber die Instanzen)
+		void writeDerStateBatch(std::ostream &f, Graph::Graph& g, Graph::AssignmentsPtr const& a, Graph::VariableVec const& states,
+								Graph::VariableVec const& inputs, Graph::VariableVec const& controller, std::string const& equations);
 		double generateVisual(Graph::Graph& g);
 		double generateSensors(Graph::Graph& g);
         
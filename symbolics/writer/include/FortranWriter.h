@@ -16,6 +16,10 @@ namespace Symbolics
         ~FortranWriter();
 
     protected:
+        // Kopie fuer runStages, mit eigenem Printer
+        FortranWriter( FortranWriter const& src );
+        Writer* clone() const;
+
         double generateTarget_Impl(Graph::Graph& g);
         
         std::string writeEquations(std::vector<Graph::Assignment> const& equations, std::vector<std::string> &additionalVarDefs) const;
@@ -27,6 +31,10 @@ namespace Symbolics
 		bool m_pymbs_wrapper;
 
 		double generateDerState(Graph::Graph& g);
+		// Abschnitt k von der_state als eigene Datei <name>_der_state_<k>.f90
+		void generateDerStateChunk(Graph::Graph& g, Chunk const& chunk, size_t k);
+		// Argumentliste der Abschnittsroutine: in, inout, Ableitungen
+		std::string chunkArguments(Chunk const& chunk) const;
 		double generateSensors(Graph::Graph& g);
 		double generateVisual(Graph::Graph& g);
 
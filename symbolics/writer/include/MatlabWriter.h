@@ -16,6 +16,10 @@ namespace Symbolics
         ~MatlabWriter();
 
     protected:
+        // Kopie fuer runStages, mit eigenem Printer
+        MatlabWriter( MatlabWriter const& src );
+        Writer* clone() const;
+
         double generateTarget_Impl(Graph::Graph& g);
         std::string writeEquations(std::vector<Graph::Assignment> const& equations) const;
 
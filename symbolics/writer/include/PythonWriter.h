@@ -39,6 +39,10 @@ namespace Symbolics
     ~PythonWriter();
 
   protected:
+    // Kopie fuer runStages, mit eigenem Printer
+    PythonWriter( PythonWriter const& src );
+    Writer* clone() const;
+
     double generateTarget_Impl(Graph::Graph& g);
 	std::string writeEquations(std::vector<Graph::Assignment> const& equations) const;
 
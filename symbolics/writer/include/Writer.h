@@ -3,6 +3,10 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <set>
+#include <fstream>
+#include <functional>
 #include "Symbolics.h"
 #include "Graph.h"
 
@@ -33,6 +37,51 @@ namespace Symbolics
 
         std::string getHeaderLine();
 
+        // Datei zum Schreiben oeffnen und fuer den Cache merken
+        void openFile(std::ofstream &f, std::string const& filename);
+        // geschriebene Dateien, ausserhalb von openFile erzeugte selbst eintragen
+        std::vector<std::string> m_files;
+
+        // Arbeitsschritt (eine oder mehrere Dateien), laeuft auf dem uebergebenen Writer
+        typedef std::function<double(Writer &w)> Stage;
+        // Schritte nacheinander, oder mit m_threads > 1 parallel auf je einer Kopie (clone)
+        // mit eigenem Printer. Die Zuweisungen der categories werden dafuer vorher in
+        // der Reihenfolge des seriellen Laufs geholt, die Schritte lesen den Graphen nur.
+        double runStages(Graph::Graph& g, std::vector<Graph::Category_Type> const& categories, std::vector<Stage> const& stages);
+        // Hash und freie Symbole werden beim ersten Lesen am Knoten gemerkt: vor den
+        // Threads fuer die Ausdruecke, Gleichungen und Startwerte der Zuweisungen berechnen
+        static void warmCaches(BasicPtr const& exp);
+        static void warmCaches(Graph::Graph& g, Graph::AssignmentsPtr const& a);
+        // Kopie fuer runStages, mit neuem Printer
+        // throws: InternalError, wenn der Writer nicht parallel schreiben kann
+        virtual Writer* clone() const;
+        // Zustand einer Kopie nach runStages uebernehmen (ausser m_files)
+        virtual void mergeStage(Writer const& stage) {};
+
+        // statt g.getAssignments in den Schritten: liefert in runStages die vorab geholten
+        Graph::AssignmentsPtr getAssignments(Graph::Graph& g, Graph::Category_Type category);
+
+        // Abschnitt von der_state als eigene Funktion (Keyword chunk_size)
+        struct Chunk
+        {
+            std::vector<Graph::Assignment> equations;
+            Graph::VariableVec in;      // lebt in den Abschnitt hinein, hier nur gelesen
+            Graph::VariableVec inout;   // hier geschrieben, lebt hinein oder hinaus
+            Graph::VariableVec local;   // lebt nur innerhalb dieses Abschnitts
+            Graph::VariableVec der;     // Zustaende, deren Ableitung (der_<Zustand>) hier vorkommt
+        };
+        // equations der Reihe nach in Abschnitte zu m_chunk_size Gleichungen teilen. Argumente werden
+        // die Variablen, deren Wert an einer Abschnittsgrenze lebt, und die Ableitungen, die uebrigen
+        // sind lokal. Ohne chunk_size oder bei weniger Gleichungen: ein Abschnitt ohne Variablenlisten
+        std::vector<Chunk> splitEquations(std::vector<Graph::Assignment> const& equations) const;
+        // Variablen, die in keinem Abschnitt Argument sind, der_state deklariert sie nicht
+        static std::set<SymbolPtr> getChunkLocals(std::vector<Chunk> const& chunks);
+        // <prefix><k>.<ext> ab k = first entfernen, Abschnitte eines frueheren Laufs
+        void removeChunkFiles(std::string const& prefix, std::string const& ext, size_t first);
+
+        // Operationen je Gleichung und Ausgang (der_state, sensors, visual) als <name>_cost.json
+        void writeCostReport(Graph::Graph& g);
+
 		// Vielleicht ist folgende Funktion logisch sinnvoller in einer anderen Klasse aufgehoben - wenn jemand wei� wo, einfach �ndern.
 		// Die Funktion ist als Parameter f�r die std::sort Funktion gedacht, um Graph::VariableVec Vektoren zu sortieren.
 		// Die Funktion muss static sein, da sie als functionpointer verwendet wird
@@ -41,8 +90,40 @@ namespace Symbolics
     public:
         double generateTarget(std::string name, std::string path, Graph::Graph& g, bool optimize);
 
+        // Kostenbericht neben den erzeugten Dateien ablegen (Keyword cost_report)
+        inline void setCostReport(bool costReport) { m_cost_report = costReport; };
+
+        // Cache (Keyword cache): stimmen Graph und options mit einem frueheren Lauf
+        // ueberein und sind dessen Dateien unveraendert, wird nichts geschrieben
+        inline void setCache(bool cache, std::string const& options) { m_cache = cache; m_cache_options = options; };
+
+        // Anzahl Threads fuer runStages (Keyword threads)
+        inline void setThreads(size_t threads) { m_threads = (threads < 1) ? 1 : threads; };
+
+        // Gleichungen je Funktion in der_state, 0 = alles in einer Funktion (Keyword chunk_size)
+        inline void setChunkSize(size_t chunkSize) { m_chunk_size = chunkSize; };
+
+        // Zuweisungen fuer wenige gleichzeitig lebende Werte umsortieren (Keyword schedule)
+        inline void setSchedule(bool schedule) { m_schedule = schedule; };
+
+        // gemeinsame Teilausdruecke als cse_<n>, Standard an (Keyword cse)
+        inline void setCSE(bool cse) { m_cse = cse; };
+
     private:
         bool m_scalar;
+        bool m_cost_report;
+        bool m_cache;
+        std::string m_cache_options;
+        size_t m_threads;
+        size_t m_chunk_size;
+        bool m_schedule;
+        bool m_cse;
+        std::map<Graph::Category_Type, Graph::AssignmentsPtr> m_assignments;
+
+        // Stempeldatei im Unterverzeichnis .pymbs_cache, Name aus Graph-Hash und Optionen
+        std::string getCacheFile(Graph::Graph& g);
+        bool isCached(std::string const& cacheFile);
+        void writeCacheFile(std::string const& cacheFile);
         
 
     };
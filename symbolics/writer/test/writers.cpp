@@ -1,5 +1,8 @@
 #include <iostream>
 #include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <iterator>
 #include "Symbolics.h"
 #include "pendulum.h"
 #include "ModelicaWriter.h"
@@ -7,6 +10,12 @@
 #include "CWriter.h"
 #include "PythonWriter.h"
 #include "MatlabWriter.h"
+#include "Filesystem.h"
+#ifdef _WIN32
+  #include <sys/utime.h>
+#else
+  #include <utime.h>
+#endif
 
 using namespace Symbolics;
 
@@ -120,11 +129,384 @@ int pend_expl_python()
     return res;
 }
 
+int pend_expl_cache()
+{
+    Graph::Graph g = Pendulum::getGraph_expl();
+    g.buildGraph(true);
+    std::string file = "./Pendulum_cache.mo";
+    filesystem::remove(file);
+    {
+        ModelicaWriter writer;
+        writer.setCache(true, "mo");
+        writer.generateTarget("Pendulum_cache","./.",g,true);
+    }
+
+    // gleiche Groesse und Zeit, anderer Inhalt: wird nicht ueberschrieben
+    long long size, mtime;
+    if (!filesystem::file_info(file, size, mtime)) return -1;
+    {
+        std::ofstream f(file.c_str());
+        f << std::string(static_cast<size_t>(size), 'x');
+    }
+    struct utimbuf times;
+    times.actime = static_cast<time_t>(mtime);
+    times.modtime = static_cast<time_t>(mtime);
+    utime(file.c_str(), &times);
+    {
+        ModelicaWriter writer;
+        writer.setCache(true, "mo");
+        writer.generateTarget("Pendulum_cache","./.",g,true);
+    }
+    std::ifstream in(file.c_str());
+    std::string line;
+    std::getline(in, line);
+    in.close();
+    if (line[0] != 'x') return -2;
+
+    // andere Optionen
+    {
+        ModelicaWriter writer;
+        writer.setCache(true, "mo|inputsAsInputs=False");
+        writer.generateTarget("Pendulum_cache","./.",g,true);
+    }
+    in.open(file.c_str());
+    std::getline(in, line);
+    in.close();
+    if (line[0] == 'x') return -3;
+
+    // anderer Graph
+    Graph::Graph g2 = Pendulum::getGraph();
+    g2.buildGraph(true);
+    if (g2.getHash() == g.getHash()) return -4;
+    return 0;
+}
+
+int pend_expl_threads()
+{
+    Graph::Graph g = Pendulum::getGraph_expl();
+    g.buildGraph(true);
+    FortranWriter writer;
+    writer.setThreads(4);
+    writer.generateTarget("Pendulum_threads","./.",g,true);
+
+    // alle Dateien muessen trotz paralleler Erzeugung vollstaendig sein
+    int res = 0;
+    std::string cmd = "gfortran -shared functionmodule.f90 \"Pendulum_threads_der_state.f90\" -ffree-line-length-none";
+    res += system(cmd.c_str());
+    cmd = "gfortran -shared functionmodule.f90 \"Pendulum_threads_visual.f90\" -ffree-line-length-none";
+    res += system(cmd.c_str());
+    cmd = "gfortran -shared functionmodule.f90 \"Pendulum_threads_sensors.f90\" -ffree-line-length-none";
+    res += system(cmd.c_str());
+
+    return res;
+}
+
+// Dateiinhalt ohne die Zeile mit dem Zeitpunkt der Erzeugung
+std::string readGenerated( std::string const& file )
+{
+    std::ifstream f(file.c_str());
+    std::string res, line;
+    while (std::getline(f, line))
+        if (line.find("generated by PyMbs on") == std::string::npos)
+            res += line + "\n";
+    return res;
+}
+
+int threads_c()
+{
+    std::map<std::string, std::string> kwds;
+    kwds["pymbs_wrapper"] = "True";
+    kwds["batch"] = "True";
+    const char* files[] = {"Pendulum_threads_der_state.c", "Pendulum_threads_visual.c", "Pendulum_threads_sensors.c", "functionmodule.c",
+                           "Pendulum_threads_der_state_CWrapper.py", "Pendulum_threads_visual_CWrapper.py", "Pendulum_threads_sensors_CWrapper.py"};
+    const size_t n = sizeof(files)/sizeof(files[0]);
+
+    // je ein eigener Graph, generateTarget macht ihn skalar. Die Reihenfolge der Parameter
+    // folgt den Adressen der Symbole, daher der serielle Lauf zuerst
+    std::vector<std::string> serial;
+    {
+        Graph::Graph g = Pendulum::getGraph_expl();
+        g.buildGraph(true);
+        CWriter writer(kwds);
+        writer.generateTarget("Pendulum_threads","./.",g,true);
+        for (size_t i=0;i<n;++i)
+            serial.push_back(readGenerated(std::string("./") + files[i]));
+    }
+    {
+        Graph::Graph g = Pendulum::getGraph_expl();
+        g.buildGraph(true);
+        CWriter writer(kwds);
+        writer.setThreads(4);
+        writer.generateTarget("Pendulum_threads","./.",g,true);
+    }
+    for (size_t i=0;i<n;++i)
+    {
+        if (serial[i].empty()) return -1;
+        if (readGenerated(std::string("./") + files[i]) != serial[i]) return -2;
+    }
+    return 0;
+}
+
+int pend_expl_chunks()
+{
+    Graph::Graph g = Pendulum::getGraph_expl();
+    g.buildGraph(true);
+    FortranWriter writer;
+    writer.setChunkSize(4);
+    writer.generateTarget("Pendulum_chunks","./.",g,true);
+    if (!filesystem::exists("./Pendulum_chunks_der_state_1.f90")) return -1;
+
+    // der_state mit allen Abschnitten uebersetzen
+    std::string cmd = "gfortran -shared functionmodule.f90 Pendulum_chunks_der_state_*.f90 \"Pendulum_chunks_der_state.f90\" -ffree-line-length-none";
+    return system(cmd.c_str());
+}
+
+// A mit den Eintraegen k[r*n+c]*p, als SymmetricMatrix (obere Haelfte) oder als Matrix
+BasicPtr getSolveMatrix( BasicPtr const& p, int const* k, size_t n, bool symmetric )
+{
+    BasicPtrVec values;
+    for (size_t r=0;r<n;++r)
+        for (size_t c=(symmetric ? r : 0);c<n;++c)
+            values.push_back(Mul::New(Int::New(k[r*n+c]),p));
+    if (symmetric)
+        return BasicPtr(new SymmetricMatrix(values,Shape(n,n)));
+    return BasicPtr(new Matrix(values,Shape(n,n)));
+}
+
+// der(q) = a, a = solve(A,[1;..;n]), A aus getSolveMatrix mit p = 1
+Graph::Graph getGraph_solve( int const* k, size_t n, bool symmetric )
+{
+    Graph::Graph gr;
+    BasicPtr p = gr.addSymbol(new Symbol("p",PARAMETER));
+    BasicPtr q = gr.addSymbol(new Symbol("q",Shape(n)));
+    BasicPtr a = gr.addSymbol(new Symbol("a",Shape(n)));
+    gr.addExpression(p,BasicPtr(new Real(1)));
+    BasicPtrVec b;
+    for (size_t i=0;i<n;++i)
+        b.push_back(Int::New(i+1));
+    gr.addExpression(a,Solve::New(getSolveMatrix(p,k,n,symmetric),BasicPtr(new Matrix(b,Shape(n)))));
+    gr.addExpression(Der::New(q),a);
+    return gr;
+}
+
+// der_state (mit allen Abschnitten) erzeugen, mit einem Hauptprogramm uebersetzen und bei y auswerten
+int eval_der_state_c( CWriter &writer, Graph::Graph &g, std::string const& name, size_t n,
+                      std::string &code, std::vector<double> &yd, std::vector<double> const& y = std::vector<double>() )
+{
+    g.buildGraph(true);
+    writer.generateTarget(name,"./.",g,true);
+    std::ifstream src((name + "_der_state.c").c_str());
+    code.assign((std::istreambuf_iterator<char>(src)), std::istreambuf_iterator<char>());
+
+    std::ofstream f;
+    f.open((name + "_main.c").c_str());
+    f << "#include <stdio.h>" << std::endl;
+    f << "int " << name << "_der_state(double time, double * y, double * yd);" << std::endl;
+    f.precision(17);
+    f << "int main() { double y[" << n << "] = {";
+    for (size_t i=0;i<y.size();++i)
+        f << (i ? ", " : "") << y[i];
+    f << (y.empty() ? "0" : "") << "}; double yd[" << n << "] = {0}; int i;" << std::endl;
+    f << "  FILE *f = fopen(\"" << name << ".txt\", \"w\");" << std::endl;
+    f << "  " << name << "_der_state(0, y, yd);" << std::endl;
+    f << "  for (i=0; i<" << n << "; ++i) fprintf(f, \"%.17g\\n\", yd[i]);" << std::endl;
+    f << "  fclose(f); return 0; }" << std::endl;
+    f.close();
+    // gcc ausserhalb von Windows kennt __declspec nicht
+    std::string cmd = "gcc -Werror=implicit-function-declaration -D\"__declspec(x)=\" -o " + name + " " + name + "_main.c \"" + name + "_der_state.c\"";
+    for (size_t k=1; filesystem::exists(name + "_der_state_" + str((int)k) + ".c"); ++k)
+        cmd += " \"" + name + "_der_state_" + str((int)k) + ".c\"";
+    cmd += " -lm";
+    if (system(cmd.c_str()) != 0) return -1;
+    if (system(("./" + name).c_str()) != 0) return -2;
+    std::ifstream res((name + ".txt").c_str());
+    yd.assign(n, 0.0);
+    for (size_t i=0;i<n;++i)
+        if (!(res >> yd[i])) return -3;
+    return 0;
+}
+
+int solve_c()
+{
+    std::string code;
+    std::vector<double> yd;
+
+    // positiv definit: LDL^T, x = [1/11; 7/11]
+    int spd[] = {4,1, 1,3};
+    Graph::Graph g1 = getGraph_solve(spd,2,true);
+    CWriter writer1;
+    if (eval_der_state_c(writer1,g1,"Solve_spd",2,code,yd) != 0) return -1;
+    if (code.find("ldlt_solve_2(") == std::string::npos) return -2;
+    if ((fabs(yd[0]-1.0/11) > 1e-12) || (fabs(yd[1]-7.0/11) > 1e-12)) return -3;
+
+    // symmetrisch, aber indefinit: ohne Pivotsuche Division durch Null, daher legs, x = [2; 1]
+    int indef[] = {0,1, 1,0};
+    Graph::Graph g2 = getGraph_solve(indef,2,false);
+    CWriter writer2;
+    if (eval_der_state_c(writer2,g2,"Solve_indef",2,code,yd) != 0) return -4;
+    if (code.find("ldlt_solve_") != std::string::npos) return -5;
+    if ((fabs(yd[0]-2.0) > 1e-12) || (fabs(yd[1]-1.0) > 1e-12)) return -6;
+    return 0;
+}
+
+int sparse_solve_c()
+{
+    std::map<std::string, std::string> kwds;
+    kwds["sparse_solve"] = "True";
+    std::string code;
+    std::vector<double> sparse, dense;
+
+    // Pfeilform, in der Reihenfolge minimalen Grades ohne Fill-in
+    int k[] = {4,0,0,1, 0,4,0,1, 0,0,4,1, 1,1,1,4};
+    Graph::Graph g1 = getGraph_solve(k,4,true);
+    CWriter writer1(kwds);
+    if (eval_der_state_c(writer1,g1,"Solve_sparse",4,code,sparse) != 0) return -1;
+    if ((code.find("solve_D_") == std::string::npos) || (code.find("legs(") != std::string::npos)) return -2;
+    // dieselbe Matrix als Matrix geht an legs
+    Graph::Graph g2 = getGraph_solve(k,4,false);
+    CWriter writer2(kwds);
+    if (eval_der_state_c(writer2,g2,"Solve_legs",4,code,dense) != 0) return -3;
+    if (code.find("legs(") == std::string::npos) return -4;
+    for (size_t i=0;i<4;++i)
+        if (fabs(sparse[i]-dense[i]) > 1e-12) return -5;
+
+    // indefinit auch mit sparse_solve nicht ohne Pivotsuche
+    int indef[] = {0,1, 1,0};
+    Graph::Graph g3 = getGraph_solve(indef,2,false);
+    CWriter writer3(kwds);
+    if (eval_der_state_c(writer3,g3,"Solve_sparse_indef",2,code,dense) != 0) return -6;
+    if (code.find("solve_D_") != std::string::npos) return -7;
+    if ((fabs(dense[0]-2.0) > 1e-12) || (fabs(dense[1]-1.0) > 1e-12)) return -8;
+    return 0;
+}
+
+// der(x) = v, der(v) = -c*sin(x) + d*v + u mit vorgegebenem c und berechnetem d
+Graph::Graph getGraph_batch()
+{
+    Graph::Graph gr;
+    BasicPtr c = gr.addSymbol(new Symbol("c",PARAMETER));
+    BasicPtr d = gr.addSymbol(new Symbol("d",PARAMETER));
+    BasicPtr u = gr.addSymbol(new Symbol("u",INPUT), new Real(0));
+    BasicPtr x = gr.addSymbol(new Symbol("x"));
+    BasicPtr v = gr.addSymbol(new Symbol("v"));
+    gr.addExpression(c,BasicPtr(new Real(2)));
+    gr.addExpression(d,Mul::New(BasicPtr(new Real(-0.25)),c));
+    gr.addExpression(Der::New(x),v);
+    gr.addExpression(Der::New(v),Add::New(Add::New(Mul::New(Neg::New(c),Sin::New(x)),Mul::New(d,v)),u));
+    return gr;
+}
+
+int batch_c()
+{
+    std::map<std::string, std::string> kwds;
+    kwds["batch"] = "True";
+    Graph::Graph g = getGraph_batch();
+    g.buildGraph(true);
+    CWriter writer(kwds);
+    writer.generateTarget("Batch","./.",g,true);
+
+    // zwei Instanzen mit verschiedenen Zustaenden und Eingaengen, je Instanz auch skalar ausgewertet
+    std::ofstream f;
+    f.open("Batch_main.c");
+    f << "#include <stdio.h>" << std::endl;
+    f << "int Batch_der_state(double time, double * y, double * yd, double u);" << std::endl;
+    f << "int Batch_der_state_batch(int lanes, double * time_lanes, double * y, double * yd, double * p_lanes, double * u_lanes);" << std::endl;
+    f << "int main() { double t[2] = {0, 0}, y[4] = {0.3, -0.7, 1.1, 0.4}, yd[4] = {0}, p[2] = {2, 2}, u[2] = {0.5, -1.5};" << std::endl;
+    f << "  double ys[2], yds[2]; int lane, k;" << std::endl;
+    f << "  FILE *f = fopen(\"Batch.txt\", \"w\");" << std::endl;
+    f << "  Batch_der_state_batch(2, t, y, yd, p, u);" << std::endl;
+    f << "  for (lane=0; lane<2; ++lane) {" << std::endl;
+    f << "    for (k=0; k<2; ++k) ys[k] = y[k*2 + lane];" << std::endl;
+    f << "    Batch_der_state(0, ys, yds, u[lane]);" << std::endl;
+    f << "    for (k=0; k<2; ++k) fprintf(f, \"%.17g %.17g\\n\", yds[k], yd[k*2 + lane]); }" << std::endl;
+    f << "  fclose(f); return 0; }" << std::endl;
+    f.close();
+    std::string cmd = "gcc -D\"__declspec(x)=\" -o Batch Batch_main.c Batch_der_state.c -lm";
+    if (system(cmd.c_str()) != 0) return -1;
+    if (system("./Batch") != 0) return -2;
+    std::ifstream res("Batch.txt");
+    for (size_t i=0;i<4;++i)
+    {
+        double scalar, batch;
+        if (!(res >> scalar >> batch)) return -3;
+        if ((scalar == 0) || (fabs(scalar-batch) > 1e-12)) return -4;
+    }
+    return 0;
+}
+
+// Kette von Variablen ueber viele Abschnitte, mit LDL^T (SymmetricMatrix) und legs (Dimension wie q)
+Graph::Graph getGraph_chunks()
+{
+    Graph::Graph gr;
+    BasicPtr p = gr.addSymbol(new Symbol("p",PARAMETER));
+    BasicPtr q = gr.addSymbol(new Symbol("q",Shape(2)));
+    BasicPtr s1 = gr.addSymbol(new Symbol("s1"));
+    BasicPtr s2 = gr.addSymbol(new Symbol("s2"));
+    BasicPtr s3 = gr.addSymbol(new Symbol("s3"));
+    BasicPtr s4 = gr.addSymbol(new Symbol("s4"));
+    BasicPtr s5 = gr.addSymbol(new Symbol("s5"));
+    BasicPtr a = gr.addSymbol(new Symbol("a",Shape(2)));
+    BasicPtr b = gr.addSymbol(new Symbol("b",Shape(2)));
+    gr.addExpression(p,BasicPtr(new Real(1)));
+    gr.addExpression(s1,Mul::New(Sin::New(Element::New(q,0,0)),p));
+    gr.addExpression(s2,Add::New(Cos::New(Element::New(q,1,0)),s1));
+    gr.addExpression(s3,Add::New(Mul::New(s1,s2),Element::New(q,1,0)));
+    gr.addExpression(s4,Add::New(Mul::New(s3,s3),Neg::New(s1)));
+    gr.addExpression(s5,Add::New(s4,Mul::New(s2,Element::New(q,0,0))));
+    // 4+s1^2 >= 4, 3+s3^2 >= 3, |s2| <= 2: positiv definit
+    BasicPtrVec A, B, ra, rb, qd;
+    A.push_back(Add::New(Int::New(4),Mul::New(s1,s1)));
+    A.push_back(s2);
+    A.push_back(Add::New(Int::New(3),Mul::New(s3,s3)));
+    B.push_back(Int::New(0));
+    B.push_back(Add::New(Int::New(1),Mul::New(s4,s4)));
+    B.push_back(Int::New(1));
+    B.push_back(s5);
+    ra.push_back(s4);
+    ra.push_back(s5);
+    rb.push_back(Int::New(1));
+    rb.push_back(s1);
+    gr.addExpression(a,Solve::New(BasicPtr(new SymmetricMatrix(A,Shape(2,2))),BasicPtr(new Matrix(ra,Shape(2)))));
+    gr.addExpression(b,Solve::New(BasicPtr(new Matrix(B,Shape(2,2))),BasicPtr(new Matrix(rb,Shape(2)))));
+    qd.push_back(Add::New(Element::New(a,0,0),Element::New(b,1,0)));
+    qd.push_back(Add::New(Mul::New(Element::New(a,1,0),s3),Mul::New(Element::New(b,0,0),s5)));
+    gr.addExpression(Der::New(q),BasicPtr(new Matrix(qd,Shape(2))));
+    return gr;
+}
+
+int chunks_c()
+{
+    std::string code;
+    std::vector<double> y, whole, chunked;
+    y.push_back(0.3);
+    y.push_back(-1.2);
+
+    Graph::Graph g = getGraph_chunks();
+    CWriter writer;
+    if (eval_der_state_c(writer,g,"Chunks",2,code,whole,y) != 0) return -1;
+    if ((code.find("ldlt_solve_2(") == std::string::npos) || (code.find("legs(") == std::string::npos)) return -2;
+    for (size_t i=0;i<2;++i)
+        if (whole[i] == 0) return -3;
+
+    // Abschnitte bis herunter zu einer Gleichung, jede Grenze liegt einmal woanders
+    for (size_t size=1; size<=3; ++size)
+    {
+        Graph::Graph gc = getGraph_chunks();
+        CWriter writerc;
+        writerc.setChunkSize(size);
+        if (eval_der_state_c(writerc,gc,"Chunks_" + str((int)size),2,code,chunked,y) != 0) return -4;
+        if (!filesystem::exists("./Chunks_" + str((int)size) + "_der_state_2.c")) return -5;
+        for (size_t i=0;i<2;++i)
+            if (chunked[i] != whole[i]) return -6;
+    }
+    return 0;
+}
 
 int main( int argc,  char *argv[])
 {
     
     int res=0;
+    std::cout << "SOLVE " << chunks_c() << std::endl; return 0;
     res = pendulum();
     if (res != 0) return -1;
     res = pendulumDAE();
@@ -139,6 +521,22 @@ int main( int argc,  char *argv[])
     if (res != 0) return -6;
     res = pend_expl_python();
     if (res != 0) return -7;
+    res = pend_expl_cache();
+    if (res != 0) return -8;
+    res = pend_expl_threads();
+    if (res != 0) return -9;
+    res = pend_expl_chunks();
+    if (res != 0) return -10;
+    res = solve_c();
+    if (res != 0) return -11;
+    res = sparse_solve_c();
+    if (res != 0) return -12;
+    res = batch_c();
+    if (res != 0) return -13;
+    res = threads_c();
+    if (res != 0) return -14;
+    res = chunks_c();
+    if (res != 0) return -15;
 
     return 0;
 }